@@ -29,5 +29,6 @@
 #include <LinearAlgebraOps.hpp>
 #include <SparseOps.hpp>
 #include <NativeImageKernel.hpp>
+#include <NativeFftService.hpp>
 
 #include <JniHeadersWrap.hpp>
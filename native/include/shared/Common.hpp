@@ -25,6 +25,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include <JniWrap.hpp>
@@ -405,6 +406,20 @@ struct jcomplex {
     }
 };
 
+// The thresholds and scalings of Blue's algorithm for double precision: Squares of magnitudes below 2^-511 would
+// underflow and are scaled up by 2^537, and squares of magnitudes above 2^486 could overflow when summed and are
+// scaled down by 2^-538.
+#define NORM2_SMALL_THRESHOLD 1.4916681462400413e-154
+#define NORM2_BIG_THRESHOLD 1.997919072202235e+146
+#define NORM2_SMALL_SCALE 4.4989137945431964e+161
+#define NORM2_BIG_SCALE 1.1113793747425387e-162
+
+// The mantissa bits and exponent biases of the half-precision formats IEEE 754 binary16 and bfloat16.
+#define HALF_FP16_MANTISSA 10
+#define HALF_FP16_BIAS 15
+#define HALF_BF16_MANTISSA 7
+#define HALF_BF16_BIAS 127
+
 /**
  * A static utility class for common operations.
  */
@@ -456,6 +471,154 @@ public:
         return acc;
     }
 
+    /**
+     * Accumulates the square of a value into one of three sums by magnitude, as in Blue's algorithm, so that the
+     * Euclidean norm comes out without overflow or underflow. The selection is branch free, and NaNs land in the
+     * medium sum.
+     * 
+     * @param value
+     *      the value.
+     * @param sums
+     *      the scaled big, medium and scaled small sums of squares.
+     */
+    inline static void norm2Accumulate(jdouble value, jdouble *sums) {
+
+        jdouble a = std::fabs(value);
+
+        bool isBig = (a > NORM2_BIG_THRESHOLD);
+        bool isSmall = (a < NORM2_SMALL_THRESHOLD);
+
+        jdouble big = isBig ? a * NORM2_BIG_SCALE : 0.0;
+        jdouble medium = (isBig || isSmall) ? 0.0 : a;
+        jdouble small = isSmall ? a * NORM2_SMALL_SCALE : 0.0;
+
+        sums[0] += big * big;
+        sums[1] += medium * medium;
+        sums[2] += small * small;
+    }
+
+    /**
+     * Combines the sums of squares from Common#norm2Accumulate into a Euclidean norm.
+     * 
+     * @param sums
+     *      the scaled big, medium and scaled small sums of squares.
+     * @return the norm.
+     */
+    inline static jdouble norm2Combine(const jdouble *sums) {
+
+        jdouble big = sums[0];
+        jdouble medium = sums[1];
+        jdouble small = sums[2];
+
+        if (big > 0.0) {
+
+            // The medium sum only matters if it's NaN or could register against the big one.
+            if (medium > 0.0 || medium != medium) {
+                big += (medium * NORM2_BIG_SCALE) * NORM2_BIG_SCALE;
+            }
+
+            return sqrt(big) / NORM2_BIG_SCALE;
+
+        } else if (small > 0.0) {
+
+            if (medium > 0.0 || medium != medium) {
+
+                jdouble m = sqrt(medium);
+                jdouble s = sqrt(small) / NORM2_SMALL_SCALE;
+
+                jdouble yMin = std::min<jdouble>(m, s);
+                jdouble yMax = std::max<jdouble>(m, s);
+
+                return (yMax == yMax) ? yMax * sqrt(1.0 + (yMin / yMax) * (yMin / yMax)) : yMax;
+            }
+
+            return sqrt(small) / NORM2_SMALL_SCALE;
+
+        } else {
+
+            return sqrt(medium);
+        }
+    }
+
+    /**
+     * Rounds a value to the nearest half-precision bit pattern, with ties going to even. The format has 16 bits and
+     * is parameterized by its mantissa bit count M and exponent bias B. Overflows become infinities, and NaNs become
+     * quiet NaNs.
+     * 
+     * @param value
+     *      the value.
+     * @return the bit pattern.
+     */
+    template<jint M, jint B> inline static jshort toHalf(jdouble value) {
+
+        jlong bits;
+        memcpy(&bits, &value, sizeof(jlong));
+
+        jint sign = (bits < 0) ? 0x8000 : 0;
+
+        bits &= std::numeric_limits<jlong>::max();
+
+        jint exp = (jint) (bits >> 52) - 1023;
+        jint inf = (2 * B + 1) << M;
+
+        if (exp == 1024) {
+            return (jshort) ((bits & (((jlong) 1 << 52) - 1)) ? (inf | (1 << (M - 1))) : (sign | inf));
+        }
+
+        if (exp > B) {
+            return (jshort) (sign | inf);
+        }
+
+        // Anything below half of the smallest subnormal rounds to zero.
+        if (exp < -B - M) {
+            return (jshort) sign;
+        }
+
+        jlong m = (bits & (((jlong) 1 << 52) - 1)) | ((jlong) 1 << 52);
+        jint shift = 52 - M + std::max<jint>(1 - B - exp, 0);
+
+        jlong q = m >> shift;
+        jlong rem = m & (((jlong) 1 << shift) - 1);
+        jlong half = (jlong) 1 << (shift - 1);
+
+        q += (jlong) ((rem > half) | ((rem == half) & (jint) (q & 1)));
+
+        // Adding the rounded significand lets carries propagate into the exponent, and from there into infinity.
+        return (jshort) (sign | (((exp >= 1 - B) ? (exp + B - 1) << M : 0) + (jint) q));
+    }
+
+    /**
+     * Expands a half-precision bit pattern into a single precision value, which is exact. The format has 16 bits and
+     * is parameterized by its mantissa bit count M and exponent bias B.
+     * 
+     * @param value
+     *      the bit pattern.
+     * @return the value.
+     */
+    template<jint M, jint B> inline static jfloat fromHalf(jshort value) {
+
+        unsigned int bits = (unsigned int) value & 0xFFFF;
+        unsigned int sign = (bits & 0x8000) << 16;
+        unsigned int exp = (bits >> M) & (2 * B + 1);
+        unsigned int mant = bits & ((1U << M) - 1);
+
+        jfloat res;
+
+        if (exp == 0) {
+
+            res = (jfloat) ldexp((jdouble) mant, 1 - B - M);
+
+            return sign ? -res : res;
+        }
+
+        unsigned int resBits = sign | (mant << (23 - M)) //
+                | ((exp == (unsigned int) (2 * B + 1)) ? 0x7F800000U : ((exp - B + 127) << 23));
+
+        memcpy(&res, &resBits, sizeof(jfloat));
+
+        return res;
+    }
+
     /**
      * Throws a new Java RuntimeException.
      * 
@@ -60,6 +60,63 @@ public:
             jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray dstV, //
             jintArray opDims);
 
+    /**
+     * Performs a real window operation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the operation type.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param dstV
+     *      the destination values.
+     * @param dim
+     *      the dimension of interest.
+     * @param size
+     *      the window size.
+     */
+    static void rwOp(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray dstV, //
+            jint dim, jint size);
+
+    /**
+     * Performs a real group operation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the operation type.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param labels
+     *      the group labels along the dimension of interest.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     * @param dim
+     *      the dimension of interest.
+     */
+    static void rgOp(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray labels, //
+            jdoubleArray dstV, jintArray dstD, jintArray dstS, //
+            jint dim);
+
     /**
      * Performs a real index operation.
      * 
@@ -138,35 +195,55 @@ public:
             jint nDims, jint dim);
 
     /**
-     * Defines a real reduce operation.
+     * Defines a real reduce operation that makes one pass over the source.
+     */
+    typedef void rrAccumulateOp_t(const jdouble *, jint, jdouble *, jint, jint);
+
+    /**
+     * Defines a real reduce operation that reduces one dimension at a time.
      */
     typedef void rrOp_t(jdouble *, const jint *, jint, jint, jint);
 
     /**
      * Real reduce sum.
      */
-    inline static rrOp_t rrSum;
+    inline static rrAccumulateOp_t rrSum;
 
     /**
      * Real reduce product.
      */
-    inline static rrOp_t rrProd;
+    inline static rrAccumulateOp_t rrProd;
 
     /**
      * Real reduce maximum.
      */
-    inline static rrOp_t rrMax;
+    inline static rrAccumulateOp_t rrMax;
 
     /**
      * Real reduce minimum.
      */
-    inline static rrOp_t rrMin;
+    inline static rrAccumulateOp_t rrMin;
 
     /**
      * Real reduce variance.
      */
     inline static rrOp_t rrVar;
 
+    /**
+     * Real reduce L1 norm.
+     */
+    inline static rrAccumulateOp_t rrNorm1;
+
+    /**
+     * Real reduce Euclidean norm, which accumulates into sums of squares for Common#norm2Combine.
+     */
+    inline static void rrNorm2(const jdouble *, jint, jdouble *, jint, jint);
+
+    /**
+     * Real reduce L-infinity norm.
+     */
+    inline static rrAccumulateOp_t rrNormInf;
+
     /**
      * Real index maximum.
      */
@@ -208,6 +285,78 @@ public:
      */
     inline static void rdProd(jdouble *, const jint *, const jint *, jdouble *, const jint *, //
             jint, jint, jint);
+
+    /**
+     * Defines a real window operation.
+     */
+    typedef void rwOp_t(const jdouble *, const jint *, jdouble *, jint, jint, jint, jint, jint *);
+
+    /**
+     * Real window sum.
+     */
+    inline static rwOp_t rwSum;
+
+    /**
+     * Real window mean.
+     */
+    inline static rwOp_t rwMean;
+
+    /**
+     * Real window variance.
+     */
+    inline static rwOp_t rwVar;
+
+    /**
+     * Real window maximum.
+     */
+    inline static rwOp_t rwMax;
+
+    /**
+     * Real window minimum.
+     */
+    inline static rwOp_t rwMin;
+
+    /**
+     * Computes moving sums with Neumaier compensation.
+     */
+    inline static void rwSumCompensated(const jdouble *, const jint *, jdouble *, jint, jint, jint, jint, bool);
+
+    /**
+     * Computes moving extrema with a monotonic deque.
+     */
+    inline static void rwExtremum(const jdouble *, const jint *, jdouble *, jint, jint, jint, jint, jint *, bool);
+
+    /**
+     * Defines a real group operation that folds a source slab into the destination slab of its group. The auxiliary
+     * values parallel the destination, and the count is that of the group so far.
+     */
+    typedef void rgOp_t(const jdouble *, jint, jdouble *, jdouble *, jint, jint, jint);
+
+    /**
+     * Real group sum.
+     */
+    inline static rgOp_t rgSum;
+
+    /**
+     * Real group variance by Welford's method.
+     */
+    inline static rgOp_t rgVar;
+
+    /**
+     * Real group maximum.
+     */
+    inline static rgOp_t rgMax;
+
+    /**
+     * Real group minimum.
+     */
+    inline static rgOp_t rgMin;
+
+    /**
+     * Walks a slab with a real group operation.
+     */
+    inline static void rgTraverse(rgOp_t *, const jdouble *, jdouble *, jdouble *, //
+            const jint *, const jint *, const jint *, jint, jint, jint, jint *);
 };
 
 #endif
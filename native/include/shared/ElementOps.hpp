@@ -99,9 +99,11 @@ public:
      * @param a
      *      the argument, if any.
      * @param srcV
-     *      the array.
+     *      the source values.
+     * @param dstV
+     *      the destination values, which may be the source values.
      */
-    static void ruOp(JNIEnv *env, jobject thisObj, jint type, jdouble a, jdoubleArray srcV);
+    static void ruOp(JNIEnv *env, jobject thisObj, jint type, jdouble a, jdoubleArray srcV, jdoubleArray dstV);
 
     /**
      * Applies a complex unary operation.
@@ -117,9 +119,11 @@ public:
      * @param aIm
      *      the imaginary part of the argument, if any.
      * @param srcV
-     *      the array.
+     *      the source values.
+     * @param dstV
+     *      the destination values, which may be the source values.
      */
-    static void cuOp(JNIEnv *env, jobject thisObj, jint type, jdouble aRe, jdouble aIm, jdoubleArray srcV);
+    static void cuOp(JNIEnv *env, jobject thisObj, jint type, jdouble aRe, jdouble aIm, jdoubleArray srcV, jdoubleArray dstV);
 
     /**
      * Applies an integer unary operation.
@@ -133,9 +137,11 @@ public:
      * @param a
      *      the argument, if any.
      * @param srcV
-     *      the array.
+     *      the source values.
+     * @param dstV
+     *      the destination values, which may be the source values.
      */
-    static void iuOp(JNIEnv *env, jobject thisObj, jint type, jint a, jintArray srcV);
+    static void iuOp(JNIEnv *env, jobject thisObj, jint type, jint a, jintArray srcV, jintArray dstV);
 
     /**
      * Applies a binary operation.
@@ -180,6 +186,157 @@ public:
             jobject srcV, jboolean isSrcComplex, //
             jobject dstV, jboolean isDstComplex);
 
+    /**
+     * Compares real values and packs the outcomes into a bit mask, one bit per element.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the comparison type.
+     * @param lhsV
+     *      the left hand side values.
+     * @param rhsV
+     *      the right hand side values, or NULL to compare against the scalar.
+     * @param a
+     *      the scalar right hand side.
+     * @param dstV
+     *      the destination mask.
+     */
+    static void rcOp(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray lhsV, jdoubleArray rhsV, jdouble a, jlongArray dstV);
+
+    /**
+     * Applies a logical operation to bit masks.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the operation type.
+     * @param lhsV
+     *      the left hand side mask.
+     * @param rhsV
+     *      the right hand side mask, which is ignored for negation.
+     * @param dstV
+     *      the destination mask.
+     * @param len
+     *      the number of bits.
+     */
+    static void mlOp(JNIEnv *env, jobject thisObj, jint type, //
+            jlongArray lhsV, jlongArray rhsV, jlongArray dstV, jint len);
+
+    /**
+     * Selects from the left hand side where the mask is set, and from the right hand side otherwise.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param maskV
+     *      the mask.
+     * @param lhsV
+     *      the left hand side values.
+     * @param rhsV
+     *      the right hand side values.
+     * @param dstV
+     *      the destination values.
+     */
+    static void select(JNIEnv *env, jobject thisObj, //
+            jlongArray maskV, jobject lhsV, jobject rhsV, jobject dstV);
+
+    /**
+     * Fills real values where the mask is set.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param maskV
+     *      the mask.
+     * @param a
+     *      the fill value.
+     * @param dstV
+     *      the destination values.
+     */
+    static void maskedFill(JNIEnv *env, jobject thisObj, //
+            jlongArray maskV, jdouble a, jdoubleArray dstV);
+
+    /**
+     * Rounds real values to half-precision bit patterns, with ties going to even.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param format
+     *      the half-precision format.
+     * @param srcV
+     *      the source values.
+     * @param dstV
+     *      the destination bit patterns.
+     */
+    static void halfConvert(JNIEnv *env, jobject thisObj, jint format, //
+            jdoubleArray srcV, jshortArray dstV);
+
+    /**
+     * Expands half-precision bit patterns into real values.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param format
+     *      the half-precision format.
+     * @param srcV
+     *      the source bit patterns.
+     * @param dstV
+     *      the destination values.
+     */
+    static void halfExpand(JNIEnv *env, jobject thisObj, jint format, //
+            jshortArray srcV, jdoubleArray dstV);
+
+    /**
+     * Applies a binary operation to half-precision values in single precision.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the operation type.
+     * @param format
+     *      the half-precision format.
+     * @param lhsV
+     *      the left hand side bit patterns.
+     * @param rhsV
+     *      the right hand side bit patterns.
+     * @param dstV
+     *      the destination bit patterns.
+     */
+    static void heOp(JNIEnv *env, jobject thisObj, jint type, jint format, //
+            jshortArray lhsV, jshortArray rhsV, jshortArray dstV);
+
+    /**
+     * Applies an accumulator operation to half-precision values in double precision.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the operation type.
+     * @param format
+     *      the half-precision format.
+     * @param srcV
+     *      the source bit patterns.
+     * @return the accumulated result.
+     */
+    static jdouble haOp(JNIEnv *env, jobject thisObj, jint type, jint format, //
+            jshortArray srcV);
+
     /**
      * Defines a real accumulator operation.
      */
@@ -215,6 +372,21 @@ public:
      */
     inline static raOp_t raEnt;
 
+    /**
+     * Real accumulator L1 norm.
+     */
+    inline static raOp_t raNorm1;
+
+    /**
+     * Real accumulator Euclidean norm.
+     */
+    inline static raOp_t raNorm2;
+
+    /**
+     * Real accumulator L-infinity norm.
+     */
+    inline static raOp_t raNormInf;
+
     /**
      * Defines a complex accumulator operation.
      */
@@ -233,37 +405,37 @@ public:
     /**
      * Templatized unary addition.
      */
-    template<class T> inline static void uAdd(T, T *, jint);
+    template<class T> inline static void uAdd(T, const T *, T *, jint);
 
     /**
      * Templatized unary multiplication.
      */
-    template<class T> inline static void uMul(T, T *, jint);
+    template<class T> inline static void uMul(T, const T *, T *, jint);
 
     /**
      * Templatized unary square.
      */
-    template<class T> inline static void uSqr(T, T *, jint);
+    template<class T> inline static void uSqr(T, const T *, T *, jint);
 
     /**
      * Templatized unary inverse.
      */
-    template<class T> inline static void uInv(T, T *, jint);
+    template<class T> inline static void uInv(T, const T *, T *, jint);
 
     /**
      * Templatized unary fill.
      */
-    template<class T> inline static void uFill(T, T *, jint);
+    template<class T> inline static void uFill(T, const T *, T *, jint);
 
     /**
      * Templatized unary shuffle.
      */
-    template<class T> inline static void uShuffle(T, T *, jint);
+    template<class T> inline static void uShuffle(T, const T *, T *, jint);
 
     /**
      * Defines a real unary operation.
      */
-    typedef void ruOp_t(jdouble, jdouble *, jint);
+    typedef void ruOp_t(jdouble, const jdouble *, jdouble *, jint);
 
     /**
      * Real unary absolute value.
@@ -313,7 +485,7 @@ public:
     /**
      * Defines a complex unary operation.
      */
-    typedef void cuOp_t(jcomplex, jcomplex *, jint);
+    typedef void cuOp_t(jcomplex, const jcomplex *, jcomplex *, jint);
 
     /**
      * Complex unary exponentiation.
@@ -343,7 +515,7 @@ public:
     /**
      * Defines an integer unary operation.
      */
-    typedef void iuOp_t(jint, jint *, jint);
+    typedef void iuOp_t(jint, const jint *, jint *, jint);
 
     /**
      * Templatized binary addition.
@@ -420,13 +592,23 @@ public:
      */
     inline static itorOp_t itor;
 
+    /**
+     * Defines a half-precision binary operation.
+     */
+    typedef void heOp_t(const jshort *, const jshort *, jshort *, jint);
+
+    /**
+     * Defines a half-precision accumulator operation.
+     */
+    typedef jdouble haOp_t(const jshort *, jint);
+
 private:
 
     template<class T> inline static T accumulatorOpProxy(JNIEnv *, T (*op)(const T *, jint),
             jarray, jboolean);
 
-    template<class T> inline static void unaryOpProxy(JNIEnv *, void (*op)(T, T *, jint),
-            jarray, T, jboolean);
+    template<class T> inline static void unaryOpProxy(JNIEnv *, void (*op)(T, const T *, T *, jint),
+            jarray, jarray, T, jboolean);
 
     template<class T> inline static void binaryOpProxy(JNIEnv *, jint,
             jarray, jarray, jarray, element_type);
@@ -434,6 +616,24 @@ private:
     template<class S, class T> inline static void convertProxy(JNIEnv *, void (*op)(const S *, T *, jint),
             jarray, jboolean,
             jarray, jboolean);
+
+    template<jint C, bool S> inline static void compareProxy(const jdouble *, const jdouble *, jlong *, jint);
+
+    template<jint C> inline static bool compare(jdouble, jdouble);
+
+    template<class T> inline static void selectProxy(const jlong *, const T *, const T *, T *, jint);
+
+    template<jint M, jint B> inline static void halfConvertProxy(const jdouble *, jshort *, jint);
+
+    template<jint M, jint B> inline static void halfExpandProxy(const jshort *, jdouble *, jint);
+
+    template<jint M, jint B> inline static heOp_t *heSelect(jint);
+
+    template<jint C, jint M, jint B> inline static void heProxy(const jshort *, const jshort *, jshort *, jint);
+
+    template<jint M, jint B> inline static haOp_t *haSelect(jint);
+
+    template<jint C, jint M, jint B> inline static jdouble haProxy(const jshort *, jint);
 };
 
 #endif
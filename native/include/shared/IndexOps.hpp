@@ -56,10 +56,200 @@ public:
     static jintArray find(JNIEnv *env, jobject thisObj, //
             jintArray srcV, jintArray srcD, jintArray srcS, jintArray logical);
 
+    /**
+     * Computes the permutation that stably sorts the rows of a one- or two-dimensional array lexicographically.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @return the permutation.
+     */
+    static jintArray sortRows(JNIEnv *env, jobject thisObj, //
+            jobject srcV, jintArray srcD, jintArray srcS);
+
+    /**
+     * Finds the unique rows of a one- or two-dimensional array.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param inverse
+     *      the index of every row's unique row.
+     * @param counts
+     *      the number of occurrences of every unique row, in the leading entries.
+     * @return the index of every unique row's first occurrence, in sorted order.
+     */
+    static jintArray unique(JNIEnv *env, jobject thisObj, //
+            jobject srcV, jintArray srcD, jintArray srcS, //
+            jintArray inverse, jintArray counts);
+
+    /**
+     * Finds the insertion indices of queries into sorted edges.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the search type.
+     * @param edges
+     *      the edges, sorted in ascending order.
+     * @param srcV
+     *      the queries.
+     * @param dstV
+     *      the insertion indices.
+     */
+    static void searchSorted(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray edges, jdoubleArray srcV, jintArray dstV);
+
+    /**
+     * Interpolates a piecewise function through the given breakpoints.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the interpolation type.
+     * @param xV
+     *      the breakpoint abscissas, in strictly ascending order.
+     * @param yV
+     *      the breakpoint ordinates.
+     * @param srcV
+     *      the queries.
+     * @param dstV
+     *      the interpolated values.
+     */
+    static void interpolate(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray xV, jdoubleArray yV, jdoubleArray srcV, jdoubleArray dstV);
+
+    /**
+     * Computes a ROC or precision-recall curve by sweeping a threshold down through the scores.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the curve type.
+     * @param scoresV
+     *      the scores.
+     * @param outcomesV
+     *      the outcomes.
+     * @param nPoints
+     *      the number of points to downsample to, or 0 to keep all of them.
+     * @param statsV
+     *      the area under the ROC curve followed by the average precision.
+     * @return the curve points, as consecutive (x, y) pairs.
+     */
+    static jdoubleArray errorCurve(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray scoresV, jbooleanArray outcomesV, jint nPoints, jdoubleArray statsV);
+
+    /**
+     * Bins values into fixed bins, quantile bins, or linearly onto grid points.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the binning type.
+     * @param srcV
+     *      the values.
+     * @param min
+     *      the range minimum, which quantile bins ignore.
+     * @param max
+     *      the range maximum, which quantile bins ignore.
+     * @param edgesV
+     *      the bin edges, or the grid points for linear binning.
+     * @param dstV
+     *      the bin counts.
+     */
+    static void histogram(JNIEnv *env, jobject thisObj, jint type, //
+            jdoubleArray srcV, jdouble min, jdouble max, jdoubleArray edgesV, jdoubleArray dstV);
+
+    /**
+     * Downsamples a series with the Largest-Triangle-Three-Buckets algorithm.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param xV
+     *      the x-coordinates.
+     * @param yV
+     *      the y-coordinates.
+     * @param nPoints
+     *      the number of points to keep.
+     * @return the indices of the kept points.
+     */
+    static jintArray lttb(JNIEnv *env, jobject thisObj, //
+            jdoubleArray xV, jdoubleArray yV, jint nPoints);
+
+    /**
+     * Thins a point cloud by keeping the first point in each grid cell.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param xV
+     *      the x-coordinates.
+     * @param yV
+     *      the y-coordinates.
+     * @param boundsV
+     *      the x-range followed by the y-range.
+     * @param nX
+     *      the number of grid cells along the x-axis.
+     * @param nY
+     *      the number of grid cells along the y-axis.
+     * @return the indices of the kept points.
+     */
+    static jintArray thin(JNIEnv *env, jobject thisObj, //
+            jdoubleArray xV, jdoubleArray yV, jdoubleArray boundsV, jint nX, jint nY);
+
 private:
 
     inline static jint *findProxy(JNIEnv *, //
             jintArray, jintArray, jintArray, jintArray);
+
+    static ArrayPinHandler::jarray_type getRowLayout(JNIEnv *, //
+            jobject, jintArray, jintArray, //
+            jint *, jint *, jint *, jint *);
+
+    static void sortRowsProxy(JNIEnv *, ArrayPinHandler::jarray_type, //
+            jobject, jint, jint, jint, jint, jint *);
+
+    inline static jint intKey(jint);
+
+    inline static jlong doubleKey(jdouble);
+
+    template<class K> inline static void radixSort(K *, K *, jint *, jint *, jint, jint *);
+
+    static jint errorCurveProxy(jint, const jlong *, const jint *, jint, jint, //
+            jint, jint, jdouble *, jdouble *);
+
+    inline static void errorCurvePoint(jint, jint, jint, jint, jint, jdouble *);
+
+    inline static jint quantileBucket(jdouble, jdouble, jdouble);
+
+    template<bool R> inline static void searchSortedProxy(const jdouble *, jint, const jdouble *, jint *, jint);
+
+    static void monotoneSlopes(const jdouble *, const jdouble *, jdouble *, jint);
 };
 
 #endif
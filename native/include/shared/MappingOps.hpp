@@ -24,6 +24,8 @@
 #include <Common.hpp>
 #include <NativeArrayKernel.hpp>
 
+#include <JniHeadersWrap.hpp>
+
 #ifndef _Included_MappingOps
 #define _Included_MappingOps
 
@@ -155,6 +157,30 @@ public:
             const jint *dims, const jint *strides, //
             jint nDims, jint len);
 
+    /**
+     * Plans a traversal that visits every element once by dropping singleton dimensions, ordering the rest by
+     * decreasing source stride, and coalescing neighbors whose strides nest in both the source and the destination.
+     * 
+     * @param dims
+     *      the dimensions.
+     * @param srcStrides
+     *      the source strides.
+     * @param dstStrides
+     *      the destination strides.
+     * @param nDims
+     *      the number of dimensions.
+     * @param planD
+     *      the planned dimensions.
+     * @param planSrcS
+     *      the planned source strides.
+     * @param planDstS
+     *      the planned destination strides.
+     * @return the number of planned dimensions, which is at least one.
+     */
+    static jint planTraversal( //
+            const jint *dims, const jint *srcStrides, const jint *dstStrides, jint nDims, //
+            jint *planD, jint *planSrcS, jint *planDstS);
+
     /**
      * Assigns source values to destination values based on arrays of physical indices.
      * 
@@ -292,6 +318,145 @@ public:
             const jint *dstDArr, const jint *dstSArr, jint dstLen, //
             jint nDims);
 
+    //
+
+    /**
+     * Performs a concatenation operation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param opDim
+     *      the dimension to concatenate along.
+     * @param srcVs
+     *      the source values.
+     * @param srcDs
+     *      the source dimensions.
+     * @param srcSs
+     *      the source strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     */
+    static void concat(JNIEnv *env, jobject thisObj, //
+            jint opDim, //
+            jobjectArray srcVs, jobjectArray srcDs, jobjectArray srcSs, //
+            jobject dstV, jintArray dstD, jintArray dstS);
+
+    //
+
+    /**
+     * Performs a padding operation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param mode
+     *      the padding mode.
+     * @param offsets
+     *      the offsets of the source in the destination.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     */
+    static void pad(JNIEnv *env, jobject thisObj, //
+            jint mode, jintArray offsets, //
+            jobject srcV, jintArray srcD, jintArray srcS, //
+            jobject dstV, jintArray dstD, jintArray dstS);
+
+    /**
+     * Assigns, for every destination index along a dimension, the source index that it takes its value from, or
+     * {@code -1} if it keeps its constant value.
+     * 
+     * @param lookup
+     *      the lookup table.
+     * @param mode
+     *      the padding mode.
+     * @param offset
+     *      the offset of the source in the destination.
+     * @param srcSize
+     *      the source size.
+     * @param dstSize
+     *      the destination size.
+     */
+    static void assignPaddingLookup(jint *lookup, jint mode, jint offset, jint srcSize, jint dstSize);
+
+    //
+
+    /**
+     * Performs a gather operation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param opDim
+     *      the dimension of interest.
+     * @param indices
+     *      the source indices along the dimension of interest.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     */
+    static void gather(JNIEnv *env, jobject thisObj, //
+            jint opDim, jintArray indices, //
+            jobject srcV, jintArray srcD, jintArray srcS, //
+            jobject dstV, jintArray dstD, jintArray dstS);
+
+    /**
+     * Performs a scatter operation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the operation type.
+     * @param opDim
+     *      the dimension of interest.
+     * @param indices
+     *      the destination indices along the dimension of interest.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     */
+    static void scatter(JNIEnv *env, jobject thisObj, //
+            jint type, jint opDim, jintArray indices, //
+            jobject srcV, jintArray srcD, jintArray srcS, //
+            jobject dstV, jintArray dstD, jintArray dstS);
+
 private:
 
     static MappingResult *mapProxy(JNIEnv *, //
@@ -303,6 +468,31 @@ private:
             jintArray, //
             jarray, jintArray, jintArray, //
             jarray, jintArray, jintArray);
+
+    template<class T> inline static void copyPlanned(const T *, T *, //
+            const jint *, const jint *, const jint *, jint, jint, jint *);
+
+    template<class T> inline static void padPlanned(const T *, T *, //
+            const jint *, const jint *, const jint *, const jint *, const jint *, //
+            const jint *, jint, const jint *const *, jint *);
+
+    static void gatherScatterProxy(JNIEnv *, //
+            jint, jint, jintArray, //
+            jobject, jintArray, jintArray, //
+            jobject, jintArray, jintArray, //
+            jboolean);
+
+    template<class T> inline static void scAssign(const T *, jint, T *, jint, jint);
+
+    template<class T> inline static void scAdd(const T *, jint, T *, jint, jint);
+
+    template<class T> inline static void scMax(const T *, jint, T *, jint, jint);
+
+    template<class T> inline static void scMin(const T *, jint, T *, jint, jint);
+
+    template<class T> inline static void transferPlanned(void (*op)(const T *, jint, T *, jint, jint), //
+            const T *, T *, const jint *, jint, jint, jint, jboolean, //
+            const jint *, const jint *, const jint *, jint, jint, jint *);
 };
 
 #endif
@@ -78,6 +78,29 @@ public:
     template<class T> inline static void mul(const T *lArr, const T *rArr, jint inner, //
             T *outArr, jint lr, jint rc, T zero);
 
+    /**
+     * Multiplies two half-precision matrices, accumulating in single precision.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param format
+     *      the half-precision format.
+     * @param lhsV
+     *      the left hand side bit patterns.
+     * @param rhsV
+     *      the right hand side bit patterns.
+     * @param lhsR
+     *      the row count of the result.
+     * @param rhsC
+     *      the column count of the result.
+     * @param dstV
+     *      the destination values.
+     */
+    static void hMul(JNIEnv *env, jobject thisObj, jint format, jshortArray lhsV, jshortArray rhsV, //
+            jint lhsR, jint rhsC, jdoubleArray dstV);
+
     /**
      * Gets the diagonal of a matrix.
      * 
@@ -115,6 +138,9 @@ private:
             jarray, jarray, jint, jint, jarray, //
             T, jboolean);
 
+    template<jint M, jint B> inline static void hMulProxy(JNIEnv *, //
+            jshortArray, jshortArray, jint, jint, jdoubleArray);
+
     template<class T> inline static void diagProxy(JNIEnv *, //
             jarray, jarray, jint, jboolean);
 };
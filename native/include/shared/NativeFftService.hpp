@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Common.hpp>
+
+#include <JniHeadersWrap.hpp>
+
+#ifndef _Included_NativeFftService
+#define _Included_NativeFftService
+
+/**
+ * A mixed-radix, one-dimensional complex FFT plan that falls back to Bluestein's algorithm for lengths with large
+ * prime factors.
+ */
+class FftPlan {
+
+public:
+
+    /**
+     * Default constructor.
+     * 
+     * @param n
+     *      the transform length.
+     */
+    explicit FftPlan(jint n);
+
+    /**
+     * Default destructor.
+     */
+    ~FftPlan();
+
+    /**
+     * Performs an unnormalized transform in place.
+     * 
+     * @param data
+     *      the interleaved complex values.
+     * @param sign
+     *      the sign of the exponent: -1 for forward and +1 for backward.
+     * @param work
+     *      a scratch array of length getWorkLength().
+     */
+    void execute(jdouble *data, jint sign, jdouble *work);
+
+    /**
+     * Gets the number of doubles required of scratch arrays passed to execute.
+     */
+    jint getWorkLength();
+
+private:
+
+    FftPlan(const FftPlan &);
+
+    FftPlan &operator=(const FftPlan &);
+
+    /**
+     * Performs a Stockham autosort pass sequence.
+     */
+    void stockham(jdouble *x, jdouble *y, jint sign);
+
+    /**
+     * Performs Bluestein's chirp z-transform.
+     */
+    void bluestein(jdouble *data, jint sign, jdouble *work);
+
+    jint n;
+
+    jint nFactors;
+
+    jint factors[32];
+
+    // The table of forward twiddle factors exp(-2 pi i k / n).
+    jdouble *twiddles;
+
+    // The power of two length of the Bluestein convolution.
+    jint m;
+
+    FftPlan *convolutionPlan;
+
+    // The forward chirp exp(-pi i k^2 / n) followed by the forward and backward chirp filter spectra.
+    jdouble *chirps;
+};
+
+/**
+ * A one-dimensional real FFT plan that packs even lengths into complex transforms of half the length.
+ */
+class RealFftPlan {
+
+public:
+
+    /**
+     * Default constructor.
+     * 
+     * @param n
+     *      the logical transform length.
+     */
+    explicit RealFftPlan(jint n);
+
+    /**
+     * Default destructor.
+     */
+    ~RealFftPlan();
+
+    /**
+     * Performs a real-to-half-complex transform.
+     * 
+     * @param in
+     *      the n real values.
+     * @param out
+     *      the n / 2 + 1 interleaved complex values.
+     * @param work
+     *      a scratch array of length getWorkLength().
+     */
+    void forward(const jdouble *in, jdouble *out, jdouble *work);
+
+    /**
+     * Performs an unnormalized half-complex-to-real transform.
+     * 
+     * @param in
+     *      the n / 2 + 1 interleaved complex values.
+     * @param out
+     *      the n real values.
+     * @param work
+     *      a scratch array of length getWorkLength().
+     */
+    void backward(const jdouble *in, jdouble *out, jdouble *work);
+
+    /**
+     * Gets the number of doubles required of scratch arrays passed to forward and backward.
+     */
+    jint getWorkLength();
+
+private:
+
+    RealFftPlan(const RealFftPlan &);
+
+    RealFftPlan &operator=(const RealFftPlan &);
+
+    jint n;
+
+    FftPlan *plan;
+
+    // The twiddle factors exp(-2 pi i k / n) for unpacking even length transforms.
+    jdouble *twiddles;
+};
+
+/**
+ * A portable FFT service for when FFTW3 is unavailable.
+ */
+class NativeFftService {
+
+public:
+
+    /**
+     * Computes a reduced forward transform.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param dims
+     *      the dimensions of the transform.
+     * @param in
+     *      the input array.
+     * @param out
+     *      the output array.
+     */
+    static void rfft(JNIEnv *env, jobject thisObj, //
+            jintArray dims, jdoubleArray in, jdoubleArray out);
+
+    /**
+     * Computes a reduced backward transform.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param dims
+     *      the dimensions of the transform.
+     * @param in
+     *      the input array.
+     * @param out
+     *      the output array.
+     */
+    static void rifft(JNIEnv *env, jobject thisObj, //
+            jintArray dims, jdoubleArray in, jdoubleArray out);
+
+    /**
+     * Computes a forward transform.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param dims
+     *      the dimensions of the transform.
+     * @param in
+     *      the input array.
+     * @param out
+     *      the output array.
+     */
+    static void fft(JNIEnv *env, jobject thisObj, //
+            jintArray dims, jdoubleArray in, jdoubleArray out);
+
+    /**
+     * Computes a backward transform.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param dims
+     *      the dimensions of the transform.
+     * @param in
+     *      the input array.
+     * @param out
+     *      the output array.
+     */
+    static void ifft(JNIEnv *env, jobject thisObj, //
+            jintArray dims, jdoubleArray in, jdoubleArray out);
+
+    /**
+     * Transforms interleaved complex values along all but the last few dimensions.
+     * 
+     * @param values
+     *      the interleaved complex values.
+     * @param dims
+     *      the dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nTransformDims
+     *      the number of leading dimensions to transform along.
+     * @param sign
+     *      the sign of the exponent.
+     */
+    static void transformComplex(jdouble *values, const jint *dims, jint nDims, jint nTransformDims, jint sign);
+
+    /**
+     * Checks the dimensions of a transform.
+     * 
+     * @param dims
+     *      the dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     */
+    static void checkDimensions(const jint *dims, jint nDims);
+
+    /**
+     * Initializes the NativeFftService class.
+     * 
+     * @param env
+     *      the JNI environment.
+     */
+    static void init(JNIEnv *env);
+
+    /**
+     * Destroys the NativeFftService class.
+     * 
+     * @param env
+     *      the JNI environment.
+     */
+    static void destroy(JNIEnv *env);
+};
+
+#endif
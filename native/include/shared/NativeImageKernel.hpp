@@ -24,6 +24,8 @@
 #include <Common.hpp>
 #include <MappingOps.hpp>
 
+#include <JniHeadersWrap.hpp>
+
 #ifndef _Included_NativeImageKernel
 #define _Included_NativeImageKernel
 
@@ -84,6 +86,573 @@ public:
             jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray memV, //
             jdoubleArray dstV, jintArray dstD, jintArray dstS);
 
+    /**
+     * Creates integral images of multiple moments in a single pass.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param types
+     *      the moment types.
+     * @param xV
+     *      the primary values.
+     * @param yV
+     *      the secondary values, or null if no moment requires them.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     */
+    static void createIntegralMoments(JNIEnv *env, jobject thisObj, //
+            jintArray types, jdoubleArray xV, jdoubleArray yV, jintArray srcD, jintArray srcS, //
+            jdoubleArray dstV, jintArray dstD, jintArray dstS);
+
+    /**
+     * Computes local means and variances over box windows.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param radii
+     *      the window radii.
+     * @param meanV
+     *      the local means.
+     * @param varV
+     *      the local variances.
+     */
+    static void localMeanVariance(JNIEnv *env, jobject thisObj, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+            jdoubleArray meanV, jdoubleArray varV);
+
+    /**
+     * Applies the guided filter.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param guideV
+     *      the guide values.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param radii
+     *      the window radii.
+     * @param epsilon
+     *      the regularization parameter.
+     * @param dstV
+     *      the destination values.
+     */
+    static void guidedFilter(JNIEnv *env, jobject thisObj, //
+            jdoubleArray guideV, jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, jdouble epsilon, //
+            jdoubleArray dstV);
+
+    /**
+     * Computes the normalized cross-correlation of a template against every position where it fits entirely inside the
+     * source.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param tplV
+     *      the template values.
+     * @param tplD
+     *      the template dimensions.
+     * @param tplS
+     *      the template strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstD
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     */
+    static void normalizedCrossCorrelation(JNIEnv *env, jobject thisObj, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+            jdoubleArray tplV, jintArray tplD, jintArray tplS, //
+            jdoubleArray dstV, jintArray dstD, jintArray dstS);
+
+    /**
+     * Supports normalizedCrossCorrelation once the correlation strategy is known.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param srcV
+     *      the source values.
+     * @param srcDArr
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param tplV
+     *      the template values.
+     * @param tplDArr
+     *      the template dimensions.
+     * @param tplS
+     *      the template strides.
+     * @param dstV
+     *      the destination values.
+     * @param dstDArr
+     *      the destination dimensions.
+     * @param dstS
+     *      the destination strides.
+     * @param nDims
+     *      the number of dimensions.
+     * @param forwardPlan
+     *      the real-to-complex plan over the source dimensions, or NULL for direct correlation.
+     * @param backwardPlan
+     *      the complex-to-real plan over the source dimensions, or NULL for direct correlation.
+     */
+    static void matchTemplate(JNIEnv *env, //
+            jdoubleArray srcV, jint *srcDArr, jintArray srcS, //
+            jdoubleArray tplV, jint *tplDArr, jintArray tplS, //
+            jdoubleArray dstV, jint *dstDArr, jintArray dstS, //
+            jint nDims, void *forwardPlan, void *backwardPlan);
+
+    /**
+     * Finds local peaks, which are values at least the threshold and no less than every other value in their box
+     * windows. Peaks are then visited in order of decreasing value, and any peak closer than the minimum distance, in
+     * the maximum norm, to an earlier accepted peak is suppressed.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param radii
+     *      the window radii.
+     * @param threshold
+     *      the threshold.
+     * @param minDistance
+     *      the minimum distance between peaks.
+     * @return the row-major logical indices of the peaks, in order of decreasing value.
+     */
+    static jintArray findPeaks(JNIEnv *env, jobject thisObj, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+            jdouble threshold, jint minDistance);
+
+    /**
+     * Supports findPeaks by computing the peaks before a Java array is allocated to hold them.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param radii
+     *      the window radii.
+     * @param threshold
+     *      the threshold.
+     * @param minDistance
+     *      the minimum distance between peaks.
+     * @return a heap array holding the number of peaks followed by their indices.
+     */
+    static jint *findPeaksProxy(JNIEnv *env, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+            jdouble threshold, jint minDistance);
+
+    /**
+     * Computes box maxima of values stored in row-major order in place. Windows are clipped at the borders.
+     * 
+     * @param values
+     *      the values.
+     * @param dims
+     *      the dimensions.
+     * @param radii
+     *      the window radii.
+     * @param nDims
+     *      the number of dimensions.
+     */
+    static void boxMaxima(jdouble *values, jint *dims, jint *radii, jint nDims);
+
+    /**
+     * Interpolates values at arbitrary coordinates. The source is treated as extended indefinitely by the boundary
+     * mode.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param interpolation
+     *      the interpolation type.
+     * @param boundary
+     *      the boundary mode.
+     * @param cval
+     *      the constant for constant boundaries, which applies only to real parts of complex values.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param coordsV
+     *      the coordinates, stored contiguously one point at a time.
+     * @param dstV
+     *      the destination values, stored contiguously one point at a time.
+     * @param complex
+     *      whether the values are complex, in which case the last source dimension holds real and imaginary parts and
+     *      isn't interpolated over.
+     */
+    static void mapCoordinates(JNIEnv *env, jobject thisObj, //
+            jint interpolation, jint boundary, jdouble cval, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+            jdoubleArray coordsV, jdoubleArray dstV, jboolean complex);
+
+    /**
+     * Computes cubic B-spline coefficients for later interpolation.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param boundary
+     *      the boundary mode.
+     * @param cval
+     *      the constant for constant boundaries, which applies only to real parts of complex values.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param dstV
+     *      the destination values, which share the source dimensions and strides.
+     * @param complex
+     *      whether the values are complex.
+     */
+    static void splineCoefficients(JNIEnv *env, jobject thisObj, //
+            jint boundary, jdouble cval, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+            jdoubleArray dstV, jboolean complex);
+
+    /**
+     * Applies an approximate bilateral filter. Single-channel values go through a bilateral grid, and multi-channel values
+     * go through a permutohedral lattice.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param sigmas
+     *      the spatial standard deviations followed by the range standard deviation. If there is one fewer spatial
+     *      standard deviation than dimensions, the last dimension holds channels.
+     * @param dstV
+     *      the destination values, which share the source dimensions and strides.
+     */
+    static void bilateralFilter(JNIEnv *env, jobject thisObj, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray sigmas, //
+            jdoubleArray dstV);
+
+    /**
+     * Applies a multilevel, separable discrete wavelet transform or its inverse in place.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param wavelet
+     *      the wavelet.
+     * @param nLevels
+     *      the number of levels.
+     * @param srcV
+     *      the source values.
+     * @param srcD
+     *      the source dimensions.
+     * @param srcS
+     *      the source strides.
+     * @param inverse
+     *      whether to apply the inverse transform.
+     */
+    static void waveletTransform(JNIEnv *env, jobject thisObj, //
+            jint wavelet, jint nLevels, //
+            jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+            jboolean inverse);
+
+    /**
+     * Checks that the interpolation type and boundary mode are recognized.
+     * 
+     * @param interpolation
+     *      the interpolation type.
+     * @param boundary
+     *      the boundary mode.
+     */
+    static void checkInterpolation(jint interpolation, jint boundary);
+
+    /**
+     * Maps an index into the extent of a dimension according to a boundary mode.
+     * 
+     * @param index
+     *      the index.
+     * @param size
+     *      the dimension size, which must be positive.
+     * @param boundary
+     *      the boundary mode.
+     * @return the mapped index, or -1 if the index falls on the constant extension.
+     */
+    static jint boundaryIndex(jint index, jint size, jint boundary);
+
+    /**
+     * Converts interleaved channels stored in row-major order into cubic B-spline coefficients in place.
+     * 
+     * @param values
+     *      the values.
+     * @param dims
+     *      the dimensions, not counting the channels.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nChannels
+     *      the number of interleaved channels.
+     * @param boundary
+     *      the boundary mode.
+     * @param cval
+     *      the constant for constant boundaries, which applies only to the first channel.
+     */
+    static void prefilter(jdouble *values, jint *dims, jint nDims, jint nChannels, //
+            jint boundary, jdouble cval);
+
+    /**
+     * Interpolates channels at coordinates by nearest neighbor, multilinear weighting, or cubic B-spline coefficients.
+     * 
+     * @param values
+     *      the values.
+     * @param dims
+     *      the dimensions, not counting the channels.
+     * @param strides
+     *      the strides.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nChannels
+     *      the number of channels.
+     * @param channelStride
+     *      the channel stride.
+     * @param coords
+     *      the coordinates.
+     * @param dst
+     *      the destination values.
+     * @param nPoints
+     *      the number of points.
+     * @param interpolation
+     *      the interpolation type, which can't require coefficients to be computed.
+     * @param boundary
+     *      the boundary mode.
+     * @param cval
+     *      the constant for constant boundaries, which applies only to the first channel.
+     */
+    static void interpolate(const jdouble *values, jint *dims, jint *strides, //
+            jint nDims, jint nChannels, jint channelStride, //
+            const jdouble *coords, jdouble *dst, jint nPoints, //
+            jint interpolation, jint boundary, jdouble cval);
+
+    /**
+     * Filters values stored in row-major order with a bilateral grid. Non-finite values pass through and don't
+     * contribute.
+     * 
+     * @param values
+     *      the values.
+     * @param dst
+     *      the destination values.
+     * @param dims
+     *      the dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param spatialSigmas
+     *      the spatial standard deviations.
+     * @param rangeSigma
+     *      the range standard deviation.
+     */
+    static void bilateralGrid(const jdouble *values, jdouble *dst, //
+            jint *dims, jint nDims, jdouble *spatialSigmas, jdouble rangeSigma);
+
+    /**
+     * Blurs interleaved grids stored in row-major order in place with the kernel [1 2 1] / 4 along each dimension.
+     * 
+     * @param values
+     *      the values.
+     * @param dims
+     *      the dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nValues
+     *      the number of interleaved grids.
+     */
+    static void blurGrid(jdouble *values, jint *dims, jint nDims, jint nValues);
+
+    /**
+     * Filters interleaved channels stored in row-major order with a permutohedral lattice. Pixels with non-finite
+     * channels pass through and don't contribute.
+     * 
+     * @param values
+     *      the values.
+     * @param dst
+     *      the destination values.
+     * @param dims
+     *      the dimensions, not counting the channels.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nChannels
+     *      the number of interleaved channels.
+     * @param spatialSigmas
+     *      the spatial standard deviations.
+     * @param rangeSigma
+     *      the range standard deviation.
+     */
+    static void bilateralLattice(const jdouble *values, jdouble *dst, //
+            jint *dims, jint nDims, jint nChannels, jdouble *spatialSigmas, jdouble rangeSigma);
+
+    /**
+     * Applies one level of a lifting scheme, or its inverse, along the rows of a block stored in row-major order in
+     * place. The forward transform leaves the approximation rows ahead of the detail rows.
+     * 
+     * @param values
+     *      the values.
+     * @param work
+     *      the working storage, which must be as large as the block.
+     * @param size
+     *      the number of rows.
+     * @param rowSize
+     *      the row size.
+     * @param scheme
+     *      the lifting scheme.
+     * @param inverse
+     *      whether to apply the inverse transform.
+     */
+    static void liftLines(jdouble *values, jdouble *work, jint size, jint rowSize, //
+            const jdouble *scheme, jboolean inverse);
+
+    /**
+     * Copies between values stored in row-major order and the leading corner region of them.
+     * 
+     * @param values
+     *      the values.
+     * @param region
+     *      the region values.
+     * @param dims
+     *      the dimensions.
+     * @param regionDims
+     *      the region dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param extract
+     *      whether to copy from the values to the region, as opposed to the reverse.
+     */
+    static void copyRegion(jdouble *values, jdouble *region, //
+            jint *dims, jint *regionDims, jint nDims, bool extract);
+
+    /**
+     * Integrates interleaved tables stored in row-major order in place.
+     * 
+     * @param values
+     *      the values.
+     * @param dims
+     *      the dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nTables
+     *      the number of interleaved tables.
+     */
+    static void integrate(jdouble *values, jint *dims, jint nDims, jint nTables);
+
+    /**
+     * Derives window sums from interleaved integral tables stored in row-major order. The window for output position
+     * j along dimension k is [j + lower[k], j + upper[k]), clipped to the source extent.
+     * 
+     * @param srcV
+     *      the integral tables, each of whose dimensions is one more than the extent it covers.
+     * @param srcD
+     *      the integral table dimensions.
+     * @param dstV
+     *      the window sums.
+     * @param dstD
+     *      the window sum dimensions.
+     * @param lower
+     *      the window lower offsets.
+     * @param upper
+     *      the window upper offsets.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nTables
+     *      the number of interleaved tables.
+     * @param normalize
+     *      whether to divide sums by window sizes.
+     */
+    static void windowSums(const jdouble *srcV, jint *srcD, //
+            jdouble *dstV, jint *dstD, //
+            jint *lower, jint *upper, jint nDims, jint nTables, bool normalize);
+
+    /**
+     * Creates integral tables from interleaved tables stored in row-major order. Each destination dimension is one
+     * more than its source counterpart, with a leading hyperplane of zeros.
+     * 
+     * @param srcV
+     *      the source values.
+     * @param dstV
+     *      the integral tables.
+     * @param dims
+     *      the source dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nTables
+     *      the number of interleaved tables.
+     */
+    static void createIntegralTables(const jdouble *srcV, jdouble *dstV, //
+            jint *dims, jint nDims, jint nTables);
+
+    /**
+     * Computes box means of interleaved tables stored in row-major order. Windows are clipped at the borders.
+     * 
+     * @param srcV
+     *      the source values.
+     * @param dstV
+     *      the destination values.
+     * @param dims
+     *      the dimensions.
+     * @param radii
+     *      the window radii.
+     * @param nDims
+     *      the number of dimensions.
+     * @param nTables
+     *      the number of interleaved tables.
+     */
+    static void boxMeans(const jdouble *srcV, jdouble *dstV, //
+            jint *dims, jint *radii, jint nDims, jint nTables);
+
     /**
      * Initializes the kernel.
      * 
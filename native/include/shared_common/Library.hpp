@@ -23,6 +23,7 @@
 
 #include <NativeArrayKernel.hpp>
 #include <NativeImageKernel.hpp>
+#include <NativeFftService.hpp>
 
 #ifndef _Included_Library
 #define _Included_Library
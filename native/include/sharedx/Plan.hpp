@@ -30,6 +30,47 @@
 #ifndef _Included_Plan
 #define _Included_Plan
 
+/**
+ * The native peer of a guru plan, which is followed in memory by the transform and loop dimensions.
+ */
+struct GuruPlanData {
+
+    /**
+     * The native plan.
+     */
+    fftw_plan plan;
+
+    /**
+     * The transform type.
+     */
+    jint type;
+
+    /**
+     * The number of transform dimensions.
+     */
+    jint rank;
+
+    /**
+     * The number of loop dimensions.
+     */
+    jint howmanyRank;
+
+    /**
+     * The number of input array elements spanned.
+     */
+    jint inExtent;
+
+    /**
+     * The number of output array elements spanned.
+     */
+    jint outExtent;
+
+    /**
+     * The scaling factor.
+     */
+    jdouble scalingFactor;
+};
+
 /**
  * A class for executing and manipulating <a href="http://www.fftw.org/">FFTW3</a> plans.
  */
@@ -51,6 +92,49 @@ public:
      */
     static void transform(JNIEnv *env, jobject thisObj, jdoubleArray in, jdoubleArray out);
 
+    /**
+     * Computes a short-time Fourier transform with this real-to-complex plan, whose length is the frame length. Frames
+     * start every hop samples and lie entirely inside the signal.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param signal
+     *      the signal.
+     * @param window
+     *      the window.
+     * @param hop
+     *      the hop size.
+     * @param outputType
+     *      the output type.
+     * @param out
+     *      the output array, which holds one spectrum after another.
+     */
+    static void stft(JNIEnv *env, jobject thisObj, //
+            jdoubleArray signal, jdoubleArray window, jint hop, jint outputType, //
+            jdoubleArray out);
+
+    /**
+     * Computes an inverse short-time Fourier transform with this complex-to-real plan by weighted overlap-add.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param in
+     *      the input array, which holds one complex spectrum after another.
+     * @param window
+     *      the window.
+     * @param hop
+     *      the hop size.
+     * @param out
+     *      the output signal.
+     */
+    static void istft(JNIEnv *env, jobject thisObj, //
+            jdoubleArray in, jdoubleArray window, jint hop, //
+            jdoubleArray out);
+
     /**
      * Creates a pointer to the native peer.
      * 
@@ -78,6 +162,65 @@ public:
      */
     static void destroy(JNIEnv *env, jobject thisObj);
 
+    /**
+     * Performs an out-of-place transform with a guru plan.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param in
+     *      the input array.
+     * @param inOffset
+     *      the offset into the input array.
+     * @param out
+     *      the output array.
+     * @param outOffset
+     *      the offset into the output array.
+     */
+    static void transformGuru(JNIEnv *env, jobject thisObj, //
+            jdoubleArray in, jint inOffset, jdoubleArray out, jint outOffset);
+
+    /**
+     * Creates a pointer to the native peer of a guru plan.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     * @param type
+     *      the transform type.
+     * @param dims
+     *      the logical transform dimensions.
+     * @param inStrides
+     *      the input strides of the transform dimensions.
+     * @param outStrides
+     *      the output strides of the transform dimensions.
+     * @param loopDims
+     *      the loop dimensions.
+     * @param loopInStrides
+     *      the input strides of the loop dimensions.
+     * @param loopOutStrides
+     *      the output strides of the loop dimensions.
+     * @param logicalMode
+     *      the transform mode.
+     * @return a pointer to the native peer.
+     */
+    static jbyteArray createGuru(JNIEnv *env, jobject thisObj, jint type, //
+            jintArray dims, jintArray inStrides, jintArray outStrides, //
+            jintArray loopDims, jintArray loopInStrides, jintArray loopOutStrides, //
+            jint logicalMode);
+
+    /**
+     * Destroys the native peer of a guru plan.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param thisObj
+     *      this object.
+     */
+    static void destroyGuru(JNIEnv *env, jobject thisObj);
+
     /**
      * Exports learned wisdom to a string.
      * 
@@ -117,6 +260,25 @@ public:
             jint &inLen, jint &outLen, //
             jdouble &scalingFactor, jint type, const jint *dimsArr, jint nDims);
 
+    /**
+     * Converts a Java logical mode into a FFTW planner flag.
+     * 
+     * @param logicalMode
+     *      the transform mode.
+     * @return the FFTW planner flag.
+     */
+    inline static jint getFftwMode(jint logicalMode);
+
+    /**
+     * Destroys the native plan referenced by the given memory.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param mem
+     *      the memory holding a native plan, which is set to NULL afterwards.
+     */
+    static void destroyPlan(JNIEnv *env, jbyteArray mem);
+
     /**
      * Creates a native plan.
      * 
@@ -194,4 +356,44 @@ public:
     static void destroy(JNIEnv *env);
 };
 
+/**
+ * A subclass of CleanupHandler for creating and destroying plans on behalf of native code. Since plan creation and
+ * destruction synchronize on the Java plan class, instances must be constructed before and destroyed after any arrays
+ * are pinned.
+ */
+class PlanHandler: public CleanupHandler<void *> {
+
+public:
+
+    /**
+     * Creates a plan while holding the plan class monitor.
+     * 
+     * @param env
+     *      the JNI environment.
+     * @param type
+     *      the transform type.
+     * @param dims
+     *      the dimensions.
+     * @param nDims
+     *      the number of dimensions.
+     * @param logicalMode
+     *      the transform mode.
+     */
+    explicit PlanHandler(JNIEnv *env, jint type, const jint *dims, jint nDims, jint logicalMode);
+
+    virtual void *get();
+
+    virtual ~PlanHandler();
+
+private:
+
+    PlanHandler(const PlanHandler &);
+
+    PlanHandler &operator=(const PlanHandler &);
+
+    JNIEnv *env;
+
+    fftw_plan plan;
+};
+
 #endif
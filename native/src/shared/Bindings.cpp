@@ -51,6 +51,46 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_slice(JNIEnv
             dstV, dstD, dstS);
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_concat(JNIEnv *env, jobject thisObj, //
+        jint opDim, //
+        jobjectArray srcVs, jobjectArray srcDs, jobjectArray srcSs, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+    MappingOps::concat(env, thisObj, //
+            opDim, //
+            srcVs, srcDs, srcSs, //
+            dstV, dstD, dstS);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_pad(JNIEnv *env, jobject thisObj, //
+        jint mode, jintArray offsets, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+    MappingOps::pad(env, thisObj, //
+            mode, offsets, //
+            srcV, srcD, srcS, //
+            dstV, dstD, dstS);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_gather(JNIEnv *env, jobject thisObj, //
+        jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+    MappingOps::gather(env, thisObj, //
+            opDim, indices, //
+            srcV, srcD, srcS, //
+            dstV, dstD, dstS);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_scatter(JNIEnv *env, jobject thisObj, //
+        jint type, jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+    MappingOps::scatter(env, thisObj, //
+            type, opDim, indices, //
+            srcV, srcD, srcS, //
+            dstV, dstD, dstS);
+}
+
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rrOp(JNIEnv *env, jobject thisObj, jint type, //
         jdoubleArray srcV, jintArray srcD, jintArray srcS, //
         jdoubleArray dstV, jintArray dstD, jintArray dstS, //
@@ -79,6 +119,24 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rdOp(JNIEnv *
             opDims);
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rwOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray dstV, //
+        jint dim, jint size) {
+    DimensionOps::rwOp(env, thisObj, type, //
+            srcV, srcD, srcS, dstV, //
+            dim, size);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rgOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray labels, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS, //
+        jint dim) {
+    DimensionOps::rgOp(env, thisObj, type, //
+            srcV, srcD, srcS, labels, //
+            dstV, dstD, dstS, //
+            dim);
+}
+
 JNIEXPORT jdouble JNICALL Java_org_shared_array_jni_NativeArrayKernel_raOp(JNIEnv *env, jobject thisObj, jint type, //
         jdoubleArray srcV) {
     return ElementOps::raOp(env, thisObj, type, srcV);
@@ -91,17 +149,32 @@ JNIEXPORT jdoubleArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_caOp(
 
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_ruOp(JNIEnv *env, jobject thisObj, jint type, //
         jdouble a, jdoubleArray srcV) {
-    ElementOps::ruOp(env, thisObj, type, a, srcV);
+    ElementOps::ruOp(env, thisObj, type, a, srcV, srcV);
 }
 
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_cuOp(JNIEnv *env, jobject thisObj, jint type, //
         jdouble aRe, jdouble aIm, jdoubleArray srcV) {
-    ElementOps::cuOp(env, thisObj, type, aRe, aIm, srcV);
+    ElementOps::cuOp(env, thisObj, type, aRe, aIm, srcV, srcV);
 }
 
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_iuOp(JNIEnv *env, jobject thisObj, jint type, //
         jint a, jintArray srcV) {
-    ElementOps::iuOp(env, thisObj, type, a, srcV);
+    ElementOps::iuOp(env, thisObj, type, a, srcV, srcV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_ruOpTo(JNIEnv *env, jobject thisObj, jint type, //
+        jdouble a, jdoubleArray srcV, jdoubleArray dstV) {
+    ElementOps::ruOp(env, thisObj, type, a, srcV, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_cuOpTo(JNIEnv *env, jobject thisObj, jint type, //
+        jdouble aRe, jdouble aIm, jdoubleArray srcV, jdoubleArray dstV) {
+    ElementOps::cuOp(env, thisObj, type, aRe, aIm, srcV, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_iuOpTo(JNIEnv *env, jobject thisObj, jint type, //
+        jint a, jintArray srcV, jintArray dstV) {
+    ElementOps::iuOp(env, thisObj, type, a, srcV, dstV);
 }
 
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_eOp(JNIEnv *env, jobject thisObj, jint type, //
@@ -114,6 +187,51 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_convert(JNIEn
     ElementOps::convert(env, thisObj, type, srcV, isSrcComplex, dstV, isDstComplex);
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rcOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray lhsV, jdoubleArray rhsV, jdouble a, jlongArray dstV) {
+    ElementOps::rcOp(env, thisObj, type, lhsV, rhsV, a, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_mlOp(JNIEnv *env, jobject thisObj, jint type, //
+        jlongArray lhsV, jlongArray rhsV, jlongArray dstV, jint len) {
+    ElementOps::mlOp(env, thisObj, type, lhsV, rhsV, dstV, len);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_select(JNIEnv *env, jobject thisObj, //
+        jlongArray maskV, jobject lhsV, jobject rhsV, jobject dstV) {
+    ElementOps::select(env, thisObj, maskV, lhsV, rhsV, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_maskedFill(JNIEnv *env, jobject thisObj, //
+        jlongArray maskV, jdouble a, jdoubleArray dstV) {
+    ElementOps::maskedFill(env, thisObj, maskV, a, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_halfConvert(JNIEnv *env, jobject thisObj, //
+        jint format, jdoubleArray srcV, jshortArray dstV) {
+    ElementOps::halfConvert(env, thisObj, format, srcV, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_halfExpand(JNIEnv *env, jobject thisObj, //
+        jint format, jshortArray srcV, jdoubleArray dstV) {
+    ElementOps::halfExpand(env, thisObj, format, srcV, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_heOp(JNIEnv *env, jobject thisObj, //
+        jint type, jint format, jshortArray lhsV, jshortArray rhsV, jshortArray dstV) {
+    ElementOps::heOp(env, thisObj, type, format, lhsV, rhsV, dstV);
+}
+
+JNIEXPORT jdouble JNICALL Java_org_shared_array_jni_NativeArrayKernel_haOp(JNIEnv *env, jobject thisObj, //
+        jint type, jint format, jshortArray srcV) {
+    return ElementOps::haOp(env, thisObj, type, format, srcV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_hMul(JNIEnv *env, jobject thisObj, //
+        jint format, jshortArray lhsV, jshortArray rhsV, jint lhsR, jint rhsC, jdoubleArray dstV) {
+    MatrixOps::hMul(env, thisObj, format, lhsV, rhsV, lhsR, rhsC, dstV);
+}
+
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_mul(JNIEnv *env, jobject thisObj, //
         jdoubleArray lhsV, jdoubleArray rhsV, jint lhsR, jint rhsC, jdoubleArray dstV, jboolean complex) {
     MatrixOps::mul(env, thisObj, lhsV, rhsV, lhsR, rhsC, dstV, complex);
@@ -157,11 +275,131 @@ JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_createIntegra
             dstV, dstD, dstS);
 }
 
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_createIntegralMoments(JNIEnv *env, jobject thisObj, //
+        jintArray types, jdoubleArray xV, jdoubleArray yV, jintArray srcD, jintArray srcS, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS) {
+    NativeImageKernel::createIntegralMoments(env, thisObj, //
+            types, xV, yV, srcD, srcS, //
+            dstV, dstD, dstS);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_localMeanVariance(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdoubleArray meanV, jdoubleArray varV) {
+    NativeImageKernel::localMeanVariance(env, thisObj, //
+            srcV, srcD, srcS, radii, //
+            meanV, varV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_guidedFilter(JNIEnv *env, jobject thisObj, //
+        jdoubleArray guideV, jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, jdouble epsilon, //
+        jdoubleArray dstV) {
+    NativeImageKernel::guidedFilter(env, thisObj, //
+            guideV, srcV, srcD, srcS, radii, epsilon, //
+            dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_normalizedCrossCorrelation(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray tplV, jintArray tplD, jintArray tplS, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS) {
+    NativeImageKernel::normalizedCrossCorrelation(env, thisObj, //
+            srcV, srcD, srcS, //
+            tplV, tplD, tplS, //
+            dstV, dstD, dstS);
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_image_jni_NativeImageKernel_findPeaks(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdouble threshold, jint minDistance) {
+    return NativeImageKernel::findPeaks(env, thisObj, //
+            srcV, srcD, srcS, radii, //
+            threshold, minDistance);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_mapCoordinates(JNIEnv *env, jobject thisObj, //
+        jint interpolation, jint boundary, jdouble cval, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray coordsV, jdoubleArray dstV, jboolean complex) {
+    NativeImageKernel::mapCoordinates(env, thisObj, //
+            interpolation, boundary, cval, //
+            srcV, srcD, srcS, //
+            coordsV, dstV, complex);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_splineCoefficients(JNIEnv *env, jobject thisObj, //
+        jint boundary, jdouble cval, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray dstV, jboolean complex) {
+    NativeImageKernel::splineCoefficients(env, thisObj, //
+            boundary, cval, //
+            srcV, srcD, srcS, //
+            dstV, complex);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_bilateralFilter(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray sigmas, //
+        jdoubleArray dstV) {
+    NativeImageKernel::bilateralFilter(env, thisObj, //
+            srcV, srcD, srcS, sigmas, //
+            dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_waveletTransform(JNIEnv *env, jobject thisObj, //
+        jint wavelet, jint nLevels, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jboolean inverse) {
+    NativeImageKernel::waveletTransform(env, thisObj, //
+            wavelet, nLevels, //
+            srcV, srcD, srcS, //
+            inverse);
+}
+
 JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_find(JNIEnv *env, jobject thisObj, //
         jintArray srcV, jintArray srcD, jintArray srcS, jintArray logical) {
     return IndexOps::find(env, thisObj, srcV, srcD, srcS, logical);
 }
 
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_sortRows(JNIEnv *env, jobject thisObj, //
+        jobject srcV, jintArray srcD, jintArray srcS) {
+    return IndexOps::sortRows(env, thisObj, srcV, srcD, srcS);
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_unique(JNIEnv *env, jobject thisObj, //
+        jobject srcV, jintArray srcD, jintArray srcS, jintArray inverse, jintArray counts) {
+    return IndexOps::unique(env, thisObj, srcV, srcD, srcS, inverse, counts);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_searchSorted(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray edges, jdoubleArray srcV, jintArray dstV) {
+    IndexOps::searchSorted(env, thisObj, type, edges, srcV, dstV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_interpolate(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray xV, jdoubleArray yV, jdoubleArray srcV, jdoubleArray dstV) {
+    IndexOps::interpolate(env, thisObj, type, xV, yV, srcV, dstV);
+}
+
+JNIEXPORT jdoubleArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_errorCurve(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray scoresV, jbooleanArray outcomesV, jint nPoints, jdoubleArray statsV) {
+    return IndexOps::errorCurve(env, thisObj, type, scoresV, outcomesV, nPoints, statsV);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_histogram(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray srcV, jdouble min, jdouble max, jdoubleArray edgesV, jdoubleArray dstV) {
+    IndexOps::histogram(env, thisObj, type, srcV, min, max, edgesV, dstV);
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_lttb(JNIEnv *env, jobject thisObj, //
+        jdoubleArray xV, jdoubleArray yV, jint nPoints) {
+    return IndexOps::lttb(env, thisObj, xV, yV, nPoints);
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_thin(JNIEnv *env, jobject thisObj, //
+        jdoubleArray xV, jdoubleArray yV, jdoubleArray boundsV, jint nX, jint nY) {
+    return IndexOps::thin(env, thisObj, xV, yV, boundsV, nX, nY);
+}
+
 JNIEXPORT jobject JNICALL Java_org_shared_array_jni_NativeArrayKernel_insertSparse(JNIEnv *env, jobject thisObj, //
         jobject oldV, jintArray oldD, jintArray oldS, jintArray oldDo, jintArray oldI, //
         jobject newV, jintArray newLi) {
@@ -180,3 +418,23 @@ JNIEXPORT jobject JNICALL Java_org_shared_array_jni_NativeArrayKernel_sliceSpars
             dstV, dstD, dstS, dstDo, //
             dstI, dstIo, dstIi);
 }
+
+JNIEXPORT void JNICALL Java_org_shared_fft_jni_NativeFftService_rfft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+    NativeFftService::rfft(env, thisObj, dims, in, out);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_fft_jni_NativeFftService_rifft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+    NativeFftService::rifft(env, thisObj, dims, in, out);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_fft_jni_NativeFftService_fft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+    NativeFftService::fft(env, thisObj, dims, in, out);
+}
+
+JNIEXPORT void JNICALL Java_org_shared_fft_jni_NativeFftService_ifft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+    NativeFftService::ifft(env, thisObj, dims, in, out);
+}
@@ -26,6 +26,9 @@
 template<class T> CleanupHandler<T>::~CleanupHandler() {
 }
 
+// Make the destructor available to handlers defined in other translation units.
+template class CleanupHandler<void *>;
+
 MallocHandler::MallocHandler(jint nBytes) {
 
     this->ptr = malloc(nBytes);
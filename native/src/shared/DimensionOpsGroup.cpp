@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <DimensionOps.hpp>
+
+void DimensionOps::rgOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray labels, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS, //
+        jint dim) {
+
+    try {
+
+        rgOp_t *op = NULL;
+        jdouble identity = 0.0;
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_RG_SUM:
+        case org_shared_array_kernel_ArrayKernel_RG_MEAN:
+            op = DimensionOps::rgSum;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RG_VAR:
+            op = DimensionOps::rgVar;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RG_MAX:
+            op = DimensionOps::rgMax;
+            identity = -HUGE_VAL;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RG_MIN:
+            op = DimensionOps::rgMin;
+            identity = HUGE_VAL;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RG_COUNT:
+            break;
+
+        default:
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        if (!srcV || !srcD || !srcS || !labels || !dstV || !dstD || !dstS) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint dstLen = env->GetArrayLength(dstV);
+        jint nDims = env->GetArrayLength(srcD);
+        jint nLabels = env->GetArrayLength(labels);
+
+        if ((nDims != env->GetArrayLength(srcS))
+                || (nDims != env->GetArrayLength(dstD))
+                || (nDims != env->GetArrayLength(dstS))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (!(dim >= 0 && dim < nDims)) {
+            throw std::runtime_error("Invalid dimension");
+        }
+
+        MallocHandler mallocH(sizeof(jint) * (9 * nDims + nLabels));
+        void *all = mallocH.get();
+
+        jint *srcDArr = (jint *) all;
+        jint *srcSArr = (jint *) all + nDims;
+        jint *dstDArr = (jint *) all + 2 * nDims;
+        jint *dstSArr = (jint *) all + 3 * nDims;
+        jint *slabD = (jint *) all + 4 * nDims;
+        jint *planD = (jint *) all + 5 * nDims;
+        jint *planSrcS = (jint *) all + 6 * nDims;
+        jint *planDstS = (jint *) all + 7 * nDims;
+        jint *counters = (jint *) all + 8 * nDims;
+        jint *labelsArr = (jint *) all + 9 * nDims;
+
+        {
+            ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstSh(env, dstS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler labelsH(env, labels, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+            memcpy(srcDArr, srcDh.get(), sizeof(jint) * nDims);
+            memcpy(srcSArr, srcSh.get(), sizeof(jint) * nDims);
+            memcpy(dstDArr, dstDh.get(), sizeof(jint) * nDims);
+            memcpy(dstSArr, dstSh.get(), sizeof(jint) * nDims);
+            memcpy(labelsArr, labelsH.get(), sizeof(jint) * nLabels);
+        }
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+        MappingOps::checkDimensions(dstDArr, dstSArr, nDims, dstLen);
+
+        for (jint i = 0; i < nDims; i++) {
+
+            if (i != dim && srcDArr[i] != dstDArr[i]) {
+                throw std::runtime_error("Dimension mismatch");
+            }
+        }
+
+        jint nGroups = dstDArr[dim];
+
+        if (nLabels != srcDArr[dim]) {
+            throw std::runtime_error("Dimension mismatch");
+        }
+
+        // Negative labels mark values that belong to no group.
+        for (jint i = 0; i < nLabels; i++) {
+
+            if (labelsArr[i] >= nGroups) {
+                throw std::runtime_error("Invalid label");
+            }
+        }
+
+        memcpy(slabD, srcDArr, sizeof(jint) * nDims);
+        slabD[dim] = 1;
+
+        jint slabLen = Common::product(slabD, nDims, (jint) 1);
+
+        // Proceed only if nonzero length.
+        if (!dstLen) {
+            return;
+        }
+
+        jint auxLen = (type == org_shared_array_kernel_ArrayKernel_RG_VAR) ? dstLen : 0;
+
+        MallocHandler groupsH(sizeof(jdouble) * auxLen + sizeof(jint) * nGroups);
+        jint *groupCounts = (jint *) ((jdouble *) groupsH.get() + auxLen);
+
+        memset(groupCounts, 0, sizeof(jint) * nGroups);
+
+        jint nPlanDims = MappingOps::planTraversal(slabD, srcSArr, dstSArr, nDims, //
+                planD, planSrcS, planDstS);
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        std::fill(dstVArr, dstVArr + dstLen, identity);
+
+        // Only the variance needs auxiliary values; everything else harmlessly aliases the destination.
+        jdouble *aux = dstVArr;
+
+        if (type == org_shared_array_kernel_ArrayKernel_RG_VAR) {
+
+            aux = (jdouble *) groupsH.get();
+
+            std::fill(aux, aux + dstLen, 0.0);
+        }
+
+        jint srcStride = srcSArr[dim];
+        jint dstStride = dstSArr[dim];
+
+        // Fold every slab into its group's slab. Consecutive slabs with the same label land on the same destination,
+        // which stays in cache.
+        for (jint i = 0; i < nLabels; i++) {
+
+            jint label = labelsArr[i];
+
+            if (label < 0) {
+                continue;
+            }
+
+            jint count = ++groupCounts[label];
+
+            if (!op || !slabLen) {
+                continue;
+            }
+
+            // Single-element slabs, as with labeled images, skip the traversal machinery.
+            if (slabLen == 1) {
+
+                op(srcVArr + i * srcStride, 1, dstVArr + label * dstStride, aux + label * dstStride, 1, 1, count);
+
+            } else {
+
+                DimensionOps::rgTraverse(op, srcVArr + i * srcStride, //
+                        dstVArr + label * dstStride, aux + label * dstStride, //
+                        planD, planSrcS, planDstS, nPlanDims, slabLen, count, counters);
+            }
+        }
+
+        // Finish up by group, which needs only the destination strides.
+
+        if (type == org_shared_array_kernel_ArrayKernel_RG_SUM || !slabLen) {
+            return;
+        }
+
+        bool extremum = (type == org_shared_array_kernel_ArrayKernel_RG_MAX
+                || type == org_shared_array_kernel_ArrayKernel_RG_MIN);
+
+        nPlanDims = MappingOps::planTraversal(slabD, dstSArr, dstSArr, nDims, //
+                planD, planSrcS, planDstS);
+
+        jdouble nan = std::numeric_limits<jdouble>::quiet_NaN();
+
+        for (jint label = 0; label < nGroups; label++) {
+
+            jdouble count = groupCounts[label];
+            jdouble *dstSlab = dstVArr + label * dstStride;
+            jdouble *auxSlab = aux + label * dstStride;
+
+            // Nonempty extrema are already final, and empty ones would otherwise keep the identity.
+            if (extremum && count) {
+                continue;
+            }
+
+            memset(counters, 0, sizeof(jint) * nDims);
+
+            for (jint n = slabLen, offset = 0; n > 0; n--) {
+
+                switch (type) {
+
+                case org_shared_array_kernel_ArrayKernel_RG_MEAN:
+                    dstSlab[offset] = count ? dstSlab[offset] / count : nan;
+                    break;
+
+                case org_shared_array_kernel_ArrayKernel_RG_VAR:
+                    dstSlab[offset] = count ? auxSlab[offset] / count : nan;
+                    break;
+
+                case org_shared_array_kernel_ArrayKernel_RG_MAX:
+                case org_shared_array_kernel_ArrayKernel_RG_MIN:
+                    dstSlab[offset] = nan;
+                    break;
+
+                default:
+                    dstSlab[offset] = count;
+                    break;
+                }
+
+                for (jint j = nPlanDims - 1; j >= 0; j--) {
+
+                    offset += planDstS[j];
+
+                    if (++counters[j] < planD[j]) {
+                        break;
+                    }
+
+                    counters[j] = 0;
+                    offset -= planDstS[j] * planD[j];
+                }
+            }
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+inline void DimensionOps::rgTraverse(rgOp_t *op, const jdouble *src, jdouble *dst, jdouble *aux, //
+        const jint *planD, const jint *planSrcS, const jint *planDstS, jint nPlanDims, jint len, jint count, //
+        jint *counters) {
+
+    jint nOuterDims = nPlanDims - 1;
+    jint innerSize = planD[nOuterDims];
+    jint innerSrcStride = planSrcS[nOuterDims];
+    jint innerDstStride = planDstS[nOuterDims];
+
+    memset(counters, 0, sizeof(jint) * nOuterDims);
+
+    for (jint n = len / innerSize, srcOffset = 0, dstOffset = 0; n > 0; n--) {
+
+        op(src + srcOffset, innerSrcStride, dst + dstOffset, aux + dstOffset, innerDstStride, innerSize, count);
+
+        for (jint dim = nOuterDims - 1; dim >= 0; dim--) {
+
+            srcOffset += planSrcS[dim];
+            dstOffset += planDstS[dim];
+
+            if (++counters[dim] < planD[dim]) {
+                break;
+            }
+
+            counters[dim] = 0;
+            srcOffset -= planSrcS[dim] * planD[dim];
+            dstOffset -= planDstS[dim] * planD[dim];
+        }
+    }
+}
+
+inline void DimensionOps::rgSum(const jdouble *src, jint srcStride, jdouble *dst, jdouble *aux, jint dstStride, //
+        jint size, jint count) {
+
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < size; i++, srcIndex += srcStride, dstIndex += dstStride) {
+        dst[dstIndex] += src[srcIndex];
+    }
+}
+
+inline void DimensionOps::rgVar(const jdouble *src, jint srcStride, jdouble *dst, jdouble *aux, jint dstStride, //
+        jint size, jint count) {
+
+    // The destination holds running means and the auxiliary values hold running sums of squared deviations.
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < size; i++, srcIndex += srcStride, dstIndex += dstStride) {
+
+        jdouble value = src[srcIndex];
+        jdouble delta = value - dst[dstIndex];
+
+        dst[dstIndex] += delta / count;
+        aux[dstIndex] += delta * (value - dst[dstIndex]);
+    }
+}
+
+inline void DimensionOps::rgMax(const jdouble *src, jint srcStride, jdouble *dst, jdouble *aux, jint dstStride, //
+        jint size, jint count) {
+
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < size; i++, srcIndex += srcStride, dstIndex += dstStride) {
+        dst[dstIndex] = std::max<jdouble>(dst[dstIndex], src[srcIndex]);
+    }
+}
+
+inline void DimensionOps::rgMin(const jdouble *src, jint srcStride, jdouble *dst, jdouble *aux, jint dstStride, //
+        jint size, jint count) {
+
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < size; i++, srcIndex += srcStride, dstIndex += dstStride) {
+        dst[dstIndex] = std::min<jdouble>(dst[dstIndex], src[srcIndex]);
+    }
+}
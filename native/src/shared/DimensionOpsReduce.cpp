@@ -30,30 +30,51 @@ void DimensionOps::rrOp(JNIEnv *env, jobject thisObj, jint type, //
 
     try {
 
+        rrAccumulateOp_t *accumulateOp = NULL;
         rrOp_t *op = NULL;
+        jdouble identity = 0.0;
+        bool isNorm2 = false;
 
         switch (type) {
 
         case org_shared_array_kernel_ArrayKernel_RR_SUM:
-            op = DimensionOps::rrSum;
+            accumulateOp = DimensionOps::rrSum;
+            identity = 0.0;
             break;
 
         case org_shared_array_kernel_ArrayKernel_RR_PROD:
-            op = DimensionOps::rrProd;
+            accumulateOp = DimensionOps::rrProd;
+            identity = 1.0;
             break;
 
         case org_shared_array_kernel_ArrayKernel_RR_MAX:
-            op = DimensionOps::rrMax;
+            accumulateOp = DimensionOps::rrMax;
+            identity = -HUGE_VAL;
             break;
 
         case org_shared_array_kernel_ArrayKernel_RR_MIN:
-            op = DimensionOps::rrMin;
+            accumulateOp = DimensionOps::rrMin;
+            identity = HUGE_VAL;
             break;
 
         case org_shared_array_kernel_ArrayKernel_RR_VAR:
             op = DimensionOps::rrVar;
             break;
 
+        case org_shared_array_kernel_ArrayKernel_RR_NORM1:
+            accumulateOp = DimensionOps::rrNorm1;
+            identity = 0.0;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RR_NORM2:
+            isNorm2 = true;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RR_NORMINF:
+            accumulateOp = DimensionOps::rrNormInf;
+            identity = 0.0;
+            break;
+
         default:
             throw std::runtime_error("Operation type not recognized");
         }
@@ -130,44 +151,129 @@ void DimensionOps::rrOp(JNIEnv *env, jobject thisObj, jint type, //
             return;
         }
 
-        MallocHandler mallocH(sizeof(jdouble) * srcLen + sizeof(jint) * (srcLen + nDims + 2 * (nDims - 1) + dstLen));
-        void *all = mallocH.get();
+        if (accumulateOp || isNorm2) {
 
-        jdouble *workingV = (jdouble *) all;
-        jint *workingIndices = (jint *) ((jdouble *) all + srcLen);
-        jint *workingD = (jint *) ((jdouble *) all + srcLen) + srcLen;
-        jint *workingDModified = (jint *) ((jdouble *) all + srcLen) + srcLen + nDims;
-        jint *srcSArrModified = (jint *) ((jdouble *) all + srcLen) + srcLen + nDims + (nDims - 1);
-        jint *dstIndices = (jint *) ((jdouble *) all + srcLen) + srcLen + nDims + 2 * (nDims - 1);
+            // Leave room for the placeholder dimension of a single element.
+            jint nSlots = std::max<jint>(nDims, 1);
 
-        memcpy(workingV, srcVArr, sizeof(jdouble) * srcLen);
-        memcpy(workingD, srcDArr, sizeof(jint) * nDims);
+            // Euclidean norms keep three sums of squares for every destination value.
+            jint nSums = isNorm2 ? 3 * dstLen : 0;
 
-        acc = srcLen;
+            MallocHandler mallocH(sizeof(jdouble) * nSums + sizeof(jint) * 5 * nSlots);
+            void *all = mallocH.get();
 
-        for (jint i = 0; i < nOpDims; i++) {
+            jdouble *sums = (jdouble *) all;
+            jint *maskedDstS = (jint *) (sums + nSums);
+            jint *planD = maskedDstS + nSlots;
+            jint *planSrcS = maskedDstS + 2 * nSlots;
+            jint *planDstS = maskedDstS + 3 * nSlots;
+            jint *counters = maskedDstS + 4 * nSlots;
 
-            jint dim = opDimsArr[i];
+            memcpy(maskedDstS, dstSArr, sizeof(jint) * nDims);
+            memset(counters, 0, sizeof(jint) * nDims);
 
-            acc /= srcDArr[dim];
+            // Reduced dimensions get a destination stride of zero, which keeps them from coalescing with kept ones.
+            for (jint i = 0; i < nOpDims; i++) {
+                maskedDstS[opDimsArr[i]] = 0;
+            }
 
-            // Assign indices while pretending that the dimension of interest doesn't exist.
-            DimensionOps::assignBaseIndices(workingIndices, //
-                    workingD, workingDModified, //
-                    srcSArr, srcSArrModified, //
-                    nDims, dim);
+            jint nPlanDims = MappingOps::planTraversal(srcDArr, srcSArr, maskedDstS, nDims, //
+                    planD, planSrcS, planDstS);
 
-            // Execute the reduce operation.
-            op(workingV, workingIndices, acc, workingD[dim], srcSArr[dim]);
+            jint nOuterDims = nPlanDims - 1;
+            jint innerSize = planD[nOuterDims];
+            jint innerSrcStride = planSrcS[nOuterDims];
+            jint innerDstStride = planDstS[nOuterDims];
 
-            workingD[dim] = 1;
-        }
+            for (jint i = 0; i < dstLen; i++) {
+                dstVArr[i] = identity;
+            }
+
+            for (jint i = 0; i < nSums; i++) {
+                sums[i] = 0.0;
+            }
+
+            // Traverse the source once, running the innermost dimension as a tight loop and the rest as an
+            // odometer.
+            for (jint n = srcLen / innerSize, srcOffset = 0, dstOffset = 0; n > 0; n--) {
+
+                if (!isNorm2) {
+
+                    accumulateOp(srcVArr + srcOffset, innerSrcStride, //
+                            dstVArr + dstOffset, innerDstStride, innerSize);
+
+                } else {
+
+                    DimensionOps::rrNorm2(srcVArr + srcOffset, innerSrcStride, //
+                            sums + 3 * dstOffset, 3 * innerDstStride, innerSize);
+                }
+
+                for (jint dim = nOuterDims - 1; dim >= 0; dim--) {
+
+                    srcOffset += planSrcS[dim];
+                    dstOffset += planDstS[dim];
+
+                    if (++counters[dim] < planD[dim]) {
+                        break;
+                    }
+
+                    counters[dim] = 0;
+                    srcOffset -= planSrcS[dim] * planD[dim];
+                    dstOffset -= planDstS[dim] * planD[dim];
+                }
+            }
+
+            if (isNorm2) {
+
+                for (jint i = 0; i < dstLen; i++) {
+                    dstVArr[i] = Common::norm2Combine(sums + 3 * i);
+                }
+            }
+
+        } else {
 
-        MappingOps::assignMappingIndices(workingIndices, dstDArr, srcSArr, nDims);
-        MappingOps::assignMappingIndices(dstIndices, dstDArr, dstSArr, nDims);
+            // Variances don't compose, so reduce one dimension at a time.
 
-        for (jint i = 0; i < dstLen; i++) {
-            dstVArr[dstIndices[i]] = workingV[workingIndices[i]];
+            MallocHandler mallocH(sizeof(jdouble) * srcLen
+                    + sizeof(jint) * (srcLen + nDims + 2 * (nDims - 1) + dstLen));
+            void *all = mallocH.get();
+
+            jdouble *workingV = (jdouble *) all;
+            jint *workingIndices = (jint *) ((jdouble *) all + srcLen);
+            jint *workingD = (jint *) ((jdouble *) all + srcLen) + srcLen;
+            jint *workingDModified = (jint *) ((jdouble *) all + srcLen) + srcLen + nDims;
+            jint *srcSArrModified = (jint *) ((jdouble *) all + srcLen) + srcLen + nDims + (nDims - 1);
+            jint *dstIndices = (jint *) ((jdouble *) all + srcLen) + srcLen + nDims + 2 * (nDims - 1);
+
+            memcpy(workingV, srcVArr, sizeof(jdouble) * srcLen);
+            memcpy(workingD, srcDArr, sizeof(jint) * nDims);
+
+            acc = srcLen;
+
+            for (jint i = 0; i < nOpDims; i++) {
+
+                jint dim = opDimsArr[i];
+
+                acc /= srcDArr[dim];
+
+                // Assign indices while pretending that the dimension of interest doesn't exist.
+                DimensionOps::assignBaseIndices(workingIndices, //
+                        workingD, workingDModified, //
+                        srcSArr, srcSArrModified, //
+                        nDims, dim);
+
+                // Execute the reduce operation.
+                op(workingV, workingIndices, acc, workingD[dim], srcSArr[dim]);
+
+                workingD[dim] = 1;
+            }
+
+            MappingOps::assignMappingIndices(workingIndices, dstDArr, srcSArr, nDims);
+            MappingOps::assignMappingIndices(dstIndices, dstDArr, dstSArr, nDims);
+
+            for (jint i = 0; i < dstLen; i++) {
+                dstVArr[dstIndices[i]] = workingV[workingIndices[i]];
+            }
         }
 
     } catch (std::exception &e) {
@@ -176,54 +282,150 @@ void DimensionOps::rrOp(JNIEnv *env, jobject thisObj, jint type, //
     }
 }
 
-inline void DimensionOps::rrSum(jdouble *working, const jint *workingIndices, //
-        jint nIndices, jint size, jint stride) {
+inline void DimensionOps::rrSum(const jdouble *src, jint srcStride, jdouble *dst, jint dstStride, jint size) {
 
-    for (jint i = 0; i < nIndices; i++) {
+    if (!dstStride) {
 
-        jint workingIndex = workingIndices[i];
+        jdouble acc = *dst;
 
-        for (jint j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-            working[workingIndex] += working[offset];
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+            acc += src[srcOffset];
+        }
+
+        *dst = acc;
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, dstOffset = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+            dst[dstOffset] += src[srcOffset];
         }
     }
 }
 
-inline void DimensionOps::rrProd(jdouble *working, const jint *workingIndices, //
-        jint nIndices, jint size, jint stride) {
+inline void DimensionOps::rrProd(const jdouble *src, jint srcStride, jdouble *dst, jint dstStride, jint size) {
 
-    for (jint i = 0; i < nIndices; i++) {
+    if (!dstStride) {
 
-        jint workingIndex = workingIndices[i];
+        jdouble acc = *dst;
 
-        for (jint j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-            working[workingIndex] *= working[offset];
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+            acc *= src[srcOffset];
+        }
+
+        *dst = acc;
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, dstOffset = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+            dst[dstOffset] *= src[srcOffset];
         }
     }
 }
 
-inline void DimensionOps::rrMax(jdouble *working, const jint *workingIndices, //
-        jint nIndices, jint size, jint stride) {
+inline void DimensionOps::rrMax(const jdouble *src, jint srcStride, jdouble *dst, jint dstStride, jint size) {
 
-    for (jint i = 0; i < nIndices; i++) {
+    if (!dstStride) {
 
-        jint workingIndex = workingIndices[i];
+        jdouble acc = *dst;
 
-        for (jint j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-            working[workingIndex] = std::max<jdouble>(working[offset], working[workingIndex]);
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+            acc = std::max<jdouble>(src[srcOffset], acc);
+        }
+
+        *dst = acc;
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, dstOffset = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+            dst[dstOffset] = std::max<jdouble>(src[srcOffset], dst[dstOffset]);
         }
     }
 }
 
-inline void DimensionOps::rrMin(jdouble *working, const jint *workingIndices, //
-        jint nIndices, jint size, jint stride) {
+inline void DimensionOps::rrMin(const jdouble *src, jint srcStride, jdouble *dst, jint dstStride, jint size) {
 
-    for (jint i = 0; i < nIndices; i++) {
+    if (!dstStride) {
 
-        jint workingIndex = workingIndices[i];
+        jdouble acc = *dst;
 
-        for (jint j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-            working[workingIndex] = std::min<jdouble>(working[offset], working[workingIndex]);
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+            acc = std::min<jdouble>(src[srcOffset], acc);
+        }
+
+        *dst = acc;
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, dstOffset = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+            dst[dstOffset] = std::min<jdouble>(src[srcOffset], dst[dstOffset]);
+        }
+    }
+}
+
+inline void DimensionOps::rrNorm1(const jdouble *src, jint srcStride, jdouble *dst, jint dstStride, jint size) {
+
+    if (!dstStride) {
+
+        jdouble acc = *dst;
+
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+            acc += std::fabs(src[srcOffset]);
+        }
+
+        *dst = acc;
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, dstOffset = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+            dst[dstOffset] += std::fabs(src[srcOffset]);
+        }
+    }
+}
+
+inline void DimensionOps::rrNorm2(const jdouble *src, jint srcStride, jdouble *sums, jint sumsStride, jint size) {
+
+    if (!sumsStride) {
+
+        jdouble acc[3] = { sums[0], sums[1], sums[2] };
+
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+            Common::norm2Accumulate(src[srcOffset], acc);
+        }
+
+        sums[0] = acc[0];
+        sums[1] = acc[1];
+        sums[2] = acc[2];
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, sumsOffset = 0; i < size; //
+                i++, srcOffset += srcStride, sumsOffset += sumsStride) {
+            Common::norm2Accumulate(src[srcOffset], sums + sumsOffset);
+        }
+    }
+}
+
+inline void DimensionOps::rrNormInf(const jdouble *src, jint srcStride, jdouble *dst, jint dstStride, jint size) {
+
+    // NaNs propagate.
+    if (!dstStride) {
+
+        jdouble acc = *dst;
+
+        for (jint i = 0, srcOffset = 0; i < size; i++, srcOffset += srcStride) {
+
+            jdouble a = std::fabs(src[srcOffset]);
+            acc = (a > acc || a != a) ? a : acc;
+        }
+
+        *dst = acc;
+
+    } else {
+
+        for (jint i = 0, srcOffset = 0, dstOffset = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+
+            jdouble a = std::fabs(src[srcOffset]);
+            dst[dstOffset] = (a > dst[dstOffset] || a != a) ? a : dst[dstOffset];
         }
     }
 }
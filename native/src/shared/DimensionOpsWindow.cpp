@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <DimensionOps.hpp>
+
+void DimensionOps::rwOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray dstV, //
+        jint dim, jint size) {
+
+    try {
+
+        rwOp_t *op = NULL;
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_RW_SUM:
+            op = DimensionOps::rwSum;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RW_MEAN:
+            op = DimensionOps::rwMean;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RW_VAR:
+            op = DimensionOps::rwVar;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RW_MAX:
+            op = DimensionOps::rwMax;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RW_MIN:
+            op = DimensionOps::rwMin;
+            break;
+
+        default:
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        if (!srcV || !srcD || !srcS || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint dstLen = env->GetArrayLength(dstV);
+        jint nDims = env->GetArrayLength(srcD);
+
+        if (!(dim >= 0 && dim < nDims) || (nDims != env->GetArrayLength(srcS)) || (srcLen != dstLen)) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (size <= 0) {
+            throw std::runtime_error("Window size must be positive");
+        }
+
+        // Initialize pinned arrays.
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        // Proceed only if nonzero length.
+        if (!srcLen) {
+            return;
+        }
+
+        jint lineSize = srcDArr[dim];
+        jint nIndices = srcLen / lineSize;
+
+        MallocHandler mallocH(sizeof(jint) * (nIndices + 2 * (nDims - 1) + lineSize));
+        void *all = mallocH.get();
+
+        jint *srcIndices = (jint *) all;
+        jint *srcDArrModified = (jint *) all + nIndices;
+        jint *srcSArrModified = (jint *) all + nIndices + (nDims - 1);
+        jint *deque = (jint *) all + nIndices + 2 * (nDims - 1);
+
+        // Assign indices while pretending that the dimension of interest doesn't exist.
+        DimensionOps::assignBaseIndices(srcIndices, srcDArr, srcDArrModified, srcSArr, srcSArrModified, //
+                nDims, dim);
+
+        // Execute the window operation.
+
+        op(srcVArr, srcIndices, dstVArr, nIndices, lineSize, srcSArr[dim], size, deque);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+inline void DimensionOps::rwSumCompensated(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, bool mean) {
+
+    jint windowStride = window * stride;
+
+    for (jint i = 0; i < nIndices; i++) {
+
+        jdouble sum = 0.0;
+        jdouble compensation = 0.0;
+
+        // Non-finite values are counted instead of summed, so that they only affect the windows holding them.
+        jint nNaNs = 0;
+        jint nPosInfs = 0;
+        jint nNegInfs = 0;
+
+        for (jint k = 0, offset = srcIndices[i]; k < size; k++, offset += stride) {
+
+            // Neumaier's variant of Kahan summation keeps what the running sum can't represent, so that values
+            // leaving the window don't leave their rounding error behind.
+            for (jint j = 0, n = (k >= window) ? 2 : 1; j < n; j++) {
+
+                jdouble value = !j ? src[offset] : src[offset - windowStride];
+                jint increment = !j ? 1 : -1;
+
+                if (value - value != 0.0) {
+
+                    if (value != value) {
+                        nNaNs += increment;
+                    } else if (value > 0.0) {
+                        nPosInfs += increment;
+                    } else {
+                        nNegInfs += increment;
+                    }
+
+                    continue;
+                }
+
+                value *= increment;
+
+                jdouble t = sum + value;
+
+                compensation += (fabs(sum) >= fabs(value)) ? (sum - t) + value : (value - t) + sum;
+                sum = t;
+            }
+
+            jdouble result = sum + compensation;
+
+            if (nNaNs > 0 || (nPosInfs > 0 && nNegInfs > 0)) {
+                result = std::numeric_limits<jdouble>::quiet_NaN();
+            } else if (nPosInfs > 0) {
+                result = std::numeric_limits<jdouble>::infinity();
+            } else if (nNegInfs > 0) {
+                result = -std::numeric_limits<jdouble>::infinity();
+            }
+
+            dst[offset] = mean ? result / std::min<jint>(k + 1, window) : result;
+        }
+    }
+}
+
+inline void DimensionOps::rwExtremum(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, jint *deque, bool max) {
+
+    // Positions on the deque have monotonically worsening values, so that the front is always the extremum.
+    for (jint i = 0; i < nIndices; i++) {
+
+        jint srcIndex = srcIndices[i];
+        jint head = 0;
+        jint tail = 0;
+
+        for (jint k = 0, offset = srcIndex; k < size; k++, offset += stride) {
+
+            jdouble value = src[offset];
+
+            for (; tail > head; tail--) {
+
+                jdouble last = src[srcIndex + deque[tail - 1] * stride];
+
+                if (max ? (last > value) : (last < value)) {
+                    break;
+                }
+            }
+
+            deque[tail++] = k;
+
+            if (deque[head] <= k - window) {
+                head++;
+            }
+
+            dst[offset] = src[srcIndex + deque[head] * stride];
+        }
+    }
+}
+
+inline void DimensionOps::rwSum(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, jint *deque) {
+    rwSumCompensated(src, srcIndices, dst, nIndices, size, stride, window, false);
+}
+
+inline void DimensionOps::rwMean(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, jint *deque) {
+    rwSumCompensated(src, srcIndices, dst, nIndices, size, stride, window, true);
+}
+
+inline void DimensionOps::rwVar(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, jint *deque) {
+
+    jint windowStride = window * stride;
+
+    for (jint i = 0; i < nIndices; i++) {
+
+        jdouble mean = 0.0;
+        jdouble m2 = 0.0;
+
+        // Welford's updates, run forward on entry and in reverse on exit. Non-finite values only make the windows
+        // holding them NaN, and are otherwise kept out of the running state.
+        for (jint k = 0, count = 0, nNonFinite = 0, offset = srcIndices[i]; k < size; k++, offset += stride) {
+
+            jdouble value = src[offset];
+
+            if (value - value != 0.0) {
+
+                nNonFinite++;
+
+            } else {
+
+                jdouble delta = value - mean;
+
+                count++;
+                mean += delta / count;
+                m2 += delta * (value - mean);
+            }
+
+            if (k >= window) {
+
+                jdouble leaving = src[offset - windowStride];
+
+                if (leaving - leaving != 0.0) {
+
+                    nNonFinite--;
+
+                } else if (count > 1) {
+
+                    jdouble delta = leaving - mean;
+
+                    count--;
+                    mean -= delta / count;
+                    m2 -= delta * (leaving - mean);
+
+                } else {
+
+                    // Restart from empty instead of dividing by zero.
+                    count = 0;
+                    mean = 0.0;
+                    m2 = 0.0;
+                }
+            }
+
+            dst[offset] = (nNonFinite > 0) ? std::numeric_limits<jdouble>::quiet_NaN() //
+                    : std::max<jdouble>(m2, 0.0) / count;
+        }
+    }
+}
+
+inline void DimensionOps::rwMax(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, jint *deque) {
+    rwExtremum(src, srcIndices, dst, nIndices, size, stride, window, deque, true);
+}
+
+inline void DimensionOps::rwMin(const jdouble *src, const jint *srcIndices, jdouble *dst, //
+        jint nIndices, jint size, jint stride, jint window, jint *deque) {
+    rwExtremum(src, srcIndices, dst, nIndices, size, stride, window, deque, false);
+}
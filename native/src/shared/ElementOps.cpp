@@ -57,6 +57,18 @@ jdouble ElementOps::raOp(JNIEnv *env, jobject thisObj, jint type, jdoubleArray s
             op = ElementOps::raEnt;
             break;
 
+        case org_shared_array_kernel_ArrayKernel_RA_NORM1:
+            op = ElementOps::raNorm1;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RA_NORM2:
+            op = ElementOps::raNorm2;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RA_NORMINF:
+            op = ElementOps::raNormInf;
+            break;
+
         default:
             throw std::runtime_error("Operation type not recognized");
         }
@@ -110,7 +122,7 @@ jdoubleArray ElementOps::caOp(JNIEnv *env, jobject thisObj, jint type, jdoubleAr
     return res;
 }
 
-void ElementOps::ruOp(JNIEnv *env, jobject thisObj, jint type, jdouble a, jdoubleArray srcV) {
+void ElementOps::ruOp(JNIEnv *env, jobject thisObj, jint type, jdouble a, jdoubleArray srcV, jdoubleArray dstV) {
 
     try {
 
@@ -182,7 +194,7 @@ void ElementOps::ruOp(JNIEnv *env, jobject thisObj, jint type, jdouble a, jdoubl
             throw std::runtime_error("Operation type not recognized");
         }
 
-        ElementOps::unaryOpProxy<jdouble>(env, op, srcV, a, JNI_FALSE);
+        ElementOps::unaryOpProxy<jdouble>(env, op, srcV, dstV, a, JNI_FALSE);
 
     } catch (std::exception &e) {
 
@@ -190,7 +202,8 @@ void ElementOps::ruOp(JNIEnv *env, jobject thisObj, jint type, jdouble a, jdoubl
     }
 }
 
-void ElementOps::cuOp(JNIEnv *env, jobject thisObj, jint type, jdouble aRe, jdouble aIm, jdoubleArray srcV) {
+void ElementOps::cuOp(JNIEnv *env, jobject thisObj, jint type, jdouble aRe, jdouble aIm, jdoubleArray srcV, //
+        jdoubleArray dstV) {
 
     try {
 
@@ -238,7 +251,7 @@ void ElementOps::cuOp(JNIEnv *env, jobject thisObj, jint type, jdouble aRe, jdou
             throw std::runtime_error("Operation type not recognized");
         }
 
-        ElementOps::unaryOpProxy<jcomplex>(env, op, srcV, jcomplex(aRe, aIm), JNI_TRUE);
+        ElementOps::unaryOpProxy<jcomplex>(env, op, srcV, dstV, jcomplex(aRe, aIm), JNI_TRUE);
 
     } catch (std::exception &e) {
 
@@ -246,7 +259,7 @@ void ElementOps::cuOp(JNIEnv *env, jobject thisObj, jint type, jdouble aRe, jdou
     }
 }
 
-void ElementOps::iuOp(JNIEnv *env, jobject thisObj, jint type, jint a, jintArray srcV) {
+void ElementOps::iuOp(JNIEnv *env, jobject thisObj, jint type, jint a, jintArray srcV, jintArray dstV) {
 
     try {
 
@@ -274,7 +287,7 @@ void ElementOps::iuOp(JNIEnv *env, jobject thisObj, jint type, jint a, jintArray
             throw std::runtime_error("Operation type not recognized");
         }
 
-        ElementOps::unaryOpProxy<jint>(env, op, srcV, a, JNI_FALSE);
+        ElementOps::unaryOpProxy<jint>(env, op, srcV, dstV, a, JNI_FALSE);
 
     } catch (std::exception &e) {
 
@@ -427,25 +440,41 @@ template<class T> inline T ElementOps::accumulatorOpProxy(JNIEnv *env, T (*op)(c
     return op((T *) srcVh.get(), logicalLen);
 }
 
-template<class T> inline void ElementOps::unaryOpProxy(JNIEnv *env, void (*op)(T, T *, jint),
-        jarray srcV, T argument, jboolean complex) {
+template<class T> inline void ElementOps::unaryOpProxy(JNIEnv *env, void (*op)(T, const T *, T *, jint),
+        jarray srcV, jarray dstV, T argument, jboolean complex) {
 
-    if (!srcV) {
+    if (!srcV || !dstV) {
         throw std::runtime_error("Invalid arguments");
     }
 
     jint srcLen = env->GetArrayLength(srcV);
 
+    if (env->GetArrayLength(dstV) != srcLen) {
+        throw std::runtime_error("Invalid array lengths");
+    }
+
     if (complex && (srcLen % 2) != 0) {
         throw std::runtime_error("Invalid array length");
     }
 
     jint logicalLen = srcLen / (complex ? 2 : 1);
 
-    ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
-    // NO JNI AFTER THIS POINT!
+    if (env->IsSameObject(srcV, dstV)) {
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        op(argument, (const T *) srcVh.get(), (T *) srcVh.get(), logicalLen);
 
-    op(argument, (T *) srcVh.get(), logicalLen);
+    } else {
+
+        // Read and write in a single pass, instead of copying before operating in place.
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        op(argument, (const T *) srcVh.get(), (T *) dstVh.get(), logicalLen);
+    }
 }
 
 template<class T> inline void ElementOps::binaryOpProxy(JNIEnv *env, jint type, jarray lhsV, jarray rhsV, jarray dstV,
@@ -655,142 +684,146 @@ template<class T> inline void ElementOps::eMin(const T *a, const T *b, T *r, jin
 
 //
 
-template<class T> inline void ElementOps::uSqr(T a, T *v, jint len) {
+template<class T> inline void ElementOps::uSqr(T a, const T *src, T *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] *= v[i];
+        dst[i] = src[i] * src[i];
     }
 }
 
-template<class T> inline void ElementOps::uInv(T a, T *v, jint len) {
+template<class T> inline void ElementOps::uInv(T a, const T *src, T *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = a / v[i];
+        dst[i] = a / src[i];
     }
 }
 
-template<class T> inline void ElementOps::uAdd(T a, T *v, jint len) {
+template<class T> inline void ElementOps::uAdd(T a, const T *src, T *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] += a;
+        dst[i] = src[i] + a;
     }
 }
 
-template<class T> inline void ElementOps::uMul(T a, T *v, jint len) {
+template<class T> inline void ElementOps::uMul(T a, const T *src, T *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] *= a;
+        dst[i] = src[i] * a;
     }
 }
 
-template<class T> inline void ElementOps::uFill(T a, T *v, jint len) {
+template<class T> inline void ElementOps::uFill(T a, const T *src, T *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = a;
+        dst[i] = a;
     }
 }
 
-template<class T> inline void ElementOps::uShuffle(T a, T *v, jint len) {
+template<class T> inline void ElementOps::uShuffle(T a, const T *src, T *dst, jint len) {
+
+    if (src != dst) {
+        memcpy(dst, src, sizeof(T) * len);
+    }
 
     for (jint i = len; i > 1; i--) {
 
         jint index = rand() % i;
 
-        T tmp = v[i - 1];
-        v[i - 1] = v[index];
-        v[index] = tmp;
+        T tmp = dst[i - 1];
+        dst[i - 1] = dst[index];
+        dst[index] = tmp;
     }
 }
 
 //
 
-inline void ElementOps::ruAbs(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruAbs(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = fabs(v[i]);
+        dst[i] = fabs(src[i]);
     }
 }
 
-inline void ElementOps::ruExp(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruExp(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = exp(v[i]);
+        dst[i] = exp(src[i]);
     }
 }
 
-inline void ElementOps::ruRnd(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruRnd(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = a * (rand() / (jdouble) RAND_MAX);
+        dst[i] = a * (rand() / (jdouble) RAND_MAX);
     }
 }
 
-inline void ElementOps::ruLog(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruLog(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = log(v[i]);
+        dst[i] = log(src[i]);
     }
 }
 
-inline void ElementOps::ruPow(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruPow(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = pow(v[i], a);
+        dst[i] = pow(src[i], a);
     }
 }
 
-inline void ElementOps::ruSqrt(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruSqrt(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = sqrt(v[i]);
+        dst[i] = sqrt(src[i]);
     }
 }
 
-inline void ElementOps::ruCos(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruCos(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = cos(v[i]);
+        dst[i] = cos(src[i]);
     }
 }
 
-inline void ElementOps::ruSin(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruSin(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = sin(v[i]);
+        dst[i] = sin(src[i]);
     }
 }
 
-inline void ElementOps::ruAtan(jdouble a, jdouble *v, jint len) {
+inline void ElementOps::ruAtan(jdouble a, const jdouble *src, jdouble *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = atan(v[i]);
+        dst[i] = atan(src[i]);
     }
 }
 
 //
 
-inline void ElementOps::cuExp(jcomplex a, jcomplex *v, jint len) {
+inline void ElementOps::cuExp(jcomplex a, const jcomplex *src, jcomplex *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = jcomplex(cos(v[i].im) * exp(v[i].re), sin(v[i].im) * exp(v[i].re));
+        dst[i] = jcomplex(cos(src[i].im) * exp(src[i].re), sin(src[i].im) * exp(src[i].re));
     }
 }
 
-inline void ElementOps::cuRnd(jcomplex a, jcomplex *v, jint len) {
+inline void ElementOps::cuRnd(jcomplex a, const jcomplex *src, jcomplex *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = jcomplex(a.re * (rand() / (jdouble) RAND_MAX), a.im * (rand() / (jdouble) RAND_MAX));
+        dst[i] = jcomplex(a.re * (rand() / (jdouble) RAND_MAX), a.im * (rand() / (jdouble) RAND_MAX));
     }
 }
 
-inline void ElementOps::cuConj(jcomplex a, jcomplex *v, jint len) {
+inline void ElementOps::cuConj(jcomplex a, const jcomplex *src, jcomplex *dst, jint len) {
 
     for (jint i = 0; i < len; i++) {
-        v[i] = jcomplex(v[i].re, -v[i].im);
+        dst[i] = jcomplex(src[i].re, -src[i].im);
     }
 }
 
-inline void ElementOps::cuCos(jcomplex a, jcomplex *v, jint len) {
+inline void ElementOps::cuCos(jcomplex a, const jcomplex *src, jcomplex *dst, jint len) {
 
     jcomplex factor_i = jcomplex(0.0, 1.0);
     jcomplex factor_minus_i = jcomplex(0.0, -1.0);
@@ -798,15 +831,15 @@ inline void ElementOps::cuCos(jcomplex a, jcomplex *v, jint len) {
 
     for (jint i = 0; i < len; i++) {
 
-        jcomplex exp1 = factor_i * v[i];
-        jcomplex exp2 = factor_minus_i * v[i];
+        jcomplex exp1 = factor_i * src[i];
+        jcomplex exp2 = factor_minus_i * src[i];
 
-        v[i] = jcomplex(cos(exp1.im) * exp(exp1.re) + cos(exp2.im) * exp(exp2.re),
+        dst[i] = jcomplex(cos(exp1.im) * exp(exp1.re) + cos(exp2.im) * exp(exp2.re),
                 sin(exp1.im) * exp(exp1.re) + sin(exp2.im) * exp(exp2.re)) / denominator;
     }
 }
 
-inline void ElementOps::cuSin(jcomplex a, jcomplex *v, jint len) {
+inline void ElementOps::cuSin(jcomplex a, const jcomplex *src, jcomplex *dst, jint len) {
 
     jcomplex factor_i = jcomplex(0.0, 1.0);
     jcomplex factor_minus_i = jcomplex(0.0, -1.0);
@@ -814,10 +847,10 @@ inline void ElementOps::cuSin(jcomplex a, jcomplex *v, jint len) {
 
     for (jint i = 0; i < len; i++) {
 
-        jcomplex exp1 = factor_i * v[i];
-        jcomplex exp2 = factor_minus_i * v[i];
+        jcomplex exp1 = factor_i * src[i];
+        jcomplex exp2 = factor_minus_i * src[i];
 
-        v[i] = jcomplex(cos(exp1.im) * exp(exp1.re) - cos(exp2.im) * exp(exp2.re),
+        dst[i] = jcomplex(cos(exp1.im) * exp(exp1.re) - cos(exp2.im) * exp(exp2.re),
                 sin(exp1.im) * exp(exp1.re) - sin(exp2.im) * exp(exp2.re)) / denominator;
     }
 }
@@ -942,6 +975,55 @@ inline jdouble ElementOps::raEnt(const jdouble *a, jint len) {
     return -en;
 }
 
+inline jdouble ElementOps::raNorm1(const jdouble *a, jint len) {
+
+    jdouble acc = 0.0;
+
+    for (jint i = 0; i < len; i++) {
+        acc += std::fabs(a[i]);
+    }
+
+    return acc;
+}
+
+inline jdouble ElementOps::raNorm2(const jdouble *a, jint len) {
+
+    // Interleave two sets of sums to shorten the dependency chains.
+    jdouble sums[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+    jint i = 0;
+
+    for (; i + 1 < len; i += 2) {
+
+        Common::norm2Accumulate(a[i], sums);
+        Common::norm2Accumulate(a[i + 1], sums + 3);
+    }
+
+    for (; i < len; i++) {
+        Common::norm2Accumulate(a[i], sums);
+    }
+
+    sums[0] += sums[3];
+    sums[1] += sums[4];
+    sums[2] += sums[5];
+
+    return Common::norm2Combine(sums);
+}
+
+inline jdouble ElementOps::raNormInf(const jdouble *a, jint len) {
+
+    jdouble acc = 0.0;
+
+    // NaNs propagate.
+    for (jint i = 0; i < len; i++) {
+
+        jdouble v = std::fabs(a[i]);
+        acc = (v > acc || v != v) ? v : acc;
+    }
+
+    return acc;
+}
+
 //
 
 inline jcomplex ElementOps::caSum(const jcomplex *a, jint len) {
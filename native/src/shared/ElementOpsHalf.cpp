@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <ElementOps.hpp>
+
+void ElementOps::halfConvert(JNIEnv *env, jobject thisObj, jint format, //
+        jdoubleArray srcV, jshortArray dstV) {
+
+    try {
+
+        if (!srcV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(srcV);
+
+        if (env->GetArrayLength(dstV) != len) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        void (*op)(const jdouble *, jshort *, jint) = NULL;
+
+        switch (format) {
+
+        case org_shared_array_kernel_ArrayKernel_HF_FP16:
+            op = &ElementOps::halfConvertProxy<HALF_FP16_MANTISSA, HALF_FP16_BIAS>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HF_BF16:
+            op = &ElementOps::halfConvertProxy<HALF_BF16_MANTISSA, HALF_BF16_BIAS>;
+            break;
+
+        default:
+            throw std::runtime_error("Format not recognized");
+        }
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        op((const jdouble *) srcVh.get(), (jshort *) dstVh.get(), len);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void ElementOps::halfExpand(JNIEnv *env, jobject thisObj, jint format, //
+        jshortArray srcV, jdoubleArray dstV) {
+
+    try {
+
+        if (!srcV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(srcV);
+
+        if (env->GetArrayLength(dstV) != len) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        void (*op)(const jshort *, jdouble *, jint) = NULL;
+
+        switch (format) {
+
+        case org_shared_array_kernel_ArrayKernel_HF_FP16:
+            op = &ElementOps::halfExpandProxy<HALF_FP16_MANTISSA, HALF_FP16_BIAS>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HF_BF16:
+            op = &ElementOps::halfExpandProxy<HALF_BF16_MANTISSA, HALF_BF16_BIAS>;
+            break;
+
+        default:
+            throw std::runtime_error("Format not recognized");
+        }
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        op((const jshort *) srcVh.get(), (jdouble *) dstVh.get(), len);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void ElementOps::heOp(JNIEnv *env, jobject thisObj, jint type, jint format, //
+        jshortArray lhsV, jshortArray rhsV, jshortArray dstV) {
+
+    try {
+
+        if (!lhsV || !rhsV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(lhsV);
+
+        if (env->GetArrayLength(rhsV) != len || env->GetArrayLength(dstV) != len) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        heOp_t *op = NULL;
+
+        switch (format) {
+
+        case org_shared_array_kernel_ArrayKernel_HF_FP16:
+            op = ElementOps::heSelect<HALF_FP16_MANTISSA, HALF_FP16_BIAS>(type);
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HF_BF16:
+            op = ElementOps::heSelect<HALF_BF16_MANTISSA, HALF_BF16_BIAS>(type);
+            break;
+
+        default:
+            throw std::runtime_error("Format not recognized");
+        }
+
+        ArrayPinHandler lhsVh(env, lhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler rhsVh(env, rhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        op((const jshort *) lhsVh.get(), (const jshort *) rhsVh.get(), (jshort *) dstVh.get(), len);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+jdouble ElementOps::haOp(JNIEnv *env, jobject thisObj, jint type, jint format, //
+        jshortArray srcV) {
+
+    jdouble res = 0.0;
+
+    try {
+
+        if (!srcV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(srcV);
+
+        haOp_t *op = NULL;
+
+        switch (format) {
+
+        case org_shared_array_kernel_ArrayKernel_HF_FP16:
+            op = ElementOps::haSelect<HALF_FP16_MANTISSA, HALF_FP16_BIAS>(type);
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HF_BF16:
+            op = ElementOps::haSelect<HALF_BF16_MANTISSA, HALF_BF16_BIAS>(type);
+            break;
+
+        default:
+            throw std::runtime_error("Format not recognized");
+        }
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        // NO JNI AFTER THIS POINT!
+
+        res = op((const jshort *) srcVh.get(), len);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return res;
+}
+
+template<jint M, jint B> inline void ElementOps::halfConvertProxy(const jdouble *src, jshort *dst, jint len) {
+
+    for (jint i = 0; i < len; i++) {
+        dst[i] = Common::toHalf<M, B>(src[i]);
+    }
+}
+
+template<jint M, jint B> inline void ElementOps::halfExpandProxy(const jshort *src, jdouble *dst, jint len) {
+
+    for (jint i = 0; i < len; i++) {
+        dst[i] = (jdouble) Common::fromHalf<M, B>(src[i]);
+    }
+}
+
+template<jint M, jint B> inline ElementOps::heOp_t *ElementOps::heSelect(jint type) {
+
+    switch (type) {
+
+    case org_shared_array_kernel_ArrayKernel_RE_ADD:
+        return &ElementOps::heProxy<org_shared_array_kernel_ArrayKernel_RE_ADD, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RE_SUB:
+        return &ElementOps::heProxy<org_shared_array_kernel_ArrayKernel_RE_SUB, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RE_MUL:
+        return &ElementOps::heProxy<org_shared_array_kernel_ArrayKernel_RE_MUL, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RE_DIV:
+        return &ElementOps::heProxy<org_shared_array_kernel_ArrayKernel_RE_DIV, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RE_MAX:
+        return &ElementOps::heProxy<org_shared_array_kernel_ArrayKernel_RE_MAX, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RE_MIN:
+        return &ElementOps::heProxy<org_shared_array_kernel_ArrayKernel_RE_MIN, M, B>;
+
+    default:
+        throw std::runtime_error("Operation type not recognized");
+    }
+}
+
+template<jint C, jint M, jint B> inline void ElementOps::heProxy(const jshort *lhs, const jshort *rhs, //
+        jshort *dst, jint len) {
+
+    for (jint i = 0; i < len; i++) {
+
+        jfloat a = Common::fromHalf<M, B>(lhs[i]);
+        jfloat b = Common::fromHalf<M, B>(rhs[i]);
+        jfloat r;
+
+        // The switch resolves at compile time. Single precision has more than twice the mantissa bits of either
+        // format, so rounding the single precision result again on store is as good as rounding the exact one.
+        switch (C) {
+
+        case org_shared_array_kernel_ArrayKernel_RE_ADD:
+            r = a + b;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RE_SUB:
+            r = a - b;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RE_MUL:
+            r = a * b;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RE_DIV:
+            r = a / b;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RE_MAX:
+            r = std::max<jfloat>(a, b);
+            break;
+
+        default:
+            r = std::min<jfloat>(a, b);
+            break;
+        }
+
+        dst[i] = Common::toHalf<M, B>((jdouble) r);
+    }
+}
+
+template<jint M, jint B> inline ElementOps::haOp_t *ElementOps::haSelect(jint type) {
+
+    switch (type) {
+
+    case org_shared_array_kernel_ArrayKernel_RA_SUM:
+        return &ElementOps::haProxy<org_shared_array_kernel_ArrayKernel_RA_SUM, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RA_MAX:
+        return &ElementOps::haProxy<org_shared_array_kernel_ArrayKernel_RA_MAX, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RA_MIN:
+        return &ElementOps::haProxy<org_shared_array_kernel_ArrayKernel_RA_MIN, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RA_NORM1:
+        return &ElementOps::haProxy<org_shared_array_kernel_ArrayKernel_RA_NORM1, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RA_NORM2:
+        return &ElementOps::haProxy<org_shared_array_kernel_ArrayKernel_RA_NORM2, M, B>;
+
+    case org_shared_array_kernel_ArrayKernel_RA_NORMINF:
+        return &ElementOps::haProxy<org_shared_array_kernel_ArrayKernel_RA_NORMINF, M, B>;
+
+    default:
+        throw std::runtime_error("Operation type not recognized");
+    }
+}
+
+template<jint C, jint M, jint B> inline jdouble ElementOps::haProxy(const jshort *src, jint len) {
+
+    jdouble acc;
+
+    switch (C) {
+
+    case org_shared_array_kernel_ArrayKernel_RA_MAX:
+        acc = -java_lang_Double_MAX_VALUE;
+        break;
+
+    case org_shared_array_kernel_ArrayKernel_RA_MIN:
+        acc = java_lang_Double_MAX_VALUE;
+        break;
+
+    default:
+        acc = 0.0;
+        break;
+    }
+
+    for (jint i = 0; i < len; i++) {
+
+        jdouble v = (jdouble) Common::fromHalf<M, B>(src[i]);
+
+        switch (C) {
+
+        case org_shared_array_kernel_ArrayKernel_RA_SUM:
+            acc += v;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RA_MAX:
+            acc = std::max<jdouble>(acc, v);
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RA_MIN:
+            acc = std::min<jdouble>(acc, v);
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RA_NORM1:
+            acc += std::fabs(v);
+            break;
+
+        // Squares of half-precision magnitudes lie well within double precision range, so plain sums suffice.
+        case org_shared_array_kernel_ArrayKernel_RA_NORM2:
+            acc += v * v;
+            break;
+
+        default:
+
+            // NaNs propagate.
+            v = std::fabs(v);
+            acc = (v > acc || v != v) ? v : acc;
+            break;
+        }
+    }
+
+    return (C == org_shared_array_kernel_ArrayKernel_RA_NORM2) ? sqrt(acc) : acc;
+}
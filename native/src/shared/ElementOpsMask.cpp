@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <ElementOps.hpp>
+
+// The number of mask bits packed into a word.
+#define MASK_WORD_BITS 64
+
+// Computes the number of words needed to pack the given number of bits, without overflowing.
+#define MASK_WORDS(len) (((len) >> 6) + (((len) & (MASK_WORD_BITS - 1)) != 0))
+
+// The unsigned type in which words are assembled and taken apart, so that shifts into the top bit are well defined.
+typedef unsigned long long mask_word;
+
+void ElementOps::rcOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray lhsV, jdoubleArray rhsV, jdouble a, jlongArray dstV) {
+
+    try {
+
+        if (!lhsV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(lhsV);
+
+        if ((rhsV && env->GetArrayLength(rhsV) != len) || env->GetArrayLength(dstV) != MASK_WORDS(len)) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        bool scalar = !rhsV;
+
+        void (*op)(const jdouble *, const jdouble *, jlong *, jint) = NULL;
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_RC_LT:
+            op = scalar ? &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_LT, true> //
+                    : &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_LT, false>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RC_LE:
+            op = scalar ? &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_LE, true> //
+                    : &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_LE, false>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RC_EQ:
+            op = scalar ? &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_EQ, true> //
+                    : &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_EQ, false>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RC_NE:
+            op = scalar ? &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_NE, true> //
+                    : &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_NE, false>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RC_GT:
+            op = scalar ? &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_GT, true> //
+                    : &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_GT, false>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RC_GE:
+            op = scalar ? &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_GE, true> //
+                    : &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_GE, false>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_RC_NAN:
+            op = &ElementOps::compareProxy<org_shared_array_kernel_ArrayKernel_RC_NAN, true>;
+            scalar = true;
+            break;
+
+        default:
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        if (scalar) {
+
+            ArrayPinHandler lhsVh(env, lhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            op((const jdouble *) lhsVh.get(), &a, (jlong *) dstVh.get(), len);
+
+        } else {
+
+            ArrayPinHandler lhsVh(env, lhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler rhsVh(env, rhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            op((const jdouble *) lhsVh.get(), (const jdouble *) rhsVh.get(), (jlong *) dstVh.get(), len);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void ElementOps::mlOp(JNIEnv *env, jobject thisObj, jint type, //
+        jlongArray lhsV, jlongArray rhsV, jlongArray dstV, jint len) {
+
+    try {
+
+        bool unary = (type == org_shared_array_kernel_ArrayKernel_ML_NOT);
+
+        if (!lhsV || (!unary && !rhsV) || !dstV || len < 0) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nWords = MASK_WORDS(len);
+
+        if (env->GetArrayLength(lhsV) != nWords || (!unary && env->GetArrayLength(rhsV) != nWords)
+                || env->GetArrayLength(dstV) != nWords) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        // Proceed only if nonzero length.
+        if (!nWords) {
+            return;
+        }
+
+        ArrayPinHandler lhsVh(env, lhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler rhsVh(env, unary ? lhsV : rhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        const jlong *lhsVArr = (const jlong *) lhsVh.get();
+        const jlong *rhsVArr = (const jlong *) rhsVh.get();
+        jlong *dstVArr = (jlong *) dstVh.get();
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_ML_AND:
+
+            for (jint i = 0; i < nWords; i++) {
+                dstVArr[i] = lhsVArr[i] & rhsVArr[i];
+            }
+
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_ML_OR:
+
+            for (jint i = 0; i < nWords; i++) {
+                dstVArr[i] = lhsVArr[i] | rhsVArr[i];
+            }
+
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_ML_XOR:
+
+            for (jint i = 0; i < nWords; i++) {
+                dstVArr[i] = lhsVArr[i] ^ rhsVArr[i];
+            }
+
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_ML_ANDNOT:
+
+            for (jint i = 0; i < nWords; i++) {
+                dstVArr[i] = lhsVArr[i] & ~rhsVArr[i];
+            }
+
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_ML_NOT:
+
+            for (jint i = 0; i < nWords; i++) {
+                dstVArr[i] = ~lhsVArr[i];
+            }
+
+            break;
+
+        default:
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        // Keep the bits past the end cleared.
+        jint nTrailingBits = len & (MASK_WORD_BITS - 1);
+
+        if (nTrailingBits) {
+            dstVArr[nWords - 1] &= (jlong) (((mask_word) 1 << nTrailingBits) - 1);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void ElementOps::select(JNIEnv *env, jobject thisObj, //
+        jlongArray maskV, jobject lhsV, jobject rhsV, jobject dstV) {
+
+    try {
+
+        if (!maskV || !lhsV || !rhsV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        bool isDouble = NativeArrayKernel::isJdoubleArray(env, lhsV) //
+                && NativeArrayKernel::isJdoubleArray(env, rhsV) //
+                && NativeArrayKernel::isJdoubleArray(env, dstV);
+
+        bool isInt = NativeArrayKernel::isJintArray(env, lhsV) //
+                && NativeArrayKernel::isJintArray(env, rhsV) //
+                && NativeArrayKernel::isJintArray(env, dstV);
+
+        if (!isDouble && !isInt) {
+            throw std::runtime_error("Invalid array types");
+        }
+
+        jint len = env->GetArrayLength((jarray) dstV);
+
+        if (env->GetArrayLength((jarray) lhsV) != len || env->GetArrayLength((jarray) rhsV) != len
+                || env->GetArrayLength(maskV) != MASK_WORDS(len)) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        ArrayPinHandler maskVh(env, maskV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler lhsVh(env, (jarray) lhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler rhsVh(env, (jarray) rhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        if (isDouble) {
+
+            ElementOps::selectProxy<jdouble>((const jlong *) maskVh.get(), //
+                    (const jdouble *) lhsVh.get(), (const jdouble *) rhsVh.get(), (jdouble *) dstVh.get(), len);
+
+        } else {
+
+            ElementOps::selectProxy<jint>((const jlong *) maskVh.get(), //
+                    (const jint *) lhsVh.get(), (const jint *) rhsVh.get(), (jint *) dstVh.get(), len);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void ElementOps::maskedFill(JNIEnv *env, jobject thisObj, //
+        jlongArray maskV, jdouble a, jdoubleArray dstV) {
+
+    try {
+
+        if (!maskV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(dstV);
+
+        if (env->GetArrayLength(maskV) != MASK_WORDS(len)) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        ArrayPinHandler maskVh(env, maskV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        const jlong *maskVArr = (const jlong *) maskVh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        for (jint offset = 0, w = 0; offset < len; offset += MASK_WORD_BITS, w++) {
+
+            mask_word bits = (mask_word) maskVArr[w];
+
+            // Skip words with no bits set.
+            if (!bits) {
+                continue;
+            }
+
+            jint size = std::min(len - offset, (jint) MASK_WORD_BITS);
+
+            jdouble *dst = dstVArr + offset;
+
+            for (jint k = 0; k < size; k++) {
+
+                jdouble values[] = { dst[k], a };
+
+                dst[k] = values[(bits >> k) & 1];
+            }
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+template<jint C, bool S> inline void ElementOps::compareProxy(const jdouble *lhs, const jdouble *rhs, //
+        jlong *dst, jint len) {
+
+    jint nFullWords = len >> 6;
+
+    // Pack whole words with fixed trip counts, so that the comparisons vectorize.
+    for (jint w = 0; w < nFullWords; w++) {
+
+        const jdouble *x = lhs + (w << 6);
+        const jdouble *y = S ? rhs : rhs + (w << 6);
+
+        mask_word bits = 0;
+
+        for (jint k = 0; k < MASK_WORD_BITS; k++) {
+            bits |= ((mask_word) ElementOps::compare<C>(x[k], S ? y[0] : y[k])) << k;
+        }
+
+        dst[w] = (jlong) bits;
+    }
+
+    jint offset = nFullWords << 6;
+
+    if (offset < len) {
+
+        const jdouble *x = lhs + offset;
+        const jdouble *y = S ? rhs : rhs + offset;
+
+        mask_word bits = 0;
+
+        for (jint k = 0, size = len - offset; k < size; k++) {
+            bits |= ((mask_word) ElementOps::compare<C>(x[k], S ? y[0] : y[k])) << k;
+        }
+
+        dst[nFullWords] = (jlong) bits;
+    }
+}
+
+template<jint C> inline bool ElementOps::compare(jdouble x, jdouble y) {
+
+    switch (C) {
+
+    case org_shared_array_kernel_ArrayKernel_RC_LT:
+        return x < y;
+
+    case org_shared_array_kernel_ArrayKernel_RC_LE:
+        return x <= y;
+
+    case org_shared_array_kernel_ArrayKernel_RC_EQ:
+        return x == y;
+
+    case org_shared_array_kernel_ArrayKernel_RC_NE:
+        return x != y;
+
+    case org_shared_array_kernel_ArrayKernel_RC_GT:
+        return x > y;
+
+    case org_shared_array_kernel_ArrayKernel_RC_GE:
+        return x >= y;
+
+    default:
+        return x != x;
+    }
+}
+
+template<class T> inline void ElementOps::selectProxy(const jlong *mask, const T *lhs, const T *rhs, T *dst, //
+        jint len) {
+
+    for (jint offset = 0, w = 0; offset < len; offset += MASK_WORD_BITS, w++) {
+
+        mask_word bits = (mask_word) mask[w];
+        jint size = std::min(len - offset, (jint) MASK_WORD_BITS);
+
+        // Copy whole runs when a word's bits agree.
+        if (bits == 0 || (bits == ~(mask_word) 0 && size == MASK_WORD_BITS)) {
+
+            const T *src = (bits ? lhs : rhs) + offset;
+
+            if (src != dst + offset) {
+                memcpy(dst + offset, src, sizeof(T) * size);
+            }
+
+            continue;
+        }
+
+        // Index into the sources by mask bit, which avoids mispredicted branches on mixed words.
+        const T *srcs[] = { rhs + offset, lhs + offset };
+
+        for (jint k = 0; k < size; k++) {
+            dst[offset + k] = srcs[(bits >> k) & 1][k];
+        }
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <IndexOps.hpp>
+
+jintArray IndexOps::lttb(JNIEnv *env, jobject thisObj, //
+        jdoubleArray xV, jdoubleArray yV, jint nPoints) {
+
+    jintArray res = NULL;
+
+    try {
+
+        if (!xV || !yV || nPoints < 3) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint n = env->GetArrayLength(xV);
+
+        if (env->GetArrayLength(yV) != n) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        jint nOut = std::min(n, nPoints);
+
+        res = Common::newIntArray(env, nOut);
+
+        ArrayPinHandler xVh(env, xV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler yVh(env, yV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler resH(env, res, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        const jdouble *x = (const jdouble *) xVh.get();
+        const jdouble *y = (const jdouble *) yVh.get();
+        jint *indices = (jint *) resH.get();
+
+        if (nOut == n) {
+
+            for (jint i = 0; i < n; i++) {
+                indices[i] = i;
+            }
+
+            return res;
+        }
+
+        jint nBuckets = nOut - 2;
+        jint a = 0;
+
+        indices[0] = 0;
+
+        for (jint bucket = 0; bucket < nBuckets; bucket++) {
+
+            // The buckets evenly divide the points strictly between the first and the last.
+            jint start = 1 + (jint) (((jlong) bucket * (n - 2)) / nBuckets);
+            jint end = 1 + (jint) (((jlong) (bucket + 1) * (n - 2)) / nBuckets);
+            jint nextEnd = std::min(1 + (jint) (((jlong) (bucket + 2) * (n - 2)) / nBuckets), n);
+
+            // Average the next bucket, which for the last bucket is just the last point.
+            jdouble xAvg = 0.0;
+            jdouble yAvg = 0.0;
+            jint count = 0;
+
+            for (jint i = end; i < nextEnd; i++) {
+
+                // Skip NaN coordinates, which would otherwise poison the average.
+                if (x[i] == x[i] && y[i] == y[i]) {
+
+                    xAvg += x[i];
+                    yAvg += y[i];
+                    count++;
+                }
+            }
+
+            xAvg /= count;
+            yAvg /= count;
+
+            jdouble xA = x[a];
+            jdouble yA = y[a];
+
+            jdouble maxArea = -1.0;
+            jint best = start;
+
+            for (jint i = start; i < end; i++) {
+
+                // Twice the triangle area; NaNs never compare greater, so that they're kept only as a last resort.
+                jdouble area = std::fabs((xA - xAvg) * (y[i] - yA) - (xA - x[i]) * (yAvg - yA));
+
+                if (area > maxArea) {
+
+                    maxArea = area;
+                    best = i;
+                }
+            }
+
+            indices[bucket + 1] = best;
+            a = best;
+        }
+
+        indices[nOut - 1] = n - 1;
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return res;
+}
+
+jintArray IndexOps::thin(JNIEnv *env, jobject thisObj, //
+        jdoubleArray xV, jdoubleArray yV, jdoubleArray boundsV, jint nX, jint nY) {
+
+    jintArray res = NULL;
+
+    try {
+
+        if (!xV || !yV || !boundsV || nX < 1 || nY < 1 || (jlong) nX * nY > 0x7FFFFFFF) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint n = env->GetArrayLength(xV);
+
+        if (env->GetArrayLength(yV) != n || env->GetArrayLength(boundsV) != 4) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        jint nCells = nX * nY;
+        jint nWords = (jint) (((jlong) nCells + 31) / 32);
+        jint nKeptMax = std::min(n, nCells);
+
+        MallocHandler mallocH(sizeof(unsigned int) * nWords + sizeof(jint) * nKeptMax);
+        unsigned int *occupied = (unsigned int *) mallocH.get();
+        jint *kept = (jint *) (occupied + nWords);
+
+        memset(occupied, 0, sizeof(unsigned int) * nWords);
+
+        jint nKept = 0;
+
+        {
+            ArrayPinHandler xVh(env, xV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler yVh(env, yV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler boundsVh(env, boundsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            // NO JNI AFTER THIS POINT!
+
+            const jdouble *x = (const jdouble *) xVh.get();
+            const jdouble *y = (const jdouble *) yVh.get();
+            const jdouble *bounds = (const jdouble *) boundsVh.get();
+
+            jdouble xMin = bounds[0];
+            jdouble xMax = bounds[1];
+            jdouble yMin = bounds[2];
+            jdouble yMax = bounds[3];
+
+            // The ranges must be nonempty and finite.
+            if (!(xMin < xMax) || !(xMax - xMin <= std::numeric_limits<jdouble>::max()) //
+                    || !(yMin < yMax) || !(yMax - yMin <= std::numeric_limits<jdouble>::max())) {
+                throw std::runtime_error("Invalid arguments");
+            }
+
+            jdouble xScale = nX / (xMax - xMin);
+            jdouble yScale = nY / (yMax - yMin);
+
+            for (jint i = 0; i < n && nKept < nCells; i++) {
+
+                jdouble tx = (x[i] - xMin) * xScale;
+                jdouble ty = (y[i] - yMin) * yScale;
+
+                // Drop NaNs and points outside of the bounds.
+                if (!(tx >= 0.0 && tx <= nX && ty >= 0.0 && ty <= nY)) {
+                    continue;
+                }
+
+                jint cell = std::min((jint) ty, nY - 1) * nX + std::min((jint) tx, nX - 1);
+                unsigned int mask = 1U << (cell & 31);
+
+                if (!(occupied[cell >> 5] & mask)) {
+
+                    occupied[cell >> 5] |= mask;
+                    kept[nKept++] = i;
+                }
+            }
+        }
+
+        res = Common::newIntArray(env, nKept);
+
+        ArrayPinHandler resH(env, res, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        memcpy((jint *) resH.get(), kept, sizeof(jint) * nKept);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return res;
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <IndexOps.hpp>
+
+// The number of interleaved count arrays for fixed bins, which keeps runs of equal bins from stalling on one counter.
+#define HISTOGRAM_N_LANES 4
+
+// The number of coarse buckets that narrow down the search for quantiles.
+#define QUANTILE_N_BUCKETS 65536
+
+void IndexOps::histogram(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jdouble min, jdouble max, jdoubleArray edgesV, jdoubleArray dstV) {
+
+    try {
+
+        if (!srcV || !edgesV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint len = env->GetArrayLength(srcV);
+        jint nBins = env->GetArrayLength(dstV);
+        jint nEdges = env->GetArrayLength(edgesV);
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_HI_FIXED:
+        case org_shared_array_kernel_ArrayKernel_HI_LINEAR:
+
+            // The range must be nonempty and finite.
+            if (!(min < max) || !(max - min <= std::numeric_limits<jdouble>::max())) {
+                throw std::runtime_error("Invalid arguments");
+            }
+
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HI_QUANTILE:
+            break;
+
+        default:
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        bool linear = (type == org_shared_array_kernel_ArrayKernel_HI_LINEAR);
+
+        if (nBins < (linear ? 2 : 1) || nEdges != (linear ? nBins : nBins + 1)) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_HI_FIXED:
+
+        {
+            MallocHandler countsH(sizeof(jint) * HISTOGRAM_N_LANES * nBins);
+            jint *counts = (jint *) countsH.get();
+
+            memset(counts, 0, sizeof(jint) * HISTOGRAM_N_LANES * nBins);
+
+            ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler edgesVh(env, edgesV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            const jdouble *src = (const jdouble *) srcVh.get();
+            jdouble *edges = (jdouble *) edgesVh.get();
+            jdouble *dst = (jdouble *) dstVh.get();
+
+            jdouble scale = nBins / (max - min);
+
+            for (jint i = 0; i < len; i++) {
+
+                jdouble t = (src[i] - min) * scale;
+
+                // Skip NaNs, and send values outside of the range to the nearest bin.
+                if (t != t) {
+                    continue;
+                }
+
+                jint bin = (t < 0.0) ? 0 : (t >= nBins) ? nBins - 1 : (jint) t;
+
+                counts[bin * HISTOGRAM_N_LANES + (i & (HISTOGRAM_N_LANES - 1))]++;
+            }
+
+            for (jint bin = 0; bin < nBins; bin++) {
+
+                jint *binCounts = counts + bin * HISTOGRAM_N_LANES;
+
+                jdouble count = 0.0;
+
+                for (jint lane = 0; lane < HISTOGRAM_N_LANES; lane++) {
+                    count += binCounts[lane];
+                }
+
+                dst[bin] = count;
+                edges[bin] = min + (max - min) * ((jdouble) bin / nBins);
+            }
+
+            edges[nBins] = max;
+        }
+
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HI_QUANTILE:
+
+        {
+            MallocHandler mallocH(sizeof(jint) * (2 * QUANTILE_N_BUCKETS + 1 + 2 * (nBins + 1)));
+            jint *prefix = (jint *) mallocH.get();
+            jint *cursors = prefix + QUANTILE_N_BUCKETS + 1;
+            jint *rankBuckets = cursors + QUANTILE_N_BUCKETS;
+            jint *nBelow = rankBuckets + nBins + 1;
+
+            ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler edgesVh(env, edgesV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            const jdouble *src = (const jdouble *) srcVh.get();
+            jdouble *edges = (jdouble *) edgesVh.get();
+            jdouble *dst = (jdouble *) dstVh.get();
+
+            std::fill(dst, dst + nBins, 0.0);
+
+            // Find the range of the finite values, and skip NaNs.
+            jint nValues = 0;
+            jdouble lower = std::numeric_limits<jdouble>::infinity();
+            jdouble upper = -std::numeric_limits<jdouble>::infinity();
+
+            for (jint i = 0; i < len; i++) {
+
+                jdouble value = src[i];
+
+                if (value != value) {
+                    continue;
+                }
+
+                nValues++;
+
+                if (std::fabs(value) <= std::numeric_limits<jdouble>::max()) {
+
+                    lower = std::min(lower, value);
+                    upper = std::max(upper, value);
+                }
+            }
+
+            if (!nValues) {
+
+                std::fill(edges, edges + nBins + 1, std::numeric_limits<jdouble>::quiet_NaN());
+
+                break;
+            }
+
+            // Halve before subtracting, so that the span doesn't overflow.
+            jdouble scale = (lower < upper) ? QUANTILE_N_BUCKETS / (0.5 * upper - 0.5 * lower) : 0.0;
+
+            // Count the values in evenly spaced coarse buckets, whose order agrees with that of the values.
+            std::fill(prefix, prefix + QUANTILE_N_BUCKETS + 1, 0);
+
+            for (jint i = 0; i < len; i++) {
+
+                jdouble value = src[i];
+
+                if (value == value) {
+                    prefix[IndexOps::quantileBucket(value, lower, scale) + 1]++;
+                }
+            }
+
+            for (jint b = 0; b < QUANTILE_N_BUCKETS; b++) {
+                prefix[b + 1] += prefix[b];
+            }
+
+            // Find the buckets that hold the order statistics at evenly spaced ranks.
+            std::fill(cursors, cursors + QUANTILE_N_BUCKETS, -1);
+
+            jint nGathered = 0;
+
+            for (jint k = 0; k <= nBins; k++) {
+
+                jint rank = (jint) (((jlong) k * (nValues - 1)) / nBins);
+                jint b = (jint) (std::upper_bound(prefix, prefix + QUANTILE_N_BUCKETS + 1, rank) - prefix) - 1;
+
+                if (cursors[b] < 0) {
+
+                    cursors[b] = nGathered;
+                    nGathered += prefix[b + 1] - prefix[b];
+                }
+
+                rankBuckets[k] = b;
+            }
+
+            // Gather and sort the contents of only those buckets.
+            MallocHandler gatheredH(sizeof(jdouble) * nGathered);
+            jdouble *gathered = (jdouble *) gatheredH.get();
+
+            for (jint i = 0; i < len; i++) {
+
+                jdouble value = src[i];
+
+                if (value == value) {
+
+                    jint b = IndexOps::quantileBucket(value, lower, scale);
+
+                    if (cursors[b] >= 0) {
+                        gathered[cursors[b]++] = value;
+                    }
+                }
+            }
+
+            for (jint k = 0; k <= nBins; k++) {
+
+                jint b = rankBuckets[k];
+
+                // The cursors now point past the ends of their buckets.
+                jdouble *end = gathered + cursors[b];
+                jdouble *start = end - (prefix[b + 1] - prefix[b]);
+
+                if (k == 0 || rankBuckets[k - 1] != b) {
+                    std::sort(start, end);
+                }
+
+                jint rank = (jint) (((jlong) k * (nValues - 1)) / nBins);
+
+                edges[k] = start[rank - prefix[b]];
+                nBelow[k] = prefix[b] + (jint) (std::lower_bound(start, end, edges[k]) - start);
+            }
+
+            // Every bin holds the values at or above its lower edge and below its upper edge, and the last bin holds
+            // the values at its upper edge too.
+            for (jint bin = 0; bin < nBins - 1; bin++) {
+                dst[bin] = nBelow[bin + 1] - nBelow[bin];
+            }
+
+            dst[nBins - 1] = nValues - nBelow[nBins - 1];
+        }
+
+            break;
+
+        default:
+
+        {
+            ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler edgesVh(env, edgesV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            const jdouble *src = (const jdouble *) srcVh.get();
+            jdouble *edges = (jdouble *) edgesVh.get();
+            jdouble *dst = (jdouble *) dstVh.get();
+
+            std::fill(dst, dst + nBins, 0.0);
+
+            jint last = nBins - 1;
+            jdouble scale = last / (max - min);
+
+            for (jint i = 0; i < len; i++) {
+
+                jdouble t = (src[i] - min) * scale;
+
+                // Skip NaNs, and send values outside of the grid to the nearest end.
+                if (t != t) {
+
+                    continue;
+
+                } else if (t <= 0.0) {
+
+                    dst[0] += 1.0;
+
+                } else if (t >= last) {
+
+                    dst[last] += 1.0;
+
+                } else {
+
+                    // Split the unit weight between the two nearest grid points.
+                    jint j = (jint) t;
+                    jdouble frac = t - j;
+
+                    dst[j] += 1.0 - frac;
+                    dst[j + 1] += frac;
+                }
+            }
+
+            for (jint j = 0; j < last; j++) {
+                edges[j] = min + (max - min) * ((jdouble) j / last);
+            }
+
+            edges[last] = max;
+        }
+
+            break;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+inline jint IndexOps::quantileBucket(jdouble value, jdouble lower, jdouble scale) {
+
+    jdouble t = (0.5 * value - 0.5 * lower) * scale;
+
+    // Infinities go to the end buckets, even when all finite values coincide.
+    return (t >= QUANTILE_N_BUCKETS || value == std::numeric_limits<jdouble>::infinity()) ? QUANTILE_N_BUCKETS - 1 //
+            : (t > 0.0) ? (jint) t : 0;
+}
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <IndexOps.hpp>
+
+// The number of queries that descend the edges in lockstep, so that their memory accesses overlap.
+#define SEARCH_BLOCK_SIZE 16
+
+// The number of queries whose insertion indices are buffered at once during interpolation.
+#define INTERPOLATION_BLOCK_SIZE 256
+
+void IndexOps::searchSorted(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray edges, jdoubleArray srcV, jintArray dstV) {
+
+    try {
+
+        if (!edges || !srcV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nEdges = env->GetArrayLength(edges);
+        jint len = env->GetArrayLength(srcV);
+
+        if (len != env->GetArrayLength(dstV)) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (type != org_shared_array_kernel_ArrayKernel_SS_LEFT //
+                && type != org_shared_array_kernel_ArrayKernel_SS_RIGHT) {
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        ArrayPinHandler edgesH(env, edges, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        const jdouble *edgesArr = (const jdouble *) edgesH.get();
+        const jdouble *srcVArr = (const jdouble *) srcVh.get();
+        jint *dstVArr = (jint *) dstVh.get();
+
+        if (type == org_shared_array_kernel_ArrayKernel_SS_LEFT) {
+            IndexOps::searchSortedProxy<false>(edgesArr, nEdges, srcVArr, dstVArr, len);
+        } else {
+            IndexOps::searchSortedProxy<true>(edgesArr, nEdges, srcVArr, dstVArr, len);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void IndexOps::interpolate(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray xV, jdoubleArray yV, jdoubleArray srcV, jdoubleArray dstV) {
+
+    try {
+
+        if (!xV || !yV || !srcV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint n = env->GetArrayLength(xV);
+        jint len = env->GetArrayLength(srcV);
+
+        if (n != env->GetArrayLength(yV) || len != env->GetArrayLength(dstV)) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (n < 1) {
+            throw std::runtime_error("There must be at least one breakpoint");
+        }
+
+        bool cubic;
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_IN_LINEAR:
+            cubic = false;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_IN_MONOTONE_CUBIC:
+            cubic = true;
+            break;
+
+        default:
+            throw std::runtime_error("Interpolation type not recognized");
+        }
+
+        MallocHandler mallocH(sizeof(jdouble) * (cubic ? n : 0));
+        jdouble *slopes = (jdouble *) mallocH.get();
+
+        ArrayPinHandler xVh(env, xV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler yVh(env, yV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        const jdouble *xVArr = (const jdouble *) xVh.get();
+        const jdouble *yVArr = (const jdouble *) yVh.get();
+        const jdouble *srcVArr = (const jdouble *) srcVh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        for (jint i = 0; i < n - 1; i++) {
+
+            if (!(xVArr[i] < xVArr[i + 1])) {
+                throw std::runtime_error("Breakpoint abscissas must be strictly increasing");
+            }
+        }
+
+        if (cubic) {
+            IndexOps::monotoneSlopes(xVArr, yVArr, slopes, n);
+        }
+
+        jdouble lower = xVArr[0];
+        jdouble upper = xVArr[n - 1];
+
+        jint indices[INTERPOLATION_BLOCK_SIZE];
+
+        for (jint offset = 0; offset < len; offset += INTERPOLATION_BLOCK_SIZE) {
+
+            jint blockSize = std::min(len - offset, (jint) INTERPOLATION_BLOCK_SIZE);
+
+            const jdouble *queries = srcVArr + offset;
+            jdouble *values = dstVArr + offset;
+
+            IndexOps::searchSortedProxy<true>(xVArr, n, queries, indices, blockSize);
+
+            for (jint i = 0; i < blockSize; i++) {
+
+                jdouble query = queries[i];
+
+                // Queries outside of the breakpoints take on the nearest endpoint value.
+                if (query != query) {
+
+                    values[i] = query;
+
+                    continue;
+
+                } else if (query <= lower) {
+
+                    values[i] = yVArr[0];
+
+                    continue;
+
+                } else if (query >= upper) {
+
+                    values[i] = yVArr[n - 1];
+
+                    continue;
+                }
+
+                jint j = indices[i] - 1;
+
+                jdouble h = xVArr[j + 1] - xVArr[j];
+                jdouble t = (query - xVArr[j]) / h;
+
+                jdouble y0 = yVArr[j];
+                jdouble y1 = yVArr[j + 1];
+
+                if (!cubic) {
+
+                    values[i] = y0 + t * (y1 - y0);
+
+                } else {
+
+                    // Evaluate the cubic Hermite basis.
+                    jdouble t2 = t * t;
+                    jdouble t3 = t2 * t;
+
+                    values[i] = (2.0 * t3 - 3.0 * t2 + 1.0) * y0 //
+                            + (t3 - 2.0 * t2 + t) * h * slopes[j] //
+                            + (3.0 * t2 - 2.0 * t3) * y1 //
+                            + (t3 - t2) * h * slopes[j + 1];
+                }
+            }
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+template<bool R> inline void IndexOps::searchSortedProxy(const jdouble *edges, jint nEdges, //
+        const jdouble *queries, jint *indices, jint len) {
+
+    // Proceed only if nonzero length.
+    if (!nEdges) {
+
+        for (jint i = 0; i < len; i++) {
+            indices[i] = 0;
+        }
+
+        return;
+    }
+
+    jint i = 0;
+
+    // Descend for a block of queries at a time without branching, so that cache misses overlap.
+    for (; i + SEARCH_BLOCK_SIZE <= len; i += SEARCH_BLOCK_SIZE) {
+
+        const jdouble *blockQueries = queries + i;
+
+        jint bases[SEARCH_BLOCK_SIZE];
+
+        for (jint k = 0; k < SEARCH_BLOCK_SIZE; k++) {
+            bases[k] = 0;
+        }
+
+        for (jint size = nEdges, half; size > 1; size -= half) {
+
+            half = size >> 1;
+
+            for (jint k = 0; k < SEARCH_BLOCK_SIZE; k++) {
+
+                jdouble edge = edges[bases[k] + half];
+
+                bases[k] += (R ? (edge <= blockQueries[k]) : (edge < blockQueries[k])) ? half : 0;
+            }
+        }
+
+        for (jint k = 0; k < SEARCH_BLOCK_SIZE; k++) {
+
+            jdouble edge = edges[bases[k]];
+            jdouble query = blockQueries[k];
+
+            // NaN queries go after all edges.
+            indices[i + k] = (query == query) //
+                    ? bases[k] + (R ? (edge <= query) : (edge < query)) //
+                    : nEdges;
+        }
+    }
+
+    for (; i < len; i++) {
+
+        jdouble query = queries[i];
+
+        jint base = 0;
+
+        for (jint size = nEdges, half; size > 1; size -= half) {
+
+            half = size >> 1;
+
+            base += (R ? (edges[base + half] <= query) : (edges[base + half] < query)) ? half : 0;
+        }
+
+        indices[i] = (query == query) //
+                ? base + (R ? (edges[base] <= query) : (edges[base] < query)) //
+                : nEdges;
+    }
+}
+
+void IndexOps::monotoneSlopes(const jdouble *xV, const jdouble *yV, jdouble *slopes, jint n) {
+
+    if (n == 1) {
+
+        slopes[0] = 0.0;
+
+        return;
+    }
+
+    if (n == 2) {
+
+        slopes[0] = slopes[1] = (yV[1] - yV[0]) / (xV[1] - xV[0]);
+
+        return;
+    }
+
+    // Interior slopes are weighted harmonic means of the secants, and vanish at local extrema (Fritsch-Carlson).
+    for (jint i = 1; i < n - 1; i++) {
+
+        jdouble hPrev = xV[i] - xV[i - 1];
+        jdouble hNext = xV[i + 1] - xV[i];
+
+        jdouble mPrev = (yV[i] - yV[i - 1]) / hPrev;
+        jdouble mNext = (yV[i + 1] - yV[i]) / hNext;
+
+        if (!((mPrev > 0.0 && mNext > 0.0) || (mPrev < 0.0 && mNext < 0.0))) {
+
+            slopes[i] = 0.0;
+
+        } else {
+
+            jdouble w1 = 2.0 * hNext + hPrev;
+            jdouble w2 = hNext + 2.0 * hPrev;
+
+            slopes[i] = (w1 + w2) / (w1 / mPrev + w2 / mNext);
+        }
+    }
+
+    // End slopes come from one-sided three-point estimates, limited to preserve monotonicity.
+    for (jint end = 0; end < 2; end++) {
+
+        jint i = end ? n - 1 : 0;
+        jint di = end ? -1 : 1;
+
+        jdouble h0 = fabs(xV[i + di] - xV[i]);
+        jdouble h1 = fabs(xV[i + 2 * di] - xV[i + di]);
+
+        jdouble m0 = (yV[i + di] - yV[i]) / (xV[i + di] - xV[i]);
+        jdouble m1 = (yV[i + 2 * di] - yV[i + di]) / (xV[i + 2 * di] - xV[i + di]);
+
+        jdouble slope = ((2.0 * h0 + h1) * m0 - h0 * m1) / (h0 + h1);
+
+        if ((slope > 0.0) != (m0 > 0.0) || (slope < 0.0) != (m0 < 0.0)) {
+
+            slope = 0.0;
+
+        } else if (((m0 > 0.0) != (m1 > 0.0) || (m0 < 0.0) != (m1 < 0.0)) && fabs(slope) > fabs(3.0 * m0)) {
+
+            slope = 3.0 * m0;
+        }
+
+        slopes[i] = slope;
+    }
+}
@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <IndexOps.hpp>
+
+// The number of key bits sorted per radix pass.
+#define RADIX_BITS 11
+
+// The number of buckets per radix pass.
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+// The number of radix passes needed to sort keys of the given type.
+#define RADIX_PASSES(K) ((jint) ((8 * sizeof(K) + RADIX_BITS - 1) / RADIX_BITS))
+
+jintArray IndexOps::sortRows(JNIEnv *env, jobject thisObj, //
+        jobject srcV, jintArray srcD, jintArray srcS) {
+
+    jintArray res = NULL;
+
+    try {
+
+        jint nRows, nCols, rowStride, colStride;
+
+        ArrayPinHandler::jarray_type type = IndexOps::getRowLayout(env, srcV, srcD, srcS, //
+                &nRows, &nCols, &rowStride, &colStride);
+
+        MallocHandler permH(sizeof(jint) * nRows);
+        jint *perm = (jint *) permH.get();
+
+        IndexOps::sortRowsProxy(env, type, srcV, nRows, nCols, rowStride, colStride, perm);
+
+        res = Common::newIntArray(env, nRows);
+
+        ArrayPinHandler resH(env, res, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        memcpy((jint *) resH.get(), perm, sizeof(jint) * nRows);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return res;
+}
+
+jintArray IndexOps::unique(JNIEnv *env, jobject thisObj, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jintArray inverse, jintArray counts) {
+
+    jintArray res = NULL;
+
+    try {
+
+        jint nRows, nCols, rowStride, colStride;
+
+        ArrayPinHandler::jarray_type type = IndexOps::getRowLayout(env, srcV, srcD, srcS, //
+                &nRows, &nCols, &rowStride, &colStride);
+
+        if (!inverse || !counts) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (env->GetArrayLength(inverse) != nRows || env->GetArrayLength(counts) != nRows) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        MallocHandler mallocH(sizeof(jint) * 4 * nRows);
+        void *all = mallocH.get();
+
+        jint *perm = (jint *) all;
+        jint *inverseArr = (jint *) all + nRows;
+        jint *countsArr = (jint *) all + 2 * nRows;
+        jint *firstsArr = (jint *) all + 3 * nRows;
+
+        IndexOps::sortRowsProxy(env, type, srcV, nRows, nCols, rowStride, colStride, perm);
+
+        jint nUnique = 0;
+
+        if (nRows > 0) {
+
+            ArrayPinHandler srcVh(env, (jarray) srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            // NO JNI AFTER THIS POINT!
+
+            // Equal rows are now adjacent, and the stable sort puts every run's first occurrence up front.
+            for (jint i = 0; i < nRows; i++) {
+
+                bool same = (i > 0);
+
+                jint offset = perm[i] * rowStride;
+                jint prevOffset = same ? perm[i - 1] * rowStride : 0;
+
+                switch (type) {
+
+                case ArrayPinHandler::DOUBLE:
+
+                {
+                    const jdouble *src = (const jdouble *) srcVh.get();
+
+                    for (jint j = 0, k = 0; same && j < nCols; j++, k += colStride) {
+                        same = (IndexOps::doubleKey(src[offset + k]) == IndexOps::doubleKey(src[prevOffset + k]));
+                    }
+                }
+
+                    break;
+
+                default:
+
+                {
+                    const jint *src = (const jint *) srcVh.get();
+
+                    for (jint j = 0, k = 0; same && j < nCols; j++, k += colStride) {
+                        same = (src[offset + k] == src[prevOffset + k]);
+                    }
+                }
+
+                    break;
+                }
+
+                if (!same) {
+
+                    firstsArr[nUnique] = perm[i];
+                    countsArr[nUnique] = 0;
+                    nUnique++;
+                }
+
+                inverseArr[perm[i]] = nUnique - 1;
+                countsArr[nUnique - 1]++;
+            }
+        }
+
+        {
+            ArrayPinHandler inverseH(env, inverse, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            ArrayPinHandler countsH(env, counts, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            memcpy((jint *) inverseH.get(), inverseArr, sizeof(jint) * nRows);
+            memcpy((jint *) countsH.get(), countsArr, sizeof(jint) * nUnique);
+        }
+
+        res = Common::newIntArray(env, nUnique);
+
+        ArrayPinHandler resH(env, res, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        memcpy((jint *) resH.get(), firstsArr, sizeof(jint) * nUnique);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return res;
+}
+
+ArrayPinHandler::jarray_type IndexOps::getRowLayout(JNIEnv *env, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jint *nRows, jint *nCols, jint *rowStride, jint *colStride) {
+
+    if (!srcV || !srcD || !srcS) {
+        throw std::runtime_error("Invalid arguments");
+    }
+
+    ArrayPinHandler::jarray_type type = NativeArrayKernel::getArrayType(env, srcV, srcV);
+
+    if (type == ArrayPinHandler::OBJECT) {
+        throw std::runtime_error("Only integer and real arrays can be sorted");
+    }
+
+    jint srcLen = env->GetArrayLength((jarray) srcV);
+    jint nDims = env->GetArrayLength(srcD);
+
+    if (nDims != env->GetArrayLength(srcS)) {
+        throw std::runtime_error("Invalid arguments");
+    }
+
+    if (!(nDims == 1 || nDims == 2)) {
+        throw std::runtime_error("Array must be one- or two-dimensional");
+    }
+
+    jint dimsArr[2], stridesArr[2];
+
+    {
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+        memcpy(dimsArr, srcDh.get(), sizeof(jint) * nDims);
+        memcpy(stridesArr, srcSh.get(), sizeof(jint) * nDims);
+    }
+
+    MappingOps::checkDimensions(dimsArr, stridesArr, nDims, srcLen);
+
+    // The elements of one-dimensional arrays are rows of their own.
+    *nRows = dimsArr[0];
+    *nCols = (nDims == 2) ? dimsArr[1] : 1;
+    *rowStride = stridesArr[0];
+    *colStride = (nDims == 2) ? stridesArr[1] : 0;
+
+    return type;
+}
+
+jdoubleArray IndexOps::errorCurve(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray scoresV, jbooleanArray outcomesV, jint nPoints, jdoubleArray statsV) {
+
+    jdoubleArray res = NULL;
+
+    try {
+
+        if (!scoresV || !outcomesV || !statsV || (nPoints != 0 && nPoints < 2)) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (type != org_shared_array_kernel_ArrayKernel_EC_ROC && type != org_shared_array_kernel_ArrayKernel_EC_PR) {
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        jint n = env->GetArrayLength(scoresV);
+
+        if (env->GetArrayLength(outcomesV) != n || env->GetArrayLength(statsV) != 2) {
+            throw std::runtime_error("Invalid array lengths");
+        }
+
+        MallocHandler mallocH(sizeof(jlong) * 2 * n + sizeof(jint) * (2 * n + RADIX_SIZE * RADIX_PASSES(jlong)));
+        void *all = mallocH.get();
+
+        jlong *keys = (jlong *) all;
+        jint *labels = (jint *) (keys + 2 * n);
+        jint *histogram = labels + 2 * n;
+
+        jint nPos = 0;
+
+        {
+            ArrayPinHandler scoresVh(env, scoresV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler outcomesVh(env, outcomesV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            // NO JNI AFTER THIS POINT!
+
+            const jdouble *scores = (const jdouble *) scoresVh.get();
+            const jboolean *outcomes = (const jboolean *) outcomesVh.get();
+
+            for (jint i = 0; i < n; i++) {
+
+                jdouble score = scores[i];
+
+                // Negative zero ties with positive zero.
+                if (score == 0.0) {
+                    score = 0.0;
+                }
+
+                // Complemented keys sort in descending order, and NaNs go last.
+                keys[i] = (score != score) ? (jlong) -1 : ~IndexOps::doubleKey(score);
+                labels[i] = (outcomes[i] != 0);
+
+                nPos += labels[i];
+            }
+        }
+
+        // Carry the outcomes along in place of a permutation.
+        if (n > 0) {
+            IndexOps::radixSort<jlong>(keys, keys + n, labels, labels + n, n, histogram);
+        }
+
+        jdouble stats[2];
+
+        jint nFull = IndexOps::errorCurveProxy(type, keys, labels, n, nPos, 0, 0, NULL, stats);
+        jint nOut = (nPoints != 0 && nPoints < nFull) ? nPoints : nFull;
+
+        res = Common::newDoubleArray(env, 2 * nOut);
+
+        ArrayPinHandler resH(env, res, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        ArrayPinHandler statsVh(env, statsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        IndexOps::errorCurveProxy(type, keys, labels, n, nPos, nFull, nOut, (jdouble *) resH.get(), NULL);
+
+        memcpy((jdouble *) statsVh.get(), stats, sizeof(stats));
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return res;
+}
+
+jint IndexOps::errorCurveProxy(jint type, const jlong *keys, const jint *labels, jint n, jint nPos, //
+        jint nFull, jint nOut, jdouble *dst, jdouble *stats) {
+
+    jint nNeg = n - nPos;
+
+    jdouble auc = 0.0;
+    jdouble ap = 0.0;
+
+    jint tp = 0;
+    jint fp = 0;
+
+    // The curve starts at the point where no example is predicted positive.
+    jint nGroups = 0;
+    jint k = 0;
+    jlong target = 0;
+
+    for (jint i = 0;;) {
+
+        if (dst && nGroups == target) {
+
+            IndexOps::errorCurvePoint(type, tp, fp, nPos, nNeg, dst + 2 * k);
+
+            k++;
+            target = (nOut > 1) ? ((jlong) k * (nFull - 1)) / (nOut - 1) : nFull;
+        }
+
+        nGroups++;
+
+        if (i == n) {
+            break;
+        }
+
+        jint tpPrev = tp;
+        jint fpPrev = fp;
+
+        // Tied scores enter together.
+        for (jlong key = keys[i]; i < n && keys[i] == key; i++) {
+            tp += labels[i];
+        }
+
+        fp = i - tp;
+
+        auc += (jdouble) (fp - fpPrev) * ((jdouble) tp + tpPrev);
+        ap += (jdouble) (tp - tpPrev) * tp / (tp + fp);
+    }
+
+    if (stats) {
+
+        stats[0] = (nPos > 0 && nNeg > 0) ? auc / (2.0 * nPos * nNeg) : std::numeric_limits<jdouble>::quiet_NaN();
+        stats[1] = (nPos > 0) ? ap / nPos : std::numeric_limits<jdouble>::quiet_NaN();
+    }
+
+    return nGroups;
+}
+
+inline void IndexOps::errorCurvePoint(jint type, jint tp, jint fp, jint nPos, jint nNeg, jdouble *dst) {
+
+    jdouble tpr = (nPos > 0) ? (jdouble) tp / nPos : 1.0;
+
+    switch (type) {
+
+    case org_shared_array_kernel_ArrayKernel_EC_ROC:
+        dst[0] = (nNeg > 0) ? (jdouble) fp / nNeg : 0.0;
+        dst[1] = tpr;
+        break;
+
+    default:
+        dst[0] = tpr;
+        dst[1] = (tp + fp > 0) ? (jdouble) tp / (tp + fp) : 1.0;
+        break;
+    }
+}
+
+void IndexOps::sortRowsProxy(JNIEnv *env, ArrayPinHandler::jarray_type type, //
+        jobject srcV, jint nRows, jint nCols, jint rowStride, jint colStride, jint *perm) {
+
+    for (jint i = 0; i < nRows; i++) {
+        perm[i] = i;
+    }
+
+    // Proceed only if nonzero length.
+    if (!nRows || !nCols) {
+        return;
+    }
+
+    MallocHandler mallocH(sizeof(jlong) * 2 * nRows + sizeof(jint) * (nRows + RADIX_SIZE * RADIX_PASSES(jlong)));
+    void *all = mallocH.get();
+
+    jint *permTmp = (jint *) ((jlong *) all + 2 * nRows);
+    jint *histogram = permTmp + nRows;
+
+    ArrayPinHandler srcVh(env, (jarray) srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    // NO JNI AFTER THIS POINT!
+
+    // Sort by the last column first, so that stability makes the order lexicographic.
+    switch (type) {
+
+    case ArrayPinHandler::DOUBLE:
+
+    {
+        const jdouble *src = (const jdouble *) srcVh.get();
+        jlong *keys = (jlong *) all;
+
+        for (jint j = nCols - 1; j >= 0; j--) {
+
+            for (jint i = 0; i < nRows; i++) {
+                keys[i] = IndexOps::doubleKey(src[perm[i] * rowStride + j * colStride]);
+            }
+
+            IndexOps::radixSort<jlong>(keys, keys + nRows, perm, permTmp, nRows, histogram);
+        }
+    }
+
+        break;
+
+    default:
+
+    {
+        const jint *src = (const jint *) srcVh.get();
+        jint *keys = (jint *) all;
+
+        for (jint j = nCols - 1; j >= 0; j--) {
+
+            for (jint i = 0; i < nRows; i++) {
+                keys[i] = IndexOps::intKey(src[perm[i] * rowStride + j * colStride]);
+            }
+
+            IndexOps::radixSort<jint>(keys, keys + nRows, perm, permTmp, nRows, histogram);
+        }
+    }
+
+        break;
+    }
+}
+
+inline jint IndexOps::intKey(jint value) {
+
+    // Flipping the sign bit makes unsigned order agree with signed order.
+    return value ^ std::numeric_limits<jint>::min();
+}
+
+inline jlong IndexOps::doubleKey(jdouble value) {
+
+    // All NaNs are the same, and they come after positive infinity.
+    if (value != value) {
+        value = std::numeric_limits<jdouble>::quiet_NaN();
+    }
+
+    jlong bits;
+
+    memcpy(&bits, &value, sizeof(jlong));
+
+    // Negative values reverse order, and positive values come after them.
+    return (bits < 0) ? ~bits : (bits ^ std::numeric_limits<jlong>::min());
+}
+
+template<class K> inline void IndexOps::radixSort(K *keys, K *keysTmp, jint *perm, jint *permTmp, jint n, //
+        jint *histograms) {
+
+    const jint nPasses = RADIX_PASSES(K);
+    const jint mask = RADIX_SIZE - 1;
+
+    K *keysIn = keys;
+    K *keysOut = keysTmp;
+    jint *permIn = perm;
+    jint *permOut = permTmp;
+
+    memset(histograms, 0, sizeof(jint) * RADIX_SIZE * nPasses);
+
+    // Count the digits of every pass in one sweep. Sign extension in the last pass only sets high digit bits that
+    // agree with the sign bit, and so it doesn't disturb the unsigned order.
+    for (jint i = 0; i < n; i++) {
+
+        K key = keysIn[i];
+
+        for (jint pass = 0; pass < nPasses; pass++) {
+            histograms[pass * RADIX_SIZE + ((key >> (pass * RADIX_BITS)) & mask)]++;
+        }
+    }
+
+    // Sort the keys as unsigned values, one digit at a time starting from the least significant.
+    for (jint pass = 0; pass < nPasses; pass++) {
+
+        jint *histogram = histograms + pass * RADIX_SIZE;
+        jint shift = pass * RADIX_BITS;
+
+        // Skip digits that all keys share.
+        if (histogram[(keysIn[0] >> shift) & mask] == n) {
+            continue;
+        }
+
+        for (jint digit = 0, acc = 0; digit < RADIX_SIZE; digit++) {
+
+            jint count = histogram[digit];
+
+            histogram[digit] = acc;
+            acc += count;
+        }
+
+        for (jint i = 0; i < n; i++) {
+
+            jint index = histogram[(keysIn[i] >> shift) & mask]++;
+
+            keysOut[index] = keysIn[i];
+            permOut[index] = permIn[i];
+        }
+
+        std::swap(keysIn, keysOut);
+        std::swap(permIn, permOut);
+    }
+
+    // Leave the sorted keys and permutation in the original buffers.
+    if (permIn != perm) {
+
+        memcpy(keys, keysIn, sizeof(K) * n);
+        memcpy(perm, permIn, sizeof(jint) * n);
+    }
+}
@@ -90,6 +90,71 @@ void MappingOps::checkDimensions( //
     }
 }
 
+jint MappingOps::planTraversal( //
+        const jint *dims, const jint *srcStrides, const jint *dstStrides, jint nDims, //
+        jint *planD, jint *planSrcS, jint *planDstS) {
+
+    jint nPlanDims = 0;
+
+    // Insert nonsingleton dimensions in order of decreasing source stride.
+    for (jint dim = 0; dim < nDims; dim++) {
+
+        if (dims[dim] == 1) {
+            continue;
+        }
+
+        jint srcStride = srcStrides[dim];
+        jint i = nPlanDims++;
+
+        for (; i > 0 && planSrcS[i - 1] < srcStride; i--) {
+
+            planD[i] = planD[i - 1];
+            planSrcS[i] = planSrcS[i - 1];
+            planDstS[i] = planDstS[i - 1];
+        }
+
+        planD[i] = dims[dim];
+        planSrcS[i] = srcStride;
+        planDstS[i] = dstStrides[dim];
+    }
+
+    // Coalesce neighbors whose strides nest exactly.
+
+    jint nCoalesced = 0;
+
+    for (jint i = 0; i < nPlanDims; i++) {
+
+        if (nCoalesced > 0
+                && planSrcS[nCoalesced - 1] == planSrcS[i] * planD[i]
+                && planDstS[nCoalesced - 1] == planDstS[i] * planD[i]) {
+
+            planD[nCoalesced - 1] *= planD[i];
+            planSrcS[nCoalesced - 1] = planSrcS[i];
+            planDstS[nCoalesced - 1] = planDstS[i];
+
+        } else {
+
+            planD[nCoalesced] = planD[i];
+            planSrcS[nCoalesced] = planSrcS[i];
+            planDstS[nCoalesced] = planDstS[i];
+
+            nCoalesced++;
+        }
+    }
+
+    // A single element still needs one dimension to traverse.
+    if (!nCoalesced) {
+
+        planD[0] = 1;
+        planSrcS[0] = 0;
+        planDstS[0] = 0;
+
+        nCoalesced = 1;
+    }
+
+    return nCoalesced;
+}
+
 void MappingOps::assign(JNIEnv *env, ArrayPinHandler::jarray_type type, //
         jarray srcV, jint *srcIndices, //
         jarray dstV, jint *dstIndices, //
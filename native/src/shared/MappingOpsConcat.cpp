@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <MappingOps.hpp>
+
+void MappingOps::concat(JNIEnv *env, jobject thisObj, //
+        jint opDim, //
+        jobjectArray srcVs, jobjectArray srcDs, jobjectArray srcSs, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+
+    try {
+
+        if (!srcVs || !srcDs || !srcSs || !dstV || !dstD || !dstS) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nSrcs = env->GetArrayLength(srcVs);
+        jint nDims = env->GetArrayLength(dstD);
+        jint dstLen = env->GetArrayLength((jarray) dstV);
+
+        if ((nSrcs != env->GetArrayLength(srcDs))
+                || (nSrcs != env->GetArrayLength(srcSs))
+                || (nDims != env->GetArrayLength(dstS))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (!(opDim >= 0 && opDim < nDims)) {
+            throw std::runtime_error("Invalid dimension");
+        }
+
+        MallocHandler mallocH(sizeof(jint) * (2 * nDims * (nSrcs + 1) + 4 * nDims + nSrcs));
+        void *all = mallocH.get();
+
+        jint *dstDArr = (jint *) all;
+        jint *dstSArr = (jint *) all + nDims;
+        jint *srcDAll = (jint *) all + 2 * nDims;
+        jint *srcSAll = (jint *) all + 2 * nDims + nDims * nSrcs;
+        jint *planD = (jint *) all + 2 * nDims * (nSrcs + 1);
+        jint *planSrcS = (jint *) all + 2 * nDims * (nSrcs + 1) + nDims;
+        jint *planDstS = (jint *) all + 2 * nDims * (nSrcs + 1) + 2 * nDims;
+        jint *counters = (jint *) all + 2 * nDims * (nSrcs + 1) + 3 * nDims;
+        jint *srcLens = (jint *) all + 2 * nDims * (nSrcs + 1) + 4 * nDims;
+
+        {
+            ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstSh(env, dstS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+            memcpy(dstDArr, dstDh.get(), sizeof(jint) * nDims);
+            memcpy(dstSArr, dstSh.get(), sizeof(jint) * nDims);
+        }
+
+        MappingOps::checkDimensions(dstDArr, dstSArr, nDims, dstLen);
+
+        // Copy out every source's dimensions and strides, and check them against the destination.
+
+        ArrayPinHandler::jarray_type type = ArrayPinHandler::DOUBLE;
+
+        jint total = 0;
+
+        for (jint i = 0; i < nSrcs; i++) {
+
+            jarray srcV = (jarray) env->GetObjectArrayElement(srcVs, i);
+            jintArray srcD = (jintArray) env->GetObjectArrayElement(srcDs, i);
+            jintArray srcS = (jintArray) env->GetObjectArrayElement(srcSs, i);
+
+            if (!srcV || !srcD || !srcS) {
+                throw std::runtime_error("Invalid arguments");
+            }
+
+            if ((nDims != env->GetArrayLength(srcD)) || (nDims != env->GetArrayLength(srcS))) {
+                throw std::runtime_error("Dimensionality mismatch");
+            }
+
+            ArrayPinHandler::jarray_type srcType = NativeArrayKernel::getArrayType(env, srcV, dstV);
+
+            if (i > 0 && srcType != type) {
+                throw std::runtime_error("Invalid array types");
+            }
+
+            type = srcType;
+            srcLens[i] = env->GetArrayLength(srcV);
+
+            jint *srcDArr = srcDAll + nDims * i;
+            jint *srcSArr = srcSAll + nDims * i;
+
+            {
+                ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+                ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+                memcpy(srcDArr, srcDh.get(), sizeof(jint) * nDims);
+                memcpy(srcSArr, srcSh.get(), sizeof(jint) * nDims);
+            }
+
+            env->DeleteLocalRef(srcV);
+            env->DeleteLocalRef(srcD);
+            env->DeleteLocalRef(srcS);
+
+            MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLens[i]);
+
+            for (jint dim = 0; dim < nDims; dim++) {
+
+                if (dim != opDim && srcDArr[dim] != dstDArr[dim]) {
+                    throw std::runtime_error("Dimension mismatch");
+                }
+            }
+
+            total += srcDArr[opDim];
+        }
+
+        if (total != dstDArr[opDim]) {
+            throw std::runtime_error("Dimension mismatch");
+        }
+
+        // Copy every source into its slab of the destination.
+
+        for (jint i = 0, offset = 0; i < nSrcs; offset += srcDAll[nDims * i + opDim], i++) {
+
+            jint srcLen = srcLens[i];
+
+            // Proceed only if nonzero length.
+            if (!srcLen) {
+                continue;
+            }
+
+            const jint *srcDArr = srcDAll + nDims * i;
+            const jint *srcSArr = srcSAll + nDims * i;
+
+            jint dstOffset = offset * dstSArr[opDim];
+
+            jarray srcV = (jarray) env->GetObjectArrayElement(srcVs, i);
+
+            switch (type) {
+
+            case ArrayPinHandler::DOUBLE:
+
+            {
+                jint nPlanDims = MappingOps::planTraversal(srcDArr, srcSArr, dstSArr, nDims, //
+                        planD, planSrcS, planDstS);
+
+                ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+                ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+                // NO JNI AFTER THIS POINT!
+
+                MappingOps::copyPlanned<jdouble>((jdouble *) srcVh.get(), (jdouble *) dstVh.get() + dstOffset, //
+                        planD, planSrcS, planDstS, nPlanDims, srcLen, counters);
+            }
+
+                break;
+
+            case ArrayPinHandler::INT:
+
+            {
+                jint nPlanDims = MappingOps::planTraversal(srcDArr, srcSArr, dstSArr, nDims, //
+                        planD, planSrcS, planDstS);
+
+                ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+                ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+                // NO JNI AFTER THIS POINT!
+
+                MappingOps::copyPlanned<jint>((jint *) srcVh.get(), (jint *) dstVh.get() + dstOffset, //
+                        planD, planSrcS, planDstS, nPlanDims, srcLen, counters);
+            }
+
+                break;
+
+            default:
+
+            {
+                // Object arrays go through the JNI one element at a time anyway.
+
+                MallocHandler indicesH(sizeof(jint) * 2 * srcLen);
+                jint *srcIndices = (jint *) indicesH.get();
+                jint *dstIndices = (jint *) indicesH.get() + srcLen;
+
+                MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+                MappingOps::assignMappingIndices(dstIndices, srcDArr, dstSArr, nDims);
+
+                for (jint j = 0; j < srcLen; j++) {
+                    dstIndices[j] += dstOffset;
+                }
+
+                MappingOps::assign(env, type, //
+                        srcV, srcIndices, //
+                        (jarray) dstV, dstIndices, //
+                        srcLen);
+            }
+
+                break;
+            }
+
+            env->DeleteLocalRef(srcV);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+template<class T> inline void MappingOps::copyPlanned(const T *src, T *dst, //
+        const jint *planD, const jint *planSrcS, const jint *planDstS, jint nPlanDims, jint len, //
+        jint *counters) {
+
+    jint nOuterDims = nPlanDims - 1;
+    jint innerSize = planD[nOuterDims];
+    jint innerSrcStride = planSrcS[nOuterDims];
+    jint innerDstStride = planDstS[nOuterDims];
+
+    memset(counters, 0, sizeof(jint) * nOuterDims);
+
+    // Copy contiguous runs in bulk, and walk the outer dimensions as an odometer.
+    for (jint n = len / innerSize, srcOffset = 0, dstOffset = 0; n > 0; n--) {
+
+        if (innerSrcStride == 1 && innerDstStride == 1) {
+
+            memcpy(dst + dstOffset, src + srcOffset, sizeof(T) * innerSize);
+
+        } else {
+
+            for (jint i = 0, srcIndex = srcOffset, dstIndex = dstOffset; i < innerSize; //
+                    i++, srcIndex += innerSrcStride, dstIndex += innerDstStride) {
+                dst[dstIndex] = src[srcIndex];
+            }
+        }
+
+        for (jint dim = nOuterDims - 1; dim >= 0; dim--) {
+
+            srcOffset += planSrcS[dim];
+            dstOffset += planDstS[dim];
+
+            if (++counters[dim] < planD[dim]) {
+                break;
+            }
+
+            counters[dim] = 0;
+            srcOffset -= planSrcS[dim] * planD[dim];
+            dstOffset -= planDstS[dim] * planD[dim];
+        }
+    }
+}
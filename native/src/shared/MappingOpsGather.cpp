@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <MappingOps.hpp>
+
+void MappingOps::gather(JNIEnv *env, jobject thisObj, //
+        jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+    MappingOps::gatherScatterProxy(env, //
+            org_shared_array_kernel_ArrayKernel_SC_ASSIGN, opDim, indices, //
+            srcV, srcD, srcS, //
+            dstV, dstD, dstS, //
+            JNI_FALSE);
+}
+
+void MappingOps::scatter(JNIEnv *env, jobject thisObj, //
+        jint type, jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+    MappingOps::gatherScatterProxy(env, //
+            type, opDim, indices, //
+            srcV, srcD, srcS, //
+            dstV, dstD, dstS, //
+            JNI_TRUE);
+}
+
+void MappingOps::gatherScatterProxy(JNIEnv *env, //
+        jint type, jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS, //
+        jboolean scatter) {
+
+    try {
+
+        void (*opD)(const jdouble *, jint, jdouble *, jint, jint);
+        void (*opI)(const jint *, jint, jint *, jint, jint);
+
+        switch (type) {
+
+        case org_shared_array_kernel_ArrayKernel_SC_ASSIGN:
+            opD = MappingOps::scAssign<jdouble>;
+            opI = MappingOps::scAssign<jint>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_SC_ADD:
+            opD = MappingOps::scAdd<jdouble>;
+            opI = MappingOps::scAdd<jint>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_SC_MAX:
+            opD = MappingOps::scMax<jdouble>;
+            opI = MappingOps::scMax<jint>;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_SC_MIN:
+            opD = MappingOps::scMin<jdouble>;
+            opI = MappingOps::scMin<jint>;
+            break;
+
+        default:
+            throw std::runtime_error("Operation type not recognized");
+        }
+
+        if (!indices || !srcV || !srcD || !srcS || !dstV || !dstD || !dstS) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        ArrayPinHandler::jarray_type arrayType = NativeArrayKernel::getArrayType(env, srcV, dstV);
+
+        if (arrayType == ArrayPinHandler::OBJECT && type != org_shared_array_kernel_ArrayKernel_SC_ASSIGN) {
+            throw std::runtime_error("Only assignment applies to object arrays");
+        }
+
+        jint srcLen = env->GetArrayLength((jarray) srcV);
+        jint dstLen = env->GetArrayLength((jarray) dstV);
+        jint nDims = env->GetArrayLength(srcD);
+        jint nIndices = env->GetArrayLength(indices);
+
+        if ((nDims != env->GetArrayLength(srcS))
+                || (nDims != env->GetArrayLength(dstD))
+                || (nDims != env->GetArrayLength(dstS))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (!(opDim >= 0 && opDim < nDims)) {
+            throw std::runtime_error("Invalid dimension");
+        }
+
+        MallocHandler mallocH(sizeof(jint) * (9 * nDims + nIndices));
+        void *all = mallocH.get();
+
+        jint *srcDArr = (jint *) all;
+        jint *srcSArr = (jint *) all + nDims;
+        jint *dstDArr = (jint *) all + 2 * nDims;
+        jint *dstSArr = (jint *) all + 3 * nDims;
+        jint *slabD = (jint *) all + 4 * nDims;
+        jint *planD = (jint *) all + 5 * nDims;
+        jint *planSrcS = (jint *) all + 6 * nDims;
+        jint *planDstS = (jint *) all + 7 * nDims;
+        jint *counters = (jint *) all + 8 * nDims;
+        jint *indicesArr = (jint *) all + 9 * nDims;
+
+        {
+            ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstSh(env, dstS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler indicesH(env, indices, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+            memcpy(srcDArr, srcDh.get(), sizeof(jint) * nDims);
+            memcpy(srcSArr, srcSh.get(), sizeof(jint) * nDims);
+            memcpy(dstDArr, dstDh.get(), sizeof(jint) * nDims);
+            memcpy(dstSArr, dstSh.get(), sizeof(jint) * nDims);
+            memcpy(indicesArr, indicesH.get(), sizeof(jint) * nIndices);
+        }
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+        MappingOps::checkDimensions(dstDArr, dstSArr, nDims, dstLen);
+
+        // The indexed side is the source for gathers and the destination for scatters.
+        jint *indexedD = scatter ? dstDArr : srcDArr;
+        jint *listedD = scatter ? srcDArr : dstDArr;
+
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            if ((dim == opDim) ? (listedD[dim] != nIndices) : (srcDArr[dim] != dstDArr[dim])) {
+                throw std::runtime_error("Dimension mismatch");
+            }
+        }
+
+        for (jint i = 0, size = indexedD[opDim]; i < nIndices; i++) {
+
+            if (!(indicesArr[i] >= 0 && indicesArr[i] < size)) {
+                throw std::runtime_error("Invalid index");
+            }
+        }
+
+        memcpy(slabD, srcDArr, sizeof(jint) * nDims);
+        slabD[opDim] = 1;
+
+        jint slabLen = Common::product(slabD, nDims, (jint) 1);
+
+        // Proceed only if nonzero length.
+        if (!nIndices || !slabLen) {
+            return;
+        }
+
+        switch (arrayType) {
+
+        case ArrayPinHandler::DOUBLE:
+
+        {
+            jint nPlanDims = MappingOps::planTraversal(slabD, srcSArr, dstSArr, nDims, //
+                    planD, planSrcS, planDstS);
+
+            ArrayPinHandler srcVh(env, (jarray) srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            MappingOps::transferPlanned<jdouble>(opD, (jdouble *) srcVh.get(), (jdouble *) dstVh.get(), //
+                    indicesArr, nIndices, srcSArr[opDim], dstSArr[opDim], scatter, //
+                    planD, planSrcS, planDstS, nPlanDims, slabLen, counters);
+        }
+
+            break;
+
+        case ArrayPinHandler::INT:
+
+        {
+            jint nPlanDims = MappingOps::planTraversal(slabD, srcSArr, dstSArr, nDims, //
+                    planD, planSrcS, planDstS);
+
+            ArrayPinHandler srcVh(env, (jarray) srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            MappingOps::transferPlanned<jint>(opI, (jint *) srcVh.get(), (jint *) dstVh.get(), //
+                    indicesArr, nIndices, srcSArr[opDim], dstSArr[opDim], scatter, //
+                    planD, planSrcS, planDstS, nPlanDims, slabLen, counters);
+        }
+
+            break;
+
+        default:
+
+        {
+            // Object arrays go through the JNI one element at a time anyway.
+
+            jint mapLen = nIndices * slabLen;
+
+            MallocHandler indicesH(sizeof(jint) * 2 * mapLen);
+            jint *srcIndices = (jint *) indicesH.get();
+            jint *dstIndices = (jint *) indicesH.get() + mapLen;
+
+            MappingOps::assignMappingIndices(srcIndices, slabD, srcSArr, nDims);
+            MappingOps::assignMappingIndices(dstIndices, slabD, dstSArr, nDims);
+
+            for (jint i = nIndices - 1; i >= 0; i--) {
+
+                jint srcOffset = (scatter ? i : indicesArr[i]) * srcSArr[opDim];
+                jint dstOffset = (scatter ? indicesArr[i] : i) * dstSArr[opDim];
+
+                for (jint j = 0; j < slabLen; j++) {
+
+                    srcIndices[i * slabLen + j] = srcIndices[j] + srcOffset;
+                    dstIndices[i * slabLen + j] = dstIndices[j] + dstOffset;
+                }
+            }
+
+            MappingOps::assign(env, arrayType, //
+                    (jarray) srcV, srcIndices, //
+                    (jarray) dstV, dstIndices, //
+                    mapLen);
+        }
+
+            break;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+template<class T> inline void MappingOps::scAssign(const T *src, jint srcStride, T *dst, jint dstStride, jint len) {
+
+    if (srcStride == 1 && dstStride == 1) {
+
+        memcpy(dst, src, sizeof(T) * len);
+
+    } else {
+
+        for (jint i = 0, srcIndex = 0, dstIndex = 0; i < len; i++, srcIndex += srcStride, dstIndex += dstStride) {
+            dst[dstIndex] = src[srcIndex];
+        }
+    }
+}
+
+template<class T> inline void MappingOps::scAdd(const T *src, jint srcStride, T *dst, jint dstStride, jint len) {
+
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < len; i++, srcIndex += srcStride, dstIndex += dstStride) {
+        dst[dstIndex] += src[srcIndex];
+    }
+}
+
+template<class T> inline void MappingOps::scMax(const T *src, jint srcStride, T *dst, jint dstStride, jint len) {
+
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < len; i++, srcIndex += srcStride, dstIndex += dstStride) {
+        dst[dstIndex] = std::max<T>(dst[dstIndex], src[srcIndex]);
+    }
+}
+
+template<class T> inline void MappingOps::scMin(const T *src, jint srcStride, T *dst, jint dstStride, jint len) {
+
+    for (jint i = 0, srcIndex = 0, dstIndex = 0; i < len; i++, srcIndex += srcStride, dstIndex += dstStride) {
+        dst[dstIndex] = std::min<T>(dst[dstIndex], src[srcIndex]);
+    }
+}
+
+template<class T> inline void MappingOps::transferPlanned(void (*op)(const T *, jint, T *, jint, jint), //
+        const T *src, T *dst, const jint *indices, jint nIndices, //
+        jint srcOpStride, jint dstOpStride, jboolean scatter, //
+        const jint *planD, const jint *planSrcS, const jint *planDstS, jint nPlanDims, jint len, //
+        jint *counters) {
+
+    jint nOuterDims = nPlanDims - 1;
+    jint innerSize = planD[nOuterDims];
+    jint innerSrcStride = planSrcS[nOuterDims];
+    jint innerDstStride = planDstS[nOuterDims];
+
+    // Linear indices name single elements, for which the traversal machinery is pure overhead.
+    if (len == 1) {
+
+        for (jint i = 0; i < nIndices; i++) {
+            op(src + (scatter ? i : indices[i]) * srcOpStride, 1, //
+                    dst + (scatter ? indices[i] : i) * dstOpStride, 1, 1);
+        }
+
+        return;
+    }
+
+    // Slabs are visited in index order, so that duplicate indices under scatters resolve sequentially and never
+    // conflict.
+    for (jint i = 0; i < nIndices; i++) {
+
+        const T *srcSlab = src + (scatter ? i : indices[i]) * srcOpStride;
+        T *dstSlab = dst + (scatter ? indices[i] : i) * dstOpStride;
+
+        memset(counters, 0, sizeof(jint) * nOuterDims);
+
+        for (jint n = len / innerSize, srcOffset = 0, dstOffset = 0; n > 0; n--) {
+
+            op(srcSlab + srcOffset, innerSrcStride, dstSlab + dstOffset, innerDstStride, innerSize);
+
+            for (jint dim = nOuterDims - 1; dim >= 0; dim--) {
+
+                srcOffset += planSrcS[dim];
+                dstOffset += planDstS[dim];
+
+                if (++counters[dim] < planD[dim]) {
+                    break;
+                }
+
+                counters[dim] = 0;
+                srcOffset -= planSrcS[dim] * planD[dim];
+                dstOffset -= planDstS[dim] * planD[dim];
+            }
+        }
+    }
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <MappingOps.hpp>
+
+void MappingOps::pad(JNIEnv *env, jobject thisObj, //
+        jint mode, jintArray offsets, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+
+    try {
+
+        switch (mode) {
+
+        case org_shared_array_kernel_ArrayKernel_PM_CONSTANT:
+        case org_shared_array_kernel_ArrayKernel_PM_REPLICATE:
+        case org_shared_array_kernel_ArrayKernel_PM_REFLECT:
+        case org_shared_array_kernel_ArrayKernel_PM_SYMMETRIC:
+        case org_shared_array_kernel_ArrayKernel_PM_CIRCULAR:
+            break;
+
+        default:
+            throw std::runtime_error("Padding mode not recognized");
+        }
+
+        if (!srcV || !srcD || !srcS || !dstV || !dstD || !dstS || !offsets) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        ArrayPinHandler::jarray_type type = NativeArrayKernel::getArrayType(env, srcV, dstV);
+
+        jint srcLen = env->GetArrayLength((jarray) srcV);
+        jint dstLen = env->GetArrayLength((jarray) dstV);
+        jint nDims = env->GetArrayLength(srcD);
+
+        if ((nDims != env->GetArrayLength(srcS))
+                || (nDims != env->GetArrayLength(dstD))
+                || (nDims != env->GetArrayLength(dstS))
+                || (nDims != env->GetArrayLength(offsets))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint lookupLen = 0;
+
+        {
+            ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+            for (jint dim = 0; dim < nDims; dim++) {
+                lookupLen += std::max<jint>(((jint *) dstDh.get())[dim], 0);
+            }
+        }
+
+        MallocHandler mallocH(sizeof(jint) * (7 * nDims + lookupLen) + sizeof(jint *) * nDims);
+        void *all = mallocH.get();
+
+        jint *srcDArr = (jint *) all;
+        jint *srcSArr = (jint *) all + nDims;
+        jint *dstDArr = (jint *) all + 2 * nDims;
+        jint *dstSArr = (jint *) all + 3 * nDims;
+        jint *offsetsArr = (jint *) all + 4 * nDims;
+        jint *order = (jint *) all + 5 * nDims;
+        jint *counters = (jint *) all + 6 * nDims;
+        jint *lookupBacking = (jint *) all + 7 * nDims;
+        jint **lookups = (jint **) ((jint *) all + 7 * nDims + lookupLen);
+
+        {
+            ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstSh(env, dstS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler offsetsH(env, offsets, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+
+            memcpy(srcDArr, srcDh.get(), sizeof(jint) * nDims);
+            memcpy(srcSArr, srcSh.get(), sizeof(jint) * nDims);
+            memcpy(dstDArr, dstDh.get(), sizeof(jint) * nDims);
+            memcpy(dstSArr, dstSh.get(), sizeof(jint) * nDims);
+            memcpy(offsetsArr, offsetsH.get(), sizeof(jint) * nDims);
+        }
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+        MappingOps::checkDimensions(dstDArr, dstSArr, nDims, dstLen);
+
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            if (!(offsetsArr[dim] >= 0 && offsetsArr[dim] + srcDArr[dim] <= dstDArr[dim])) {
+                throw std::runtime_error("Invalid padding offsets");
+            }
+        }
+
+        // Proceed only if nonzero length.
+        if (!dstLen) {
+            return;
+        }
+
+        for (jint dim = 0, acc = 0; dim < nDims; acc += dstDArr[dim++]) {
+
+            lookups[dim] = lookupBacking + acc;
+
+            MappingOps::assignPaddingLookup(lookups[dim], mode, offsetsArr[dim], srcDArr[dim], dstDArr[dim]);
+        }
+
+        // Constant padding of an empty source leaves everything as is.
+        if (!srcLen) {
+            return;
+        }
+
+        // Order dimensions by decreasing destination stride, so that the innermost one is written contiguously.
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            jint i = dim;
+
+            for (; i > 0 && dstSArr[order[i - 1]] < dstSArr[dim]; i--) {
+                order[i] = order[i - 1];
+            }
+
+            order[i] = dim;
+        }
+
+        switch (type) {
+
+        case ArrayPinHandler::DOUBLE:
+
+        {
+            ArrayPinHandler srcVh(env, (jarray) srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            MappingOps::padPlanned<jdouble>((jdouble *) srcVh.get(), (jdouble *) dstVh.get(), //
+                    srcDArr, srcSArr, dstDArr, dstSArr, offsetsArr, //
+                    order, nDims, lookups, counters);
+        }
+
+            break;
+
+        case ArrayPinHandler::INT:
+
+        {
+            ArrayPinHandler srcVh(env, (jarray) srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+            ArrayPinHandler dstVh(env, (jarray) dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+            // NO JNI AFTER THIS POINT!
+
+            MappingOps::padPlanned<jint>((jint *) srcVh.get(), (jint *) dstVh.get(), //
+                    srcDArr, srcSArr, dstDArr, dstSArr, offsetsArr, //
+                    order, nDims, lookups, counters);
+        }
+
+            break;
+
+        default:
+
+        {
+            // Object arrays go through the JNI one element at a time anyway, so just slice by the lookup tables.
+
+            jint nSlices = 0;
+            jint nIndices = 1;
+
+            for (jint dim = 0; dim < nDims; dim++) {
+
+                jint count = 0;
+
+                for (jint i = 0; i < dstDArr[dim]; i++) {
+                    count += (lookups[dim][i] >= 0) ? 1 : 0;
+                }
+
+                counters[dim] = count;
+                nSlices += count;
+                nIndices *= count;
+            }
+
+            if (!nIndices) {
+                return;
+            }
+
+            MallocHandler slicesH(sizeof(jint) * (2 * nSlices + 2 * nIndices) + sizeof(jint *) * (2 * nDims));
+            void *slicesAll = slicesH.get();
+
+            jint *ssiBacking = (jint *) slicesAll;
+            jint *dsiBacking = (jint *) slicesAll + nSlices;
+            jint *srcIndices = (jint *) slicesAll + 2 * nSlices;
+            jint *dstIndices = (jint *) slicesAll + 2 * nSlices + nIndices;
+            jint **ssiArr = (jint **) ((jint *) slicesAll + 2 * nSlices + 2 * nIndices);
+            jint **dsiArr = (jint **) ((jint *) slicesAll + 2 * nSlices + 2 * nIndices) + nDims;
+
+            for (jint dim = 0, acc = 0; dim < nDims; acc += counters[dim++]) {
+
+                ssiArr[dim] = ssiBacking + acc;
+                dsiArr[dim] = dsiBacking + acc;
+
+                for (jint i = 0, j = 0; i < dstDArr[dim]; i++) {
+
+                    if (lookups[dim][i] >= 0) {
+
+                        ssiArr[dim][j] = lookups[dim][i];
+                        dsiArr[dim][j] = i;
+                        j++;
+                    }
+                }
+            }
+
+            MappingOps::assignSlicingIndices(srcIndices, counters, srcSArr, nDims, ssiArr);
+            MappingOps::assignSlicingIndices(dstIndices, counters, dstSArr, nDims, dsiArr);
+
+            MappingOps::assign(env, type, //
+                    (jarray) srcV, srcIndices, //
+                    (jarray) dstV, dstIndices, //
+                    nIndices);
+        }
+
+            break;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void MappingOps::assignPaddingLookup(jint *lookup, jint mode, jint offset, jint srcSize, jint dstSize) {
+
+    if (!srcSize) {
+
+        if (mode != org_shared_array_kernel_ArrayKernel_PM_CONSTANT && dstSize > 0) {
+            throw std::runtime_error("Only constant padding applies to empty dimensions");
+        }
+
+        for (jint i = 0; i < dstSize; i++) {
+            lookup[i] = -1;
+        }
+
+        return;
+    }
+
+    // Periods of the reflective modes.
+    jint reflectPeriod = std::max<jint>(2 * srcSize - 2, 1);
+    jint symmetricPeriod = 2 * srcSize;
+
+    for (jint i = 0; i < dstSize; i++) {
+
+        jint index = i - offset;
+
+        if (index >= 0 && index < srcSize) {
+
+            lookup[i] = index;
+
+            continue;
+        }
+
+        switch (mode) {
+
+        case org_shared_array_kernel_ArrayKernel_PM_CONSTANT:
+            index = -1;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_PM_REPLICATE:
+            index = std::min<jint>(std::max<jint>(index, 0), srcSize - 1);
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_PM_REFLECT:
+            index = ((index % reflectPeriod) + reflectPeriod) % reflectPeriod;
+            index = (index < srcSize) ? index : reflectPeriod - index;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_PM_SYMMETRIC:
+            index = ((index % symmetricPeriod) + symmetricPeriod) % symmetricPeriod;
+            index = (index < srcSize) ? index : symmetricPeriod - 1 - index;
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_PM_CIRCULAR:
+            index = ((index % srcSize) + srcSize) % srcSize;
+            break;
+
+        default:
+            throw std::runtime_error("Padding mode not recognized");
+        }
+
+        lookup[i] = index;
+    }
+}
+
+template<class T> inline void MappingOps::padPlanned(const T *src, T *dst, //
+        const jint *srcDArr, const jint *srcSArr, const jint *dstDArr, const jint *dstSArr, const jint *offsetsArr, //
+        const jint *order, jint nDims, const jint *const *lookups, jint *counters) {
+
+    jint nOuterDims = nDims - 1;
+    jint inner = order[nOuterDims];
+
+    jint innerSize = dstDArr[inner];
+    jint innerSrcStride = srcSArr[inner];
+    jint innerDstStride = dstSArr[inner];
+    const jint *innerLookup = lookups[inner];
+
+    // The interior maps the source through unchanged.
+    jint lower = offsetsArr[inner];
+    jint upper = lower + srcDArr[inner];
+
+    memset(counters, 0, sizeof(jint) * nDims);
+
+    for (jint n = (innerSize > 0) ? Common::product((jint *) dstDArr, nDims, (jint) 1) / innerSize : 0; n > 0; n--) {
+
+        // Locate the source and destination lines.
+
+        jint srcOffset = 0;
+        jint dstOffset = 0;
+        bool inside = true;
+
+        for (jint i = 0; i < nOuterDims; i++) {
+
+            jint dim = order[i];
+            jint index = lookups[dim][counters[i]];
+
+            inside &= (index >= 0);
+            srcOffset += index * srcSArr[dim];
+            dstOffset += counters[i] * dstSArr[dim];
+        }
+
+        // Lines that fall entirely in constant padding keep their values.
+        if (inside) {
+
+            if (innerSrcStride == 1 && innerDstStride == 1) {
+
+                memcpy(dst + dstOffset + lower, src + srcOffset, sizeof(T) * (upper - lower));
+
+            } else {
+
+                for (jint i = lower, srcIndex = srcOffset, dstIndex = dstOffset + lower * innerDstStride; i < upper; //
+                        i++, srcIndex += innerSrcStride, dstIndex += innerDstStride) {
+                    dst[dstIndex] = src[srcIndex];
+                }
+            }
+
+            // Synthesize the borders.
+
+            for (jint i = 0; i < lower; i++) {
+
+                jint index = innerLookup[i];
+
+                if (index >= 0) {
+                    dst[dstOffset + i * innerDstStride] = src[srcOffset + index * innerSrcStride];
+                }
+            }
+
+            for (jint i = upper; i < innerSize; i++) {
+
+                jint index = innerLookup[i];
+
+                if (index >= 0) {
+                    dst[dstOffset + i * innerDstStride] = src[srcOffset + index * innerSrcStride];
+                }
+            }
+        }
+
+        for (jint i = nOuterDims - 1; i >= 0 && ++counters[i] == dstDArr[order[i]]; i--) {
+            counters[i] = 0;
+        }
+    }
+}
@@ -98,6 +98,97 @@ template<class T> inline void MatrixOps::mul(const T *lArr, const T *rArr, jint
     }
 }
 
+void MatrixOps::hMul(JNIEnv *env, jobject thisObj, jint format, jshortArray lhsV, jshortArray rhsV, //
+        jint lhsR, jint rhsC, jdoubleArray dstV) {
+
+    try {
+
+        switch (format) {
+
+        case org_shared_array_kernel_ArrayKernel_HF_FP16:
+            MatrixOps::hMulProxy<HALF_FP16_MANTISSA, HALF_FP16_BIAS>(env, lhsV, rhsV, lhsR, rhsC, dstV);
+            break;
+
+        case org_shared_array_kernel_ArrayKernel_HF_BF16:
+            MatrixOps::hMulProxy<HALF_BF16_MANTISSA, HALF_BF16_BIAS>(env, lhsV, rhsV, lhsR, rhsC, dstV);
+            break;
+
+        default:
+            throw std::runtime_error("Format not recognized");
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+template<jint M, jint B> inline void MatrixOps::hMulProxy(JNIEnv *env, //
+        jshortArray lhsV, jshortArray rhsV, jint lhsR, jint rhsC, jdoubleArray dstV) {
+
+    if (!lhsV || !rhsV || !dstV) {
+        throw std::runtime_error("Invalid arguments");
+    }
+
+    jint lhsLen = env->GetArrayLength(lhsV);
+    jint rhsLen = env->GetArrayLength(rhsV);
+    jint dstLen = env->GetArrayLength(dstV);
+
+    jint lhsC = lhsR ? lhsLen / lhsR : 0;
+    jint rhsR = rhsC ? rhsLen / rhsC : 0;
+    jint inner = lhsC;
+
+    if (lhsR < 0 || rhsC < 0
+            || (lhsLen != lhsR * lhsC)
+            || (rhsLen != rhsR * rhsC)
+            || (dstLen != lhsR * rhsC)
+            || (inner != rhsR)) {
+        throw std::runtime_error("Invalid array lengths");
+    }
+
+    if (dstLen == 0) {
+        return;
+    }
+
+    // Expand the right hand side once, and keep a row of single precision accumulators after it.
+    MallocHandler allH(sizeof(jfloat) * (rhsLen + rhsC));
+    jfloat *rArr = (jfloat *) allH.get();
+    jfloat *accArr = rArr + rhsLen;
+
+    ArrayPinHandler lhsVh(env, lhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler rhsVh(env, rhsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+    // NO JNI AFTER THIS POINT!
+
+    const jshort *lhsVArr = (const jshort *) lhsVh.get();
+    const jshort *rhsVArr = (const jshort *) rhsVh.get();
+    jdouble *dstVArr = (jdouble *) dstVh.get();
+
+    for (jint i = 0; i < rhsLen; i++) {
+        rArr[i] = Common::fromHalf<M, B>(rhsVArr[i]);
+    }
+
+    // The i-k-j order streams through contiguous rows of the right hand side and the accumulators.
+    for (jint i = 0; i < lhsR; i++) {
+
+        std::fill(accArr, accArr + rhsC, (jfloat) 0.0);
+
+        for (jint k = 0; k < inner; k++) {
+
+            jfloat a = Common::fromHalf<M, B>(lhsVArr[i * inner + k]);
+            const jfloat *rRow = rArr + k * rhsC;
+
+            for (jint j = 0; j < rhsC; j++) {
+                accArr[j] += a * rRow[j];
+            }
+        }
+
+        for (jint j = 0; j < rhsC; j++) {
+            dstVArr[i * rhsC + j] = (jdouble) accArr[j];
+        }
+    }
+}
+
 void MatrixOps::diag(JNIEnv *env, jobject thisObj, //
         jdoubleArray srcV, jdoubleArray dstV, jint size, jboolean complex) {
 
@@ -0,0 +1,848 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeFftService.hpp>
+
+// The largest prime factor handled by a generic radix pass instead of Bluestein's algorithm.
+#define MAX_GENERIC_RADIX 31
+
+// The maximum number of lines gathered at once when transforming along strided dimensions.
+#define MAX_BLOCK_LINES 16
+
+void NativeFftService::init(JNIEnv *env) {
+}
+
+void NativeFftService::destroy(JNIEnv *env) {
+}
+
+//
+
+FftPlan::FftPlan(jint n) {
+
+    this->n = n;
+    this->nFactors = 0;
+    this->twiddles = NULL;
+    this->m = 0;
+    this->convolutionPlan = NULL;
+    this->chirps = NULL;
+
+    // Factor the length, preferring radix 4 passes.
+
+    jint r = n;
+    bool smooth = true;
+
+    for (; r % 4 == 0; r /= 4) {
+        this->factors[this->nFactors++] = 4;
+    }
+
+    for (jint p = 2; p * p <= r || (p <= r && r > 1); p += (p == 2) ? 1 : 2) {
+
+        for (; r % p == 0; r /= p) {
+
+            if (p > MAX_GENERIC_RADIX) {
+                smooth = false;
+            }
+
+            this->factors[this->nFactors++] = p;
+        }
+    }
+
+    if (r > 1) {
+
+        if (r > MAX_GENERIC_RADIX) {
+            smooth = false;
+        }
+
+        this->factors[this->nFactors++] = r;
+    }
+
+    try {
+
+        if (smooth) {
+
+            this->twiddles = (jdouble *) malloc(sizeof(jdouble) * 2 * n);
+
+            if (!this->twiddles) {
+                throw std::runtime_error("Allocation failed");
+            }
+
+            for (jint k = 0; k < n; k++) {
+
+                jdouble angle = (2.0 * M_PI * k) / n;
+
+                this->twiddles[2 * k] = cos(angle);
+                this->twiddles[2 * k + 1] = -sin(angle);
+            }
+
+        } else {
+
+            // Bluestein's algorithm expresses the transform as a power of two length convolution.
+
+            this->nFactors = 0;
+
+            for (this->m = 1; this->m < 2 * n - 1; this->m *= 2) {
+            }
+
+            jint m = this->m;
+
+            this->convolutionPlan = new FftPlan(m);
+            this->chirps = (jdouble *) malloc(sizeof(jdouble) * (2 * n + 4 * m));
+
+            if (!this->chirps) {
+                throw std::runtime_error("Allocation failed");
+            }
+
+            jdouble *chirp = this->chirps;
+            jdouble *forwardSpectrum = this->chirps + 2 * n;
+            jdouble *backwardSpectrum = this->chirps + 2 * n + 2 * m;
+
+            for (jint k = 0; k < n; k++) {
+
+                // Reduce k^2 modulo 2n to preserve precision.
+                jdouble angle = (M_PI * (jdouble) (((jlong) k * k) % (2 * (jlong) n))) / n;
+
+                chirp[2 * k] = cos(angle);
+                chirp[2 * k + 1] = -sin(angle);
+            }
+
+            memset(forwardSpectrum, 0, sizeof(jdouble) * 4 * m);
+
+            for (jint k = 0; k < n; k++) {
+
+                forwardSpectrum[2 * k] = chirp[2 * k];
+                forwardSpectrum[2 * k + 1] = -chirp[2 * k + 1];
+                backwardSpectrum[2 * k] = chirp[2 * k];
+                backwardSpectrum[2 * k + 1] = chirp[2 * k + 1];
+            }
+
+            for (jint k = 1; k < n; k++) {
+
+                forwardSpectrum[2 * (m - k)] = forwardSpectrum[2 * k];
+                forwardSpectrum[2 * (m - k) + 1] = forwardSpectrum[2 * k + 1];
+                backwardSpectrum[2 * (m - k)] = backwardSpectrum[2 * k];
+                backwardSpectrum[2 * (m - k) + 1] = backwardSpectrum[2 * k + 1];
+            }
+
+            MallocHandler mallocH(sizeof(jdouble) * this->convolutionPlan->getWorkLength());
+            jdouble *work = (jdouble *) mallocH.get();
+
+            this->convolutionPlan->execute(forwardSpectrum, -1, work);
+            this->convolutionPlan->execute(backwardSpectrum, -1, work);
+        }
+
+    } catch (...) {
+
+        free(this->twiddles);
+        free(this->chirps);
+        delete this->convolutionPlan;
+
+        throw;
+    }
+}
+
+FftPlan::~FftPlan() {
+
+    free(this->twiddles);
+    free(this->chirps);
+    delete this->convolutionPlan;
+}
+
+jint FftPlan::getWorkLength() {
+    return (this->m > 0) ? 2 * this->m + this->convolutionPlan->getWorkLength() : 2 * this->n;
+}
+
+void FftPlan::execute(jdouble *data, jint sign, jdouble *work) {
+
+    if (this->m > 0) {
+
+        bluestein(data, sign, work);
+
+    } else {
+
+        stockham(data, work, sign);
+    }
+}
+
+void FftPlan::stockham(jdouble *x, jdouble *y, jint sign) {
+
+    jint n = this->n;
+    jdouble *twiddles = this->twiddles;
+
+    jdouble *src = x;
+    jdouble *dst = y;
+
+    // Each pass splits every length len subsequence, interleaved with stride s, into r subsequences of length m.
+    for (jint f = 0, s = 1, len = n; f < this->nFactors; f++) {
+
+        jint r = this->factors[f];
+        jint m = len / r;
+
+        jdouble a[2 * MAX_GENERIC_RADIX], b[2 * MAX_GENERIC_RADIX];
+
+        for (jint p = 0; p < m; p++) {
+
+            for (jint q = 0; q < s; q++) {
+
+                for (jint t = 0; t < r; t++) {
+
+                    a[2 * t] = src[2 * (q + s * (p + t * m))];
+                    a[2 * t + 1] = src[2 * (q + s * (p + t * m)) + 1];
+                }
+
+                switch (r) {
+
+                case 2:
+
+                    b[0] = a[0] + a[2];
+                    b[1] = a[1] + a[3];
+                    b[2] = a[0] - a[2];
+                    b[3] = a[1] - a[3];
+
+                    break;
+
+                case 3:
+
+                {
+                    const jdouble c = 0.86602540378443864676 * sign;
+
+                    jdouble tRe = a[2] + a[4], tIm = a[3] + a[5];
+                    jdouble dRe = a[2] - a[4], dIm = a[3] - a[5];
+                    jdouble hRe = a[0] - 0.5 * tRe, hIm = a[1] - 0.5 * tIm;
+
+                    b[0] = a[0] + tRe;
+                    b[1] = a[1] + tIm;
+                    b[2] = hRe - c * dIm;
+                    b[3] = hIm + c * dRe;
+                    b[4] = hRe + c * dIm;
+                    b[5] = hIm - c * dRe;
+                }
+
+                    break;
+
+                case 4:
+
+                {
+                    jdouble t0Re = a[0] + a[4], t0Im = a[1] + a[5];
+                    jdouble t1Re = a[0] - a[4], t1Im = a[1] - a[5];
+                    jdouble t2Re = a[2] + a[6], t2Im = a[3] + a[7];
+
+                    // Multiply the difference by sign * i.
+                    jdouble t3Re = -(a[3] - a[7]) * sign, t3Im = (a[2] - a[6]) * sign;
+
+                    b[0] = t0Re + t2Re;
+                    b[1] = t0Im + t2Im;
+                    b[2] = t1Re + t3Re;
+                    b[3] = t1Im + t3Im;
+                    b[4] = t0Re - t2Re;
+                    b[5] = t0Im - t2Im;
+                    b[6] = t1Re - t3Re;
+                    b[7] = t1Im - t3Im;
+                }
+
+                    break;
+
+                case 5:
+
+                {
+                    const jdouble c1 = 0.30901699437494742410, c2 = -0.80901699437494742410;
+                    const jdouble s1 = 0.95105651629515357212 * sign, s2 = 0.58778525229247312917 * sign;
+
+                    jdouble s14Re = a[2] + a[8], s14Im = a[3] + a[9];
+                    jdouble d14Re = a[2] - a[8], d14Im = a[3] - a[9];
+                    jdouble s23Re = a[4] + a[6], s23Im = a[5] + a[7];
+                    jdouble d23Re = a[4] - a[6], d23Im = a[5] - a[7];
+
+                    jdouble u1Re = a[0] + c1 * s14Re + c2 * s23Re, u1Im = a[1] + c1 * s14Im + c2 * s23Im;
+                    jdouble u2Re = a[0] + c2 * s14Re + c1 * s23Re, u2Im = a[1] + c2 * s14Im + c1 * s23Im;
+
+                    // The rotated parts i * (s1 * d14 + s2 * d23) and i * (s2 * d14 - s1 * d23).
+                    jdouble v1Re = -(s1 * d14Im + s2 * d23Im), v1Im = s1 * d14Re + s2 * d23Re;
+                    jdouble v2Re = -(s2 * d14Im - s1 * d23Im), v2Im = s2 * d14Re - s1 * d23Re;
+
+                    b[0] = a[0] + s14Re + s23Re;
+                    b[1] = a[1] + s14Im + s23Im;
+                    b[2] = u1Re + v1Re;
+                    b[3] = u1Im + v1Im;
+                    b[4] = u2Re + v2Re;
+                    b[5] = u2Im + v2Im;
+                    b[6] = u2Re - v2Re;
+                    b[7] = u2Im - v2Im;
+                    b[8] = u1Re - v1Re;
+                    b[9] = u1Im - v1Im;
+                }
+
+                    break;
+
+                default:
+
+                    for (jint u = 0, stride = n / r; u < r; u++) {
+
+                        jdouble re = 0.0, im = 0.0;
+
+                        for (jint t = 0; t < r; t++) {
+
+                            jint k = ((t * u) % r) * stride;
+
+                            jdouble wRe = twiddles[2 * k];
+                            jdouble wIm = -sign * twiddles[2 * k + 1];
+
+                            re += a[2 * t] * wRe - a[2 * t + 1] * wIm;
+                            im += a[2 * t] * wIm + a[2 * t + 1] * wRe;
+                        }
+
+                        b[2 * u] = re;
+                        b[2 * u + 1] = im;
+                    }
+
+                    break;
+                }
+
+                // Apply the twiddle factors exp(sign * 2 pi i p u / len) and write out.
+                for (jint u = 0; u < r; u++) {
+
+                    jdouble *d = dst + 2 * (q + s * (r * p + u));
+
+                    if (p == 0 || u == 0) {
+
+                        d[0] = b[2 * u];
+                        d[1] = b[2 * u + 1];
+
+                    } else {
+
+                        jint k = p * u * s;
+
+                        jdouble wRe = twiddles[2 * k];
+                        jdouble wIm = -sign * twiddles[2 * k + 1];
+
+                        d[0] = b[2 * u] * wRe - b[2 * u + 1] * wIm;
+                        d[1] = b[2 * u] * wIm + b[2 * u + 1] * wRe;
+                    }
+                }
+            }
+        }
+
+        jdouble *tmp = src;
+        src = dst;
+        dst = tmp;
+
+        s *= r;
+        len = m;
+    }
+
+    if (src != x) {
+        memcpy(x, src, sizeof(jdouble) * 2 * n);
+    }
+}
+
+void FftPlan::bluestein(jdouble *data, jint sign, jdouble *work) {
+
+    jint n = this->n;
+    jint m = this->m;
+
+    // Backward transforms use the conjugate chirp.
+    jdouble *chirp = this->chirps;
+    jdouble *spectrum = this->chirps + 2 * n + ((sign < 0) ? 0 : 2 * m);
+    jdouble *conv = work;
+
+    memset(conv, 0, sizeof(jdouble) * 2 * m);
+
+    for (jint k = 0; k < n; k++) {
+
+        jdouble wRe = chirp[2 * k];
+        jdouble wIm = -sign * chirp[2 * k + 1];
+
+        conv[2 * k] = data[2 * k] * wRe - data[2 * k + 1] * wIm;
+        conv[2 * k + 1] = data[2 * k] * wIm + data[2 * k + 1] * wRe;
+    }
+
+    this->convolutionPlan->execute(conv, -1, work + 2 * m);
+
+    for (jint k = 0; k < m; k++) {
+
+        jdouble re = conv[2 * k] * spectrum[2 * k] - conv[2 * k + 1] * spectrum[2 * k + 1];
+        jdouble im = conv[2 * k] * spectrum[2 * k + 1] + conv[2 * k + 1] * spectrum[2 * k];
+
+        conv[2 * k] = re;
+        conv[2 * k + 1] = im;
+    }
+
+    this->convolutionPlan->execute(conv, 1, work + 2 * m);
+
+    jdouble scalingFactor = 1.0 / m;
+
+    for (jint k = 0; k < n; k++) {
+
+        jdouble wRe = chirp[2 * k] * scalingFactor;
+        jdouble wIm = -sign * chirp[2 * k + 1] * scalingFactor;
+
+        data[2 * k] = conv[2 * k] * wRe - conv[2 * k + 1] * wIm;
+        data[2 * k + 1] = conv[2 * k] * wIm + conv[2 * k + 1] * wRe;
+    }
+}
+
+//
+
+RealFftPlan::RealFftPlan(jint n) {
+
+    this->n = n;
+    this->plan = NULL;
+    this->twiddles = NULL;
+
+    try {
+
+        if (n % 2 == 0) {
+
+            jint h = n / 2;
+
+            this->plan = new FftPlan(h);
+            this->twiddles = (jdouble *) malloc(sizeof(jdouble) * 2 * (h + 1));
+
+            if (!this->twiddles) {
+                throw std::runtime_error("Allocation failed");
+            }
+
+            for (jint k = 0; k <= h; k++) {
+
+                jdouble angle = (2.0 * M_PI * k) / n;
+
+                this->twiddles[2 * k] = cos(angle);
+                this->twiddles[2 * k + 1] = -sin(angle);
+            }
+
+        } else {
+
+            this->plan = new FftPlan(n);
+        }
+
+    } catch (...) {
+
+        free(this->twiddles);
+        delete this->plan;
+
+        throw;
+    }
+}
+
+RealFftPlan::~RealFftPlan() {
+
+    free(this->twiddles);
+    delete this->plan;
+}
+
+jint RealFftPlan::getWorkLength() {
+    return ((this->n % 2 == 0) ? this->n : 2 * this->n) + this->plan->getWorkLength();
+}
+
+void RealFftPlan::forward(const jdouble *in, jdouble *out, jdouble *work) {
+
+    jint n = this->n;
+
+    if (n % 2 != 0) {
+
+        jdouble *z = work;
+
+        for (jint j = 0; j < n; j++) {
+
+            z[2 * j] = in[j];
+            z[2 * j + 1] = 0.0;
+        }
+
+        this->plan->execute(z, -1, work + 2 * n);
+
+        memcpy(out, z, sizeof(jdouble) * 2 * (n / 2 + 1));
+
+        return;
+    }
+
+    // Transform even and odd samples as the real and imaginary parts of a half length sequence.
+
+    jint h = n / 2;
+    jdouble *z = work;
+
+    memcpy(z, in, sizeof(jdouble) * n);
+
+    this->plan->execute(z, -1, work + n);
+
+    for (jint k = 0; k <= h; k++) {
+
+        jint k1 = (k < h) ? k : 0;
+        jint k2 = (k > 0) ? h - k : 0;
+
+        jdouble zRe = z[2 * k1], zIm = z[2 * k1 + 1];
+        jdouble cRe = z[2 * k2], cIm = -z[2 * k2 + 1];
+
+        // The even part (z_k + conj(z_{h - k})) / 2 and the odd part -i (z_k - conj(z_{h - k})) / 2.
+        jdouble eRe = 0.5 * (zRe + cRe), eIm = 0.5 * (zIm + cIm);
+        jdouble oRe = 0.5 * (zIm - cIm), oIm = -0.5 * (zRe - cRe);
+
+        jdouble wRe = this->twiddles[2 * k], wIm = this->twiddles[2 * k + 1];
+
+        out[2 * k] = eRe + oRe * wRe - oIm * wIm;
+        out[2 * k + 1] = eIm + oRe * wIm + oIm * wRe;
+    }
+}
+
+void RealFftPlan::backward(const jdouble *in, jdouble *out, jdouble *work) {
+
+    jint n = this->n;
+    jint h = n / 2;
+
+    if (n % 2 != 0) {
+
+        jdouble *z = work;
+
+        z[0] = in[0];
+        z[1] = 0.0;
+
+        for (jint k = 1; k <= h; k++) {
+
+            z[2 * k] = in[2 * k];
+            z[2 * k + 1] = in[2 * k + 1];
+            z[2 * (n - k)] = in[2 * k];
+            z[2 * (n - k) + 1] = -in[2 * k + 1];
+        }
+
+        this->plan->execute(z, 1, work + 2 * n);
+
+        for (jint j = 0; j < n; j++) {
+            out[j] = z[2 * j];
+        }
+
+        return;
+    }
+
+    // Recombine the even and odd parts into a half length sequence, ignoring the imaginary parts at zero and Nyquist.
+
+    jdouble *z = work;
+
+    for (jint k = 0; k < h; k++) {
+
+        jdouble xRe = in[2 * k], xIm = (k > 0) ? in[2 * k + 1] : 0.0;
+        jdouble cRe = in[2 * (h - k)], cIm = (k > 0) ? -in[2 * (h - k) + 1] : 0.0;
+
+        jdouble eRe = xRe + cRe, eIm = xIm + cIm;
+        jdouble dRe = xRe - cRe, dIm = xIm - cIm;
+
+        // The odd part (x_k - conj(x_{h - k})) * conj(w_k).
+        jdouble wRe = this->twiddles[2 * k], wIm = -this->twiddles[2 * k + 1];
+        jdouble oRe = dRe * wRe - dIm * wIm, oIm = dRe * wIm + dIm * wRe;
+
+        z[2 * k] = eRe - oIm;
+        z[2 * k + 1] = eIm + oRe;
+    }
+
+    this->plan->execute(z, 1, work + n);
+
+    memcpy(out, z, sizeof(jdouble) * n);
+}
+
+//
+
+void NativeFftService::transformComplex(jdouble *values, const jint *dims, jint nDims, jint nTransformDims,
+        jint sign) {
+
+    jint len = Common::product((jint *) dims, nDims, (jint) 1);
+
+    for (jint dim = 0; dim < nTransformDims; dim++) {
+
+        jint n = dims[dim];
+
+        if (n == 1) {
+            continue;
+        }
+
+        jint stride = Common::product((jint *) dims + dim + 1, nDims - dim - 1, (jint) 1);
+        jint nOuter = len / (n * stride);
+        jint blockSize = std::min(stride, (jint) MAX_BLOCK_LINES);
+
+        FftPlan plan(n);
+
+        MallocHandler mallocH(sizeof(jdouble) * (2 * n * blockSize + plan.getWorkLength()));
+        jdouble *lines = (jdouble *) mallocH.get();
+        jdouble *work = lines + 2 * n * blockSize;
+
+        for (jint outer = 0; outer < nOuter; outer++) {
+
+            jdouble *base = values + 2 * outer * n * stride;
+
+            if (stride == 1) {
+
+                plan.execute(base, sign, work);
+
+                continue;
+            }
+
+            // Gather blocks of adjacent lines so that memory is traversed contiguously.
+            for (jint q = 0; q < stride; q += blockSize) {
+
+                jint nLines = std::min(blockSize, stride - q);
+
+                for (jint t = 0; t < n; t++) {
+
+                    jdouble *row = base + 2 * (t * stride + q);
+
+                    for (jint b = 0; b < nLines; b++) {
+
+                        lines[2 * (b * n + t)] = row[2 * b];
+                        lines[2 * (b * n + t) + 1] = row[2 * b + 1];
+                    }
+                }
+
+                for (jint b = 0; b < nLines; b++) {
+                    plan.execute(lines + 2 * b * n, sign, work);
+                }
+
+                for (jint t = 0; t < n; t++) {
+
+                    jdouble *row = base + 2 * (t * stride + q);
+
+                    for (jint b = 0; b < nLines; b++) {
+
+                        row[2 * b] = lines[2 * (b * n + t)];
+                        row[2 * b + 1] = lines[2 * (b * n + t) + 1];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void NativeFftService::checkDimensions(const jint *dims, jint nDims) {
+
+    if (nDims == 0) {
+        throw std::runtime_error("Rank must be greater than zero");
+    }
+
+    for (jint dim = 0; dim < nDims; dim++) {
+
+        if (dims[dim] <= 0) {
+            throw std::runtime_error("Invalid dimensions");
+        }
+    }
+}
+
+void NativeFftService::rfft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+
+    try {
+
+        if (!dims || !in || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nDims = env->GetArrayLength(dims);
+        jint inLen = env->GetArrayLength(in);
+        jint outLen = env->GetArrayLength(out);
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler inH(env, in, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jdouble *inArr = (jdouble *) inH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+
+        NativeFftService::checkDimensions(dimsArr, nDims);
+
+        jint n = dimsArr[nDims - 1];
+        jint h = n / 2 + 1;
+        jint nRows = Common::product(dimsArr, nDims - 1, (jint) 1);
+
+        if (inLen != nRows * n || outLen != nRows * 2 * h) {
+            throw std::runtime_error("Input and/or output arrays do not have expected sizes");
+        }
+
+        RealFftPlan plan(n);
+
+        MallocHandler mallocH(sizeof(jdouble) * plan.getWorkLength());
+        jdouble *work = (jdouble *) mallocH.get();
+
+        for (jint row = 0; row < nRows; row++) {
+            plan.forward(inArr + row * n, outArr + row * 2 * h, work);
+        }
+
+        MallocHandler reducedDimsH(sizeof(jint) * nDims);
+        jint *reducedDims = (jint *) reducedDimsH.get();
+
+        memcpy(reducedDims, dimsArr, sizeof(jint) * nDims);
+        reducedDims[nDims - 1] = h;
+
+        NativeFftService::transformComplex(outArr, reducedDims, nDims, nDims - 1, -1);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeFftService::rifft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+
+    try {
+
+        if (!dims || !in || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nDims = env->GetArrayLength(dims);
+        jint inLen = env->GetArrayLength(in);
+        jint outLen = env->GetArrayLength(out);
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler inH(env, in, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jdouble *inArr = (jdouble *) inH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+
+        NativeFftService::checkDimensions(dimsArr, nDims);
+
+        jint n = dimsArr[nDims - 1];
+        jint h = n / 2 + 1;
+        jint nRows = Common::product(dimsArr, nDims - 1, (jint) 1);
+
+        if (inLen != nRows * 2 * h || outLen != nRows * n) {
+            throw std::runtime_error("Input and/or output arrays do not have expected sizes");
+        }
+
+        RealFftPlan plan(n);
+
+        MallocHandler mallocH(sizeof(jdouble) * (inLen + plan.getWorkLength()) + sizeof(jint) * nDims);
+        jdouble *reduced = (jdouble *) mallocH.get();
+        jdouble *work = reduced + inLen;
+        jint *reducedDims = (jint *) (work + plan.getWorkLength());
+
+        memcpy(reduced, inArr, sizeof(jdouble) * inLen);
+        memcpy(reducedDims, dimsArr, sizeof(jint) * nDims);
+        reducedDims[nDims - 1] = h;
+
+        NativeFftService::transformComplex(reduced, reducedDims, nDims, nDims - 1, 1);
+
+        for (jint row = 0; row < nRows; row++) {
+            plan.backward(reduced + row * 2 * h, outArr + row * n, work);
+        }
+
+        jdouble scalingFactor = 1.0 / outLen;
+
+        for (jint i = 0; i < outLen; i++) {
+            outArr[i] *= scalingFactor;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeFftService::fft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+
+    try {
+
+        if (!dims || !in || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nDims = env->GetArrayLength(dims);
+        jint inLen = env->GetArrayLength(in);
+        jint outLen = env->GetArrayLength(out);
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler inH(env, in, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jdouble *inArr = (jdouble *) inH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+
+        NativeFftService::checkDimensions(dimsArr, nDims);
+
+        jint len = Common::product(dimsArr, nDims, (jint) 1);
+
+        if (inLen != 2 * len || outLen != 2 * len) {
+            throw std::runtime_error("Input and/or output arrays do not have expected sizes");
+        }
+
+        if (outArr != inArr) {
+            memcpy(outArr, inArr, sizeof(jdouble) * outLen);
+        }
+
+        NativeFftService::transformComplex(outArr, dimsArr, nDims, nDims, -1);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeFftService::ifft(JNIEnv *env, jobject thisObj, //
+        jintArray dims, jdoubleArray in, jdoubleArray out) {
+
+    try {
+
+        if (!dims || !in || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nDims = env->GetArrayLength(dims);
+        jint inLen = env->GetArrayLength(in);
+        jint outLen = env->GetArrayLength(out);
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler inH(env, in, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jdouble *inArr = (jdouble *) inH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+
+        NativeFftService::checkDimensions(dimsArr, nDims);
+
+        jint len = Common::product(dimsArr, nDims, (jint) 1);
+
+        if (inLen != 2 * len || outLen != 2 * len) {
+            throw std::runtime_error("Input and/or output arrays do not have expected sizes");
+        }
+
+        if (outArr != inArr) {
+            memcpy(outArr, inArr, sizeof(jdouble) * outLen);
+        }
+
+        NativeFftService::transformComplex(outArr, dimsArr, nDims, nDims, 1);
+
+        jdouble scalingFactor = 1.0 / len;
+
+        for (jint i = 0; i < outLen; i++) {
+            outArr[i] *= scalingFactor;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
@@ -0,0 +1,813 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeImageKernel.hpp>
+
+/**
+ * The number of padding cells on either side of each bilateral grid dimension.
+ */
+#define GRID_PADDING 1
+
+/**
+ * A hash table of permutohedral lattice points, each with a vector of values. Storage grows geometrically as points are
+ * inserted.
+ */
+class PermutohedralLattice {
+
+public:
+
+    /**
+     * Default constructor.
+     * 
+     * @param nKeys
+     *      the number of key components.
+     * @param nValues
+     *      the number of value components.
+     * @param capacity
+     *      the initial capacity.
+     */
+    explicit PermutohedralLattice(jint nKeys, jint nValues, jint capacity);
+
+    /**
+     * Default destructor.
+     */
+    ~PermutohedralLattice();
+
+    /**
+     * Looks up a lattice point, and inserts it if it isn't present.
+     * 
+     * @param key
+     *      the key.
+     * @return the index of the lattice point.
+     */
+    jint insert(const jint *key);
+
+    /**
+     * Looks up a lattice point.
+     * 
+     * @param key
+     *      the key.
+     * @return the index of the lattice point, or -1 if it isn't present.
+     */
+    jint find(const jint *key);
+
+    /**
+     * The keys of lattice points.
+     */
+    jint *keys;
+
+    /**
+     * The values of lattice points.
+     */
+    jdouble *values;
+
+    /**
+     * The number of lattice points.
+     */
+    jint size;
+
+private:
+
+    PermutohedralLattice(const PermutohedralLattice &);
+
+    PermutohedralLattice &operator=(const PermutohedralLattice &);
+
+    /**
+     * Finds the slot of a key.
+     */
+    jint slotOf(const jint *key);
+
+    /**
+     * Doubles the capacity.
+     */
+    void grow();
+
+    jint nKeys;
+
+    jint nValues;
+
+    jint capacity;
+
+    jint *slots;
+};
+
+PermutohedralLattice::PermutohedralLattice(jint nKeys, jint nValues, jint capacity) {
+
+    this->nKeys = nKeys;
+    this->nValues = nValues;
+    this->capacity = 1;
+    this->size = 0;
+
+    while (this->capacity < 2 * capacity) {
+        this->capacity <<= 1;
+    }
+
+    this->slots = (jint *) malloc(sizeof(jint) * this->capacity);
+    this->keys = (jint *) malloc(sizeof(jint) * nKeys * (this->capacity >> 1));
+    this->values = (jdouble *) malloc(sizeof(jdouble) * nValues * (this->capacity >> 1));
+
+    if (!this->slots || !this->keys || !this->values) {
+
+        free(this->slots);
+        free(this->keys);
+        free(this->values);
+
+        throw std::runtime_error("Allocation failed");
+    }
+
+    for (jint i = 0; i < this->capacity; i++) {
+        this->slots[i] = -1;
+    }
+}
+
+PermutohedralLattice::~PermutohedralLattice() {
+
+    free(this->slots);
+    free(this->keys);
+    free(this->values);
+}
+
+jint PermutohedralLattice::slotOf(const jint *key) {
+
+    jint nKeys = this->nKeys;
+    jint mask = this->capacity - 1;
+
+    unsigned int hash = 0;
+
+    for (jint i = 0; i < nKeys; i++) {
+        hash = (hash + (unsigned int) key[i]) * 2531011U;
+    }
+
+    // Lattice keys share residues, so fold the high bits into the low bits used for indexing.
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bU;
+    hash ^= hash >> 13;
+
+    for (jint slot = (jint) (hash & mask);; slot = (slot + 1) & mask) {
+
+        jint index = this->slots[slot];
+
+        if (index < 0 || !memcmp(this->keys + index * nKeys, key, sizeof(jint) * nKeys)) {
+            return slot;
+        }
+    }
+}
+
+jint PermutohedralLattice::find(const jint *key) {
+    return this->slots[slotOf(key)];
+}
+
+jint PermutohedralLattice::insert(const jint *key) {
+
+    jint slot = slotOf(key);
+    jint index = this->slots[slot];
+
+    if (index >= 0) {
+        return index;
+    }
+
+    index = this->size++;
+
+    this->slots[slot] = index;
+
+    memcpy(this->keys + index * this->nKeys, key, sizeof(jint) * this->nKeys);
+
+    for (jint i = 0; i < this->nValues; i++) {
+        this->values[index * this->nValues + i] = 0.0;
+    }
+
+    // Keep the load factor at most one half.
+    if (2 * this->size >= this->capacity) {
+        grow();
+    }
+
+    return index;
+}
+
+void PermutohedralLattice::grow() {
+
+    if (this->capacity > (1 << 29)) {
+        throw std::runtime_error("Lattice too large");
+    }
+
+    jint capacity = this->capacity << 1;
+
+    jint *slots = (jint *) malloc(sizeof(jint) * capacity);
+    jint *keys = (jint *) realloc(this->keys, sizeof(jint) * this->nKeys * (capacity >> 1));
+
+    if (keys) {
+        this->keys = keys;
+    }
+
+    jdouble *values = (jdouble *) realloc(this->values, sizeof(jdouble) * this->nValues * (capacity >> 1));
+
+    if (values) {
+        this->values = values;
+    }
+
+    if (!slots || !keys || !values) {
+
+        free(slots);
+
+        throw std::runtime_error("Allocation failed");
+    }
+
+    free(this->slots);
+
+    this->slots = slots;
+    this->capacity = capacity;
+
+    for (jint i = 0; i < capacity; i++) {
+        slots[i] = -1;
+    }
+
+    for (jint index = 0; index < this->size; index++) {
+        slots[slotOf(this->keys + index * this->nKeys)] = index;
+    }
+}
+
+void NativeImageKernel::bilateralFilter(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray sigmas, //
+        jdoubleArray dstV) {
+
+    try {
+
+        if (!srcV || !srcD || !srcS || !sigmas || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint nDims = env->GetArrayLength(srcD);
+        jint nSpatialDims = env->GetArrayLength(sigmas) - 1;
+
+        if ((nDims == 0)
+                || (nDims != env->GetArrayLength(srcS))
+                || (nSpatialDims != nDims && nSpatialDims != nDims - 1)
+                || (srcLen != env->GetArrayLength(dstV))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler sigmasH(env, sigmas, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jdouble *sigmasArr = (jdouble *) sigmasH.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        for (jint dim = 0; dim <= nSpatialDims; dim++) {
+
+            if (!(sigmasArr[dim] > 0.0 && sigmasArr[dim] < HUGE_VAL)) {
+                throw std::runtime_error("Invalid standard deviation");
+            }
+        }
+
+        if (!srcLen) {
+            return;
+        }
+
+        jint nChannels = srcLen / Common::product(srcDArr, nSpatialDims, (jint) 1);
+
+        MallocHandler mallocH((2 * sizeof(jdouble) + sizeof(jint)) * srcLen);
+        void *all = mallocH.get();
+
+        jdouble *values = (jdouble *) all;
+        jdouble *filtered = values + srcLen;
+        jint *srcIndices = (jint *) (filtered + srcLen);
+
+        MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+        for (jint i = 0; i < srcLen; i++) {
+            values[i] = srcVArr[srcIndices[i]];
+        }
+
+        if (nChannels == 1) {
+
+            bilateralGrid(values, filtered, srcDArr, nSpatialDims, sigmasArr, sigmasArr[nSpatialDims]);
+
+        } else {
+
+            bilateralLattice(values, filtered, srcDArr, nSpatialDims, nChannels, sigmasArr, sigmasArr[nSpatialDims]);
+        }
+
+        for (jint i = 0; i < srcLen; i++) {
+            dstVArr[srcIndices[i]] = filtered[i];
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::bilateralGrid(const jdouble *values, jdouble *dst, //
+        jint *dims, jint nDims, jdouble *spatialSigmas, jdouble rangeSigma) {
+
+    jint len = Common::product(dims, nDims, (jint) 1);
+
+    jdouble lower = HUGE_VAL;
+    jdouble upper = -HUGE_VAL;
+
+    for (jint i = 0; i < len; i++) {
+
+        jdouble value = values[i];
+
+        if (value > -HUGE_VAL && value < HUGE_VAL) {
+
+            lower = std::min(lower, value);
+            upper = std::max(upper, value);
+        }
+    }
+
+    if (lower > upper) {
+
+        memcpy(dst, values, sizeof(jdouble) * len);
+
+        return;
+    }
+
+    jint nGridDims = nDims + 1;
+    jint nCorners = 1 << nGridDims;
+
+    MallocHandler dimsH((sizeof(jdouble) * 4 + sizeof(jint) * 3) * nGridDims);
+    void *dimsAll = dimsH.get();
+
+    jdouble *scales = (jdouble *) dimsAll;
+    jdouble *lowers = scales + nGridDims;
+    jdouble *fractions = scales + 2 * nGridDims;
+    jdouble *positions = scales + 3 * nGridDims;
+    jint *gridD = (jint *) (scales + 4 * nGridDims);
+    jint *gridS = gridD + nGridDims;
+    jint *bases = gridD + 2 * nGridDims;
+
+    // The grid samples each dimension at its standard deviation, and an extra cell absorbs round-off at the upper end.
+    jdouble gridLen = 2.0;
+
+    for (jint dim = 0; dim < nGridDims; dim++) {
+
+        scales[dim] = 1.0 / ((dim < nDims) ? spatialSigmas[dim] : rangeSigma);
+        lowers[dim] = (dim < nDims) ? 0.0 : lower;
+
+        jdouble size = floor(((dim < nDims) ? dims[dim] - 1 : upper - lower) * scales[dim]) + 2 + 2 * GRID_PADDING;
+
+        gridLen *= size;
+
+        if (!(gridLen < (1 << 27))) {
+            throw std::runtime_error("Grid too large");
+        }
+
+        gridD[dim] = (jint) size;
+    }
+
+    gridS[nGridDims - 1] = 2;
+
+    for (jint dim = nGridDims - 1; dim > 0; dim--) {
+        gridS[dim - 1] = gridS[dim] * gridD[dim];
+    }
+
+    MallocHandler gridH(sizeof(jdouble) * (jint) gridLen);
+    jdouble *grid = (jdouble *) gridH.get();
+
+    for (jint i = 0, n = (jint) gridLen; i < n; i++) {
+        grid[i] = 0.0;
+    }
+
+    // Splat homogeneous values into the grid with multilinear weights.
+    for (jint pass = 0; pass < 2; pass++) {
+
+        for (jint dim = 0; dim < nDims; dim++) {
+            positions[dim] = 0.0;
+        }
+
+        for (jint i = 0; i < len; i++) {
+
+            jdouble value = values[i];
+
+            if (value > -HUGE_VAL && value < HUGE_VAL) {
+
+                positions[nDims] = value;
+
+                jint base = 0;
+
+                for (jint dim = 0; dim < nGridDims; dim++) {
+
+                    jdouble position = (positions[dim] - lowers[dim]) * scales[dim] + GRID_PADDING;
+
+                    bases[dim] = (jint) position;
+                    fractions[dim] = position - bases[dim];
+                    base += bases[dim] * gridS[dim];
+                }
+
+                jdouble acc = 0.0;
+                jdouble weightAcc = 0.0;
+
+                for (jint corner = 0; corner < nCorners; corner++) {
+
+                    jdouble weight = 1.0;
+                    jint offset = base;
+
+                    for (jint dim = 0; dim < nGridDims; dim++) {
+
+                        if (corner & (1 << dim)) {
+
+                            weight *= fractions[dim];
+                            offset += gridS[dim];
+
+                        } else {
+
+                            weight *= 1.0 - fractions[dim];
+                        }
+                    }
+
+                    if (!pass) {
+
+                        grid[offset] += weight * value;
+                        grid[offset + 1] += weight;
+
+                    } else {
+
+                        acc += weight * grid[offset];
+                        weightAcc += weight * grid[offset + 1];
+                    }
+                }
+
+                if (pass) {
+                    dst[i] = acc / weightAcc;
+                }
+
+            } else if (pass) {
+
+                dst[i] = value;
+            }
+
+            for (jint dim = nDims - 1; dim >= 0 && ++positions[dim] == dims[dim]; dim--) {
+                positions[dim] = 0.0;
+            }
+        }
+
+        if (!pass) {
+            blurGrid(grid, gridD, nGridDims, 2);
+        }
+    }
+}
+
+void NativeImageKernel::blurGrid(jdouble *values, jint *dims, jint nDims, jint nValues) {
+
+    jint len = Common::product(dims, nDims, (jint) 1) * nValues;
+    jint bufferLen = 0;
+
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+        bufferLen = std::max(bufferLen, blockSize / dims[dim]);
+    }
+
+    MallocHandler mallocH(sizeof(jdouble) * 2 * bufferLen);
+    void *all = mallocH.get();
+
+    jdouble *prev = (jdouble *) all;
+    jdouble *curr = prev + bufferLen;
+
+    // Convolve with the kernel [1 2 1] / 4 along each dimension, treating the outside as zero.
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+        jint size = dims[dim];
+        jint rowSize = blockSize / size;
+
+        for (jint offset = 0; offset < len; offset += blockSize) {
+
+            for (jint i = 0; i < rowSize; i++) {
+                prev[i] = 0.0;
+            }
+
+            for (jint k = 0; k < size; k++) {
+
+                jdouble *row = values + offset + k * rowSize;
+                const jdouble *next = row + rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    curr[i] = row[i];
+                }
+
+                if (k + 1 < size) {
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        row[i] = 0.5 * row[i] + 0.25 * (prev[i] + next[i]);
+                    }
+
+                } else {
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        row[i] = 0.5 * row[i] + 0.25 * prev[i];
+                    }
+                }
+
+                std::swap(prev, curr);
+            }
+        }
+    }
+}
+
+void NativeImageKernel::bilateralLattice(const jdouble *values, jdouble *dst, //
+        jint *dims, jint nDims, jint nChannels, jdouble *spatialSigmas, jdouble rangeSigma) {
+
+    jint len = Common::product(dims, nDims, (jint) 1);
+    jint d = nDims + nChannels;
+    jint nValues = nChannels + 1;
+
+    MallocHandler dimsH(sizeof(jdouble) * (d + 2 * (d + 1) + 1 + nValues) //
+            + sizeof(jint) * (nDims + 3 * (d + 1) + (d + 1) * (d + 1)));
+    void *dimsAll = dimsH.get();
+
+    jdouble *scales = (jdouble *) dimsAll;
+    jdouble *elevated = scales + d;
+    jdouble *barycentric = elevated + (d + 1);
+    jdouble *acc = barycentric + (d + 2);
+    jint *positions = (jint *) (acc + nValues);
+    jint *greedy = positions + nDims;
+    jint *rank = greedy + (d + 1);
+    jint *key = rank + (d + 1);
+    jint *canonical = key + (d + 1);
+
+    // Features are scaled so that the lattice blur approximates a Gaussian of unit variance.
+    for (jint i = 0; i < d; i++) {
+
+        jdouble sigma = (i < nDims) ? spatialSigmas[i] : rangeSigma;
+
+        scales[i] = (d + 1) * sqrt(2.0 / 3.0) / sqrt((i + 1.0) * (i + 2.0)) / sigma;
+    }
+
+    for (jint i = 0; i <= d; i++) {
+
+        for (jint j = 0; j <= d; j++) {
+            canonical[i * (d + 1) + j] = (j <= d - i) ? i : i - (d + 1);
+        }
+    }
+
+    if (!((jdouble) (sizeof(jdouble) + sizeof(jint)) * (d + 1) * len < (1 << 30))) {
+        throw std::runtime_error("Lattice too large");
+    }
+
+    MallocHandler pixelsH((sizeof(jdouble) + sizeof(jint)) * (d + 1) * len);
+    void *pixelsAll = pixelsH.get();
+
+    jdouble *weights = (jdouble *) pixelsAll;
+    jint *indices = (jint *) (weights + (d + 1) * len);
+
+    PermutohedralLattice lattice(d, nValues, len);
+
+    for (jint dim = 0; dim < nDims; dim++) {
+        positions[dim] = 0;
+    }
+
+    // Splat homogeneous values onto the vertices of enclosing simplices.
+    for (jint i = 0; i < len; i++) {
+
+        const jdouble *pixel = values + i * nChannels;
+        jint *pixelIndices = indices + i * (d + 1);
+        jdouble *pixelWeights = weights + i * (d + 1);
+
+        bool finite = true;
+
+        for (jint c = 0; c < nChannels; c++) {
+            finite &= (pixel[c] > -HUGE_VAL && pixel[c] < HUGE_VAL);
+        }
+
+        if (finite) {
+
+            // Project onto the hyperplane of coordinates summing to zero.
+            jdouble sum = 0.0;
+
+            for (jint j = d; j > 0; j--) {
+
+                jdouble feature = ((j - 1 < nDims) ? positions[j - 1] : pixel[j - 1 - nDims]) * scales[j - 1];
+
+                elevated[j] = sum - j * feature;
+                sum += feature;
+            }
+
+            elevated[0] = sum;
+
+            // Find the nearest remainder-zero lattice point.
+            jint remainder = 0;
+
+            for (jint j = 0; j <= d; j++) {
+
+                jdouble v = elevated[j] / (d + 1);
+                jdouble up = ceil(v) * (d + 1);
+                jdouble down = floor(v) * (d + 1);
+
+                greedy[j] = (jint) ((up - elevated[j] < elevated[j] - down) ? up : down);
+                remainder += greedy[j];
+                rank[j] = 0;
+            }
+
+            remainder /= d + 1;
+
+            // Rank differentials to find the enclosing simplex.
+            for (jint j = 0; j < d; j++) {
+
+                for (jint k = j + 1; k <= d; k++) {
+
+                    if (elevated[j] - greedy[j] < elevated[k] - greedy[k]) {
+
+                        rank[j]++;
+
+                    } else {
+
+                        rank[k]++;
+                    }
+                }
+            }
+
+            if (remainder > 0) {
+
+                for (jint j = 0; j <= d; j++) {
+
+                    if (rank[j] >= d + 1 - remainder) {
+
+                        greedy[j] -= d + 1;
+                        rank[j] += remainder - (d + 1);
+
+                    } else {
+
+                        rank[j] += remainder;
+                    }
+                }
+
+            } else if (remainder < 0) {
+
+                for (jint j = 0; j <= d; j++) {
+
+                    if (rank[j] < -remainder) {
+
+                        greedy[j] += d + 1;
+                        rank[j] += (d + 1) + remainder;
+
+                    } else {
+
+                        rank[j] += remainder;
+                    }
+                }
+            }
+
+            for (jint j = 0; j <= d + 1; j++) {
+                barycentric[j] = 0.0;
+            }
+
+            for (jint j = 0; j <= d; j++) {
+
+                jdouble delta = (elevated[j] - greedy[j]) / (d + 1);
+
+                barycentric[d - rank[j]] += delta;
+                barycentric[d + 1 - rank[j]] -= delta;
+            }
+
+            barycentric[0] += 1.0 + barycentric[d + 1];
+
+            for (jint r = 0; r <= d; r++) {
+
+                for (jint j = 0; j < d; j++) {
+                    key[j] = greedy[j] + canonical[r * (d + 1) + rank[j]];
+                }
+
+                jint index = lattice.insert(key);
+                jdouble *vertex = lattice.values + index * nValues;
+
+                for (jint c = 0; c < nChannels; c++) {
+                    vertex[c] += barycentric[r] * pixel[c];
+                }
+
+                vertex[nChannels] += barycentric[r];
+
+                pixelIndices[r] = index;
+                pixelWeights[r] = barycentric[r];
+            }
+
+        } else {
+
+            pixelIndices[0] = -1;
+        }
+
+        for (jint dim = nDims - 1; dim >= 0 && ++positions[dim] == dims[dim]; dim--) {
+            positions[dim] = 0;
+        }
+    }
+
+    // Blur along each lattice direction with the kernel [1 2 1] / 4.
+    jint nPoints = lattice.size;
+
+    MallocHandler blurH(sizeof(jdouble) * nPoints * nValues + sizeof(jint) * 2 * d);
+    void *blurAll = blurH.get();
+
+    jdouble *blurred = (jdouble *) blurAll;
+    jint *prevKey = (jint *) (blurred + nPoints * nValues);
+    jint *nextKey = prevKey + d;
+
+    for (jint j = 0; j <= d; j++) {
+
+        for (jint i = 0; i < nPoints; i++) {
+
+            const jint *pointKey = lattice.keys + i * d;
+
+            for (jint k = 0; k < d; k++) {
+
+                prevKey[k] = pointKey[k] + 1;
+                nextKey[k] = pointKey[k] - 1;
+            }
+
+            if (j < d) {
+
+                prevKey[j] = pointKey[j] - d;
+                nextKey[j] = pointKey[j] + d;
+            }
+
+            jint prev = lattice.find(prevKey);
+            jint next = lattice.find(nextKey);
+
+            const jdouble *point = lattice.values + i * nValues;
+            jdouble *res = blurred + i * nValues;
+
+            for (jint c = 0; c < nValues; c++) {
+                res[c] = 0.5 * point[c];
+            }
+
+            if (prev >= 0) {
+
+                const jdouble *prevPoint = lattice.values + prev * nValues;
+
+                for (jint c = 0; c < nValues; c++) {
+                    res[c] += 0.25 * prevPoint[c];
+                }
+            }
+
+            if (next >= 0) {
+
+                const jdouble *nextPoint = lattice.values + next * nValues;
+
+                for (jint c = 0; c < nValues; c++) {
+                    res[c] += 0.25 * nextPoint[c];
+                }
+            }
+        }
+
+        memcpy(lattice.values, blurred, sizeof(jdouble) * nPoints * nValues);
+    }
+
+    // Slice by barycentric interpolation, and then divide out the homogeneous coordinate.
+    for (jint i = 0; i < len; i++) {
+
+        const jint *pixelIndices = indices + i * (d + 1);
+        const jdouble *pixelWeights = weights + i * (d + 1);
+        jdouble *res = dst + i * nChannels;
+
+        if (pixelIndices[0] < 0) {
+
+            memcpy(res, values + i * nChannels, sizeof(jdouble) * nChannels);
+
+            continue;
+        }
+
+        for (jint c = 0; c < nValues; c++) {
+            acc[c] = 0.0;
+        }
+
+        for (jint r = 0; r <= d; r++) {
+
+            const jdouble *vertex = lattice.values + pixelIndices[r] * nValues;
+
+            for (jint c = 0; c < nValues; c++) {
+                acc[c] += pixelWeights[r] * vertex[c];
+            }
+        }
+
+        for (jint c = 0; c < nChannels; c++) {
+            res[c] = acc[c] / acc[nChannels];
+        }
+    }
+}
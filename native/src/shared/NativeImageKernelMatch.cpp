@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeImageKernel.hpp>
+
+#if defined(sstx_EXPORTS)
+#include <Plan.hpp>
+#else
+#include <NativeFftService.hpp>
+#endif
+
+void NativeImageKernel::normalizedCrossCorrelation(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray tplV, jintArray tplD, jintArray tplS, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS) {
+
+    try {
+
+        if (!srcV || !srcD || !srcS || !tplV || !tplD || !tplS || !dstV || !dstD || !dstS) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nDims = env->GetArrayLength(srcD);
+
+        if ((nDims == 0)
+                || (nDims != env->GetArrayLength(srcS))
+                || (nDims != env->GetArrayLength(tplD))
+                || (nDims != env->GetArrayLength(tplS))
+                || (nDims != env->GetArrayLength(dstD))
+                || (nDims != env->GetArrayLength(dstS))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        // Pin the dimensions noncritically, since plans may need to be created before entering the critical section.
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::INT, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler tplDh(env, tplD, ArrayPinHandler::INT, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::INT, ArrayPinHandler::READ_ONLY);
+
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *tplDArr = (jint *) tplDh.get();
+        jint *dstDArr = (jint *) dstDh.get();
+
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            if (!(tplDArr[dim] > 0 && tplDArr[dim] <= srcDArr[dim])) {
+                throw std::runtime_error("Invalid template dimensions");
+            }
+
+            if (srcDArr[dim] - tplDArr[dim] + 1 != dstDArr[dim]) {
+                throw std::runtime_error("Dimension mismatch");
+            }
+        }
+
+        jint srcLen = Common::product(srcDArr, nDims, (jint) 1);
+        jint tplLen = Common::product(tplDArr, nDims, (jint) 1);
+        jint dstLen = Common::product(dstDArr, nDims, (jint) 1);
+
+        // Correlate in the frequency domain once the direct approach would be substantially more expensive.
+        if ((jdouble) dstLen * tplLen > 8.0 * srcLen * (std::log((jdouble) srcLen) / std::log(2.0) + 1.0)) {
+
+#if defined(sstx_EXPORTS)
+
+            PlanHandler forwardH(env, org_sharedx_fftw_Plan_R_TO_C, srcDArr, nDims, //
+                    org_sharedx_fftw_Plan_FFTW_ESTIMATE);
+            PlanHandler backwardH(env, org_sharedx_fftw_Plan_C_TO_R, srcDArr, nDims, //
+                    org_sharedx_fftw_Plan_FFTW_ESTIMATE);
+
+            matchTemplate(env, //
+                    srcV, srcDArr, srcS, //
+                    tplV, tplDArr, tplS, //
+                    dstV, dstDArr, dstS, //
+                    nDims, forwardH.get(), backwardH.get());
+
+#else
+
+            // Without FFTW, real transforms along the last dimension feed portable complex transforms along the rest.
+            RealFftPlan plan(srcDArr[nDims - 1]);
+
+            matchTemplate(env, //
+                    srcV, srcDArr, srcS, //
+                    tplV, tplDArr, tplS, //
+                    dstV, dstDArr, dstS, //
+                    nDims, &plan, &plan);
+
+#endif
+
+            return;
+        }
+
+        matchTemplate(env, //
+                srcV, srcDArr, srcS, //
+                tplV, tplDArr, tplS, //
+                dstV, dstDArr, dstS, //
+                nDims, NULL, NULL);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::matchTemplate(JNIEnv *env, //
+        jdoubleArray srcV, jint *srcDArr, jintArray srcS, //
+        jdoubleArray tplV, jint *tplDArr, jintArray tplS, //
+        jdoubleArray dstV, jint *dstDArr, jintArray dstS, //
+        jint nDims, void *forwardPlan, void *backwardPlan) {
+
+    jint srcLen = env->GetArrayLength(srcV);
+    jint tplLen = env->GetArrayLength(tplV);
+    jint dstLen = env->GetArrayLength(dstV);
+
+    ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler tplVh(env, tplV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler tplSh(env, tplS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+    ArrayPinHandler dstSh(env, dstS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    // NO JNI AFTER THIS POINT!
+
+    jdouble *srcVArr = (jdouble *) srcVh.get();
+    jint *srcSArr = (jint *) srcSh.get();
+    jdouble *tplVArr = (jdouble *) tplVh.get();
+    jint *tplSArr = (jint *) tplSh.get();
+    jdouble *dstVArr = (jdouble *) dstVh.get();
+    jint *dstSArr = (jint *) dstSh.get();
+
+    MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+    MappingOps::checkDimensions(tplDArr, tplSArr, nDims, tplLen);
+    MappingOps::checkDimensions(dstDArr, dstSArr, nDims, dstLen);
+
+    jint tablesLen = 2;
+
+    for (jint dim = 0; dim < nDims; dim++) {
+        tablesLen *= srcDArr[dim] + 1;
+    }
+
+    jint srcLast = srcDArr[nDims - 1];
+    jint tplLast = tplDArr[nDims - 1];
+    jint dstLast = dstDArr[nDims - 1];
+    jint nTplRows = tplLen / tplLast;
+    jint nDstRows = dstLen / dstLast;
+    jint spectrumLen = forwardPlan ? 2 * (srcLen / srcLast) * (srcLast / 2 + 1) : 0;
+
+    MallocHandler mallocH(sizeof(jdouble) * (3 * srcLen + tplLen + 3 * dstLen + tablesLen + 2 * spectrumLen) //
+            + sizeof(jint) * (srcLen + tplLen + dstLen + nTplRows + 4 * nDims));
+    void *all = mallocH.get();
+
+    jdouble *srcBuf = (jdouble *) all;
+    jdouble *moments = srcBuf + srcLen;
+    jdouble *tplBuf = moments + 2 * srcLen;
+    jdouble *stats = tplBuf + tplLen;
+    jdouble *numerators = stats + 2 * dstLen;
+    jdouble *tables = numerators + dstLen;
+    jdouble *srcSpectrum = tables + tablesLen;
+    jdouble *tplSpectrum = srcSpectrum + spectrumLen;
+    jint *srcIndices = (jint *) (tplSpectrum + spectrumLen);
+    jint *tplIndices = srcIndices + srcLen;
+    jint *dstIndices = tplIndices + tplLen;
+    jint *tplRowOffsets = dstIndices + dstLen;
+    jint *rowStrides = tplRowOffsets + nTplRows;
+    jint *tablesD = rowStrides + nDims;
+    jint *lower = tablesD + nDims;
+    jint *upper = lower + nDims;
+
+    MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+    MappingOps::assignMappingIndices(tplIndices, tplDArr, tplSArr, nDims);
+    MappingOps::assignMappingIndices(dstIndices, dstDArr, dstSArr, nDims);
+
+    for (jint dim = nDims - 1, stride = 1; dim >= 0; stride *= srcDArr[dim--]) {
+
+        rowStrides[dim] = stride;
+        tablesD[dim] = srcDArr[dim] + 1;
+        lower[dim] = 0;
+        upper[dim] = tplDArr[dim];
+    }
+
+    // Offsets of template rows, as they would lie in the source.
+    for (jint row = 0; row < nTplRows; row++) {
+
+        jint offset = 0;
+
+        for (jint dim = nDims - 2, rem = row; dim >= 0; rem /= tplDArr[dim--]) {
+            offset += (rem % tplDArr[dim]) * rowStrides[dim];
+        }
+
+        tplRowOffsets[row] = offset;
+    }
+
+    // Center the source and template. The former doesn't change the numerators, since the template sums to zero.
+    jdouble srcShift = 0.0;
+    jdouble tplShift = 0.0;
+
+    for (jint i = 0; i < srcLen; i++) {
+        srcShift += srcVArr[i];
+    }
+
+    for (jint i = 0; i < tplLen; i++) {
+        tplShift += tplVArr[i];
+    }
+
+    srcShift /= srcLen;
+    tplShift /= tplLen;
+
+    jdouble srcNorm = 0.0;
+    jdouble tplNorm = 0.0;
+
+    for (jint i = 0; i < srcLen; i++) {
+
+        jdouble x = srcVArr[srcIndices[i]] - srcShift;
+
+        srcBuf[i] = x;
+        moments[2 * i] = x;
+        moments[2 * i + 1] = x * x;
+        srcNorm += x * x;
+    }
+
+    for (jint i = 0; i < tplLen; i++) {
+
+        jdouble t = tplVArr[tplIndices[i]] - tplShift;
+
+        tplBuf[i] = t;
+        tplNorm += t * t;
+    }
+
+    createIntegralTables(moments, tables, srcDArr, nDims, 2);
+    windowSums(tables, tablesD, stats, dstDArr, lower, upper, nDims, 2, false);
+
+    //
+
+    if (!forwardPlan) {
+
+        std::fill(numerators, numerators + dstLen, 0.0);
+
+        // Accumulate along contiguous output rows, one template element at a time.
+        for (jint row = 0; row < nDstRows; row++) {
+
+            jint base = 0;
+
+            for (jint dim = nDims - 2, rem = row; dim >= 0; rem /= dstDArr[dim--]) {
+                base += (rem % dstDArr[dim]) * rowStrides[dim];
+            }
+
+            jdouble *acc = numerators + row * dstLast;
+
+            for (jint tplRow = 0; tplRow < nTplRows; tplRow++) {
+
+                const jdouble *srcRow = srcBuf + base + tplRowOffsets[tplRow];
+                const jdouble *tplRowArr = tplBuf + tplRow * tplLast;
+
+                for (jint j = 0; j < tplLast; j++) {
+
+                    jdouble t = tplRowArr[j];
+                    const jdouble *s = srcRow + j;
+
+                    for (jint k = 0; k < dstLast; k++) {
+                        acc[k] += t * s[k];
+                    }
+                }
+            }
+        }
+
+    } else {
+
+        // Reuse the moments buffer for the zero-padded template and, later, the circular correlation.
+        jdouble *padded = moments;
+
+        std::fill(padded, padded + srcLen, 0.0);
+
+        for (jint tplRow = 0; tplRow < nTplRows; tplRow++) {
+            std::copy(tplBuf + tplRow * tplLast, tplBuf + (tplRow + 1) * tplLast, padded + tplRowOffsets[tplRow]);
+        }
+
+#if defined(sstx_EXPORTS)
+
+        fftw_execute_dft_r2c((fftw_plan) forwardPlan, srcBuf, (fftw_complex *) srcSpectrum);
+        fftw_execute_dft_r2c((fftw_plan) forwardPlan, padded, (fftw_complex *) tplSpectrum);
+
+#else
+
+        RealFftPlan *plan = (RealFftPlan *) forwardPlan;
+
+        jint nSrcRows = srcLen / srcLast;
+        jint h = srcLast / 2 + 1;
+
+        MallocHandler workH(sizeof(jdouble) * plan->getWorkLength() + sizeof(jint) * nDims);
+        jdouble *work = (jdouble *) workH.get();
+        jint *reducedDims = (jint *) (work + plan->getWorkLength());
+
+        std::copy(srcDArr, srcDArr + nDims, reducedDims);
+        reducedDims[nDims - 1] = h;
+
+        for (jint row = 0; row < nSrcRows; row++) {
+
+            plan->forward(srcBuf + row * srcLast, srcSpectrum + row * 2 * h, work);
+            plan->forward(padded + row * srcLast, tplSpectrum + row * 2 * h, work);
+        }
+
+        NativeFftService::transformComplex(srcSpectrum, reducedDims, nDims, nDims - 1, -1);
+        NativeFftService::transformComplex(tplSpectrum, reducedDims, nDims, nDims - 1, -1);
+
+#endif
+
+        for (jint i = 0; i < spectrumLen; i += 2) {
+
+            jdouble re1 = srcSpectrum[i];
+            jdouble im1 = srcSpectrum[i + 1];
+            jdouble re2 = tplSpectrum[i];
+            jdouble im2 = tplSpectrum[i + 1];
+
+            srcSpectrum[i] = re1 * re2 + im1 * im2;
+            srcSpectrum[i + 1] = im1 * re2 - re1 * im2;
+        }
+
+#if defined(sstx_EXPORTS)
+
+        fftw_execute_dft_c2r((fftw_plan) backwardPlan, (fftw_complex *) srcSpectrum, padded);
+
+#else
+
+        NativeFftService::transformComplex(srcSpectrum, reducedDims, nDims, nDims - 1, 1);
+
+        for (jint row = 0; row < nSrcRows; row++) {
+            plan->backward(srcSpectrum + row * 2 * h, padded + row * srcLast, work);
+        }
+
+#endif
+
+        // Only positions where the template doesn't wrap around are kept.
+        for (jint row = 0; row < nDstRows; row++) {
+
+            jint base = 0;
+
+            for (jint dim = nDims - 2, rem = row; dim >= 0; rem /= dstDArr[dim--]) {
+                base += (rem % dstDArr[dim]) * rowStrides[dim];
+            }
+
+            for (jint k = 0; k < dstLast; k++) {
+                numerators[row * dstLast + k] = padded[base + k] / srcLen;
+            }
+        }
+    }
+
+    //
+
+    // Treat windows with negligible variance relative to the whole source as flat.
+    jdouble varianceFloor = 1e-12 * tplLen * (srcNorm / srcLen);
+
+    for (jint i = 0; i < dstLen; i++) {
+
+        jdouble sum = stats[2 * i];
+        jdouble variance = stats[2 * i + 1] - sum * sum / tplLen;
+
+        jdouble score = (variance > varianceFloor && tplNorm > 0.0) //
+                ? numerators[i] / std::sqrt(variance * tplNorm) : 0.0;
+
+        dstVArr[dstIndices[i]] = std::max(std::min(score, 1.0), -1.0);
+    }
+}
@@ -0,0 +1,552 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeImageKernel.hpp>
+
+void NativeImageKernel::createIntegralMoments(JNIEnv *env, jobject thisObj, //
+        jintArray types, jdoubleArray xV, jdoubleArray yV, jintArray srcD, jintArray srcS, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS) {
+
+    try {
+
+        if (!types || !xV || !srcD || !srcS || !dstV || !dstD || !dstS) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nTypes = env->GetArrayLength(types);
+        jint srcLen = env->GetArrayLength(xV);
+        jint dstLen = env->GetArrayLength(dstV);
+        jint nDims = env->GetArrayLength(srcD);
+
+        if ((nDims != env->GetArrayLength(srcS))
+                || (nDims + 1 != env->GetArrayLength(dstD))
+                || (nDims + 1 != env->GetArrayLength(dstS))
+                || (yV && srcLen != env->GetArrayLength(yV))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        ArrayPinHandler typesH(env, types, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler xVh(env, xV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler yVh(env, yV ? yV : xV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        ArrayPinHandler dstDh(env, dstD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstSh(env, dstS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        // NO JNI AFTER THIS POINT!
+
+        jint *typesArr = (jint *) typesH.get();
+        jdouble *xVArr = (jdouble *) xVh.get();
+        jdouble *yVArr = yV ? (jdouble *) yVh.get() : NULL;
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+        jint *dstDArr = (jint *) dstDh.get();
+        jint *dstSArr = (jint *) dstSh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+        MappingOps::checkDimensions(dstDArr, dstSArr, nDims + 1, dstLen);
+
+        if (dstDArr[nDims] != nTypes) {
+            throw std::runtime_error("Dimension mismatch");
+        }
+
+        for (jint i = 0; i < nTypes; i++) {
+
+            switch (typesArr[i]) {
+
+            case org_shared_image_kernel_ImageKernel_IM_X:
+            case org_shared_image_kernel_ImageKernel_IM_XX:
+                break;
+
+            case org_shared_image_kernel_ImageKernel_IM_Y:
+            case org_shared_image_kernel_ImageKernel_IM_YY:
+            case org_shared_image_kernel_ImageKernel_IM_XY:
+
+                if (!yVArr) {
+                    throw std::runtime_error("Secondary values required");
+                }
+
+                break;
+
+            default:
+                throw std::runtime_error("Operation type not recognized");
+            }
+        }
+
+        jint dstOffset = 0;
+
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            if (srcDArr[dim] + 1 != dstDArr[dim]) {
+                throw std::runtime_error("Dimension mismatch");
+            }
+
+            dstOffset += dstSArr[dim];
+        }
+
+        if (!srcLen || !nTypes) {
+            return;
+        }
+
+        jint typeStride = dstSArr[nDims];
+        jint dstLenModified = dstLen / nTypes;
+
+        MallocHandler mallocH(sizeof(jint) * (srcLen + dstLenModified));
+        void *all = mallocH.get();
+
+        jint *srcIndices = (jint *) all;
+        jint *dstIndices = ((jint *) all) + srcLen;
+
+        MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+        MappingOps::assignMappingIndices(dstIndices, srcDArr, dstSArr, nDims);
+
+        // Scatter every requested moment while each source value is at hand.
+        for (jint i = 0; i < srcLen; i++) {
+
+            jdouble x = xVArr[srcIndices[i]];
+            jdouble y = yVArr ? yVArr[srcIndices[i]] : 0.0;
+
+            for (jint typeIndex = 0, physical = dstIndices[i] + dstOffset;
+                    typeIndex < nTypes;
+                    typeIndex++, physical += typeStride) {
+
+                switch (typesArr[typeIndex]) {
+
+                case org_shared_image_kernel_ImageKernel_IM_X:
+                    dstVArr[physical] = x;
+                    break;
+
+                case org_shared_image_kernel_ImageKernel_IM_XX:
+                    dstVArr[physical] = x * x;
+                    break;
+
+                case org_shared_image_kernel_ImageKernel_IM_Y:
+                    dstVArr[physical] = y;
+                    break;
+
+                case org_shared_image_kernel_ImageKernel_IM_YY:
+                    dstVArr[physical] = y * y;
+                    break;
+
+                case org_shared_image_kernel_ImageKernel_IM_XY:
+                    dstVArr[physical] = x * y;
+                    break;
+                }
+            }
+        }
+
+        //
+
+        MappingOps::assignMappingIndices(dstIndices, dstDArr, dstSArr, nDims);
+
+        for (jint dim = 0, indexBlockIncrement = dstLenModified;
+                dim < nDims;
+                indexBlockIncrement /= dstDArr[dim++]) {
+
+            jint size = dstDArr[dim];
+            jint stride = dstSArr[dim];
+
+            for (jint lower = 0, upper = indexBlockIncrement / size;
+                    lower < dstLenModified;
+                    lower += indexBlockIncrement, upper += indexBlockIncrement) {
+
+                for (jint indexIndex = lower; indexIndex < upper; indexIndex++) {
+
+                    for (jint typeIndex = 0, typeOffset = 0;
+                            typeIndex < nTypes;
+                            typeIndex++, typeOffset += typeStride) {
+
+                        jdouble acc = 0.0;
+
+                        for (jint k = 0, physical = dstIndices[indexIndex] + typeOffset; k < size; k++, physical
+                                += stride) {
+
+                            acc += dstVArr[physical];
+                            dstVArr[physical] = acc;
+                        }
+                    }
+                }
+            }
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::localMeanVariance(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdoubleArray meanV, jdoubleArray varV) {
+
+    try {
+
+        if (!srcV || !srcD || !srcS || !radii || !meanV || !varV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint nDims = env->GetArrayLength(srcD);
+
+        if ((nDims == 0)
+                || (nDims != env->GetArrayLength(srcS))
+                || (nDims != env->GetArrayLength(radii))
+                || (srcLen != env->GetArrayLength(meanV))
+                || (srcLen != env->GetArrayLength(varV))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler radiiH(env, radii, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler meanVh(env, meanV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        ArrayPinHandler varVh(env, varV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jint *radiiArr = (jint *) radiiH.get();
+        jdouble *meanVArr = (jdouble *) meanVh.get();
+        jdouble *varVArr = (jdouble *) varVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            if (radiiArr[dim] < 0) {
+                throw std::runtime_error("Invalid radius");
+            }
+        }
+
+        if (!srcLen) {
+            return;
+        }
+
+        MallocHandler mallocH((sizeof(jdouble) * 2 + sizeof(jint)) * srcLen);
+        void *all = mallocH.get();
+
+        jdouble *moments = (jdouble *) all;
+        jint *srcIndices = (jint *) (moments + 2 * srcLen);
+
+        MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+        // Center the values first so that the sum of squares doesn't swamp the squared sum.
+        jdouble shift = 0.0;
+
+        for (jint i = 0; i < srcLen; i++) {
+            shift += srcVArr[i];
+        }
+
+        shift /= srcLen;
+
+        for (jint i = 0; i < srcLen; i++) {
+
+            jdouble x = srcVArr[srcIndices[i]] - shift;
+
+            moments[2 * i] = x;
+            moments[2 * i + 1] = x * x;
+        }
+
+        boxMeans(moments, moments, srcDArr, radiiArr, nDims, 2);
+
+        for (jint i = 0; i < srcLen; i++) {
+
+            jdouble mean = moments[2 * i];
+            jdouble var = moments[2 * i + 1] - mean * mean;
+
+            meanVArr[srcIndices[i]] = mean + shift;
+            varVArr[srcIndices[i]] = std::max(var, 0.0);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::guidedFilter(JNIEnv *env, jobject thisObj, //
+        jdoubleArray guideV, jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, jdouble epsilon, //
+        jdoubleArray dstV) {
+
+    try {
+
+        if (!guideV || !srcV || !srcD || !srcS || !radii || !dstV || !(epsilon > 0.0)) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint nDims = env->GetArrayLength(srcD);
+
+        if ((nDims == 0)
+                || (nDims != env->GetArrayLength(srcS))
+                || (nDims != env->GetArrayLength(radii))
+                || (srcLen != env->GetArrayLength(guideV))
+                || (srcLen != env->GetArrayLength(dstV))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        ArrayPinHandler guideVh(env, guideV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler radiiH(env, radii, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *guideVArr = (jdouble *) guideVh.get();
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jint *radiiArr = (jint *) radiiH.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            if (radiiArr[dim] < 0) {
+                throw std::runtime_error("Invalid radius");
+            }
+        }
+
+        if (!srcLen) {
+            return;
+        }
+
+        MallocHandler mallocH((sizeof(jdouble) * 4 + sizeof(jint)) * srcLen);
+        void *all = mallocH.get();
+
+        jdouble *tables = (jdouble *) all;
+        jint *srcIndices = (jint *) (tables + 4 * srcLen);
+
+        MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+        // The coefficients are invariant to shifts of the guide, and the output shifts with the source.
+        jdouble guideShift = 0.0;
+        jdouble srcShift = 0.0;
+
+        for (jint i = 0; i < srcLen; i++) {
+
+            guideShift += guideVArr[i];
+            srcShift += srcVArr[i];
+        }
+
+        guideShift /= srcLen;
+        srcShift /= srcLen;
+
+        for (jint i = 0; i < srcLen; i++) {
+
+            jdouble g = guideVArr[srcIndices[i]] - guideShift;
+            jdouble p = srcVArr[srcIndices[i]] - srcShift;
+
+            tables[4 * i] = g;
+            tables[4 * i + 1] = p;
+            tables[4 * i + 2] = g * g;
+            tables[4 * i + 3] = g * p;
+        }
+
+        boxMeans(tables, tables, srcDArr, radiiArr, nDims, 4);
+
+        // Compact the linear coefficients into the front of the buffer; reads stay ahead of writes.
+        for (jint i = 0; i < srcLen; i++) {
+
+            jdouble meanG = tables[4 * i];
+            jdouble meanP = tables[4 * i + 1];
+            jdouble varG = std::max(tables[4 * i + 2] - meanG * meanG, 0.0);
+            jdouble covGp = tables[4 * i + 3] - meanG * meanP;
+
+            jdouble a = covGp / (varG + epsilon);
+
+            tables[2 * i] = a;
+            tables[2 * i + 1] = meanP - a * meanG;
+        }
+
+        boxMeans(tables, tables, srcDArr, radiiArr, nDims, 2);
+
+        for (jint i = 0; i < srcLen; i++) {
+
+            jdouble g = guideVArr[srcIndices[i]] - guideShift;
+
+            dstVArr[srcIndices[i]] = tables[2 * i] * g + tables[2 * i + 1] + srcShift;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::integrate(jdouble *values, jint *dims, jint nDims, jint nTables) {
+
+    jint len = Common::product(dims, nDims, (jint) 1) * nTables;
+
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+        jint size = dims[dim];
+        jint rowSize = blockSize / size;
+
+        for (jint offset = 0; offset < len; offset += blockSize) {
+
+            for (jint k = 1; k < size; k++) {
+
+                jdouble *row = values + offset + k * rowSize;
+                const jdouble *prev = row - rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    row[i] += prev[i];
+                }
+            }
+        }
+    }
+}
+
+void NativeImageKernel::windowSums(const jdouble *srcV, jint *srcD, //
+        jdouble *dstV, jint *dstD, //
+        jint *lower, jint *upper, jint nDims, jint nTables, bool normalize) {
+
+    // Find the largest intermediate, whose leading dimensions have been differenced and trailing ones haven't.
+    jint maxLen = 1;
+
+    for (jint dim = 0; dim < nDims - 1; dim++) {
+        maxLen = std::max(maxLen, Common::product(dstD, dim + 1, (jint) 1) //
+                * Common::product(srcD + dim + 1, nDims - dim - 1, (jint) 1));
+    }
+
+    maxLen *= nTables;
+
+    MallocHandler mallocH(sizeof(jdouble) * 2 * maxLen + sizeof(jint) * nDims);
+    void *all = mallocH.get();
+
+    jdouble *buffers[] = { (jdouble *) all, ((jdouble *) all) + maxLen };
+    jint *currentD = (jint *) (((jdouble *) all) + 2 * maxLen);
+
+    for (jint dim = 0; dim < nDims; dim++) {
+        currentD[dim] = srcD[dim];
+    }
+
+    const jdouble *in = srcV;
+
+    for (jint dim = 0; dim < nDims; dim++) {
+
+        jdouble *out = (dim == nDims - 1) ? dstV : buffers[dim % 2];
+
+        jint nBlocks = Common::product(currentD, dim, (jint) 1);
+        jint inSize = currentD[dim];
+        jint outSize = dstD[dim];
+        jint rowSize = Common::product(currentD + dim + 1, nDims - dim - 1, (jint) 1) * nTables;
+        jint extent = inSize - 1;
+
+        for (jint block = 0; block < nBlocks; block++) {
+
+            const jdouble *inBlock = in + block * inSize * rowSize;
+            jdouble *outBlock = out + block * outSize * rowSize;
+
+            for (jint k = 0; k < outSize; k++) {
+
+                jint lo = std::min(std::max(k + lower[dim], 0), extent);
+                jint hi = std::min(std::max(k + upper[dim], 0), extent);
+
+                jdouble factor = !normalize ? 1.0 : (hi > lo) ? 1.0 / (hi - lo) : 0.0;
+
+                const jdouble *rowLo = inBlock + lo * rowSize;
+                const jdouble *rowHi = inBlock + hi * rowSize;
+                jdouble *row = outBlock + k * rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    row[i] = (rowHi[i] - rowLo[i]) * factor;
+                }
+            }
+        }
+
+        currentD[dim] = outSize;
+        in = out;
+    }
+}
+
+void NativeImageKernel::createIntegralTables(const jdouble *srcV, jdouble *dstV, //
+        jint *dims, jint nDims, jint nTables) {
+
+    MallocHandler mallocH(sizeof(jint) * 2 * nDims);
+    void *all = mallocH.get();
+
+    jint *dstD = (jint *) all;
+    jint *dstS = ((jint *) all) + nDims;
+
+    jint dstLen = nTables;
+
+    for (jint dim = nDims - 1; dim >= 0; dstLen *= dstD[dim--]) {
+
+        dstD[dim] = dims[dim] + 1;
+        dstS[dim] = dstLen;
+    }
+
+    std::fill(dstV, dstV + dstLen, 0.0);
+
+    // Copy rows into the interior, leaving a leading hyperplane of zeros along every dimension.
+    jint rowSize = dims[nDims - 1] * nTables;
+    jint nRows = Common::product(dims, nDims - 1, (jint) 1);
+
+    for (jint row = 0; row < nRows; row++) {
+
+        jint offset = dstS[nDims - 1];
+
+        for (jint dim = nDims - 2, rem = row; dim >= 0; rem /= dims[dim--]) {
+            offset += (rem % dims[dim] + 1) * dstS[dim];
+        }
+
+        std::copy(srcV + row * rowSize, srcV + (row + 1) * rowSize, dstV + offset);
+    }
+
+    integrate(dstV, dstD, nDims, nTables);
+}
+
+void NativeImageKernel::boxMeans(const jdouble *srcV, jdouble *dstV, //
+        jint *dims, jint *radii, jint nDims, jint nTables) {
+
+    jint tablesLen = nTables;
+
+    for (jint dim = 0; dim < nDims; dim++) {
+        tablesLen *= dims[dim] + 1;
+    }
+
+    MallocHandler mallocH(sizeof(jdouble) * tablesLen + sizeof(jint) * 3 * nDims);
+    void *all = mallocH.get();
+
+    jdouble *tables = (jdouble *) all;
+    jint *tablesD = (jint *) (tables + tablesLen);
+    jint *lower = tablesD + nDims;
+    jint *upper = tablesD + 2 * nDims;
+
+    for (jint dim = 0; dim < nDims; dim++) {
+
+        tablesD[dim] = dims[dim] + 1;
+        lower[dim] = -radii[dim];
+        upper[dim] = radii[dim] + 1;
+    }
+
+    createIntegralTables(srcV, tables, dims, nDims, nTables);
+    windowSums(tables, tablesD, dstV, dims, lower, upper, nDims, nTables, true);
+}
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeImageKernel.hpp>
+
+jintArray NativeImageKernel::findPeaks(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdouble threshold, jint minDistance) {
+
+    jintArray res = NULL;
+
+    jint *peaksArr = NULL;
+
+    try {
+
+        peaksArr = findPeaksProxy(env, srcV, srcD, srcS, radii, threshold, minDistance);
+
+        jint nPeaks = peaksArr[0];
+
+        res = Common::newIntArray(env, nPeaks);
+
+        ArrayPinHandler resH(env, res, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        memcpy((jint *) resH.get(), peaksArr + 1, sizeof(jint) * nPeaks);
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    if (peaksArr) {
+        delete[] peaksArr;
+    }
+
+    return res;
+}
+
+jint *NativeImageKernel::findPeaksProxy(JNIEnv *env, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdouble threshold, jint minDistance) {
+
+    if (!srcV || !srcD || !srcS || !radii) {
+        throw std::runtime_error("Invalid arguments");
+    }
+
+    jint srcLen = env->GetArrayLength(srcV);
+    jint nDims = env->GetArrayLength(srcD);
+
+    if ((nDims == 0)
+            || (nDims != env->GetArrayLength(srcS))
+            || (nDims != env->GetArrayLength(radii))) {
+        throw std::runtime_error("Invalid arguments");
+    }
+
+    ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    ArrayPinHandler radiiH(env, radii, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+    // NO JNI AFTER THIS POINT!
+
+    jdouble *srcVArr = (jdouble *) srcVh.get();
+    jint *srcDArr = (jint *) srcDh.get();
+    jint *srcSArr = (jint *) srcSh.get();
+    jint *radiiArr = (jint *) radiiH.get();
+
+    MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+    for (jint dim = 0; dim < nDims; dim++) {
+
+        if (radiiArr[dim] < 0) {
+            throw std::runtime_error("Invalid radius");
+        }
+    }
+
+    if (minDistance < 0) {
+        throw std::runtime_error("Invalid minimum distance");
+    }
+
+    MallocHandler mallocH(sizeof(jdouble) * 2 * srcLen //
+            + sizeof(permutation_entry<jdouble, jint>) * srcLen //
+            + sizeof(jint) * (2 * srcLen + 1 + 4 * nDims));
+    void *all = mallocH.get();
+
+    jdouble *values = (jdouble *) all;
+    jdouble *maxima = values + srcLen;
+    permutation_entry<jdouble, jint> *entries = (permutation_entry<jdouble, jint> *) (maxima + srcLen);
+    jint *srcIndices = (jint *) (entries + srcLen);
+    jint *offsets = srcIndices + srcLen;
+    jint *strides = offsets + srcLen + 1;
+    jint *coords = strides + nDims;
+    jint *lower = strides + 2 * nDims;
+    jint *upper = strides + 3 * nDims;
+
+    MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+    // NaNs can neither be peaks nor mask their neighbors.
+    for (jint i = 0; i < srcLen; i++) {
+
+        jdouble value = srcVArr[srcIndices[i]];
+
+        values[i] = maxima[i] = (value == value) ? value : -HUGE_VAL;
+    }
+
+    boxMaxima(maxima, srcDArr, radiiArr, nDims);
+
+    // Flag the candidates, and then compact them by way of an exclusive prefix sum.
+    offsets[0] = 0;
+
+    for (jint i = 0; i < srcLen; i++) {
+
+        jdouble value = values[i];
+
+        offsets[i + 1] = offsets[i] + ((value >= threshold && value >= maxima[i] && value > -HUGE_VAL) ? 1 : 0);
+    }
+
+    jint nCandidates = offsets[srcLen];
+
+    for (jint i = 0; i < srcLen; i++) {
+
+        if (offsets[i + 1] != offsets[i]) {
+
+            entries[offsets[i]].value = -values[i];
+            entries[offsets[i]].payload = i;
+        }
+    }
+
+    // A stable sort keeps ties in row-major order.
+    std::stable_sort(entries, entries + nCandidates);
+
+    jint nPeaks = 0;
+
+    if (minDistance > 1) {
+
+        // Reuse the offsets as a suppression mask.
+        jint *suppressed = offsets;
+
+        for (jint i = 0; i < srcLen; i++) {
+            suppressed[i] = 0;
+        }
+
+        strides[nDims - 1] = 1;
+
+        for (jint dim = nDims - 1; dim > 0; dim--) {
+            strides[dim - 1] = strides[dim] * srcDArr[dim];
+        }
+
+        for (jint i = 0; i < nCandidates; i++) {
+
+            jint index = entries[i].payload;
+
+            if (suppressed[index]) {
+                continue;
+            }
+
+            entries[nPeaks++].payload = index;
+
+            // Suppress everything strictly within the minimum distance.
+            for (jint dim = 0, rem = index; dim < nDims; dim++) {
+
+                jint coord = rem / strides[dim];
+
+                rem %= strides[dim];
+
+                lower[dim] = std::max(coord - minDistance + 1, 0);
+                upper[dim] = std::min(coord + minDistance, srcDArr[dim]);
+                coords[dim] = lower[dim];
+            }
+
+            for (bool done = false; !done;) {
+
+                jint offset = 0;
+
+                for (jint dim = 0; dim < nDims; dim++) {
+                    offset += coords[dim] * strides[dim];
+                }
+
+                for (jint j = 0, size = upper[nDims - 1] - lower[nDims - 1]; j < size; j++) {
+                    suppressed[offset + j] = 1;
+                }
+
+                jint dim = nDims - 2;
+
+                for (; dim >= 0 && ++coords[dim] == upper[dim]; dim--) {
+                    coords[dim] = lower[dim];
+                }
+
+                done = (dim < 0);
+            }
+        }
+
+    } else {
+
+        nPeaks = nCandidates;
+    }
+
+    jint *resArr = new jint[1 + nPeaks];
+
+    resArr[0] = nPeaks;
+
+    for (jint i = 0; i < nPeaks; i++) {
+        resArr[i + 1] = entries[i].payload;
+    }
+
+    return resArr;
+}
+
+void NativeImageKernel::boxMaxima(jdouble *values, jint *dims, jint *radii, jint nDims) {
+
+    jint len = Common::product(dims, nDims, (jint) 1);
+
+    if (!len) {
+        return;
+    }
+
+    jint bufferLen = 0;
+
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+        bufferLen = std::max(bufferLen, (blockSize / dims[dim]) * (dims[dim] + 2 * radii[dim]));
+    }
+
+    MallocHandler mallocH(sizeof(jdouble) * 2 * bufferLen);
+    void *all = mallocH.get();
+
+    jdouble *prefixes = (jdouble *) all;
+    jdouble *suffixes = prefixes + bufferLen;
+
+    // The van Herk-Gil-Werman algorithm takes running maxima within blocks of the window width, so that any window
+    // is the union of a suffix of one block and a prefix of the next. Lines are padded with negative infinities and
+    // processed a whole row at a time.
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+        jint size = dims[dim];
+        jint radius = radii[dim];
+        jint rowSize = blockSize / size;
+        jint width = 2 * radius + 1;
+        jint padded = size + 2 * radius;
+
+        if (!radius) {
+            continue;
+        }
+
+        for (jint offset = 0; offset < len; offset += blockSize) {
+
+            for (jint j = 0; j < padded; j++) {
+
+                jint k = j - radius;
+
+                jdouble *prefix = prefixes + j * rowSize;
+                jdouble *suffix = suffixes + j * rowSize;
+
+                if (k >= 0 && k < size) {
+
+                    const jdouble *row = values + offset + k * rowSize;
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        suffix[i] = row[i];
+                    }
+
+                } else {
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        suffix[i] = -HUGE_VAL;
+                    }
+                }
+
+                if (j % width) {
+
+                    const jdouble *prev = prefix - rowSize;
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        prefix[i] = std::max(prev[i], suffix[i]);
+                    }
+
+                } else {
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        prefix[i] = suffix[i];
+                    }
+                }
+            }
+
+            for (jint j = padded - 2; j >= 0; j--) {
+
+                if ((j + 1) % width) {
+
+                    jdouble *suffix = suffixes + j * rowSize;
+                    const jdouble *next = suffix + rowSize;
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        suffix[i] = std::max(suffix[i], next[i]);
+                    }
+                }
+            }
+
+            for (jint k = 0; k < size; k++) {
+
+                jdouble *row = values + offset + k * rowSize;
+                const jdouble *suffix = suffixes + k * rowSize;
+                const jdouble *prefix = prefixes + (k + 2 * radius) * rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    row[i] = std::max(suffix[i], prefix[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeImageKernel.hpp>
+
+/**
+ * The pole of the cubic B-spline prefilter.
+ */
+#define SPLINE_POLE (1.7320508075688772 - 2.0)
+
+/**
+ * The number of samples past which the influence of the prefilter's initial conditions drops below machine precision.
+ */
+#define SPLINE_HORIZON 28
+
+/**
+ * The coordinate magnitude past which coordinates are clamped to avoid integer overflow.
+ */
+#define COORDINATE_LIMIT 1073741824.0
+
+void NativeImageKernel::mapCoordinates(JNIEnv *env, jobject thisObj, //
+        jint interpolation, jint boundary, jdouble cval, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray coordsV, jdoubleArray dstV, jboolean complex) {
+
+    try {
+
+        if (!srcV || !srcD || !srcS || !coordsV || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint coordsLen = env->GetArrayLength(coordsV);
+        jint dstLen = env->GetArrayLength(dstV);
+        jint nDims = env->GetArrayLength(srcD);
+        jint nChannels = complex ? 2 : 1;
+        jint nCoordDims = complex ? nDims - 1 : nDims;
+
+        if ((nCoordDims <= 0)
+                || (nDims != env->GetArrayLength(srcS))
+                || (coordsLen % nCoordDims != 0)
+                || (coordsLen / nCoordDims * nChannels != dstLen)) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        checkInterpolation(interpolation, boundary);
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler coordsVh(env, coordsV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jdouble *coordsVArr = (jdouble *) coordsVh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        if (complex && srcDArr[nDims - 1] != 2) {
+            throw std::runtime_error("Invalid dimensions");
+        }
+
+        jint nPoints = coordsLen / nCoordDims;
+
+        if (!nPoints) {
+            return;
+        }
+
+        if (!srcLen) {
+            throw std::runtime_error("Invalid dimensions");
+        }
+
+        if (interpolation == org_shared_image_kernel_ImageKernel_IP_CUBIC) {
+
+            // Compute spline coefficients over a row-major copy of the source.
+            MallocHandler mallocH(sizeof(jdouble) * srcLen + sizeof(jint) * (srcLen + nCoordDims));
+            void *all = mallocH.get();
+
+            jdouble *coefficients = (jdouble *) all;
+            jint *srcIndices = (jint *) (coefficients + srcLen);
+            jint *strides = srcIndices + srcLen;
+
+            MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+            for (jint i = 0; i < srcLen; i++) {
+                coefficients[i] = srcVArr[srcIndices[i]];
+            }
+
+            strides[nCoordDims - 1] = nChannels;
+
+            for (jint dim = nCoordDims - 1; dim > 0; dim--) {
+                strides[dim - 1] = strides[dim] * srcDArr[dim];
+            }
+
+            prefilter(coefficients, srcDArr, nCoordDims, nChannels, boundary, cval);
+            interpolate(coefficients, srcDArr, strides, nCoordDims, nChannels, 1, //
+                    coordsVArr, dstVArr, nPoints, //
+                    org_shared_image_kernel_ImageKernel_IP_SPLINE, boundary, cval);
+
+        } else {
+
+            interpolate(srcVArr, srcDArr, srcSArr, nCoordDims, nChannels, complex ? srcSArr[nDims - 1] : 0, //
+                    coordsVArr, dstVArr, nPoints, //
+                    interpolation, boundary, cval);
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::splineCoefficients(JNIEnv *env, jobject thisObj, //
+        jint boundary, jdouble cval, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray dstV, jboolean complex) {
+
+    try {
+
+        if (!srcV || !srcD || !srcS || !dstV) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint nDims = env->GetArrayLength(srcD);
+        jint nChannels = complex ? 2 : 1;
+        jint nCoordDims = complex ? nDims - 1 : nDims;
+
+        if ((nCoordDims <= 0)
+                || (nDims != env->GetArrayLength(srcS))
+                || (srcLen != env->GetArrayLength(dstV))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        checkInterpolation(org_shared_image_kernel_ImageKernel_IP_SPLINE, boundary);
+
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler dstVh(env, dstV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jdouble *dstVArr = (jdouble *) dstVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        if (complex && srcDArr[nDims - 1] != 2) {
+            throw std::runtime_error("Invalid dimensions");
+        }
+
+        MallocHandler mallocH((sizeof(jdouble) + sizeof(jint)) * srcLen);
+        void *all = mallocH.get();
+
+        jdouble *coefficients = (jdouble *) all;
+        jint *srcIndices = (jint *) (coefficients + srcLen);
+
+        MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+        for (jint i = 0; i < srcLen; i++) {
+            coefficients[i] = srcVArr[srcIndices[i]];
+        }
+
+        prefilter(coefficients, srcDArr, nCoordDims, nChannels, boundary, cval);
+
+        for (jint i = 0; i < srcLen; i++) {
+            dstVArr[srcIndices[i]] = coefficients[i];
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::checkInterpolation(jint interpolation, jint boundary) {
+
+    switch (interpolation) {
+
+    case org_shared_image_kernel_ImageKernel_IP_NEAREST:
+    case org_shared_image_kernel_ImageKernel_IP_LINEAR:
+    case org_shared_image_kernel_ImageKernel_IP_CUBIC:
+    case org_shared_image_kernel_ImageKernel_IP_SPLINE:
+        break;
+
+    default:
+        throw std::runtime_error("Interpolation type not recognized");
+    }
+
+    switch (boundary) {
+
+    case org_shared_image_kernel_ImageKernel_BM_CONSTANT:
+    case org_shared_image_kernel_ImageKernel_BM_NEAREST:
+    case org_shared_image_kernel_ImageKernel_BM_REFLECT:
+    case org_shared_image_kernel_ImageKernel_BM_WRAP:
+        break;
+
+    default:
+        throw std::runtime_error("Boundary mode not recognized");
+    }
+}
+
+jint NativeImageKernel::boundaryIndex(jint index, jint size, jint boundary) {
+
+    if (index >= 0 && index < size) {
+        return index;
+    }
+
+    switch (boundary) {
+
+    case org_shared_image_kernel_ImageKernel_BM_CONSTANT:
+        return -1;
+
+    case org_shared_image_kernel_ImageKernel_BM_NEAREST:
+        return (index < 0) ? 0 : size - 1;
+
+    case org_shared_image_kernel_ImageKernel_BM_REFLECT:
+
+        index %= 2 * size;
+        index += (index < 0) ? 2 * size : 0;
+
+        return (index < size) ? index : 2 * size - 1 - index;
+
+    case org_shared_image_kernel_ImageKernel_BM_WRAP:
+
+        index %= size;
+
+        return index + ((index < 0) ? size : 0);
+
+    default:
+        throw std::runtime_error("Boundary mode not recognized");
+    }
+}
+
+void NativeImageKernel::prefilter(jdouble *values, jint *dims, jint nDims, jint nChannels, //
+        jint boundary, jdouble cval) {
+
+    jint len = Common::product(dims, nDims, (jint) 1) * nChannels;
+
+    if (!len) {
+        return;
+    }
+
+    jint bufferLen = 0;
+
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+        bufferLen = std::max(bufferLen, (blockSize / dims[dim]) * (dims[dim] + 2 * SPLINE_HORIZON));
+    }
+
+    MallocHandler mallocH(sizeof(jdouble) * bufferLen);
+    jdouble *buffer = (jdouble *) mallocH.get();
+
+    const jdouble z = SPLINE_POLE;
+    const jdouble gain = (1.0 - z) * (1.0 - 1.0 / z);
+
+    // Clamped coordinates never leave the source extent, and so reflection serves just as well.
+    if (boundary == org_shared_image_kernel_ImageKernel_BM_NEAREST) {
+        boundary = org_shared_image_kernel_ImageKernel_BM_REFLECT;
+    }
+
+    // Lines are padded with enough of the boundary extension that truncating the recursive filters' initial conditions
+    // is harmless. This way, the coefficients interpolate the source as extended by the boundary mode.
+    for (jint dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+        jint size = dims[dim];
+        jint rowSize = blockSize / size;
+        jint padded = size + 2 * SPLINE_HORIZON;
+
+        if (size == 1 && boundary != org_shared_image_kernel_ImageKernel_BM_CONSTANT) {
+            continue;
+        }
+
+        for (jint offset = 0; offset < len; offset += blockSize) {
+
+            for (jint j = 0; j < padded; j++) {
+
+                jint k = boundaryIndex(j - SPLINE_HORIZON, size, boundary);
+                jdouble *row = buffer + j * rowSize;
+
+                if (k >= 0) {
+
+                    const jdouble *srcRow = values + offset + k * rowSize;
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        row[i] = srcRow[i];
+                    }
+
+                } else {
+
+                    for (jint i = 0; i < rowSize; i++) {
+                        row[i] = (i % nChannels) ? 0.0 : cval;
+                    }
+                }
+            }
+
+            for (jint j = 1; j < padded; j++) {
+
+                jdouble *row = buffer + j * rowSize;
+                const jdouble *prev = row - rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    row[i] += z * prev[i];
+                }
+            }
+
+            jdouble *last = buffer + (padded - 1) * rowSize;
+
+            for (jint i = 0; i < rowSize; i++) {
+                last[i] = (z / (z * z - 1.0)) * (last[i] + z * last[i - rowSize]);
+            }
+
+            for (jint j = padded - 2; j >= 0; j--) {
+
+                jdouble *row = buffer + j * rowSize;
+                const jdouble *next = row + rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    row[i] = z * (next[i] - row[i]);
+                }
+            }
+
+            for (jint k = 0; k < size; k++) {
+
+                jdouble *dstRow = values + offset + k * rowSize;
+                const jdouble *row = buffer + (k + SPLINE_HORIZON) * rowSize;
+
+                for (jint i = 0; i < rowSize; i++) {
+                    dstRow[i] = gain * row[i];
+                }
+            }
+        }
+    }
+}
+
+void NativeImageKernel::interpolate(const jdouble *values, jint *dims, jint *strides, //
+        jint nDims, jint nChannels, jint channelStride, //
+        const jdouble *coords, jdouble *dst, jint nPoints, //
+        jint interpolation, jint boundary, jdouble cval) {
+
+    jint nTaps;
+
+    switch (interpolation) {
+
+    case org_shared_image_kernel_ImageKernel_IP_NEAREST:
+        nTaps = 1;
+        break;
+
+    case org_shared_image_kernel_ImageKernel_IP_LINEAR:
+        nTaps = 2;
+        break;
+
+    case org_shared_image_kernel_ImageKernel_IP_SPLINE:
+        nTaps = 4;
+        break;
+
+    default:
+        throw std::runtime_error("Interpolation type not recognized");
+    }
+
+    bool clamp = (boundary == org_shared_image_kernel_ImageKernel_BM_NEAREST);
+    bool spline = (interpolation == org_shared_image_kernel_ImageKernel_IP_SPLINE);
+
+    // Clamped coordinates sample the source as reflected, since that's how coefficients are computed.
+    jint tapBoundary = clamp ? org_shared_image_kernel_ImageKernel_BM_REFLECT : boundary;
+
+    MallocHandler mallocH((2 * sizeof(jdouble) + sizeof(jint)) * nTaps * nDims + sizeof(jint) * nDims);
+    void *all = mallocH.get();
+
+    jdouble *weights = (jdouble *) all;
+    jdouble *factors = weights + nTaps * nDims;
+    jint *offsets = (jint *) (factors + nTaps * nDims);
+    jint *taps = offsets + nTaps * nDims;
+
+    jint nCombinations = 1;
+
+    for (jint dim = 0; dim < nDims; dim++) {
+        nCombinations *= nTaps;
+    }
+
+    for (jint p = 0; p < nPoints; p++) {
+
+        const jdouble *coord = coords + p * nDims;
+        jdouble *res = dst + p * nChannels;
+
+        jint nanDim = 0;
+
+        for (; nanDim < nDims && coord[nanDim] == coord[nanDim]; nanDim++) {
+        }
+
+        // NaN coordinates propagate.
+        if (nanDim < nDims) {
+
+            for (jint c = 0; c < nChannels; c++) {
+                res[c] = coord[nanDim];
+            }
+
+            continue;
+        }
+
+        // Precompute the physical offsets and weights of taps along each dimension.
+        for (jint dim = 0; dim < nDims; dim++) {
+
+            jint size = dims[dim];
+            jdouble x = std::max(std::min(coord[dim], COORDINATE_LIMIT), -COORDINATE_LIMIT);
+
+            if (clamp) {
+                x = std::max(std::min(x, (jdouble) (size - 1)), 0.0);
+            }
+
+            jdouble *w = weights + dim * nTaps;
+            jdouble *f = factors + dim * nTaps;
+            jint *o = offsets + dim * nTaps;
+            jint base;
+
+            switch (interpolation) {
+
+            case org_shared_image_kernel_ImageKernel_IP_NEAREST:
+
+                base = (jint) floor(x + 0.5);
+                w[0] = 1.0;
+
+                break;
+
+            case org_shared_image_kernel_ImageKernel_IP_LINEAR:
+            {
+                base = (jint) floor(x);
+
+                jdouble t = x - base;
+
+                w[0] = 1.0 - t;
+                w[1] = t;
+            }
+
+                break;
+
+            default:
+            {
+                base = (jint) floor(x) - 1;
+
+                jdouble t = x - (base + 1);
+                jdouble s = 1.0 - t;
+
+                w[0] = s * s * s / 6.0;
+                w[1] = (4.0 - 6.0 * t * t + 3.0 * t * t * t) / 6.0;
+                w[2] = (4.0 - 6.0 * s * s + 3.0 * s * s * s) / 6.0;
+                w[3] = t * t * t / 6.0;
+            }
+
+                break;
+            }
+
+            for (jint tap = 0; tap < nTaps; tap++) {
+
+                jint index = boundaryIndex(base + tap, size, tapBoundary);
+
+                if (index >= 0) {
+
+                    o[tap] = index * strides[dim];
+                    f[tap] = 1.0;
+
+                } else {
+
+                    // Past the edges of a constant extension, spline coefficients relax toward the constant
+                    // geometrically.
+                    index = std::max(std::min(base + tap, size - 1), 0);
+
+                    o[tap] = index * strides[dim];
+                    f[tap] = spline ? pow(SPLINE_POLE, (jdouble) std::abs(base + tap - index)) : 0.0;
+                }
+            }
+        }
+
+        for (jint c = 0; c < nChannels; c++) {
+            res[c] = 0.0;
+        }
+
+        for (jint dim = 0; dim < nDims; dim++) {
+            taps[dim] = 0;
+        }
+
+        // Accumulate the tensor product of taps.
+        for (jint combination = 0; combination < nCombinations; combination++) {
+
+            jdouble weight = 1.0;
+            jdouble factor = 1.0;
+            jint offset = 0;
+
+            for (jint dim = 0; dim < nDims; dim++) {
+
+                jint k = dim * nTaps + taps[dim];
+
+                weight *= weights[k];
+                factor *= factors[k];
+                offset += offsets[k];
+            }
+
+            if (factor == 1.0) {
+
+                for (jint c = 0; c < nChannels; c++) {
+                    res[c] += weight * values[offset + c * channelStride];
+                }
+
+            } else {
+
+                for (jint c = 0; c < nChannels; c++) {
+
+                    jdouble constant = c ? 0.0 : cval;
+
+                    res[c] += weight * (constant + factor * (values[offset + c * channelStride] - constant));
+                }
+            }
+
+            for (jint dim = nDims - 1; dim >= 0 && ++taps[dim] == nTaps; dim--) {
+                taps[dim] = 0;
+            }
+        }
+    }
+}
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2010 Roy Liu
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * 
+ *   * Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ *     disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ *     following disclaimer in the documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <NativeImageKernel.hpp>
+
+/*
+ * Lifting schemes, one per wavelet. Each begins with the scale factors of the even and odd channels and the number of
+ * steps, which follow as (channel, first offset, number of taps, taps). Channel 0 means that the even channel is
+ * updated from the odd channel, and channel 1 means the reverse. The Daubechies schemes come from Euclidean
+ * factorizations of the polyphase matrices of the minimum phase filters.
+ */
+
+static const jdouble haarScheme[] = {
+        1.4142135623730951, 0.7071067811865475, 2, //
+        1, 0, 1, -1.0, //
+        0, 0, 1, 0.5 };
+
+static const jdouble db2Scheme[] = {
+        1.9318516525781366, 0.5176380902050415, 3, //
+        1, 0, 1, -1.7320508075688772, //
+        0, 0, 2, 0.4330127018922193, -0.06698729810778067, //
+        1, -1, 1, 1.0 };
+
+static const jdouble db3Scheme[] = {
+        1.0475237291258894, 0.9546323125629376, 5, //
+        1, 0, 1, 0.41228659505180554, //
+        0, -1, 2, -0.46675694679423824, -0.35238765767485547, //
+        1, 0, 3, -1.0, 0.492151844887739, -0.09542943900975187, //
+        0, 0, 1, 1.0, //
+        1, -2, 3, -0.11619309193636232, 0.0, -1.0 };
+
+static const jdouble db4Scheme[] = {
+        0.6829218120354147, 1.4642964719775893, 5, //
+        1, 0, 1, 0.3222758880002811, //
+        0, -1, 2, 1.1171236051162172, -0.29195312600347534, //
+        1, 0, 2, -0.11355149660809287, -0.5400282834197139, //
+        0, 0, 2, 0.5547946968043383, -0.09842349449508443, //
+        1, -1, 1, 0.02145362655440929 };
+
+static const jdouble db5Scheme[] = {
+        1.3101844390190502, 0.7632513180729816, 7, //
+        1, 0, 1, 0.26514514281158824, //
+        0, -1, 2, -0.9940591343240417, -0.24772929136032967, //
+        1, 1, 2, 0.5341246460373478, -0.21327429818773413, //
+        0, -3, 2, -0.22473522485729788, 0.7168557193161884, //
+        1, 0, 5, -1.0, 0.0, 0.0, 0.07755333443426865, -0.012132186617261762, //
+        0, 0, 1, 1.0, //
+        1, -4, 5, -0.03576492464588209, 0.0, 0.0, 0.0, -1.0 };
+
+static const jdouble db6Scheme[] = {
+        0.9209502755579572, 1.0858349538949328, 7, //
+        1, 0, 1, 0.2255061785637888, //
+        0, -1, 2, 0.7273420740972343, -0.2145934500030082, //
+        1, 0, 2, -0.391113547975628, -0.507005568565545, //
+        0, 0, 2, 0.6595714136346803, -0.2718462593445387, //
+        1, -2, 2, -0.05908637151044026, 0.20512679659260868, //
+        0, 2, 2, 0.08252478647755451, -0.011386511463891974, //
+        1, -3, 1, 0.008191735616131821 };
+
+static const jdouble db7Scheme[] = {
+        0.7387553345534635, 1.3536281272397772, 9, //
+        1, 0, 1, 0.19632871258951998, //
+        0, -1, 2, 0.6226081148006308, -0.18904209207199213, //
+        1, 0, 2, 0.9762494930979289, -0.473542027592843, //
+        0, -1, 2, -0.17784841690967768, -0.6554653836458486, //
+        1, 1, 2, 0.6504897597802894, -0.2556344430137497, //
+        0, -3, 2, -0.020183939381539093, 0.07747053174898423, //
+        1, 0, 5, -1.0, 0.0, 0.0, 0.06785481821590963, -0.008324759649383943, //
+        0, 0, 1, 1.0, //
+        1, -4, 5, -0.0024796089094268705, 0.0, 0.0, 0.0, -1.0 };
+
+static const jdouble db8Scheme[] = {
+        1.0998205796126963, 0.9092392145927581, 9, //
+        1, 0, 1, 0.17392388386585503, //
+        0, -1, 2, 0.545240042147073, -0.16881724371813134, //
+        1, 0, 2, -0.709599782718359, -0.4399133163852162, //
+        0, 0, 2, 0.6353677588938296, -0.337998430891021, //
+        1, -2, 2, -0.26417387650139024, 0.5578087497857382, //
+        0, 2, 2, 0.18749477001593542, -0.06841128991724878, //
+        1, -4, 2, -0.02370601458932583, 0.10071357518206554, //
+        0, 4, 2, 0.016208171869188496, -0.0017847647755538983, //
+        1, -5, 1, 0.0026113818275875092 };
+
+static const jdouble cdf97Scheme[] = {
+        1.1496043988602445, 0.8698644516247788, 4, //
+        1, 0, 2, -1.586134342059924, -1.586134342059924, //
+        0, -1, 2, -0.052980118572961, -0.052980118572961, //
+        1, 0, 2, 0.882911075530934, 0.882911075530934, //
+        0, -1, 2, 0.443506852043971, 0.443506852043971 };
+
+static const jdouble *const liftingSchemes[] = {
+        haarScheme, db2Scheme, db3Scheme, db4Scheme, db5Scheme, db6Scheme, db7Scheme, db8Scheme, cdf97Scheme };
+
+/**
+ * The maximum number of lifting steps in a scheme.
+ */
+#define MAX_LIFTING_STEPS 16
+
+void NativeImageKernel::waveletTransform(JNIEnv *env, jobject thisObj, //
+        jint wavelet, jint nLevels, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jboolean inverse) {
+
+    try {
+
+        if (!srcV || !srcD || !srcS) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint srcLen = env->GetArrayLength(srcV);
+        jint nDims = env->GetArrayLength(srcD);
+
+        if ((nDims == 0) || (nDims != env->GetArrayLength(srcS))) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        if (!(wavelet >= org_shared_image_kernel_ImageKernel_WT_HAAR //
+                && wavelet <= org_shared_image_kernel_ImageKernel_WT_CDF97)) {
+            throw std::runtime_error("Wavelet not recognized");
+        }
+
+        if (nLevels < 0) {
+            throw std::runtime_error("Invalid number of levels");
+        }
+
+        ArrayPinHandler srcDh(env, srcD, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcSh(env, srcS, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler srcVh(env, srcV, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jint *srcDArr = (jint *) srcDh.get();
+        jint *srcSArr = (jint *) srcSh.get();
+        jdouble *srcVArr = (jdouble *) srcVh.get();
+
+        MappingOps::checkDimensions(srcDArr, srcSArr, nDims, srcLen);
+
+        if (!srcLen) {
+            return;
+        }
+
+        // Levels past the point where every dimension has collapsed to one leave the values unchanged.
+        jint maxSize = 1;
+
+        for (jint dim = 0; dim < nDims; dim++) {
+            maxSize = std::max(maxSize, srcDArr[dim]);
+        }
+
+        jint nEffectiveLevels = 0;
+
+        for (; nEffectiveLevels < nLevels && maxSize > 1; nEffectiveLevels++) {
+            maxSize = (maxSize + 1) >> 1;
+        }
+
+        MallocHandler mallocH(sizeof(jdouble) * 3 * srcLen + sizeof(jint) * (srcLen + nDims * (nEffectiveLevels + 1)));
+        void *all = mallocH.get();
+
+        jdouble *values = (jdouble *) all;
+        jdouble *region = values + srcLen;
+        jdouble *work = values + 2 * srcLen;
+        jint *srcIndices = (jint *) (values + 3 * srcLen);
+        jint *levelDims = srcIndices + srcLen;
+
+        MappingOps::assignMappingIndices(srcIndices, srcDArr, srcSArr, nDims);
+
+        for (jint i = 0; i < srcLen; i++) {
+            values[i] = srcVArr[srcIndices[i]];
+        }
+
+        memcpy(levelDims, srcDArr, sizeof(jint) * nDims);
+
+        for (jint level = 1; level <= nEffectiveLevels; level++) {
+
+            for (jint dim = 0; dim < nDims; dim++) {
+                levelDims[level * nDims + dim] = (levelDims[(level - 1) * nDims + dim] + 1) >> 1;
+            }
+        }
+
+        const jdouble *scheme = liftingSchemes[wavelet];
+
+        for (jint i = 0; i < nEffectiveLevels; i++) {
+
+            jint level = !inverse ? i : nEffectiveLevels - 1 - i;
+            jint *dims = levelDims + level * nDims;
+            jint regionLen = Common::product(dims, nDims, (jint) 1);
+
+            copyRegion(values, region, srcDArr, dims, nDims, true);
+
+            for (jint j = 0; j < nDims; j++) {
+
+                jint dim = !inverse ? j : nDims - 1 - j;
+                jint size = dims[dim];
+                jint blockSize = Common::product(dims + dim, nDims - dim, (jint) 1);
+
+                if (size < 2) {
+                    continue;
+                }
+
+                for (jint offset = 0; offset < regionLen; offset += blockSize) {
+                    liftLines(region + offset, work, size, blockSize / size, scheme, inverse);
+                }
+            }
+
+            copyRegion(values, region, srcDArr, dims, nDims, false);
+        }
+
+        for (jint i = 0; i < srcLen; i++) {
+            srcVArr[srcIndices[i]] = values[i];
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void NativeImageKernel::liftLines(jdouble *values, jdouble *work, jint size, jint rowSize, //
+        const jdouble *scheme, jboolean inverse) {
+
+    jint nSteps = (jint) scheme[2];
+    jint sizes[] = { (size + 1) >> 1, size >> 1 };
+    jdouble *channels[] = { work, work + sizes[0] * rowSize };
+    const jdouble *steps[MAX_LIFTING_STEPS];
+
+    for (jint i = 0, offset = 3; i < nSteps; offset += 3 + (jint) scheme[offset + 2], i++) {
+        steps[i] = scheme + offset;
+    }
+
+    if (!inverse) {
+
+        // Split the rows into even and odd channels.
+        for (jint k = 0; k < size; k++) {
+            memcpy(channels[k & 1] + (k >> 1) * rowSize, values + k * rowSize, sizeof(jdouble) * rowSize);
+        }
+
+    } else {
+
+        // Undo the scaling.
+        memcpy(work, values, sizeof(jdouble) * size * rowSize);
+
+        for (jint c = 0; c < 2; c++) {
+
+            jdouble factor = 1.0 / scheme[c];
+
+            for (jint i = 0, n = sizes[c] * rowSize; i < n; i++) {
+                channels[c][i] *= factor;
+            }
+        }
+    }
+
+    // Lift whole rows at a time, extending the source channel symmetrically past its ends.
+    for (jint i = 0; i < nSteps; i++) {
+
+        const jdouble *step = steps[!inverse ? i : nSteps - 1 - i];
+
+        jint channel = (jint) step[0];
+        jint first = (jint) step[1];
+        jint nTaps = (jint) step[2];
+        jdouble sign = !inverse ? 1.0 : -1.0;
+
+        jdouble *dst = channels[channel];
+        const jdouble *src = channels[1 - channel];
+        jint dstSize = sizes[channel];
+        jint srcSize = sizes[1 - channel];
+
+        for (jint k = 0; k < dstSize; k++) {
+
+            jdouble *dstRow = dst + k * rowSize;
+
+            for (jint tap = 0; tap < nTaps; tap++) {
+
+                jdouble coefficient = sign * step[3 + tap];
+
+                if (coefficient == 0.0) {
+                    continue;
+                }
+
+                jint index = k + first + tap;
+
+                while (index < 0 || index >= srcSize) {
+                    index = (index < 0) ? -1 - index : 2 * srcSize - 1 - index;
+                }
+
+                const jdouble *srcRow = src + index * rowSize;
+
+                for (jint r = 0; r < rowSize; r++) {
+                    dstRow[r] += coefficient * srcRow[r];
+                }
+            }
+        }
+    }
+
+    if (!inverse) {
+
+        for (jint c = 0; c < 2; c++) {
+
+            jdouble factor = scheme[c];
+
+            for (jint i = 0, n = sizes[c] * rowSize; i < n; i++) {
+                channels[c][i] *= factor;
+            }
+        }
+
+        memcpy(values, work, sizeof(jdouble) * size * rowSize);
+
+    } else {
+
+        // Merge the even and odd channels back into rows.
+        for (jint k = 0; k < size; k++) {
+            memcpy(values + k * rowSize, channels[k & 1] + (k >> 1) * rowSize, sizeof(jdouble) * rowSize);
+        }
+    }
+}
+
+void NativeImageKernel::copyRegion(jdouble *values, jdouble *region, //
+        jint *dims, jint *regionDims, jint nDims, bool extract) {
+
+    jint rowSize = regionDims[nDims - 1];
+    jint nRows = Common::product(regionDims, nDims - 1, (jint) 1);
+
+    for (jint row = 0; row < nRows; row++) {
+
+        // Find the offset of the row's leading corner in the full array.
+        jint offset = 0;
+
+        for (jint dim = nDims - 2, rem = row, stride = dims[nDims - 1]; dim >= 0; stride *= dims[dim--]) {
+
+            offset += (rem % regionDims[dim]) * stride;
+            rem /= regionDims[dim];
+        }
+
+        if (extract) {
+
+            memcpy(region + row * rowSize, values + offset, sizeof(jdouble) * rowSize);
+
+        } else {
+
+            memcpy(values + offset, region + row * rowSize, sizeof(jdouble) * rowSize);
+        }
+    }
+}
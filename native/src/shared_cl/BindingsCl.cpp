@@ -66,6 +66,30 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_slice(JNIEnv
         jobject dstV, jintArray dstD, jintArray dstS) {
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_concat(JNIEnv *env, jobject thisObj, //
+        jint opDim, //
+        jobjectArray srcVs, jobjectArray srcDs, jobjectArray srcSs, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_pad(JNIEnv *env, jobject thisObj, //
+        jint mode, jintArray offsets, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_gather(JNIEnv *env, jobject thisObj, //
+        jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_scatter(JNIEnv *env, jobject thisObj, //
+        jint type, jint opDim, jintArray indices, //
+        jobject srcV, jintArray srcD, jintArray srcS, //
+        jobject dstV, jintArray dstD, jintArray dstS) {
+}
+
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rrOp(JNIEnv *env, jobject thisObj, jint type, //
         jdoubleArray srcV, jintArray srcD, jintArray srcS, //
         jdoubleArray dstV, jintArray dstD, jintArray dstS, //
@@ -83,6 +107,17 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rdOp(JNIEnv *
         jintArray opDims) {
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rwOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray dstV, //
+        jint dim, jint size) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rgOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray labels, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS, //
+        jint dim) {
+}
+
 JNIEXPORT jdouble JNICALL Java_org_shared_array_jni_NativeArrayKernel_raOp(JNIEnv *env, jobject thisObj, jint type, //
         jdoubleArray srcV) {
     return 0.0;
@@ -105,6 +140,18 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_iuOp(JNIEnv *
         jint a, jintArray srcV) {
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_ruOpTo(JNIEnv *env, jobject thisObj, jint type, //
+        jdouble a, jdoubleArray srcV, jdoubleArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_cuOpTo(JNIEnv *env, jobject thisObj, jint type, //
+        jdouble aRe, jdouble aIm, jdoubleArray srcV, jdoubleArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_iuOpTo(JNIEnv *env, jobject thisObj, jint type, //
+        jint a, jintArray srcV, jintArray dstV) {
+}
+
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_eOp(JNIEnv *env, jobject thisObj, jint type, //
         jobject lhsV, jobject rhsV, jobject dstV, jboolean complex) {
 }
@@ -113,6 +160,43 @@ JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_convert(JNIEn
         jobject srcV, jboolean isSrcComplex, jobject dstV, jboolean isDstComplex) {
 }
 
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_rcOp(JNIEnv *env, jobject thisObj, jint type, //
+        jdoubleArray lhsV, jdoubleArray rhsV, jdouble a, jlongArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_mlOp(JNIEnv *env, jobject thisObj, jint type, //
+        jlongArray lhsV, jlongArray rhsV, jlongArray dstV, jint len) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_select(JNIEnv *env, jobject thisObj, //
+        jlongArray maskV, jobject lhsV, jobject rhsV, jobject dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_maskedFill(JNIEnv *env, jobject thisObj, //
+        jlongArray maskV, jdouble a, jdoubleArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_halfConvert(JNIEnv *env, jobject thisObj, //
+        jint format, jdoubleArray srcV, jshortArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_halfExpand(JNIEnv *env, jobject thisObj, //
+        jint format, jshortArray srcV, jdoubleArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_heOp(JNIEnv *env, jobject thisObj, //
+        jint type, jint format, jshortArray lhsV, jshortArray rhsV, jshortArray dstV) {
+}
+
+JNIEXPORT jdouble JNICALL Java_org_shared_array_jni_NativeArrayKernel_haOp(JNIEnv *env, jobject thisObj, //
+        jint type, jint format, jshortArray srcV) {
+    return 0.0;
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_hMul(JNIEnv *env, jobject thisObj, //
+        jint format, jshortArray lhsV, jshortArray rhsV, jint lhsR, jint rhsC, jdoubleArray dstV) {
+}
+
 JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_mul(JNIEnv *env, jobject thisObj, //
         jdoubleArray lhsV, jdoubleArray rhsV, jint lhsR, jint rhsC, jdoubleArray dstV, jboolean complex) {
 }
@@ -145,11 +229,98 @@ JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_createIntegra
         jdoubleArray dstV, jintArray dstD, jintArray dstS) {
 }
 
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_createIntegralMoments(JNIEnv *env, jobject thisObj, //
+        jintArray types, jdoubleArray xV, jdoubleArray yV, jintArray srcD, jintArray srcS, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_localMeanVariance(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdoubleArray meanV, jdoubleArray varV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_guidedFilter(JNIEnv *env, jobject thisObj, //
+        jdoubleArray guideV, jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, jdouble epsilon, //
+        jdoubleArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_normalizedCrossCorrelation(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray tplV, jintArray tplD, jintArray tplS, //
+        jdoubleArray dstV, jintArray dstD, jintArray dstS) {
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_image_jni_NativeImageKernel_findPeaks(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jintArray radii, //
+        jdouble threshold, jint minDistance) {
+    return NULL;
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_mapCoordinates(JNIEnv *env, jobject thisObj, //
+        jint interpolation, jint boundary, jdouble cval, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray coordsV, jdoubleArray dstV, jboolean complex) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_splineCoefficients(JNIEnv *env, jobject thisObj, //
+        jint boundary, jdouble cval, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jdoubleArray dstV, jboolean complex) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_bilateralFilter(JNIEnv *env, jobject thisObj, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, jdoubleArray sigmas, //
+        jdoubleArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_image_jni_NativeImageKernel_waveletTransform(JNIEnv *env, jobject thisObj, //
+        jint wavelet, jint nLevels, //
+        jdoubleArray srcV, jintArray srcD, jintArray srcS, //
+        jboolean inverse) {
+}
+
 JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_find(JNIEnv *env, jobject thisObj, //
         jintArray srcV, jintArray srcD, jintArray srcS, jintArray logical) {
     return NULL;
 }
 
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_sortRows(JNIEnv *env, jobject thisObj, //
+        jobject srcV, jintArray srcD, jintArray srcS) {
+    return NULL;
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_unique(JNIEnv *env, jobject thisObj, //
+        jobject srcV, jintArray srcD, jintArray srcS, jintArray inverse, jintArray counts) {
+    return NULL;
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_searchSorted(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray edges, jdoubleArray srcV, jintArray dstV) {
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_interpolate(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray xV, jdoubleArray yV, jdoubleArray srcV, jdoubleArray dstV) {
+}
+
+JNIEXPORT jdoubleArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_errorCurve(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray scoresV, jbooleanArray outcomesV, jint nPoints, jdoubleArray statsV) {
+    return NULL;
+}
+
+JNIEXPORT void JNICALL Java_org_shared_array_jni_NativeArrayKernel_histogram(JNIEnv *env, jobject thisObj, //
+        jint type, jdoubleArray srcV, jdouble min, jdouble max, jdoubleArray edgesV, jdoubleArray dstV) {
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_lttb(JNIEnv *env, jobject thisObj, //
+        jdoubleArray xV, jdoubleArray yV, jint nPoints) {
+    return NULL;
+}
+
+JNIEXPORT jintArray JNICALL Java_org_shared_array_jni_NativeArrayKernel_thin(JNIEnv *env, jobject thisObj, //
+        jdoubleArray xV, jdoubleArray yV, jdoubleArray boundsV, jint nX, jint nY) {
+    return NULL;
+}
+
 JNIEXPORT jobject JNICALL Java_org_shared_array_jni_NativeArrayKernel_insertSparse(JNIEnv *env, jobject thisObj, //
         jobject oldV, jintArray oldD, jintArray oldS, jintArray oldDo, jintArray oldI, //
         jobject newV, jintArray newLi) {
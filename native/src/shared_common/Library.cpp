@@ -65,12 +65,19 @@ jint Library::OnLoad(JavaVM *jvm, void *reserved) {
         Library::registerService(env, //
                 "org/shared/image/kernel/ImageKernel", "org/shared/image/jni/NativeImageKernel");
 
+        NativeFftService::init(env);
+
 #ifdef sstx_EXPORTS
 
         Library::init(env);
         Library::registerService(env, //
                 "org/shared/fft/FftService", "org/sharedx/fftw/FftwService");
 
+#else
+
+        Library::registerService(env, //
+                "org/shared/fft/FftService", "org/shared/fft/jni/NativeFftService");
+
 #endif
 
         // Set the initialization flag to true.
@@ -96,6 +103,7 @@ void Library::OnUnload(JavaVM *jvm, void *reserved) {
 
     NativeArrayKernel::destroy(env);
     NativeImageKernel::destroy(env);
+    NativeFftService::destroy(env);
 
 #ifdef sstx_EXPORTS
 
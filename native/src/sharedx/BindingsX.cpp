@@ -28,6 +28,16 @@ JNIEXPORT void JNICALL Java_org_sharedx_fftw_Plan_transform(JNIEnv *env, jobject
     Plan::transform(env, thisObj, in, out);
 }
 
+JNIEXPORT void JNICALL Java_org_sharedx_fftw_Plan_stft(JNIEnv *env, jobject thisObj, //
+        jdoubleArray signal, jdoubleArray window, jint hop, jint outputType, jdoubleArray out) {
+    Plan::stft(env, thisObj, signal, window, hop, outputType, out);
+}
+
+JNIEXPORT void JNICALL Java_org_sharedx_fftw_Plan_istft(JNIEnv *env, jobject thisObj, //
+        jdoubleArray in, jdoubleArray window, jint hop, jdoubleArray out) {
+    Plan::istft(env, thisObj, in, window, hop, out);
+}
+
 JNIEXPORT jbyteArray JNICALL Java_org_sharedx_fftw_Plan_create(JNIEnv *env, jobject thisObj, jint type, //
         jintArray dims, jint logicalMode) {
     return Plan::create(env, thisObj, type, dims, logicalMode);
@@ -45,6 +55,25 @@ JNIEXPORT void JNICALL Java_org_sharedx_fftw_Plan_importWisdom(JNIEnv *env, jcla
     Plan::importWisdom(env, wisdom);
 }
 
+JNIEXPORT void JNICALL Java_org_sharedx_fftw_GuruPlan_transform(JNIEnv *env, jobject thisObj, //
+        jdoubleArray in, jint inOffset, jdoubleArray out, jint outOffset) {
+    Plan::transformGuru(env, thisObj, in, inOffset, out, outOffset);
+}
+
+JNIEXPORT jbyteArray JNICALL Java_org_sharedx_fftw_GuruPlan_create(JNIEnv *env, jobject thisObj, jint type, //
+        jintArray dims, jintArray inStrides, jintArray outStrides, //
+        jintArray loopDims, jintArray loopInStrides, jintArray loopOutStrides, //
+        jint logicalMode) {
+    return Plan::createGuru(env, thisObj, type, //
+            dims, inStrides, outStrides, //
+            loopDims, loopInStrides, loopOutStrides, //
+            logicalMode);
+}
+
+JNIEXPORT void JNICALL Java_org_sharedx_fftw_GuruPlan_destroy(JNIEnv *env, jobject thisObj) {
+    Plan::destroyGuru(env, thisObj);
+}
+
 JNIEXPORT void JNICALL Java_org_sharedx_test_BenchmarkNative_testConvolve(JNIEnv *env, jobject thisObj) {
     Benchmark::testConvolve(env, thisObj);
 }
@@ -29,16 +29,25 @@ static jfieldID typeFieldId;
 static jfieldID dimsFieldId;
 static jfieldID memFieldId;
 
+static jclass guruPlanClass = NULL;
+
+static jfieldID guruMemFieldId;
+
 void Plan::init(JNIEnv *env) {
 
     planClass = (jclass) Common::newWeakGlobalRef(env, Common::findClass(env, "org/sharedx/fftw/Plan"));
     typeFieldId = Common::getFieldId(env, planClass, "type", "I");
     dimsFieldId = Common::getFieldId(env, planClass, "dims", "[I");
     memFieldId = Common::getFieldId(env, planClass, "memory", "[B");
+
+    guruPlanClass = (jclass) Common::newWeakGlobalRef(env, Common::findClass(env, "org/sharedx/fftw/GuruPlan"));
+    guruMemFieldId = Common::getFieldId(env, guruPlanClass, "memory", "[B");
 }
 
 void Plan::destroy(JNIEnv *env) {
+
     Common::deleteWeakGlobalRef(env, planClass);
+    Common::deleteWeakGlobalRef(env, guruPlanClass);
 }
 
 void Plan::transform(JNIEnv *env, jobject thisObj, jdoubleArray in, jdoubleArray out) {
@@ -98,6 +107,246 @@ void Plan::transform(JNIEnv *env, jobject thisObj, jdoubleArray in, jdoubleArray
     }
 }
 
+void Plan::stft(JNIEnv *env, jobject thisObj, //
+        jdoubleArray signal, jdoubleArray window, jint hop, jint outputType, //
+        jdoubleArray out) {
+
+    try {
+
+        if (!signal || !window || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint type = env->GetIntField(thisObj, typeFieldId);
+        jintArray dims = (jintArray) env->GetObjectField(thisObj, dimsFieldId);
+        jbyteArray mem = (jbyteArray) env->GetObjectField(thisObj, memFieldId);
+
+        if (!mem) {
+            throw std::runtime_error("The byte array reference was not properly initialized");
+        }
+
+        jint nDims = env->GetArrayLength(dims);
+        jint signalLen = env->GetArrayLength(signal);
+        jint frameLen = env->GetArrayLength(window);
+        jint outLen = env->GetArrayLength(out);
+
+        if (type != org_sharedx_fftw_Plan_R_TO_C || nDims != 1) {
+            throw std::runtime_error("Plan must be one-dimensional and real-to-complex");
+        }
+
+        if (hop <= 0) {
+            throw std::runtime_error("Invalid hop size");
+        }
+
+        jint nBins = frameLen / 2 + 1;
+        jint spectrumLen;
+
+        switch (outputType) {
+
+        case org_sharedx_fftw_Plan_STFT_COMPLEX:
+            spectrumLen = 2 * nBins;
+            break;
+
+        case org_sharedx_fftw_Plan_STFT_MAGNITUDE:
+        case org_sharedx_fftw_Plan_STFT_POWER:
+        case org_sharedx_fftw_Plan_STFT_LOG_MAGNITUDE:
+            spectrumLen = nBins;
+            break;
+
+        default:
+            throw std::runtime_error("Output type not recognized");
+        }
+
+        jint nFrames = (signalLen >= frameLen) ? (signalLen - frameLen) / hop + 1 : 0;
+
+        //
+        //
+        // Initialize pinned arrays.
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler signalH(env, signal, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler windowH(env, window, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        ArrayPinHandler memH(env, mem, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jdouble *signalArr = (jdouble *) signalH.get();
+        jdouble *windowArr = (jdouble *) windowH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+        fftw_plan *memArr = (fftw_plan *) memH.get();
+
+        if (dimsArr[0] != frameLen || outLen != nFrames * spectrumLen) {
+            throw std::runtime_error("Input and/or output arrays do not have expected sizes");
+        }
+
+        //
+        //
+        // Set up and execute!
+
+        MallocHandler mallocH(sizeof(jdouble) * (frameLen + 2 * nBins));
+        jdouble *all = (jdouble *) mallocH.get();
+
+        jdouble *frame = all;
+        jdouble *spectrum = all + frameLen;
+
+        for (jint t = 0; t < nFrames; t++) {
+
+            const jdouble *src = signalArr + t * hop;
+            jdouble *dst = outArr + t * spectrumLen;
+
+            for (jint i = 0; i < frameLen; i++) {
+                frame[i] = windowArr[i] * src[i];
+            }
+
+            // Complex spectra go directly into the output, which the unaligned plan permits.
+            if (outputType == org_sharedx_fftw_Plan_STFT_COMPLEX) {
+
+                fftw_execute_dft_r2c(*memArr, frame, (fftw_complex *) dst);
+
+                continue;
+            }
+
+            fftw_execute_dft_r2c(*memArr, frame, (fftw_complex *) spectrum);
+
+            for (jint k = 0; k < nBins; k++) {
+
+                jdouble re = spectrum[2 * k];
+                jdouble im = spectrum[2 * k + 1];
+                jdouble power = re * re + im * im;
+
+                switch (outputType) {
+
+                case org_sharedx_fftw_Plan_STFT_MAGNITUDE:
+                    dst[k] = sqrt(power);
+                    break;
+
+                case org_sharedx_fftw_Plan_STFT_POWER:
+                    dst[k] = power;
+                    break;
+
+                default:
+                    dst[k] = 0.5 * log(power);
+                    break;
+                }
+            }
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+void Plan::istft(JNIEnv *env, jobject thisObj, //
+        jdoubleArray in, jdoubleArray window, jint hop, //
+        jdoubleArray out) {
+
+    try {
+
+        if (!in || !window || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint type = env->GetIntField(thisObj, typeFieldId);
+        jintArray dims = (jintArray) env->GetObjectField(thisObj, dimsFieldId);
+        jbyteArray mem = (jbyteArray) env->GetObjectField(thisObj, memFieldId);
+
+        if (!mem) {
+            throw std::runtime_error("The byte array reference was not properly initialized");
+        }
+
+        jint nDims = env->GetArrayLength(dims);
+        jint inLen = env->GetArrayLength(in);
+        jint frameLen = env->GetArrayLength(window);
+        jint outLen = env->GetArrayLength(out);
+
+        if (type != org_sharedx_fftw_Plan_C_TO_R || nDims != 1) {
+            throw std::runtime_error("Plan must be one-dimensional and complex-to-real");
+        }
+
+        if (hop <= 0) {
+            throw std::runtime_error("Invalid hop size");
+        }
+
+        jint spectrumLen = 2 * (frameLen / 2 + 1);
+        jint nFrames = inLen / spectrumLen;
+
+        //
+        //
+        // Initialize pinned arrays.
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler inH(env, in, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler windowH(env, window, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        ArrayPinHandler memH(env, mem, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jdouble *inArr = (jdouble *) inH.get();
+        jdouble *windowArr = (jdouble *) windowH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+        fftw_plan *memArr = (fftw_plan *) memH.get();
+
+        if (dimsArr[0] != frameLen || inLen != nFrames * spectrumLen //
+                || outLen != ((nFrames > 0) ? (nFrames - 1) * hop + frameLen : 0)) {
+            throw std::runtime_error("Input and/or output arrays do not have expected sizes");
+        }
+
+        //
+        //
+        // Set up and execute!
+
+        MallocHandler mallocH(sizeof(jdouble) * (spectrumLen + frameLen + outLen));
+        jdouble *all = (jdouble *) mallocH.get();
+
+        jdouble *spectrum = all;
+        jdouble *frame = all + spectrumLen;
+        jdouble *norms = all + spectrumLen + frameLen;
+
+        for (jint i = 0; i < outLen; i++) {
+
+            outArr[i] = 0.0;
+            norms[i] = 0.0;
+        }
+
+        jdouble scalingFactor = 1.0 / frameLen;
+
+        for (jint t = 0; t < nFrames; t++) {
+
+            // Complex-to-real transforms destroy their input.
+            memcpy(spectrum, inArr + t * spectrumLen, sizeof(jdouble) * spectrumLen);
+
+            fftw_execute_dft_c2r(*memArr, (fftw_complex *) spectrum, frame);
+
+            jdouble *dst = outArr + t * hop;
+            jdouble *norm = norms + t * hop;
+
+            for (jint i = 0; i < frameLen; i++) {
+
+                dst[i] += windowArr[i] * frame[i] * scalingFactor;
+                norm[i] += windowArr[i] * windowArr[i];
+            }
+        }
+
+        // Samples where the squared windows sum to a negligible amount can't be recovered.
+        jdouble maxNorm = 0.0;
+
+        for (jint i = 0; i < outLen; i++) {
+            maxNorm = std::max(maxNorm, norms[i]);
+        }
+
+        for (jint i = 0; i < outLen; i++) {
+            outArr[i] = (norms[i] > 1e-10 * maxNorm) ? outArr[i] / norms[i] : 0.0;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
 jbyteArray Plan::create(JNIEnv *env, jobject thisObj, jint type, jintArray dims, jint logicalMode) {
 
     jbyteArray mem = NULL;
@@ -141,8 +390,311 @@ jbyteArray Plan::create(JNIEnv *env, jobject thisObj, jint type, jintArray dims,
 }
 
 void Plan::destroy(JNIEnv *env, jobject thisObj) {
+    Plan::destroyPlan(env, (jbyteArray) env->GetObjectField(thisObj, memFieldId));
+}
+
+void Plan::transformGuru(JNIEnv *env, jobject thisObj, //
+        jdoubleArray in, jint inOffset, jdoubleArray out, jint outOffset) {
 
-    jbyteArray mem = (jbyteArray) env->GetObjectField(thisObj, memFieldId);
+    try {
+
+        if (!in || !out) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jbyteArray mem = (jbyteArray) env->GetObjectField(thisObj, guruMemFieldId);
+
+        if (!mem) {
+            throw std::runtime_error("The byte array reference was not properly initialized");
+        }
+
+        // Decide aliasing by object identity, since pinned pointers coincide only if the arrays aren't copied.
+        if (env->IsSameObject(in, out)) {
+            throw std::runtime_error("Input and output arrays must be distinct");
+        }
+
+        jint inLen = env->GetArrayLength(in);
+        jint outLen = env->GetArrayLength(out);
+
+        //
+        //
+        // Initialize pinned arrays.
+
+        ArrayPinHandler inH(env, in, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outH(env, out, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        ArrayPinHandler memH(env, mem, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        // NO JNI AFTER THIS POINT!
+
+        jdouble *inArr = (jdouble *) inH.get();
+        jdouble *outArr = (jdouble *) outH.get();
+        GuruPlanData *data = (GuruPlanData *) memH.get();
+        fftw_iodim *iodims = (fftw_iodim *) (data + 1);
+
+        if (inOffset < 0 || inOffset > inLen - data->inExtent //
+                || outOffset < 0 || outOffset > outLen - data->outExtent) {
+            throw std::runtime_error("Input and/or output arrays do not span the plan layout");
+        }
+
+        //
+        //
+        // Set up and execute!
+
+        jdouble *src = inArr + inOffset;
+        jdouble *dst = outArr + outOffset;
+
+        jint type = data->type;
+        jint nIodims = data->rank + data->howmanyRank;
+
+        // Execution of a plan via the guru interface is thread-safe, so one need not acquire any monitors.
+        switch (type) {
+
+        case org_sharedx_fftw_Plan_R_TO_C:
+            fftw_execute_dft_r2c(data->plan, src, (fftw_complex *) dst);
+            break;
+
+        case org_sharedx_fftw_Plan_C_TO_R:
+            executePlanCToR(data->plan, src, dst, data->inExtent);
+            break;
+
+        case org_sharedx_fftw_Plan_FORWARD:
+        case org_sharedx_fftw_Plan_BACKWARD:
+            fftw_execute_dft(data->plan, (fftw_complex *) src, (fftw_complex *) dst);
+            break;
+
+        default:
+            throw std::runtime_error("Plan type not recognized");
+        }
+
+        if (data->scalingFactor == 1.0) {
+            return;
+        }
+
+        // Scale only the output elements in the layout, which need not be contiguous.
+
+        jint outUnit = (type == org_sharedx_fftw_Plan_C_TO_R) ? 1 : 2;
+
+        MallocHandler mallocH(sizeof(jint) * nIodims);
+        jint *indices = (jint *) mallocH.get();
+
+        for (jint i = 0; i < nIodims; i++) {
+            indices[i] = 0;
+        }
+
+        for (jint offset = 0;;) {
+
+            for (jint i = 0; i < outUnit; i++) {
+                dst[outUnit * offset + i] *= data->scalingFactor;
+            }
+
+            jint i = nIodims - 1;
+
+            for (; i >= 0 && indices[i] == iodims[i].n - 1; i--) {
+
+                offset -= indices[i] * iodims[i].os;
+                indices[i] = 0;
+            }
+
+            if (i < 0) {
+                break;
+            }
+
+            indices[i]++;
+            offset += iodims[i].os;
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+}
+
+jbyteArray Plan::createGuru(JNIEnv *env, jobject thisObj, jint type, //
+        jintArray dims, jintArray inStrides, jintArray outStrides, //
+        jintArray loopDims, jintArray loopInStrides, jintArray loopOutStrides, //
+        jint logicalMode) {
+
+    jbyteArray mem = NULL;
+
+    try {
+
+        if (!dims || !inStrides || !outStrides || !loopDims || !loopInStrides || !loopOutStrides) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint rank = env->GetArrayLength(dims);
+        jint howmanyRank = env->GetArrayLength(loopDims);
+
+        if (rank == 0) {
+            throw std::runtime_error("Rank must be greater than zero");
+        }
+
+        if (env->GetArrayLength(inStrides) != rank || env->GetArrayLength(outStrides) != rank //
+                || env->GetArrayLength(loopInStrides) != howmanyRank //
+                || env->GetArrayLength(loopOutStrides) != howmanyRank) {
+            throw std::runtime_error("Invalid arguments");
+        }
+
+        jint nIodims = rank + howmanyRank;
+
+        mem = Common::newByteArray(env, sizeof(GuruPlanData) + sizeof(fftw_iodim) * nIodims);
+
+        // Acquire the class monitor before pinning/creating.
+        MonitorHandler monitorH(env, (jobject) planClass);
+
+        ArrayPinHandler dimsH(env, dims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler inStridesH(env, inStrides, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler outStridesH(env, outStrides, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler loopDimsH(env, loopDims, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler loopInStridesH(env, loopInStrides, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler loopOutStridesH(env, loopOutStrides, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_ONLY);
+        ArrayPinHandler memH(env, mem, ArrayPinHandler::PRIMITIVE, ArrayPinHandler::READ_WRITE);
+        // NO JNI AFTER THIS POINT!
+
+        jint *dimsArr = (jint *) dimsH.get();
+        jint *inStridesArr = (jint *) inStridesH.get();
+        jint *outStridesArr = (jint *) outStridesH.get();
+        jint *loopDimsArr = (jint *) loopDimsH.get();
+        jint *loopInStridesArr = (jint *) loopInStridesH.get();
+        jint *loopOutStridesArr = (jint *) loopOutStridesH.get();
+        GuruPlanData *data = (GuruPlanData *) memH.get();
+        fftw_iodim *iodims = (fftw_iodim *) (data + 1);
+
+        // Lay out the transform dimensions followed by the loop dimensions.
+
+        for (jint i = 0; i < rank; i++) {
+
+            iodims[i].n = dimsArr[i];
+            iodims[i].is = inStridesArr[i];
+            iodims[i].os = outStridesArr[i];
+        }
+
+        for (jint i = 0; i < howmanyRank; i++) {
+
+            iodims[rank + i].n = loopDimsArr[i];
+            iodims[rank + i].is = loopInStridesArr[i];
+            iodims[rank + i].os = loopOutStridesArr[i];
+        }
+
+        jint inUnit, outUnit;
+        jdouble scalingFactor = 1.0;
+
+        switch (type) {
+
+        case org_sharedx_fftw_Plan_R_TO_C:
+            inUnit = 1;
+            outUnit = 2;
+            break;
+
+        case org_sharedx_fftw_Plan_C_TO_R:
+            inUnit = 2;
+            outUnit = 1;
+            break;
+
+        case org_sharedx_fftw_Plan_FORWARD:
+        case org_sharedx_fftw_Plan_BACKWARD:
+            inUnit = 2;
+            outUnit = 2;
+            break;
+
+        default:
+            throw std::runtime_error("Transform type not recognized");
+        }
+
+        // Compute the spans of the layout in units of doubles.
+
+        jlong inSpan = 1;
+        jlong outSpan = 1;
+
+        for (jint i = 0; i < nIodims; i++) {
+
+            if (iodims[i].n <= 0 || iodims[i].is <= 0 || iodims[i].os <= 0) {
+                throw std::runtime_error("Invalid dimensions and/or strides");
+            }
+
+            jint inSize = iodims[i].n;
+            jint outSize = iodims[i].n;
+
+            // The last transform dimension of the complex side of a real transform is halved.
+            if (i == rank - 1) {
+
+                if (type == org_sharedx_fftw_Plan_R_TO_C) {
+
+                    outSize = inSize / 2 + 1;
+
+                } else if (type == org_sharedx_fftw_Plan_C_TO_R) {
+
+                    inSize = outSize / 2 + 1;
+                }
+            }
+
+            inSpan += (jlong) (inSize - 1) * iodims[i].is;
+            outSpan += (jlong) (outSize - 1) * iodims[i].os;
+
+            if (i < rank && (type == org_sharedx_fftw_Plan_C_TO_R || type == org_sharedx_fftw_Plan_BACKWARD)) {
+                scalingFactor /= iodims[i].n;
+            }
+
+            if (inSpan * inUnit > 0x7FFFFFFF || outSpan * outUnit > 0x7FFFFFFF) {
+                throw std::runtime_error("Layout too large");
+            }
+        }
+
+        data->type = type;
+        data->rank = rank;
+        data->howmanyRank = howmanyRank;
+        data->inExtent = (jint) (inSpan * inUnit);
+        data->outExtent = (jint) (outSpan * outUnit);
+        data->scalingFactor = scalingFactor;
+
+        MallocHandler mallocH(sizeof(jdouble) * (data->inExtent + data->outExtent));
+        jdouble *all = (jdouble *) mallocH.get();
+
+        jdouble *inArr = all;
+        jdouble *outArr = all + data->inExtent;
+
+        jint mode = Plan::getFftwMode(logicalMode);
+
+        fftw_iodim *loops = iodims + rank;
+
+        // Plan creation is NOT thread-safe.
+        switch (type) {
+
+        case org_sharedx_fftw_Plan_R_TO_C:
+            data->plan = fftw_plan_guru_dft_r2c(rank, iodims, howmanyRank, loops, //
+                    inArr, (fftw_complex *) outArr, mode | FFTW_PRESERVE_INPUT | FFTW_UNALIGNED);
+            break;
+
+        case org_sharedx_fftw_Plan_C_TO_R:
+            // NOTE: Complex-to-real transforms may destroy their input.
+            data->plan = fftw_plan_guru_dft_c2r(rank, iodims, howmanyRank, loops, //
+                    (fftw_complex *) inArr, outArr, mode | FFTW_DESTROY_INPUT | FFTW_UNALIGNED);
+            break;
+
+        default:
+            data->plan = fftw_plan_guru_dft(rank, iodims, howmanyRank, loops, //
+                    (fftw_complex *) inArr, (fftw_complex *) outArr, //
+                    (type == org_sharedx_fftw_Plan_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD, //
+                    mode | FFTW_PRESERVE_INPUT | FFTW_UNALIGNED);
+            break;
+        }
+
+        if (!data->plan) {
+            throw std::runtime_error("Plan creation failed");
+        }
+
+    } catch (std::exception &e) {
+
+        Common::throwNew(env, e);
+    }
+
+    return mem;
+}
+
+void Plan::destroyGuru(JNIEnv *env, jobject thisObj) {
+    Plan::destroyPlan(env, (jbyteArray) env->GetObjectField(thisObj, guruMemFieldId));
+}
+
+void Plan::destroyPlan(JNIEnv *env, jbyteArray mem) {
 
     // Null field value; perhaps the constructor didn't finish. Return immediately because there is nothing to clean up.
     if (!mem) {
@@ -319,42 +871,41 @@ inline void Plan::getTransformParameters( //
     }
 }
 
-inline fftw_plan Plan::createPlan( //
-        jint type, const jint *dimsArr, jint nDims, //
-        jint logicalMode, jint inLen, jint outLen) {
-
-    fftw_plan plan = NULL;
-
-    MallocHandler mallocH(sizeof(jdouble) * (inLen + outLen));
-    jdouble *all = (jdouble *) mallocH.get();
-
-    jdouble *inArr = all;
-    jdouble *outArr = all + inLen;
-
-    jint mode;
+inline jint Plan::getFftwMode(jint logicalMode) {
 
     // Convert a Java logical constant into a FFTW constant.
     switch (logicalMode) {
 
     case org_sharedx_fftw_Plan_FFTW_ESTIMATE:
-        mode = FFTW_ESTIMATE;
-        break;
+        return FFTW_ESTIMATE;
 
     case org_sharedx_fftw_Plan_FFTW_MEASURE:
-        mode = FFTW_MEASURE;
-        break;
+        return FFTW_MEASURE;
 
     case org_sharedx_fftw_Plan_FFTW_PATIENT:
-        mode = FFTW_PATIENT;
-        break;
+        return FFTW_PATIENT;
 
     case org_sharedx_fftw_Plan_FFTW_EXHAUSTIVE:
-        mode = FFTW_EXHAUSTIVE;
-        break;
+        return FFTW_EXHAUSTIVE;
 
     default:
         throw std::runtime_error("Plan type not recognized");
     }
+}
+
+inline fftw_plan Plan::createPlan( //
+        jint type, const jint *dimsArr, jint nDims, //
+        jint logicalMode, jint inLen, jint outLen) {
+
+    fftw_plan plan = NULL;
+
+    MallocHandler mallocH(sizeof(jdouble) * (inLen + outLen));
+    jdouble *all = (jdouble *) mallocH.get();
+
+    jdouble *inArr = all;
+    jdouble *outArr = all + inLen;
+
+    jint mode = Plan::getFftwMode(logicalMode);
 
     switch (type) {
 
@@ -435,3 +986,38 @@ void Plan::executePlanCToR( //
 
     fftw_execute_dft_c2r(plan, tmpArr, outArr);
 }
+
+//
+
+PlanHandler::PlanHandler(JNIEnv *env, jint type, const jint *dims, jint nDims, jint logicalMode) {
+
+    jint inLen, outLen;
+    jdouble scalingFactor;
+
+    Plan::getTransformParameters(inLen, outLen, scalingFactor, type, dims, nDims);
+
+    MonitorHandler monitorH(env, (jobject) planClass);
+
+    // Plan creation is NOT thread-safe.
+    this->plan = Plan::createPlan(type, dims, nDims, logicalMode, inLen, outLen);
+    this->env = env;
+}
+
+void *PlanHandler::get() {
+    return this->plan;
+}
+
+PlanHandler::~PlanHandler() {
+
+    try {
+
+        MonitorHandler monitorH(this->env, (jobject) planClass);
+
+        // Plan destruction is NOT thread-safe.
+        fftw_destroy_plan(this->plan);
+
+    } catch (...) {
+
+        // Do nothing.
+    }
+}
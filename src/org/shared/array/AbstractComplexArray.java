@@ -223,6 +223,41 @@ abstract public class AbstractComplexArray<C extends AbstractComplexArray<C, R>,
         return super.reshape(dims);
     }
 
+    @Override
+    public C gather(int dim, int... indices) {
+
+        Control.checkTrue(dim != dims.length - 1, //
+                "Invalid gather dimension for complex-valued array");
+
+        return super.gather(dim, indices);
+    }
+
+    @Override
+    public C scatter(int type, C dst, int dim, int... indices) {
+
+        Control.checkTrue(dim != dims.length - 1, //
+                "Invalid scatter dimension for complex-valued array");
+
+        Control.checkTrue(type == ArrayKernel.SC_ASSIGN || type == ArrayKernel.SC_ADD, //
+                "Invalid scatter operation for complex-valued array");
+
+        return super.scatter(type, dst, dim, indices);
+    }
+
+    @Override
+    public C scatterLinear(int type, C dst, int... indices) {
+
+        Control.checkTrue(type == ArrayKernel.SC_ASSIGN || type == ArrayKernel.SC_ADD, //
+                "Invalid scatter operation for complex-valued array");
+
+        return super.scatterLinear(type, dst, indices);
+    }
+
+    @Override
+    protected int[] linearDimensions(int[] dims) {
+        return new int[] { Arithmetic.product(dims) / 2, 2 };
+    }
+
     @Override
     public C reverseOrder() {
         throw new UnsupportedOperationException("Cannot reverse storage orders of complex-valued arrays");
@@ -373,6 +408,34 @@ abstract public class AbstractComplexArray<C extends AbstractComplexArray<C, R>,
         return applyKernelComplexUnaryOperation(Double.NaN, Double.NaN, ArrayKernel.CU_SHUFFLE);
     }
 
+    /**
+     * Non-mutatively exponentiates the elements to the base {@link Math#E}.
+     */
+    public C eExp() {
+        return applyKernelComplexUnaryOperationTo(Double.NaN, Double.NaN, ArrayKernel.CU_EXP);
+    }
+
+    /**
+     * Non-mutatively takes the complex conjugates of the elements.
+     */
+    public C eConj() {
+        return applyKernelComplexUnaryOperationTo(Double.NaN, Double.NaN, ArrayKernel.CU_CONJ);
+    }
+
+    /**
+     * Non-mutatively takes the cosine of the elements.
+     */
+    public C eCos() {
+        return applyKernelComplexUnaryOperationTo(Double.NaN, Double.NaN, ArrayKernel.CU_COS);
+    }
+
+    /**
+     * Non-mutatively takes the sine of the elements.
+     */
+    public C eSin() {
+        return applyKernelComplexUnaryOperationTo(Double.NaN, Double.NaN, ArrayKernel.CU_SIN);
+    }
+
     /**
      * Computes the sum over the elements.
      */
@@ -470,6 +533,18 @@ abstract public class AbstractComplexArray<C extends AbstractComplexArray<C, R>,
         return (C) this;
     }
 
+    /**
+     * Supports the non-mutative unary operations, which read the elements and write the results in a single pass.
+     */
+    protected C applyKernelComplexUnaryOperationTo(double aRe, double aIm, int type) {
+
+        C res = wrap(this.order, this.dims, this.strides);
+
+        opKernel.cuOpTo(type, aRe, aIm, this.values, res.values);
+
+        return res;
+    }
+
     /**
      * A representation of complex numbers.
      */
@@ -34,6 +34,7 @@ import static org.shared.array.ArrayBase.opKernel;
 import java.util.Arrays;
 
 import org.shared.array.kernel.ArrayKernel;
+import org.shared.util.Control;
 
 /**
  * An abstract base class for arrays of real values.
@@ -200,6 +201,203 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return applyKernelRealUnaryOperation(Double.NaN, ArrayKernel.RU_SHUFFLE);
     }
 
+    /**
+     * Non-mutatively exponentiates the elements to the base {@link Math#E}.
+     */
+    public R eExp() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_EXP);
+    }
+
+    /**
+     * Non-mutatively takes the cosine of the elements.
+     */
+    public R eCos() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_COS);
+    }
+
+    /**
+     * Non-mutatively takes the sine of the elements.
+     */
+    public R eSin() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_SIN);
+    }
+
+    /**
+     * Non-mutatively takes the arctangent of the elements.
+     */
+    public R eAtan() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_ATAN);
+    }
+
+    /**
+     * Non-mutatively takes the natural logarithm of the elements.
+     */
+    public R eLog() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_LOG);
+    }
+
+    /**
+     * Non-mutatively takes the absolute value of the elements.
+     */
+    public R eAbs() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_ABS);
+    }
+
+    /**
+     * Non-mutatively takes the elements to the power of the argument.
+     */
+    public R ePow(double a) {
+        return applyKernelRealUnaryOperationTo(a, ArrayKernel.RU_POW);
+    }
+
+    /**
+     * Non-mutatively takes the square root of the elements.
+     */
+    public R eSqrt() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_SQRT);
+    }
+
+    /**
+     * Non-mutatively squares the elements.
+     */
+    public R eSqr() {
+        return applyKernelRealUnaryOperationTo(Double.NaN, ArrayKernel.RU_SQR);
+    }
+
+    /**
+     * Non-mutatively takes the multiplicative inverse of the elements.
+     */
+    public R eInv(double a) {
+        return applyKernelRealUnaryOperationTo(a, ArrayKernel.RU_INV);
+    }
+
+    /**
+     * Mutatively fills this array with the argument where the mask is set.
+     */
+    @SuppressWarnings("unchecked")
+    public R uFill(double a, Mask mask) {
+
+        R res = (R) this;
+
+        mask.checkShape(res.order, res.dims);
+
+        opKernel.maskedFill(mask.words, a, res.values);
+
+        return res;
+    }
+
+    /**
+     * Compares the elements to the argument for less-than.
+     */
+    public Mask cLt(double a) {
+        return applyKernelRealComparison(null, a, ArrayKernel.RC_LT);
+    }
+
+    /**
+     * Compares the elements to the argument for less-than-or-equal.
+     */
+    public Mask cLe(double a) {
+        return applyKernelRealComparison(null, a, ArrayKernel.RC_LE);
+    }
+
+    /**
+     * Compares the elements to the argument for equality.
+     */
+    public Mask cEq(double a) {
+        return applyKernelRealComparison(null, a, ArrayKernel.RC_EQ);
+    }
+
+    /**
+     * Compares the elements to the argument for inequality.
+     */
+    public Mask cNe(double a) {
+        return applyKernelRealComparison(null, a, ArrayKernel.RC_NE);
+    }
+
+    /**
+     * Compares the elements to the argument for greater-than.
+     */
+    public Mask cGt(double a) {
+        return applyKernelRealComparison(null, a, ArrayKernel.RC_GT);
+    }
+
+    /**
+     * Compares the elements to the argument for greater-than-or-equal.
+     */
+    public Mask cGe(double a) {
+        return applyKernelRealComparison(null, a, ArrayKernel.RC_GE);
+    }
+
+    /**
+     * Compares the elements elementwise for less-than.
+     */
+    public Mask cLt(R array) {
+        return applyKernelRealComparison(array, Double.NaN, ArrayKernel.RC_LT);
+    }
+
+    /**
+     * Compares the elements elementwise for less-than-or-equal.
+     */
+    public Mask cLe(R array) {
+        return applyKernelRealComparison(array, Double.NaN, ArrayKernel.RC_LE);
+    }
+
+    /**
+     * Compares the elements elementwise for equality.
+     */
+    public Mask cEq(R array) {
+        return applyKernelRealComparison(array, Double.NaN, ArrayKernel.RC_EQ);
+    }
+
+    /**
+     * Compares the elements elementwise for inequality.
+     */
+    public Mask cNe(R array) {
+        return applyKernelRealComparison(array, Double.NaN, ArrayKernel.RC_NE);
+    }
+
+    /**
+     * Compares the elements elementwise for greater-than.
+     */
+    public Mask cGt(R array) {
+        return applyKernelRealComparison(array, Double.NaN, ArrayKernel.RC_GT);
+    }
+
+    /**
+     * Compares the elements elementwise for greater-than-or-equal.
+     */
+    public Mask cGe(R array) {
+        return applyKernelRealComparison(array, Double.NaN, ArrayKernel.RC_GE);
+    }
+
+    /**
+     * Finds the elements that are NaN.
+     */
+    public Mask cNaN() {
+        return applyKernelRealComparison(null, Double.NaN, ArrayKernel.RC_NAN);
+    }
+
+    /**
+     * Selects elements from this array where the mask is set, and from the given array otherwise.
+     * 
+     * @param mask
+     *            the {@link Mask}.
+     * @param array
+     *            the array to select from where the mask is cleared.
+     * @return the selection.
+     */
+    public R select(Mask mask, R array) {
+
+        checkShape(array);
+        mask.checkShape(this.order, this.dims);
+
+        R res = wrap(INVALID_PARITY, this.order, this.dims, this.strides);
+
+        opKernel.select(mask.words, this.values, array.values, res.values);
+
+        return res;
+    }
+
     /**
      * Computes the elementwise addition.
      */
@@ -326,6 +524,28 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return applyKernelRealAccumulatorOperation(ArrayKernel.RA_MIN);
     }
 
+    /**
+     * Computes the L1 norm over the elements.
+     */
+    public double aNorm1() {
+        return applyKernelRealAccumulatorOperation(ArrayKernel.RA_NORM1);
+    }
+
+    /**
+     * Computes the Euclidean norm over the elements without overflow or underflow. For matrices, this is the
+     * Frobenius norm.
+     */
+    public double aNorm2() {
+        return applyKernelRealAccumulatorOperation(ArrayKernel.RA_NORM2);
+    }
+
+    /**
+     * Computes the L-infinity norm over the elements.
+     */
+    public double aNormInf() {
+        return applyKernelRealAccumulatorOperation(ArrayKernel.RA_NORMINF);
+    }
+
     /**
      * Computes the mean over the elements.
      */
@@ -382,6 +602,27 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return applyKernelRealReduceOperation(ArrayKernel.RR_VAR, opDims);
     }
 
+    /**
+     * Computes the L1 norm along the given dimensions.
+     */
+    public R rNorm1(int... opDims) {
+        return applyKernelRealReduceOperation(ArrayKernel.RR_NORM1, opDims);
+    }
+
+    /**
+     * Computes the Euclidean norm along the given dimensions without overflow or underflow.
+     */
+    public R rNorm2(int... opDims) {
+        return applyKernelRealReduceOperation(ArrayKernel.RR_NORM2, opDims);
+    }
+
+    /**
+     * Computes the L-infinity norm along the given dimensions.
+     */
+    public R rNormInf(int... opDims) {
+        return applyKernelRealReduceOperation(ArrayKernel.RR_NORMINF, opDims);
+    }
+
     /**
      * Finds the maximum values along the given dimension.
      */
@@ -480,6 +721,297 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return applyKernelRealDimensionOperation(ArrayKernel.RD_PROD, opDims);
     }
 
+    /**
+     * Takes the moving sum over trailing windows along the given dimension. Windows at the start of a line are
+     * truncated.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param size
+     *            the window size.
+     * @return the moving sums.
+     */
+    public R wSum(int dim, int size) {
+        return applyKernelRealWindowOperation(ArrayKernel.RW_SUM, dim, size);
+    }
+
+    /**
+     * Takes the moving mean over trailing windows along the given dimension.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param size
+     *            the window size.
+     * @return the moving means.
+     */
+    public R wMean(int dim, int size) {
+        return applyKernelRealWindowOperation(ArrayKernel.RW_MEAN, dim, size);
+    }
+
+    /**
+     * Takes the moving variance over trailing windows along the given dimension.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param size
+     *            the window size.
+     * @return the moving variances.
+     */
+    public R wVar(int dim, int size) {
+        return applyKernelRealWindowOperation(ArrayKernel.RW_VAR, dim, size);
+    }
+
+    /**
+     * Takes the moving maximum over trailing windows along the given dimension.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param size
+     *            the window size.
+     * @return the moving maxima.
+     */
+    public R wMax(int dim, int size) {
+        return applyKernelRealWindowOperation(ArrayKernel.RW_MAX, dim, size);
+    }
+
+    /**
+     * Takes the moving minimum over trailing windows along the given dimension.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param size
+     *            the window size.
+     * @return the moving minima.
+     */
+    public R wMin(int dim, int size) {
+        return applyKernelRealWindowOperation(ArrayKernel.RW_MIN, dim, size);
+    }
+
+    /**
+     * Computes sums by group, where every element has a label and negative labels belong to no group. Empty groups have
+     * sum {@code 0}.
+     * 
+     * @param labels
+     *            the labels, which have the same dimensions as this array.
+     * @param nGroups
+     *            the number of groups.
+     * @return the one-dimensional array of sums.
+     */
+    public R gSum(IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_SUM, -1, labels, nGroups);
+    }
+
+    /**
+     * Computes sums by group along the given dimension, where every slab has a label and negative labels belong to
+     * no group. Empty groups have sum {@code 0}.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param labels
+     *            the one-dimensional labels, one for each slab along the given dimension.
+     * @param nGroups
+     *            the number of groups.
+     * @return the sums, whose given dimension has size {@code nGroups}.
+     */
+    public R gSum(int dim, IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_SUM, dim, labels, nGroups);
+    }
+
+    /**
+     * Computes means by group, where every element has a label and negative labels belong to no group. Empty groups
+     * have mean {@link Double#NaN}.
+     * 
+     * @param labels
+     *            the labels, which have the same dimensions as this array.
+     * @param nGroups
+     *            the number of groups.
+     * @return the one-dimensional array of means.
+     */
+    public R gMean(IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_MEAN, -1, labels, nGroups);
+    }
+
+    /**
+     * Computes means by group along the given dimension, where every slab has a label and negative labels belong to
+     * no group. Empty groups have mean {@link Double#NaN}.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param labels
+     *            the one-dimensional labels, one for each slab along the given dimension.
+     * @param nGroups
+     *            the number of groups.
+     * @return the means, whose given dimension has size {@code nGroups}.
+     */
+    public R gMean(int dim, IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_MEAN, dim, labels, nGroups);
+    }
+
+    /**
+     * Computes variances by group, where every element has a label and negative labels belong to no group. Empty groups
+     * have variance {@link Double#NaN}.
+     * 
+     * @param labels
+     *            the labels, which have the same dimensions as this array.
+     * @param nGroups
+     *            the number of groups.
+     * @return the one-dimensional array of variances.
+     */
+    public R gVar(IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_VAR, -1, labels, nGroups);
+    }
+
+    /**
+     * Computes variances by group along the given dimension, where every slab has a label and negative labels belong to
+     * no group. Empty groups have variance {@link Double#NaN}.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param labels
+     *            the one-dimensional labels, one for each slab along the given dimension.
+     * @param nGroups
+     *            the number of groups.
+     * @return the variances, whose given dimension has size {@code nGroups}.
+     */
+    public R gVar(int dim, IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_VAR, dim, labels, nGroups);
+    }
+
+    /**
+     * Computes maxima by group, where every element has a label and negative labels belong to no group. Empty groups
+     * have maximum {@link Double#NaN}.
+     * 
+     * @param labels
+     *            the labels, which have the same dimensions as this array.
+     * @param nGroups
+     *            the number of groups.
+     * @return the one-dimensional array of maxima.
+     */
+    public R gMax(IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_MAX, -1, labels, nGroups);
+    }
+
+    /**
+     * Computes maxima by group along the given dimension, where every slab has a label and negative labels belong to
+     * no group. Empty groups have maximum {@link Double#NaN}.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param labels
+     *            the one-dimensional labels, one for each slab along the given dimension.
+     * @param nGroups
+     *            the number of groups.
+     * @return the maxima, whose given dimension has size {@code nGroups}.
+     */
+    public R gMax(int dim, IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_MAX, dim, labels, nGroups);
+    }
+
+    /**
+     * Computes minima by group, where every element has a label and negative labels belong to no group. Empty groups
+     * have minimum {@link Double#NaN}.
+     * 
+     * @param labels
+     *            the labels, which have the same dimensions as this array.
+     * @param nGroups
+     *            the number of groups.
+     * @return the one-dimensional array of minima.
+     */
+    public R gMin(IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_MIN, -1, labels, nGroups);
+    }
+
+    /**
+     * Computes minima by group along the given dimension, where every slab has a label and negative labels belong to
+     * no group. Empty groups have minimum {@link Double#NaN}.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param labels
+     *            the one-dimensional labels, one for each slab along the given dimension.
+     * @param nGroups
+     *            the number of groups.
+     * @return the minima, whose given dimension has size {@code nGroups}.
+     */
+    public R gMin(int dim, IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_MIN, dim, labels, nGroups);
+    }
+
+    /**
+     * Computes counts by group, where every element has a label and negative labels belong to no group. Empty groups
+     * have count {@code 0}.
+     * 
+     * @param labels
+     *            the labels, which have the same dimensions as this array.
+     * @param nGroups
+     *            the number of groups.
+     * @return the one-dimensional array of counts.
+     */
+    public R gCount(IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_COUNT, -1, labels, nGroups);
+    }
+
+    /**
+     * Computes counts by group along the given dimension, where every slab has a label and negative labels belong to
+     * no group. Empty groups have count {@code 0}.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param labels
+     *            the one-dimensional labels, one for each slab along the given dimension.
+     * @param nGroups
+     *            the number of groups.
+     * @return the counts, whose given dimension has size {@code nGroups}.
+     */
+    public R gCount(int dim, IntegerArray labels, int nGroups) {
+        return applyKernelRealGroupOperation(ArrayKernel.RG_COUNT, dim, labels, nGroups);
+    }
+
+    /**
+     * Finds the insertion indices of this array's elements into the given edges.
+     * 
+     * @param type
+     *            the search type, one of {@link ArrayKernel#SS_LEFT} and {@link ArrayKernel#SS_RIGHT}.
+     * @param edges
+     *            the one-dimensional edges, sorted in ascending order.
+     * @return the insertion indices.
+     */
+    public IntegerArray searchSorted(int type, R edges) {
+
+        Control.checkTrue(edges.dims.length == 1, //
+                "Edges must be one-dimensional");
+
+        IntegerArray res = new IntegerArray(this.order, this.dims);
+
+        opKernel.searchSorted(type, edges.values, this.values, res.values);
+
+        return res;
+    }
+
+    /**
+     * Interpolates a piecewise function through the given breakpoints at this array's elements.
+     * 
+     * @param type
+     *            the interpolation type, one of {@link ArrayKernel#IN_LINEAR} and
+     *            {@link ArrayKernel#IN_MONOTONE_CUBIC}.
+     * @param x
+     *            the one-dimensional breakpoint abscissas, in strictly ascending order.
+     * @param y
+     *            the one-dimensional breakpoint ordinates.
+     * @return the interpolated values.
+     */
+    public R interpolate(int type, R x, R y) {
+
+        Control.checkTrue(x.dims.length == 1 && y.dims.length == 1, //
+                "Breakpoints must be one-dimensional");
+
+        R res = wrap(INVALID_PARITY, this.order, this.dims, this.strides);
+
+        opKernel.interpolate(type, x.values, y.values, this.values, res.values);
+
+        return res;
+    }
+
     /**
      * Supports the a* series of operations.
      */
@@ -487,6 +1019,22 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return opKernel.raOp(type, this.values);
     }
 
+    /**
+     * Supports the c* series of operations.
+     */
+    protected Mask applyKernelRealComparison(R b, double a, int type) {
+
+        if (b != null) {
+            checkShape(b);
+        }
+
+        Mask res = new Mask(this.order, this.dims);
+
+        opKernel.rcOp(type, this.values, (b != null) ? b.values : null, a, res.words);
+
+        return res;
+    }
+
     /**
      * Supports the e* series of operations.
      */
@@ -550,6 +1098,18 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return (R) this;
     }
 
+    /**
+     * Supports the non-mutative unary operations, which read the elements and write the results in a single pass.
+     */
+    protected R applyKernelRealUnaryOperationTo(double a, int type) {
+
+        R res = wrap(this.order, this.dims, this.strides);
+
+        opKernel.ruOpTo(type, a, this.values, res.values);
+
+        return res;
+    }
+
     /**
      * Supports the r* series of operations.
      */
@@ -610,6 +1170,75 @@ abstract public class AbstractRealArray<R extends AbstractRealArray<R, C>, C ext
         return res;
     }
 
+    /**
+     * Supports the w* series of operations.
+     */
+    @SuppressWarnings("unchecked")
+    protected R applyKernelRealWindowOperation(int type, int dim, int size) {
+
+        R a = (R) this;
+
+        R res = wrap(INVALID_PARITY, a.order, a.dims, a.strides);
+
+        opKernel.rwOp(type, //
+                a.values, a.dims, a.strides, res.values, //
+                dim, size);
+
+        return res;
+    }
+
+    /**
+     * Supports the g* series of operations.
+     */
+    @SuppressWarnings("unchecked")
+    protected R applyKernelRealGroupOperation(int type, int dim, IntegerArray labels, int nGroups) {
+
+        R a = (R) this;
+
+        Control.checkTrue(nGroups >= 0, //
+                "Invalid number of groups");
+
+        final R res;
+
+        if (dim < 0) {
+
+            Control.checkTrue(Arrays.equals(a.dims, labels.dims), //
+                    "Dimension mismatch");
+
+            // Line up labels with values in storage order, and treat both as flat.
+            if (labels.order != a.order) {
+                labels = labels.reverseOrder();
+            }
+
+            res = wrap(INVALID_PARITY, a.order, new int[] { nGroups }, new int[] { 1 });
+
+            opKernel.rgOp(type, //
+                    a.values, new int[] { a.values.length }, new int[] { 1 }, labels.values, //
+                    res.values, res.dims, res.strides, //
+                    0);
+
+        } else {
+
+            Control.checkTrue(dim < a.dims.length, //
+                    "Invalid dimension");
+
+            Control.checkTrue(labels.dims.length == 1, //
+                    "Labels must be one-dimensional");
+
+            int[] newDims = a.dims.clone();
+            newDims[dim] = nGroups;
+
+            res = wrap(INVALID_PARITY, a.order, newDims, a.order.strides(newDims));
+
+            opKernel.rgOp(type, //
+                    a.values, a.dims, a.strides, labels.values, //
+                    res.values, res.dims, res.strides, //
+                    dim);
+        }
+
+        return res;
+    }
+
     /**
      * Mutatively maps the elements.
      * 
@@ -208,6 +208,18 @@ public interface Array<T extends Array<T, E>, E> extends Cloneable {
      */
     public T concat(int opDim, T... srcs);
 
+    /**
+     * Stacks this array with the given arrays, all of the same shape, along a new dimension inserted at the given
+     * position.
+     * 
+     * @param opDim
+     *            the position of the new dimension.
+     * @param srcs
+     *            the arrays to stack with.
+     * @return the stacking result.
+     */
+    public T stack(int opDim, T... srcs);
+
     /**
      * Creates an array where the storage order is reversed.
      */
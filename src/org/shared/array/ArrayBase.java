@@ -398,6 +398,33 @@ public class ArrayBase {
         return logical;
     }
 
+    /**
+     * Inserts a value at the given dimension, shifting later dimensions up by one.
+     * 
+     * @param values
+     *            the per-dimension values.
+     * @param dim
+     *            the dimension to insert at.
+     * @param value
+     *            the value to insert.
+     * @return the per-dimension values with one more dimension.
+     */
+    final public static int[] insertDimension(int[] values, int dim, int value) {
+
+        int nDims = values.length;
+
+        Control.checkTrue(dim >= 0 && dim <= nDims, //
+                "Invalid dimension");
+
+        int[] res = new int[nDims + 1];
+
+        System.arraycopy(values, 0, res, 0, dim);
+        System.arraycopy(values, dim, res, dim + 1, nDims - dim);
+        res[dim] = value;
+
+        return res;
+    }
+
     /**
      * Infers dimensions from the backing array length if the number of declared dimensions is {@code 0}.
      * 
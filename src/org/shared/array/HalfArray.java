@@ -0,0 +1,290 @@
+/**
+ * <p>
+ * Copyright (c) 2007 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.array;
+
+import static org.shared.array.ArrayBase.DEFAULT_ORDER;
+import static org.shared.array.ArrayBase.opKernel;
+
+import java.util.Arrays;
+
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.kernel.ArrayKernel;
+import org.shared.util.Control;
+
+/**
+ * A densely packed buffer of half-precision values, stored as 16-bit patterns in either {@link ArrayKernel#HF_FP16} or
+ * {@link ArrayKernel#HF_BF16} format. Storage takes a quarter of the space of a {@link RealArray}; values are expanded
+ * on load, computed on in single precision, and rounded to nearest even on store. Instances are meant for converting to
+ * and from {@link RealArray}s and for the elementwise operations, reductions and matrix products below. They are not
+ * part of the {@link Array} hierarchy: there are no strides, and so no mapping, slicing, reshaping or IO. Go through
+ * {@link #toReal()} for those.
+ * 
+ * @apiviz.uses org.shared.array.ArrayBase
+ * @author Roy Liu
+ */
+public class HalfArray {
+
+    /**
+     * The bit patterns.
+     */
+    final protected short[] values;
+
+    /**
+     * The half-precision format.
+     */
+    final protected int format;
+
+    /**
+     * The storage order.
+     */
+    final protected IndexingOrder order;
+
+    /**
+     * The dimensions.
+     */
+    final protected int[] dims;
+
+    /**
+     * Default constructor, which creates an array of zeros.
+     */
+    public HalfArray(int format, IndexingOrder order, int... dims) {
+
+        Control.checkTrue(format == ArrayKernel.HF_FP16 || format == ArrayKernel.HF_BF16, //
+                "Format not recognized");
+
+        Control.checkTrue(order != null, //
+                "Invalid indexing order");
+
+        this.format = format;
+        this.order = order;
+        this.dims = dims.clone();
+
+        int size = 1;
+
+        for (int dim : this.dims) {
+
+            Control.checkTrue(dim >= 0, //
+                    "Invalid dimensions");
+
+            size *= dim;
+        }
+
+        this.values = new short[size];
+    }
+
+    /**
+     * Alternate constructor, which rounds the given {@link RealArray}.
+     */
+    public HalfArray(int format, RealArray array) {
+        this(format, array.order(), array.dims());
+
+        opKernel.halfConvert(this.format, array.values(), this.values);
+    }
+
+    /**
+     * Gets the bit patterns.
+     */
+    public short[] values() {
+        return this.values;
+    }
+
+    /**
+     * Gets the half-precision format.
+     */
+    public int format() {
+        return this.format;
+    }
+
+    /**
+     * Gets the storage order.
+     */
+    public IndexingOrder order() {
+        return this.order;
+    }
+
+    /**
+     * Gets the dimensions.
+     */
+    public int[] dims() {
+        return this.dims.clone();
+    }
+
+    /**
+     * Expands this array into a {@link RealArray}.
+     */
+    public RealArray toReal() {
+
+        RealArray res = new RealArray(this.order, this.dims);
+
+        opKernel.halfExpand(this.format, this.values, res.values());
+
+        return res;
+    }
+
+    /**
+     * Adds elementwise.
+     */
+    public HalfArray eAdd(HalfArray b) {
+        return applyKernelHalfElementwiseOperation(b, ArrayKernel.RE_ADD);
+    }
+
+    /**
+     * Subtracts elementwise.
+     */
+    public HalfArray eSub(HalfArray b) {
+        return applyKernelHalfElementwiseOperation(b, ArrayKernel.RE_SUB);
+    }
+
+    /**
+     * Multiplies elementwise.
+     */
+    public HalfArray eMul(HalfArray b) {
+        return applyKernelHalfElementwiseOperation(b, ArrayKernel.RE_MUL);
+    }
+
+    /**
+     * Divides elementwise.
+     */
+    public HalfArray eDiv(HalfArray b) {
+        return applyKernelHalfElementwiseOperation(b, ArrayKernel.RE_DIV);
+    }
+
+    /**
+     * Takes the elementwise maximum.
+     */
+    public HalfArray eMax(HalfArray b) {
+        return applyKernelHalfElementwiseOperation(b, ArrayKernel.RE_MAX);
+    }
+
+    /**
+     * Takes the elementwise minimum.
+     */
+    public HalfArray eMin(HalfArray b) {
+        return applyKernelHalfElementwiseOperation(b, ArrayKernel.RE_MIN);
+    }
+
+    /**
+     * Computes the sum over all elements.
+     */
+    public double aSum() {
+        return opKernel.haOp(ArrayKernel.RA_SUM, this.format, this.values);
+    }
+
+    /**
+     * Computes the maximum over all elements.
+     */
+    public double aMax() {
+        return opKernel.haOp(ArrayKernel.RA_MAX, this.format, this.values);
+    }
+
+    /**
+     * Computes the minimum over all elements.
+     */
+    public double aMin() {
+        return opKernel.haOp(ArrayKernel.RA_MIN, this.format, this.values);
+    }
+
+    /**
+     * Computes the L1 norm over all elements.
+     */
+    public double aNorm1() {
+        return opKernel.haOp(ArrayKernel.RA_NORM1, this.format, this.values);
+    }
+
+    /**
+     * Computes the Euclidean norm over all elements.
+     */
+    public double aNorm2() {
+        return opKernel.haOp(ArrayKernel.RA_NORM2, this.format, this.values);
+    }
+
+    /**
+     * Computes the L-infinity norm over all elements.
+     */
+    public double aNormInf() {
+        return opKernel.haOp(ArrayKernel.RA_NORMINF, this.format, this.values);
+    }
+
+    /**
+     * Multiplies two matrices, accumulating in single precision. The result is left unrounded. Both operands must have
+     * storage order {@link ArrayBase#DEFAULT_ORDER}.
+     */
+    public RealArray mMul(HalfArray b) {
+
+        HalfArray a = this;
+
+        Control.checkTrue(a.format == b.format, //
+                "Formats do not match");
+
+        Control.checkTrue(a.order == DEFAULT_ORDER && b.order == DEFAULT_ORDER, //
+                "Array must have row major indexing");
+
+        Control.checkTrue(Control.checkEquals(a.dims.length, b.dims.length, //
+                "Dimensionality mismatch") == 2, //
+                "Arrays must have exactly two dimensions");
+
+        Control.checkTrue(a.dims[1] == b.dims[0], //
+                "Dimension mismatch");
+
+        RealArray res = new RealArray(DEFAULT_ORDER, a.dims[0], b.dims[1]);
+
+        // The kernel can't infer inner dimensions from empty operands, and there's nothing to compute anyway.
+        if (res.values().length > 0) {
+            opKernel.hMul(a.format, a.values, b.values, a.dims[0], b.dims[1], res.values());
+        }
+
+        return res;
+    }
+
+    @Override
+    public String toString() {
+        return String.format("%s(%s, %s)", getClass().getSimpleName(), Arrays.toString(this.dims), toReal());
+    }
+
+    /**
+     * Supports the elementwise binary operations.
+     */
+    protected HalfArray applyKernelHalfElementwiseOperation(HalfArray b, int type) {
+
+        Control.checkTrue(this.format == b.format, //
+                "Formats do not match");
+
+        Control.checkTrue(this.order == b.order, //
+                "Indexing orders do not match");
+
+        Control.checkTrue(Arrays.equals(this.dims, b.dims), //
+                "Dimensions do not match");
+
+        HalfArray res = new HalfArray(this.format, this.order, this.dims);
+
+        opKernel.heOp(type, this.format, this.values, b.values, res.values);
+
+        return res;
+    }
+}
@@ -332,6 +332,27 @@ public class IntegerArray extends ProtoArray<IntegerArray, int[], Integer> {
         return applyKernelLeftElementwiseOperation(array, ArrayKernel.IE_MIN);
     }
 
+    /**
+     * Selects elements from this array where the mask is set, and from the given array otherwise.
+     * 
+     * @param mask
+     *            the {@link Mask}.
+     * @param array
+     *            the array to select from where the mask is cleared.
+     * @return the selection.
+     */
+    public IntegerArray select(Mask mask, IntegerArray array) {
+
+        checkShape(array);
+        mask.checkShape(this.order, this.dims);
+
+        IntegerArray res = wrap(this.order, this.dims, this.strides);
+
+        opKernel.select(mask.words, this.values, array.values, res.values);
+
+        return res;
+    }
+
     /**
      * Supports the e* series of operations.
      */
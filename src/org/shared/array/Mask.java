@@ -0,0 +1,232 @@
+/**
+ * <p>
+ * Copyright (c) 2007 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.array;
+
+import static org.shared.array.ArrayBase.opKernel;
+
+import java.util.Arrays;
+
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.kernel.ArrayKernel;
+import org.shared.util.Control;
+
+/**
+ * A bit-packed mask over the elements of a multidimensional array, laid out in the array's storage order. Bit
+ * {@code i} resides at bit {@code i % 64} of word {@code i / 64}, and the bits past the end are always cleared.
+ * 
+ * @apiviz.uses org.shared.array.ArrayBase
+ * @author Roy Liu
+ */
+public class Mask {
+
+    /**
+     * The packed bits.
+     */
+    final protected long[] words;
+
+    /**
+     * The storage order.
+     */
+    final protected IndexingOrder order;
+
+    /**
+     * The dimensions.
+     */
+    final protected int[] dims;
+
+    /**
+     * The number of bits.
+     */
+    final protected int size;
+
+    /**
+     * Default constructor, which creates a mask with all bits cleared.
+     */
+    public Mask(IndexingOrder order, int... dims) {
+
+        this.order = order;
+        this.dims = dims.clone();
+
+        int size = 1;
+
+        for (int dim : this.dims) {
+
+            Control.checkTrue(dim >= 0, //
+                    "Invalid dimensions");
+
+            size *= dim;
+        }
+
+        this.size = size;
+        this.words = new long[(size >>> 6) + ((size & 63) != 0 ? 1 : 0)];
+    }
+
+    /**
+     * Gets the packed bits.
+     */
+    public long[] words() {
+        return this.words;
+    }
+
+    /**
+     * Gets the storage order.
+     */
+    public IndexingOrder order() {
+        return this.order;
+    }
+
+    /**
+     * Gets the dimensions.
+     */
+    public int[] dims() {
+        return this.dims.clone();
+    }
+
+    /**
+     * Gets the number of bits.
+     */
+    public int size() {
+        return this.size;
+    }
+
+    /**
+     * Counts the set bits.
+     */
+    public int count() {
+
+        int count = 0;
+
+        for (long word : this.words) {
+            count += Long.bitCount(word);
+        }
+
+        return count;
+    }
+
+    /**
+     * Gets the bit at the given logical index.
+     */
+    public boolean get(int... logical) {
+
+        int[] strides = this.order.strides(this.dims);
+
+        Control.checkTrue(logical.length == this.dims.length, //
+                "Invalid index");
+
+        int physical = 0;
+
+        for (int dim = 0, nDims = this.dims.length; dim < nDims; dim++) {
+
+            Control.checkTrue(logical[dim] >= 0 && logical[dim] < this.dims[dim], //
+                    "Invalid index");
+
+            physical += logical[dim] * strides[dim];
+        }
+
+        return ((this.words[physical >>> 6] >>> (physical & 63)) & 1L) != 0;
+    }
+
+    /**
+     * Computes the logical and.
+     */
+    public Mask and(Mask b) {
+        return applyKernelMaskLogicalOperation(b, ArrayKernel.ML_AND);
+    }
+
+    /**
+     * Computes the logical or.
+     */
+    public Mask or(Mask b) {
+        return applyKernelMaskLogicalOperation(b, ArrayKernel.ML_OR);
+    }
+
+    /**
+     * Computes the logical exclusive or.
+     */
+    public Mask xor(Mask b) {
+        return applyKernelMaskLogicalOperation(b, ArrayKernel.ML_XOR);
+    }
+
+    /**
+     * Computes the logical and with the negation of the argument.
+     */
+    public Mask andNot(Mask b) {
+        return applyKernelMaskLogicalOperation(b, ArrayKernel.ML_ANDNOT);
+    }
+
+    /**
+     * Computes the logical negation.
+     */
+    public Mask not() {
+
+        Mask res = new Mask(this.order, this.dims);
+
+        opKernel.mlOp(ArrayKernel.ML_NOT, this.words, null, res.words, this.size);
+
+        return res;
+    }
+
+    @Override
+    public String toString() {
+
+        StringBuilder sb = new StringBuilder();
+
+        for (int i = 0; i < this.size; i++) {
+            sb.append(((this.words[i >>> 6] >>> (i & 63)) & 1L) != 0 ? '1' : '0');
+        }
+
+        return String.format("%s(%s, %s)", getClass().getSimpleName(), Arrays.toString(this.dims), sb);
+    }
+
+    /**
+     * Supports the binary logical operations.
+     */
+    protected Mask applyKernelMaskLogicalOperation(Mask b, int type) {
+
+        b.checkShape(this.order, this.dims);
+
+        Mask res = new Mask(this.order, this.dims);
+
+        opKernel.mlOp(type, this.words, b.words, res.words, this.size);
+
+        return res;
+    }
+
+    /**
+     * Checks that this mask lines up with an array of the given storage order and dimensions.
+     */
+    protected void checkShape(IndexingOrder order, int[] dims) {
+
+        Control.checkTrue(this.order == order, //
+                "Indexing orders do not match");
+
+        Control.checkTrue(Arrays.equals(this.dims, dims), //
+                "Dimensions do not match");
+    }
+}
@@ -33,6 +33,7 @@ import static org.shared.array.ArrayBase.opKernel;
 
 import java.util.Arrays;
 
+import org.shared.array.kernel.ArrayKernel;
 import org.shared.util.Arithmetic;
 import org.shared.util.Control;
 
@@ -435,31 +436,330 @@ abstract public class ProtoArray<T extends ProtoArray<T, V, E>, V, E> implements
         int[] newDims = src.dims.clone();
         newDims[opDim] = offset;
 
-        int[] mappingBounds = new int[3 * nDims];
+        T dst = wrap(src.order, newDims, src.order.strides(newDims));
 
-        for (int dim = 0; dim < nDims; dim++) {
-            mappingBounds[3 * dim + 2] = src.dims[dim];
+        int nSrcs = srcs.length;
+
+        Object[] srcVs = new Object[nSrcs];
+        int[][] srcDs = new int[nSrcs][];
+        int[][] srcSs = new int[nSrcs][];
+
+        for (int i = 0; i < nSrcs; i++) {
+
+            ProtoArray<T, V, E> elt = srcs[i];
+
+            srcVs[i] = elt.values;
+            srcDs[i] = elt.dims;
+            srcSs[i] = elt.strides;
         }
 
+        opKernel.concat(opDim, //
+                srcVs, srcDs, srcSs, //
+                dst.values, dst.dims, dst.strides);
+
+        return dst;
+    }
+
+    @SuppressWarnings("unchecked")
+    @Override
+    public T stack(int opDim, T... srcs) {
+
+        ProtoArray<T, V, E> src = this;
+
+        int nDims = src.dims.length;
+
+        Control.checkTrue(opDim >= 0 && opDim <= nDims, //
+                "Invalid dimension");
+
+        srcs = Arrays.copyOf(srcs, srcs.length + 1);
+        System.arraycopy(srcs, 0, srcs, 1, srcs.length - 1);
+        srcs[0] = (T) this;
+
+        int nSrcs = srcs.length;
+
+        Object[] srcVs = new Object[nSrcs];
+        int[][] srcDs = new int[nSrcs][];
+        int[][] srcSs = new int[nSrcs][];
+
+        // Give every source a singleton dimension with zero stride, so that stacking reduces to concatenation.
+        for (int i = 0; i < nSrcs; i++) {
+
+            ProtoArray<T, V, E> elt = srcs[i];
+
+            Control.checkTrue(Arrays.equals(src.dims, elt.dims), //
+                    "Dimension mismatch");
+
+            srcVs[i] = elt.values;
+            srcDs[i] = ArrayBase.insertDimension(elt.dims, opDim, 1);
+            srcSs[i] = ArrayBase.insertDimension(elt.strides, opDim, 0);
+        }
+
+        int[] newDims = ArrayBase.insertDimension(src.dims, opDim, nSrcs);
+
         T dst = wrap(src.order, newDims, src.order.strides(newDims));
 
-        offset = 0;
+        opKernel.concat(opDim, //
+                srcVs, srcDs, srcSs, //
+                dst.values, dst.dims, dst.strides);
 
-        for (T elt : srcs) {
+        return dst;
+    }
 
-            int dimSize = elt.size(opDim);
+    /**
+     * Pads this array by synthesizing values beyond its edges.
+     * 
+     * @param mode
+     *            the padding mode, one of {@link ArrayKernel#PM_REPLICATE}, {@link ArrayKernel#PM_REFLECT},
+     *            {@link ArrayKernel#PM_SYMMETRIC}, and {@link ArrayKernel#PM_CIRCULAR}.
+     * @param widths
+     *            the padding widths before and after, as consecutive pairs for each dimension.
+     * @return the padded array.
+     */
+    public T pad(int mode, int... widths) {
 
-            mappingBounds[3 * opDim + 1] = offset;
-            mappingBounds[3 * opDim + 2] = dimSize;
+        Control.checkTrue(mode != ArrayKernel.PM_CONSTANT, //
+                "Constant padding requires a value");
 
-            elt.map(dst, mappingBounds);
+        ProtoArray<T, V, E> src = this;
 
-            offset += dimSize;
+        int[] newDims = padDimensions(src.dims, widths);
+
+        return pad(mode, widths, wrap(src.order, newDims, src.order.strides(newDims)));
+    }
+
+    /**
+     * Pads this array with a constant value.
+     * 
+     * @param value
+     *            the padding value.
+     * @param widths
+     *            the padding widths before and after, as consecutive pairs for each dimension.
+     * @return the padded array.
+     */
+    public T padConstant(E value, int... widths) {
+
+        ProtoArray<T, V, E> src = this;
+
+        int[] newDims = padDimensions(src.dims, widths);
+
+        return pad(ArrayKernel.PM_CONSTANT, widths, wrap(value, src.order, newDims, src.order.strides(newDims)));
+    }
+
+    /**
+     * Pads this array into the given destination.
+     */
+    protected T pad(int mode, int[] widths, T dst) {
+
+        ProtoArray<T, V, E> src = this;
+
+        int nDims = src.dims.length;
+        int[] offsets = new int[nDims];
+
+        for (int dim = 0; dim < nDims; dim++) {
+            offsets[dim] = widths[2 * dim];
         }
 
+        opKernel.pad(mode, offsets, //
+                src.values, src.dims, src.strides, //
+                dst.values, dst.dims, dst.strides);
+
         return dst;
     }
 
+    /**
+     * Computes the dimensions of a padded array.
+     */
+    protected static int[] padDimensions(int[] dims, int[] widths) {
+
+        int nDims = dims.length;
+
+        Control.checkTrue(widths.length == 2 * nDims, //
+                "Dimensionality mismatch");
+
+        int[] newDims = dims.clone();
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            Control.checkTrue(widths[2 * dim] >= 0 && widths[2 * dim + 1] >= 0, //
+                    "Invalid padding widths");
+
+            newDims[dim] += widths[2 * dim] + widths[2 * dim + 1];
+        }
+
+        return newDims;
+    }
+
+    /**
+     * Gathers slabs along the given dimension.
+     * 
+     * @param dim
+     *            the dimension of interest.
+     * @param indices
+     *            the indices of the slabs to gather, which may repeat.
+     * @return the gathered array.
+     */
+    public T gather(int dim, int... indices) {
+
+        ProtoArray<T, V, E> src = this;
+
+        Control.checkTrue(dim >= 0 && dim < src.dims.length, //
+                "Invalid dimension");
+
+        int[] newDims = src.dims.clone();
+        newDims[dim] = indices.length;
+
+        T dst = wrap(src.order, newDims, src.order.strides(newDims));
+
+        opKernel.gather(dim, indices, //
+                src.values, src.dims, src.strides, //
+                dst.values, dst.dims, dst.strides);
+
+        return dst;
+    }
+
+    /**
+     * Scatters slabs along the given dimension into the given destination, the inverse of
+     * {@link #gather(int, int...)}.
+     * 
+     * @param type
+     *            the operation type, one of {@link ArrayKernel#SC_ASSIGN}, {@link ArrayKernel#SC_ADD},
+     *            {@link ArrayKernel#SC_MAX}, and {@link ArrayKernel#SC_MIN}, which determines how slabs sent to the
+     *            same index combine.
+     * @param dst
+     *            the destination.
+     * @param dim
+     *            the dimension of interest.
+     * @param indices
+     *            the destination indices of this array's slabs.
+     * @return the destination.
+     */
+    public T scatter(int type, T dst, int dim, int... indices) {
+
+        ProtoArray<T, V, E> src = this;
+
+        Control.checkTrue(src != dst, //
+                "Source and destination cannot be the same");
+
+        opKernel.scatter(type, dim, indices, //
+                src.values, src.dims, src.strides, //
+                dst.values, dst.dims, dst.strides);
+
+        return dst;
+    }
+
+    /**
+     * Gathers elements by their linear indices into the underlying storage.
+     * 
+     * @param indices
+     *            the linear indices.
+     * @return the gathered elements as a one-dimensional array.
+     */
+    public T gatherLinear(int... indices) {
+
+        ProtoArray<T, V, E> src = this;
+
+        int[] srcDims = linearDimensions(src.dims);
+        int[] newDims = srcDims.clone();
+        newDims[0] = indices.length;
+
+        IndexingOrder order = IndexingOrder.FAR;
+        T dst = wrap(order, newDims, order.strides(newDims));
+
+        opKernel.gather(0, indices, //
+                src.values, srcDims, order.strides(srcDims), //
+                dst.values, dst.dims, dst.strides);
+
+        return dst;
+    }
+
+    /**
+     * Scatters the elements of this array, taken in storage order, by their linear indices into the given
+     * destination's underlying storage, the inverse of {@link #gatherLinear(int...)}.
+     * 
+     * @param type
+     *            the operation type, one of {@link ArrayKernel#SC_ASSIGN}, {@link ArrayKernel#SC_ADD},
+     *            {@link ArrayKernel#SC_MAX}, and {@link ArrayKernel#SC_MIN}.
+     * @param dst
+     *            the destination.
+     * @param indices
+     *            the linear indices.
+     * @return the destination.
+     */
+    public T scatterLinear(int type, T dst, int... indices) {
+
+        ProtoArray<T, V, E> src = this;
+
+        Control.checkTrue(src != dst, //
+                "Source and destination cannot be the same");
+
+        int[] srcDims = linearDimensions(src.dims);
+        int[] dstDims = linearDimensions(dst.dims);
+
+        IndexingOrder order = IndexingOrder.FAR;
+
+        opKernel.scatter(type, 0, indices, //
+                src.values, srcDims, order.strides(srcDims), //
+                dst.values, dstDims, order.strides(dstDims));
+
+        return dst;
+    }
+
+    /**
+     * Gets the dimensions of the underlying storage when viewed as a list of elements.
+     */
+    protected int[] linearDimensions(int[] dims) {
+        return new int[] { Arithmetic.product(dims) };
+    }
+
+    /**
+     * Computes the permutation that stably sorts the elements of a one-dimensional array, or the rows of a
+     * two-dimensional array lexicographically.
+     * 
+     * @return the permutation.
+     */
+    public int[] sortOrder() {
+
+        ProtoArray<T, V, E> src = this;
+
+        return opKernel.sortRows(src.values, src.dims, src.strides);
+    }
+
+    /**
+     * Finds the unique elements of a one-dimensional array, or the unique rows of a two-dimensional array.
+     * 
+     * @return the indices of the unique rows' first occurrences in sorted order, the index of every row's unique row,
+     *         and the number of occurrences of every unique row.
+     */
+    public IntegerArray[] uniqueIndices() {
+
+        ProtoArray<T, V, E> src = this;
+
+        int nRows = (src.dims.length > 0) ? src.dims[0] : 0;
+
+        int[] inverse = new int[nRows];
+        int[] counts = new int[nRows];
+
+        int[] firsts = opKernel.unique(src.values, src.dims, src.strides, inverse, counts);
+
+        int nUnique = firsts.length;
+
+        return new IntegerArray[] {
+                //
+                new IntegerArray(firsts, nUnique), //
+                new IntegerArray(inverse, nRows), //
+                new IntegerArray(Arrays.copyOf(counts, nUnique), nUnique) //
+        };
+    }
+
+    /**
+     * Finds the unique elements of a one-dimensional array, or the unique rows of a two-dimensional array.
+     * 
+     * @return the unique rows in sorted order.
+     */
+    public T unique() {
+        return gather(0, uniqueIndices()[0].values());
+    }
+
     @Override
     public T reverseOrder() {
 
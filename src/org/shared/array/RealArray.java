@@ -283,6 +283,60 @@ public class RealArray extends AbstractRealArray<RealArray, ComplexArray> implem
         return res;
     }
 
+    /**
+     * Estimates the spectral norm, or the largest singular value, by power iteration. Every iteration costs two
+     * matrix-vector products, which makes the estimate far cheaper than {@link #mSvd()} for large matrices. The
+     * estimate approaches the spectral norm from below.
+     * 
+     * @param nIterations
+     *            the number of iterations.
+     * @return the estimate.
+     */
+    public double mNormEstimate(int nIterations) {
+
+        RealArray a = this;
+
+        a.checkMatrixOrder();
+
+        Control.checkTrue(a.dims.length == 2, //
+                "Array must have exactly two dimensions");
+
+        int nCols = a.dims[1];
+
+        if (a.values.length == 0) {
+            return 0.0;
+        }
+
+        RealArray aT = a.mTranspose();
+
+        // Start from an uneven vector, which is unlikely to be orthogonal to the leading right singular vector.
+        RealArray x = new RealArray(nCols, 1);
+
+        for (int i = 0; i < nCols; i++) {
+            x.values[i] = 1.0 + (double) i / nCols;
+        }
+
+        x = x.uMul(1.0 / x.aNorm2());
+
+        double estimate = 0.0;
+
+        for (int i = 0; i < nIterations; i++) {
+
+            RealArray y = a.mMul(x);
+
+            estimate = y.aNorm2();
+
+            if (!(estimate > 0.0 && estimate < Double.POSITIVE_INFINITY)) {
+                break;
+            }
+
+            x = aT.mMul(y);
+            x = x.uMul(1.0 / x.aNorm2());
+        }
+
+        return estimate;
+    }
+
     @Override
     public byte[] getBytes() {
         return ioKernel.getBytes(this);
@@ -69,6 +69,26 @@ public class NativeArrayKernel implements ArrayKernel {
             Object srcV, int[] srcD, int[] srcS, //
             Object dstV, int[] dstD, int[] dstS);
 
+    @Override
+    final public native void concat(int opDim, //
+            Object[] srcVs, int[][] srcDs, int[][] srcSs, //
+            Object dstV, int[] dstD, int[] dstS);
+
+    @Override
+    final public native void pad(int mode, int[] offsets, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS);
+
+    @Override
+    final public native void gather(int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS);
+
+    @Override
+    final public native void scatter(int type, int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS);
+
     //
 
     @Override
@@ -87,6 +107,17 @@ public class NativeArrayKernel implements ArrayKernel {
             double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
             int... opDims);
 
+    @Override
+    final public native void rwOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
+            int dim, int size);
+
+    @Override
+    final public native void rgOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, int[] labels, //
+            double[] dstV, int[] dstD, int[] dstS, //
+            int dim);
+
     //
 
     @Override
@@ -104,6 +135,15 @@ public class NativeArrayKernel implements ArrayKernel {
     @Override
     final public native void iuOp(int type, int a, int[] srcV);
 
+    @Override
+    final public native void ruOpTo(int type, double a, double[] srcV, double[] dstV);
+
+    @Override
+    final public native void cuOpTo(int type, double aRe, double aIm, double[] srcV, double[] dstV);
+
+    @Override
+    final public native void iuOpTo(int type, int a, int[] srcV, int[] dstV);
+
     @Override
     final public native void eOp(int type, Object lhsV, Object rhsV, Object dstV, boolean complex);
 
@@ -112,6 +152,35 @@ public class NativeArrayKernel implements ArrayKernel {
             Object srcV, boolean isSrcComplex, //
             Object dstV, boolean isDstComplex);
 
+    @Override
+    final public native void rcOp(int type, double[] lhsV, double[] rhsV, double a, long[] dstV);
+
+    @Override
+    final public native void mlOp(int type, long[] lhsV, long[] rhsV, long[] dstV, int len);
+
+    @Override
+    final public native void select(long[] maskV, Object lhsV, Object rhsV, Object dstV);
+
+    @Override
+    final public native void maskedFill(long[] maskV, double a, double[] dstV);
+
+    //
+
+    @Override
+    final public native void halfConvert(int format, double[] srcV, short[] dstV);
+
+    @Override
+    final public native void halfExpand(int format, short[] srcV, double[] dstV);
+
+    @Override
+    final public native void heOp(int type, int format, short[] lhsV, short[] rhsV, short[] dstV);
+
+    @Override
+    final public native double haOp(int type, int format, short[] srcV);
+
+    @Override
+    final public native void hMul(int format, short[] lhsV, short[] rhsV, int lr, int rc, double[] dstV);
+
     //
 
     @Override
@@ -138,6 +207,32 @@ public class NativeArrayKernel implements ArrayKernel {
     @Override
     final public native int[] find(int[] srcV, int[] srcD, int[] srcS, int[] logical);
 
+    @Override
+    final public native int[] sortRows(Object srcV, int[] srcD, int[] srcS);
+
+    @Override
+    final public native int[] unique(Object srcV, int[] srcD, int[] srcS, int[] inverse, int[] counts);
+
+    @Override
+    final public native void searchSorted(int type, double[] edges, double[] srcV, int[] dstV);
+
+    @Override
+    final public native void interpolate(int type, double[] xV, double[] yV, double[] srcV, double[] dstV);
+
+    @Override
+    final public native double[] errorCurve(int type, double[] scoresV, boolean[] outcomesV, int nPoints,
+            double[] statsV);
+
+    @Override
+    final public native void histogram(int type, double[] srcV, double min, double max, double[] edgesV,
+            double[] dstV);
+
+    @Override
+    final public native int[] lttb(double[] xV, double[] yV, int nPoints);
+
+    @Override
+    final public native int[] thin(double[] xV, double[] yV, double[] boundsV, int nX, int nY);
+
     //
 
     @Override
@@ -56,6 +56,15 @@ public interface ArrayKernel extends Service {
     /** Real reduce variance. */
     final public static int RR_VAR = 4;
 
+    /** Real reduce L1 norm. */
+    final public static int RR_NORM1 = 5;
+
+    /** Real reduce Euclidean norm, computed without overflow or underflow. */
+    final public static int RR_NORM2 = 6;
+
+    /** Real reduce L-infinity norm. */
+    final public static int RR_NORMINF = 7;
+
     //
 
     /** Real index maximum. */
@@ -86,6 +95,109 @@ public interface ArrayKernel extends Service {
 
     //
 
+    /** Real window sum. */
+    final public static int RW_SUM = 0;
+
+    /** Real window mean. */
+    final public static int RW_MEAN = 1;
+
+    /** Real window variance. */
+    final public static int RW_VAR = 2;
+
+    /** Real window maximum. */
+    final public static int RW_MAX = 3;
+
+    /** Real window minimum. */
+    final public static int RW_MIN = 4;
+
+    //
+
+    /** Real group sum. */
+    final public static int RG_SUM = 0;
+
+    /** Real group mean. */
+    final public static int RG_MEAN = 1;
+
+    /** Real group variance. */
+    final public static int RG_VAR = 2;
+
+    /** Real group maximum. */
+    final public static int RG_MAX = 3;
+
+    /** Real group minimum. */
+    final public static int RG_MIN = 4;
+
+    /** Real group count. */
+    final public static int RG_COUNT = 5;
+
+    //
+
+    /** Padding that leaves the destination as is. */
+    final public static int PM_CONSTANT = 0;
+
+    /** Padding that replicates edge values. */
+    final public static int PM_REPLICATE = 1;
+
+    /** Padding that reflects about edge values without repeating them. */
+    final public static int PM_REFLECT = 2;
+
+    /** Padding that reflects about edges, repeating the edge values. */
+    final public static int PM_SYMMETRIC = 3;
+
+    /** Padding that wraps around. */
+    final public static int PM_CIRCULAR = 4;
+
+    //
+
+    /** Scatter by assignment. */
+    final public static int SC_ASSIGN = 0;
+
+    /** Scatter by addition. */
+    final public static int SC_ADD = 1;
+
+    /** Scatter by maximum. */
+    final public static int SC_MAX = 2;
+
+    /** Scatter by minimum. */
+    final public static int SC_MIN = 3;
+
+    //
+
+    /** Search sorted for the leftmost insertion index. */
+    final public static int SS_LEFT = 0;
+
+    /** Search sorted for the rightmost insertion index. */
+    final public static int SS_RIGHT = 1;
+
+    //
+
+    /** Piecewise linear interpolation. */
+    final public static int IN_LINEAR = 0;
+
+    /** Piecewise monotone cubic interpolation. */
+    final public static int IN_MONOTONE_CUBIC = 1;
+
+    //
+
+    /** A ROC curve of true positive rate against false positive rate. */
+    final public static int EC_ROC = 0;
+
+    /** A precision-recall curve of precision against recall. */
+    final public static int EC_PR = 1;
+
+    //
+
+    /** Fixed-width bins. */
+    final public static int HI_FIXED = 0;
+
+    /** Quantile bins, which hold about the same number of values each. */
+    final public static int HI_QUANTILE = 1;
+
+    /** Linear binning onto evenly spaced grid points. */
+    final public static int HI_LINEAR = 2;
+
+    //
+
     /** Real accumulator sum. */
     final public static int RA_SUM = 0;
 
@@ -104,6 +216,15 @@ public interface ArrayKernel extends Service {
     /** Real accumulator entropy. */
     final public static int RA_ENT = 5;
 
+    /** Real accumulator L1 norm. */
+    final public static int RA_NORM1 = 6;
+
+    /** Real accumulator Euclidean norm, computed without overflow or underflow. */
+    final public static int RA_NORM2 = 7;
+
+    /** Real accumulator L-infinity norm. */
+    final public static int RA_NORMINF = 8;
+
     //
 
     /** Complex accumulator sum. */
@@ -279,6 +400,54 @@ public interface ArrayKernel extends Service {
 
     //
 
+    /** Real comparison less-than. */
+    final public static int RC_LT = 0;
+
+    /** Real comparison less-than-or-equal. */
+    final public static int RC_LE = 1;
+
+    /** Real comparison equal. */
+    final public static int RC_EQ = 2;
+
+    /** Real comparison not-equal. */
+    final public static int RC_NE = 3;
+
+    /** Real comparison greater-than. */
+    final public static int RC_GT = 4;
+
+    /** Real comparison greater-than-or-equal. */
+    final public static int RC_GE = 5;
+
+    /** Real comparison is-NaN. */
+    final public static int RC_NAN = 6;
+
+    //
+
+    /** Mask logical and. */
+    final public static int ML_AND = 0;
+
+    /** Mask logical or. */
+    final public static int ML_OR = 1;
+
+    /** Mask logical exclusive or. */
+    final public static int ML_XOR = 2;
+
+    /** Mask logical and-not. */
+    final public static int ML_ANDNOT = 3;
+
+    /** Mask logical not. */
+    final public static int ML_NOT = 4;
+
+    //
+
+    /** Half-precision format IEEE 754 binary16, with 5 exponent bits and 10 mantissa bits. */
+    final public static int HF_FP16 = 0;
+
+    /** Half-precision format bfloat16, with 8 exponent bits and 7 mantissa bits. */
+    final public static int HF_BF16 = 1;
+
+    //
+
     /**
      * Seeds the underlying source of randomness with the current time.
      */
@@ -335,6 +504,107 @@ public interface ArrayKernel extends Service {
             Object srcV, int[] srcD, int[] srcS, //
             Object dstV, int[] dstD, int[] dstS);
 
+    /**
+     * Performs a concatenation operation. The sources agree with the destination on all dimensions except the one of
+     * interest, and their sizes along it sum to the destination's.
+     * 
+     * @param opDim
+     *            the dimension to concatenate along.
+     * @param srcVs
+     *            the source values.
+     * @param srcDs
+     *            the source dimensions.
+     * @param srcSs
+     *            the source strides.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     */
+    public void concat(int opDim, //
+            Object[] srcVs, int[][] srcDs, int[][] srcSs, //
+            Object dstV, int[] dstD, int[] dstS);
+
+    /**
+     * Performs a padding operation. The source occupies the destination window starting at the given offsets, and
+     * every destination element outside of it is synthesized from the source according to the padding mode; under
+     * {@link #PM_CONSTANT}, such elements are left as is.
+     * 
+     * @param mode
+     *            the padding mode.
+     * @param offsets
+     *            the offsets of the source within the destination.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     */
+    public void pad(int mode, int[] offsets, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS);
+
+    /**
+     * Performs a gather operation. The destination agrees with the source on all dimensions except the one of
+     * interest, along which it has as many entries as there are indices.
+     * 
+     * @param opDim
+     *            the dimension of interest.
+     * @param indices
+     *            the source indices along the dimension of interest.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     */
+    public void gather(int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS);
+
+    /**
+     * Performs a scatter operation, the inverse of a gather operation. Destination entries named by repeated indices
+     * are combined in index order according to the operation type.
+     * 
+     * @param type
+     *            the operation type.
+     * @param opDim
+     *            the dimension of interest.
+     * @param indices
+     *            the destination indices along the dimension of interest.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     */
+    public void scatter(int type, int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS);
+
     //
 
     /**
@@ -403,6 +673,58 @@ public interface ArrayKernel extends Service {
             double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
             int... opDims);
 
+    /**
+     * Performs a real window operation. Every destination value summarizes the trailing window of the given size that
+     * ends at its position along the dimension of interest; windows at the start of a line are truncated.
+     * 
+     * @param type
+     *            the operation type.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param dstV
+     *            the destination values.
+     * @param dim
+     *            the dimension of interest.
+     * @param size
+     *            the window size.
+     */
+    public void rwOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
+            int dim, int size);
+
+    /**
+     * Performs a real group operation. Slabs along the dimension of interest are reduced by their group labels, and
+     * slabs with negative labels belong to no group. The destination has as many entries along the dimension of
+     * interest as there are groups.
+     * 
+     * @param type
+     *            the operation type.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param labels
+     *            the group labels along the dimension of interest.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     * @param dim
+     *            the dimension of interest.
+     */
+    public void rgOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, int[] labels, //
+            double[] dstV, int[] dstD, int[] dstS, //
+            int dim);
+
     //
 
     /**
@@ -465,6 +787,50 @@ public interface ArrayKernel extends Service {
      */
     public void iuOp(int type, int a, int[] srcV);
 
+    /**
+     * Applies a real unary operation out of place, in a single pass over the source and destination.
+     * 
+     * @param type
+     *            the operation type.
+     * @param a
+     *            the argument, if any.
+     * @param srcV
+     *            the source values.
+     * @param dstV
+     *            the destination values.
+     */
+    public void ruOpTo(int type, double a, double[] srcV, double[] dstV);
+
+    /**
+     * Applies a complex unary operation out of place, in a single pass over the source and destination.
+     * 
+     * @param type
+     *            the operation type.
+     * @param aRe
+     *            the real part of the argument, if any.
+     * @param aIm
+     *            the imaginary part of the argument, if any.
+     * @param srcV
+     *            the source values.
+     * @param dstV
+     *            the destination values.
+     */
+    public void cuOpTo(int type, double aRe, double aIm, double[] srcV, double[] dstV);
+
+    /**
+     * Applies an integer unary operation out of place, in a single pass over the source and destination.
+     * 
+     * @param type
+     *            the operation type.
+     * @param a
+     *            the argument, if any.
+     * @param srcV
+     *            the source values.
+     * @param dstV
+     *            the destination values.
+     */
+    public void iuOpTo(int type, int a, int[] srcV, int[] dstV);
+
     /**
      * Applies a binary operation.
      * 
@@ -499,6 +865,141 @@ public interface ArrayKernel extends Service {
             Object srcV, boolean isSrcComplex, //
             Object dstV, boolean isDstComplex);
 
+    /**
+     * Compares real values and packs the outcomes into a bit mask, where bit {@code i} of the mask resides at bit
+     * {@code i % 64} of word {@code i / 64}.
+     * 
+     * @param type
+     *            the comparison type.
+     * @param lhsV
+     *            the left hand side values.
+     * @param rhsV
+     *            the right hand side values, or {@code null} to compare against the scalar.
+     * @param a
+     *            the scalar right hand side.
+     * @param dstV
+     *            the destination mask.
+     */
+    public void rcOp(int type, double[] lhsV, double[] rhsV, double a, long[] dstV);
+
+    /**
+     * Applies a logical operation to bit masks.
+     * 
+     * @param type
+     *            the operation type.
+     * @param lhsV
+     *            the left hand side mask.
+     * @param rhsV
+     *            the right hand side mask, which is ignored for negation.
+     * @param dstV
+     *            the destination mask.
+     * @param len
+     *            the number of bits.
+     */
+    public void mlOp(int type, long[] lhsV, long[] rhsV, long[] dstV, int len);
+
+    /**
+     * Selects from the left hand side where the mask is set, and from the right hand side otherwise.
+     * 
+     * @param maskV
+     *            the mask.
+     * @param lhsV
+     *            the left hand side values.
+     * @param rhsV
+     *            the right hand side values.
+     * @param dstV
+     *            the destination values.
+     */
+    public void select(long[] maskV, Object lhsV, Object rhsV, Object dstV);
+
+    /**
+     * Fills real values where the mask is set.
+     * 
+     * @param maskV
+     *            the mask.
+     * @param a
+     *            the fill value.
+     * @param dstV
+     *            the destination values.
+     */
+    public void maskedFill(long[] maskV, double a, double[] dstV);
+
+    //
+
+    /**
+     * Rounds real values to half-precision bit patterns, with ties going to even. Overflows become infinities.
+     * 
+     * @param format
+     *            the half-precision format.
+     * @param srcV
+     *            the source values.
+     * @param dstV
+     *            the destination bit patterns.
+     */
+    public void halfConvert(int format, double[] srcV, short[] dstV);
+
+    /**
+     * Expands half-precision bit patterns into real values. The expansion is exact.
+     * 
+     * @param format
+     *            the half-precision format.
+     * @param srcV
+     *            the source bit patterns.
+     * @param dstV
+     *            the destination values.
+     */
+    public void halfExpand(int format, short[] srcV, double[] dstV);
+
+    /**
+     * Applies a binary operation to half-precision values. Operands are expanded to single precision on load, and
+     * results are rounded back to half precision on store.
+     * 
+     * @param type
+     *            the operation type, which is one of the real elementwise types.
+     * @param format
+     *            the half-precision format.
+     * @param lhsV
+     *            the left hand side bit patterns.
+     * @param rhsV
+     *            the right hand side bit patterns.
+     * @param dstV
+     *            the destination bit patterns.
+     */
+    public void heOp(int type, int format, short[] lhsV, short[] rhsV, short[] dstV);
+
+    /**
+     * Applies an accumulator operation to half-precision values. Accumulation happens in double precision.
+     * 
+     * @param type
+     *            the operation type, which is one of sum, maximum, minimum, or the L1, Euclidean and L-infinity
+     *            norms.
+     * @param format
+     *            the half-precision format.
+     * @param srcV
+     *            the source bit patterns.
+     * @return the accumulated result.
+     */
+    public double haOp(int type, int format, short[] srcV);
+
+    /**
+     * Multiplies two half-precision {@link Matrix}s, accumulating in single precision. They are assumed to have
+     * storage order {@link IndexingOrder#FAR}.
+     * 
+     * @param format
+     *            the half-precision format.
+     * @param lhsV
+     *            the left hand side bit patterns.
+     * @param rhsV
+     *            the right hand side bit patterns.
+     * @param lr
+     *            the row count of the result.
+     * @param rc
+     *            the column count of the result.
+     * @param dstV
+     *            the destination values.
+     */
+    public void hMul(int format, short[] lhsV, short[] rhsV, int lr, int rc, double[] dstV);
+
     //
 
     /**
@@ -602,6 +1103,144 @@ public interface ArrayKernel extends Service {
      */
     public int[] find(int[] srcV, int[] srcD, int[] srcS, int[] logical);
 
+    /**
+     * Computes the permutation that stably sorts the rows of a one- or two-dimensional array lexicographically. The
+     * elements of a one-dimensional array are rows of their own, and real values order as in
+     * {@link Double#compare(double, double)}.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @return the permutation.
+     */
+    public int[] sortRows(Object srcV, int[] srcD, int[] srcS);
+
+    /**
+     * Finds the unique rows of a one- or two-dimensional array.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param inverse
+     *            the index of every row's unique row.
+     * @param counts
+     *            the number of occurrences of every unique row, in the leading entries.
+     * @return the index of every unique row's first occurrence, in sorted order.
+     */
+    public int[] unique(Object srcV, int[] srcD, int[] srcS, int[] inverse, int[] counts);
+
+    /**
+     * Finds the insertion indices of queries into sorted edges. NaN queries go after all edges.
+     * 
+     * @param type
+     *            the search type, one of {@link #SS_LEFT} and {@link #SS_RIGHT}, which determines whether queries
+     *            equal to edges go before or after them.
+     * @param edges
+     *            the edges, sorted in ascending order.
+     * @param srcV
+     *            the queries.
+     * @param dstV
+     *            the insertion indices.
+     */
+    public void searchSorted(int type, double[] edges, double[] srcV, int[] dstV);
+
+    /**
+     * Interpolates a piecewise function through the given breakpoints. Queries outside of the breakpoints take on the
+     * nearest endpoint value.
+     * 
+     * @param type
+     *            the interpolation type, one of {@link #IN_LINEAR} and {@link #IN_MONOTONE_CUBIC}.
+     * @param xV
+     *            the breakpoint abscissas, in strictly ascending order.
+     * @param yV
+     *            the breakpoint ordinates.
+     * @param srcV
+     *            the queries.
+     * @param dstV
+     *            the interpolated values.
+     */
+    public void interpolate(int type, double[] xV, double[] yV, double[] srcV, double[] dstV);
+
+    /**
+     * Computes a ROC or precision-recall curve by sweeping a threshold down through the scores. Tied scores enter
+     * together and contribute one point, and NaN scores rank below all others. ROC curves start at {@code (0, 0)}, and
+     * precision-recall curves start at {@code (0, 1)}.
+     * 
+     * @param type
+     *            the curve type, one of {@link #EC_ROC} and {@link #EC_PR}.
+     * @param scoresV
+     *            the scores.
+     * @param outcomesV
+     *            the outcomes, where {@code true} denotes a positive example.
+     * @param nPoints
+     *            the number of evenly spaced points to downsample to, or {@code 0} to keep all of them.
+     * @param statsV
+     *            the area under the ROC curve followed by the average precision, which are NaN in the absence of
+     *            positive or negative examples.
+     * @return the curve points, as consecutive {@code (x, y)} pairs.
+     */
+    public double[] errorCurve(int type, double[] scoresV, boolean[] outcomesV, int nPoints, double[] statsV);
+
+    /**
+     * Bins values. NaNs are skipped, and values outside of the range go to the nearest bin. Linear binning splits
+     * every value's unit weight between the two nearest of evenly spaced grid points spanning the range, as a
+     * precursor to kernel density estimation.
+     * 
+     * @param type
+     *            the binning type, one of {@link #HI_FIXED}, {@link #HI_QUANTILE} and {@link #HI_LINEAR}.
+     * @param srcV
+     *            the values.
+     * @param min
+     *            the range minimum, which quantile bins ignore.
+     * @param max
+     *            the range maximum, which quantile bins ignore.
+     * @param edgesV
+     *            the bin edges, one more than the number of bins, or the grid points for linear binning.
+     * @param dstV
+     *            the bin counts.
+     */
+    public void histogram(int type, double[] srcV, double min, double max, double[] edgesV, double[] dstV);
+
+    /**
+     * Downsamples a series with the Largest-Triangle-Three-Buckets algorithm. The first and last points are kept, and
+     * the rest are divided into evenly sized buckets, from each of which the point forming the largest triangle with
+     * the previously kept point and the average of the next bucket is kept.
+     * 
+     * @param xV
+     *            the <code>x</code>-coordinates, which are ideally in ascending order.
+     * @param yV
+     *            the <code>y</code>-coordinates.
+     * @param nPoints
+     *            the number of points to keep, which is at least {@code 3}.
+     * @return the indices of the kept points, in ascending order. All points are kept if there are no more than the
+     *         requested number of them.
+     */
+    public int[] lttb(double[] xV, double[] yV, int nPoints);
+
+    /**
+     * Thins a point cloud by keeping the first point to fall into each cell of an evenly spaced grid. Points outside
+     * of the bounds and points with NaN coordinates are dropped.
+     * 
+     * @param xV
+     *            the <code>x</code>-coordinates.
+     * @param yV
+     *            the <code>y</code>-coordinates.
+     * @param boundsV
+     *            the bounds, as the <code>x</code>-range followed by the <code>y</code>-range.
+     * @param nX
+     *            the number of grid cells along the <code>x</code>-axis.
+     * @param nY
+     *            the number of grid cells along the <code>y</code>-axis.
+     * @return the indices of the kept points, in ascending order.
+     */
+    public int[] thin(double[] xV, double[] yV, double[] boundsV, int nX, int nY);
+
     //
 
     /**
@@ -30,6 +30,12 @@ package org.shared.array.kernel;
 
 import static org.shared.array.kernel.ArrayKernel.RD_PROD;
 import static org.shared.array.kernel.ArrayKernel.RD_SUM;
+import static org.shared.array.kernel.ArrayKernel.RG_COUNT;
+import static org.shared.array.kernel.ArrayKernel.RG_MAX;
+import static org.shared.array.kernel.ArrayKernel.RG_MEAN;
+import static org.shared.array.kernel.ArrayKernel.RG_MIN;
+import static org.shared.array.kernel.ArrayKernel.RG_SUM;
+import static org.shared.array.kernel.ArrayKernel.RG_VAR;
 import static org.shared.array.kernel.ArrayKernel.RI_GZERO;
 import static org.shared.array.kernel.ArrayKernel.RI_LZERO;
 import static org.shared.array.kernel.ArrayKernel.RI_MAX;
@@ -38,9 +44,17 @@ import static org.shared.array.kernel.ArrayKernel.RI_SORT;
 import static org.shared.array.kernel.ArrayKernel.RI_ZERO;
 import static org.shared.array.kernel.ArrayKernel.RR_MAX;
 import static org.shared.array.kernel.ArrayKernel.RR_MIN;
+import static org.shared.array.kernel.ArrayKernel.RR_NORM1;
+import static org.shared.array.kernel.ArrayKernel.RR_NORM2;
+import static org.shared.array.kernel.ArrayKernel.RR_NORMINF;
 import static org.shared.array.kernel.ArrayKernel.RR_PROD;
 import static org.shared.array.kernel.ArrayKernel.RR_SUM;
 import static org.shared.array.kernel.ArrayKernel.RR_VAR;
+import static org.shared.array.kernel.ArrayKernel.RW_MAX;
+import static org.shared.array.kernel.ArrayKernel.RW_MEAN;
+import static org.shared.array.kernel.ArrayKernel.RW_MIN;
+import static org.shared.array.kernel.ArrayKernel.RW_SUM;
+import static org.shared.array.kernel.ArrayKernel.RW_VAR;
 
 import java.util.Arrays;
 
@@ -50,16 +64,31 @@ import org.shared.util.Control;
 /**
  * A class for dimension operations in pure Java.
  * 
+ * @apiviz.has org.shared.array.kernel.DimensionOps.RealAccumulateOperation - - - argument
  * @apiviz.has org.shared.array.kernel.DimensionOps.RealDimensionOperation - - - argument
  * @apiviz.has org.shared.array.kernel.DimensionOps.RealIndexOperation - - - argument
  * @apiviz.has org.shared.array.kernel.DimensionOps.RealReduceOperation - - - argument
+ * @apiviz.has org.shared.array.kernel.DimensionOps.RealWindowOperation - - - argument
  * @apiviz.uses org.shared.array.kernel.PermutationEntry
  * @author Roy Liu
  */
 public class DimensionOps {
 
     /**
-     * Defines real reduce operations.
+     * Defines real reduce operations that make one pass over the source.
+     */
+    protected interface RealAccumulateOperation {
+
+        /**
+         * Accumulates a line of source values into a line of destination values. A destination stride of zero folds
+         * the whole line into a single value.
+         */
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size);
+    }
+
+    /**
+     * Defines real reduce operations that reduce one dimension at a time.
      */
     protected interface RealReduceOperation {
 
@@ -69,62 +98,162 @@ public class DimensionOps {
         public void op(double[] working, int[] workingIndices, int size, int stride);
     }
 
-    final static RealReduceOperation rrSumOp = new RealReduceOperation() {
+    final static RealAccumulateOperation rrSumOp = new RealAccumulateOperation() {
 
         @Override
-        public void op(double[] working, int[] workingIndices, int size, int stride) {
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
 
-            for (int workingIndex : workingIndices) {
+            if (dstStride == 0) {
 
-                for (int j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-                    working[workingIndex] += working[offset];
+                double acc = dstV[dstOffset];
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride) {
+                    acc += srcV[srcOffset];
+                }
+
+                dstV[dstOffset] = acc;
+
+            } else {
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+                    dstV[dstOffset] += srcV[srcOffset];
                 }
             }
         }
     };
 
-    final static RealReduceOperation rrProdOp = new RealReduceOperation() {
+    final static RealAccumulateOperation rrProdOp = new RealAccumulateOperation() {
 
         @Override
-        public void op(double[] working, int[] workingIndices, int size, int stride) {
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
 
-            for (int workingIndex : workingIndices) {
+            if (dstStride == 0) {
 
-                for (int j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-                    working[workingIndex] *= working[offset];
+                double acc = dstV[dstOffset];
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride) {
+                    acc *= srcV[srcOffset];
+                }
+
+                dstV[dstOffset] = acc;
+
+            } else {
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+                    dstV[dstOffset] *= srcV[srcOffset];
                 }
             }
         }
     };
 
-    final static RealReduceOperation rrMaxOp = new RealReduceOperation() {
+    final static RealAccumulateOperation rrMaxOp = new RealAccumulateOperation() {
 
         @Override
-        public void op(double[] working, int[] workingIndices, int size, int stride) {
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
 
-            for (int workingIndex : workingIndices) {
+            if (dstStride == 0) {
 
-                for (int j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-                    working[workingIndex] = Math.max(working[offset], working[workingIndex]);
+                double acc = dstV[dstOffset];
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride) {
+                    acc = Math.max(srcV[srcOffset], acc);
+                }
+
+                dstV[dstOffset] = acc;
+
+            } else {
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+                    dstV[dstOffset] = Math.max(srcV[srcOffset], dstV[dstOffset]);
                 }
             }
         }
     };
 
-    final static RealReduceOperation rrMinOp = new RealReduceOperation() {
+    final static RealAccumulateOperation rrMinOp = new RealAccumulateOperation() {
 
         @Override
-        public void op(double[] working, int[] workingIndices, int size, int stride) {
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
 
-            for (int workingIndex : workingIndices) {
+            if (dstStride == 0) {
 
-                for (int j = 1, offset = workingIndex + stride; j < size; j++, offset += stride) {
-                    working[workingIndex] = Math.min(working[offset], working[workingIndex]);
+                double acc = dstV[dstOffset];
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride) {
+                    acc = Math.min(srcV[srcOffset], acc);
+                }
+
+                dstV[dstOffset] = acc;
+
+            } else {
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+                    dstV[dstOffset] = Math.min(srcV[srcOffset], dstV[dstOffset]);
                 }
             }
         }
     };
 
+    final static RealAccumulateOperation rrNorm1Op = new RealAccumulateOperation() {
+
+        @Override
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
+
+            if (dstStride == 0) {
+
+                double acc = dstV[dstOffset];
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride) {
+                    acc += Math.abs(srcV[srcOffset]);
+                }
+
+                dstV[dstOffset] = acc;
+
+            } else {
+
+                for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+                    dstV[dstOffset] += Math.abs(srcV[srcOffset]);
+                }
+            }
+        }
+    };
+
+    /**
+     * Accumulates into triples of sums of squares for {@link Arithmetic#norm2Combine(double[], int)}, so that the
+     * destination offsets and strides count triples.
+     */
+    final static RealAccumulateOperation rrNorm2Op = new RealAccumulateOperation() {
+
+        @Override
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
+
+            for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+                Arithmetic.norm2Accumulate(srcV[srcOffset], dstV, 3 * dstOffset);
+            }
+        }
+    };
+
+    final static RealAccumulateOperation rrNormInfOp = new RealAccumulateOperation() {
+
+        @Override
+        public void op(double[] srcV, int srcOffset, int srcStride, //
+                double[] dstV, int dstOffset, int dstStride, int size) {
+
+            // NaNs propagate.
+            for (int i = 0; i < size; i++, srcOffset += srcStride, dstOffset += dstStride) {
+
+                double a = Math.abs(srcV[srcOffset]);
+                dstV[dstOffset] = (a > dstV[dstOffset] || Double.isNaN(a)) ? a : dstV[dstOffset];
+            }
+        }
+    };
+
     final static RealReduceOperation rrVarOp = new RealReduceOperation() {
 
         @Override
@@ -484,6 +613,209 @@ public class DimensionOps {
         }
     };
 
+    /**
+     * Defines real window operations.
+     */
+    protected interface RealWindowOperation {
+
+        /**
+         * Performs a real window operation.
+         */
+        public void op(double[] srcV, int[] srcIndices, double[] dstV, int size, int stride, int window);
+    }
+
+    final static RealWindowOperation rwSumOp = new RealWindowOperation() {
+
+        @Override
+        public void op(double[] srcV, int[] srcIndices, double[] dstV, int size, int stride, int window) {
+            rwSum(srcV, srcIndices, dstV, size, stride, window, false);
+        }
+    };
+
+    final static RealWindowOperation rwMeanOp = new RealWindowOperation() {
+
+        @Override
+        public void op(double[] srcV, int[] srcIndices, double[] dstV, int size, int stride, int window) {
+            rwSum(srcV, srcIndices, dstV, size, stride, window, true);
+        }
+    };
+
+    final static RealWindowOperation rwVarOp = new RealWindowOperation() {
+
+        @Override
+        public void op(double[] srcV, int[] srcIndices, double[] dstV, int size, int stride, int window) {
+
+            for (int srcIndex : srcIndices) {
+
+                double mean = 0.0;
+                double m2 = 0.0;
+
+                // Welford's updates, run forward on entry and in reverse on exit. Non-finite values only make the
+                // windows holding them NaN, and are otherwise kept out of the running state.
+                for (int k = 0, count = 0, nNonFinite = 0, offset = srcIndex; k < size; k++, offset += stride) {
+
+                    double value = srcV[offset];
+
+                    if (value - value != 0.0) {
+
+                        nNonFinite++;
+
+                    } else {
+
+                        double delta = value - mean;
+
+                        count++;
+                        mean += delta / count;
+                        m2 += delta * (value - mean);
+                    }
+
+                    if (k >= window) {
+
+                        double leaving = srcV[offset - window * stride];
+
+                        if (leaving - leaving != 0.0) {
+
+                            nNonFinite--;
+
+                        } else if (count > 1) {
+
+                            double delta = leaving - mean;
+
+                            count--;
+                            mean -= delta / count;
+                            m2 -= delta * (leaving - mean);
+
+                        } else {
+
+                            // Restart from empty instead of dividing by zero.
+                            count = 0;
+                            mean = 0.0;
+                            m2 = 0.0;
+                        }
+                    }
+
+                    dstV[offset] = (nNonFinite > 0) ? Double.NaN : Math.max(m2, 0.0) / count;
+                }
+            }
+        }
+    };
+
+    final static RealWindowOperation rwMaxOp = new RealWindowOperation() {
+
+        @Override
+        public void op(double[] srcV, int[] srcIndices, double[] dstV, int size, int stride, int window) {
+            rwExtremum(srcV, srcIndices, dstV, size, stride, window, true);
+        }
+    };
+
+    final static RealWindowOperation rwMinOp = new RealWindowOperation() {
+
+        @Override
+        public void op(double[] srcV, int[] srcIndices, double[] dstV, int size, int stride, int window) {
+            rwExtremum(srcV, srcIndices, dstV, size, stride, window, false);
+        }
+    };
+
+    /**
+     * Computes moving sums with Neumaier compensation, so that values leaving the window don't leave rounding error
+     * behind.
+     */
+    final static void rwSum(double[] srcV, int[] srcIndices, double[] dstV, //
+            int size, int stride, int window, boolean mean) {
+
+        for (int srcIndex : srcIndices) {
+
+            double sum = 0.0;
+            double compensation = 0.0;
+
+            // Non-finite values are counted instead of summed, so that they only affect the windows holding them.
+            int nNaNs = 0;
+            int nPosInfs = 0;
+            int nNegInfs = 0;
+
+            for (int k = 0, offset = srcIndex; k < size; k++, offset += stride) {
+
+                for (int i = 0, n = (k >= window) ? 2 : 1; i < n; i++) {
+
+                    double value = (i == 0) ? srcV[offset] : srcV[offset - window * stride];
+                    int increment = (i == 0) ? 1 : -1;
+
+                    if (value - value != 0.0) {
+
+                        if (Double.isNaN(value)) {
+                            nNaNs += increment;
+                        } else if (value > 0.0) {
+                            nPosInfs += increment;
+                        } else {
+                            nNegInfs += increment;
+                        }
+
+                        continue;
+                    }
+
+                    value *= increment;
+
+                    double t = sum + value;
+
+                    compensation += (Math.abs(sum) >= Math.abs(value)) ? (sum - t) + value : (value - t) + sum;
+                    sum = t;
+                }
+
+                double result = sum + compensation;
+
+                if (nNaNs > 0 || (nPosInfs > 0 && nNegInfs > 0)) {
+                    result = Double.NaN;
+                } else if (nPosInfs > 0) {
+                    result = Double.POSITIVE_INFINITY;
+                } else if (nNegInfs > 0) {
+                    result = Double.NEGATIVE_INFINITY;
+                }
+
+                dstV[offset] = mean ? result / Math.min(k + 1, window) : result;
+            }
+        }
+    }
+
+    /**
+     * Computes moving extrema with a monotonic deque of positions, so that each value is pushed and popped at most
+     * once.
+     */
+    final static void rwExtremum(double[] srcV, int[] srcIndices, double[] dstV, //
+            int size, int stride, int window, boolean max) {
+
+        int[] deque = new int[size];
+
+        for (int srcIndex : srcIndices) {
+
+            int head = 0;
+            int tail = 0;
+
+            for (int k = 0, offset = srcIndex; k < size; k++, offset += stride) {
+
+                double value = srcV[offset];
+
+                while (tail > head) {
+
+                    double last = srcV[srcIndex + deque[tail - 1] * stride];
+
+                    if (max ? (last > value) : (last < value)) {
+                        break;
+                    }
+
+                    tail--;
+                }
+
+                deque[tail++] = k;
+
+                if (deque[head] <= k - window) {
+                    head++;
+                }
+
+                dstV[offset] = srcV[srcIndex + deque[head] * stride];
+            }
+        }
+    }
+
     /**
      * Assigns base indices when excluding a dimension.
      * 
@@ -526,30 +858,50 @@ public class DimensionOps {
         int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
         int dstLen = MappingOps.checkDimensions(dstV.length, dstD, dstS);
 
-        final RealReduceOperation op;
+        RealAccumulateOperation accumulateOp = null;
+        RealReduceOperation op = null;
+        double identity = 0.0;
 
         switch (type) {
 
         case RR_SUM:
-            op = rrSumOp;
+            accumulateOp = rrSumOp;
+            identity = 0.0;
             break;
 
         case RR_PROD:
-            op = rrProdOp;
+            accumulateOp = rrProdOp;
+            identity = 1.0;
             break;
 
         case RR_MAX:
-            op = rrMaxOp;
+            accumulateOp = rrMaxOp;
+            identity = Double.NEGATIVE_INFINITY;
             break;
 
         case RR_MIN:
-            op = rrMinOp;
+            accumulateOp = rrMinOp;
+            identity = Double.POSITIVE_INFINITY;
             break;
 
         case RR_VAR:
             op = rrVarOp;
             break;
 
+        case RR_NORM1:
+            accumulateOp = rrNorm1Op;
+            identity = 0.0;
+            break;
+
+        case RR_NORM2:
+            accumulateOp = rrNorm2Op;
+            break;
+
+        case RR_NORMINF:
+            accumulateOp = rrNormInfOp;
+            identity = 0.0;
+            break;
+
         default:
             throw new IllegalArgumentException();
         }
@@ -587,26 +939,88 @@ public class DimensionOps {
             return;
         }
 
-        double[] workingV = srcV.clone();
-        int[] workingD = srcD.clone();
+        if (accumulateOp != null) {
 
-        acc = srcLen;
+            int[] maskedDstS = dstS.clone();
 
-        for (int i = 0; i < nOpDims; i++) {
+            // Reduced dimensions get a destination stride of zero, which keeps them from coalescing with kept ones.
+            for (int dim : opDims) {
+                maskedDstS[dim] = 0;
+            }
 
-            int dim = opDims[i];
+            // Leave room for the placeholder dimension of a single element.
+            int nSlots = Math.max(nDims, 1);
 
-            acc /= srcD[dim];
+            int[] planD = new int[nSlots];
+            int[] planSrcS = new int[nSlots];
+            int[] planDstS = new int[nSlots];
 
-            op.op(workingV, assignBaseIndices(acc, workingD, srcS, dim), //
-                    workingD[dim], srcS[dim]);
+            int nPlanDims = MappingOps.planTraversal(srcD, srcS, maskedDstS, planD, planSrcS, planDstS);
 
-            workingD[dim] = 1;
-        }
+            int nOuterDims = nPlanDims - 1;
+            int innerSize = planD[nOuterDims];
+            int innerSrcStride = planSrcS[nOuterDims];
+            int innerDstStride = planDstS[nOuterDims];
+
+            int[] counters = new int[nOuterDims];
+
+            // Euclidean norms accumulate into sums of squares first.
+            double[] accV = (accumulateOp == rrNorm2Op) ? new double[3 * dstLen] : dstV;
+
+            Arrays.fill(accV, identity);
+
+            // Traverse the source once, running the innermost dimension as a tight loop and the rest as an odometer.
+            for (int n = srcLen / innerSize, srcOffset = 0, dstOffset = 0; n > 0; n--) {
+
+                accumulateOp.op(srcV, srcOffset, innerSrcStride, accV, dstOffset, innerDstStride, innerSize);
+
+                for (int dim = nOuterDims - 1; dim >= 0; dim--) {
+
+                    srcOffset += planSrcS[dim];
+                    dstOffset += planDstS[dim];
+
+                    if (++counters[dim] < planD[dim]) {
+                        break;
+                    }
+
+                    counters[dim] = 0;
+                    srcOffset -= planSrcS[dim] * planD[dim];
+                    dstOffset -= planDstS[dim] * planD[dim];
+                }
+            }
+
+            if (accV != dstV) {
+
+                for (int i = 0; i < dstLen; i++) {
+                    dstV[i] = Arithmetic.norm2Combine(accV, 3 * i);
+                }
+            }
+
+        } else {
 
-        MappingOps.assign( //
-                workingV, MappingOps.assignMappingIndices(dstLen, dstD, srcS), //
-                dstV, MappingOps.assignMappingIndices(dstLen, dstD, dstS));
+            // Variances don't compose, so reduce one dimension at a time.
+
+            double[] workingV = srcV.clone();
+            int[] workingD = srcD.clone();
+
+            acc = srcLen;
+
+            for (int i = 0; i < nOpDims; i++) {
+
+                int dim = opDims[i];
+
+                acc /= srcD[dim];
+
+                op.op(workingV, assignBaseIndices(acc, workingD, srcS, dim), //
+                        workingD[dim], srcS[dim]);
+
+                workingD[dim] = 1;
+            }
+
+            MappingOps.assign( //
+                    workingV, MappingOps.assignMappingIndices(dstLen, dstD, srcS), //
+                    dstV, MappingOps.assignMappingIndices(dstLen, dstD, dstS));
+        }
     }
 
     /**
@@ -708,6 +1122,234 @@ public class DimensionOps {
         op.op(srcV, srcD, srcS, dstV, opDims);
     }
 
+    /**
+     * Dimension window operations in support of
+     * {@link ArrayKernel#rwOp(int, double[], int[], int[], double[], int, int)}.
+     */
+    final public static void rwOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
+            int dim, int size) {
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        final RealWindowOperation op;
+
+        switch (type) {
+
+        case RW_SUM:
+            op = rwSumOp;
+            break;
+
+        case RW_MEAN:
+            op = rwMeanOp;
+            break;
+
+        case RW_VAR:
+            op = rwVarOp;
+            break;
+
+        case RW_MAX:
+            op = rwMaxOp;
+            break;
+
+        case RW_MIN:
+            op = rwMinOp;
+            break;
+
+        default:
+            throw new IllegalArgumentException();
+        }
+
+        int nDims = Control.checkEquals(srcD.length, srcS.length, //
+                "Dimensionality mismatch");
+
+        Control.checkTrue(dim >= 0 && dim < nDims, //
+                "Invalid dimension");
+
+        Control.checkTrue(size > 0, //
+                "Window size must be positive");
+
+        Control.checkTrue(srcLen == dstV.length, //
+                "Invalid arguments");
+
+        if (srcLen == 0) {
+            return;
+        }
+
+        op.op(srcV, assignBaseIndices(srcLen / srcD[dim], srcD, srcS, dim), //
+                dstV, srcD[dim], srcS[dim], size);
+    }
+
+    /**
+     * A real group operation in support of
+     * {@link JavaArrayKernel#rgOp(int, double[], int[], int[], int[], double[], int[], int[], int)}.
+     */
+    final public static void rgOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, int[] labels, //
+            double[] dstV, int[] dstD, int[] dstS, //
+            int dim) {
+
+        final double identity;
+
+        switch (type) {
+
+        case RG_SUM:
+        case RG_MEAN:
+        case RG_VAR:
+        case RG_COUNT:
+            identity = 0.0;
+            break;
+
+        case RG_MAX:
+            identity = Double.NEGATIVE_INFINITY;
+            break;
+
+        case RG_MIN:
+            identity = Double.POSITIVE_INFINITY;
+            break;
+
+        default:
+            throw new IllegalArgumentException();
+        }
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims == srcS.length //
+                && nDims == dstD.length //
+                && nDims == dstS.length, //
+                "Invalid arguments");
+
+        Control.checkTrue(dim >= 0 && dim < nDims, //
+                "Invalid dimension");
+
+        MappingOps.checkDimensions(srcV.length, srcD, srcS);
+        int dstLen = MappingOps.checkDimensions(dstV.length, dstD, dstS);
+
+        for (int i = 0; i < nDims; i++) {
+            Control.checkTrue(i == dim || srcD[i] == dstD[i], //
+                    "Dimension mismatch");
+        }
+
+        int nLabels = Control.checkEquals(labels.length, srcD[dim], //
+                "Dimension mismatch");
+        int nGroups = dstD[dim];
+
+        // Negative labels mark values that belong to no group.
+        for (int i = 0; i < nLabels; i++) {
+            Control.checkTrue(labels[i] < nGroups, //
+                    "Invalid label");
+        }
+
+        if (dstLen == 0) {
+            return;
+        }
+
+        int[] slabD = srcD.clone();
+        slabD[dim] = 1;
+
+        int slabLen = Arithmetic.product(slabD);
+
+        int[] srcIndices = MappingOps.assignMappingIndices(slabLen, slabD, srcS);
+        int[] dstIndices = MappingOps.assignMappingIndices(slabLen, slabD, dstS);
+
+        int[] groupCounts = new int[nGroups];
+        double[] aux = (type == RG_VAR) ? new double[dstLen] : null;
+
+        Arrays.fill(dstV, identity);
+
+        // Fold every slab into its group's slab.
+        for (int i = 0; i < nLabels; i++) {
+
+            int label = labels[i];
+
+            if (label < 0) {
+                continue;
+            }
+
+            int count = ++groupCounts[label];
+            int srcOffset = i * srcS[dim];
+            int dstOffset = label * dstS[dim];
+
+            for (int j = 0; j < slabLen; j++) {
+
+                double value = srcV[srcIndices[j] + srcOffset];
+                int dstIndex = dstIndices[j] + dstOffset;
+
+                switch (type) {
+
+                case RG_SUM:
+                case RG_MEAN:
+                    dstV[dstIndex] += value;
+                    break;
+
+                case RG_VAR:
+
+                    // Welford's method keeps running means in the destination and running sums of squared
+                    // deviations on the side.
+
+                    double delta = value - dstV[dstIndex];
+
+                    dstV[dstIndex] += delta / count;
+                    aux[dstIndex] += delta * (value - dstV[dstIndex]);
+
+                    break;
+
+                case RG_MAX:
+                    dstV[dstIndex] = Math.max(dstV[dstIndex], value);
+                    break;
+
+                case RG_MIN:
+                    dstV[dstIndex] = Math.min(dstV[dstIndex], value);
+                    break;
+                }
+            }
+        }
+
+        // Finish up by group.
+
+        if (type == RG_SUM) {
+            return;
+        }
+
+        boolean extremum = (type == RG_MAX || type == RG_MIN);
+
+        for (int label = 0; label < nGroups; label++) {
+
+            double count = groupCounts[label];
+            int dstOffset = label * dstS[dim];
+
+            // Nonempty extrema are already final, and empty ones would otherwise keep the identity.
+            if (extremum && count > 0) {
+                continue;
+            }
+
+            for (int j = 0; j < slabLen; j++) {
+
+                int dstIndex = dstIndices[j] + dstOffset;
+
+                switch (type) {
+
+                case RG_MEAN:
+                    dstV[dstIndex] = (count > 0) ? dstV[dstIndex] / count : Double.NaN;
+                    break;
+
+                case RG_VAR:
+                    dstV[dstIndex] = (count > 0) ? aux[dstIndex] / count : Double.NaN;
+                    break;
+
+                case RG_MAX:
+                case RG_MIN:
+                    dstV[dstIndex] = Double.NaN;
+                    break;
+
+                default:
+                    dstV[dstIndex] = count;
+                    break;
+                }
+            }
+        }
+    }
+
     // Dummy constructor.
     DimensionOps() {
     }
@@ -46,6 +46,8 @@ import static org.shared.array.kernel.ArrayKernel.CU_SIN;
 import static org.shared.array.kernel.ArrayKernel.C_TO_R_ABS;
 import static org.shared.array.kernel.ArrayKernel.C_TO_R_IM;
 import static org.shared.array.kernel.ArrayKernel.C_TO_R_RE;
+import static org.shared.array.kernel.ArrayKernel.HF_BF16;
+import static org.shared.array.kernel.ArrayKernel.HF_FP16;
 import static org.shared.array.kernel.ArrayKernel.IE_ADD;
 import static org.shared.array.kernel.ArrayKernel.IE_MAX;
 import static org.shared.array.kernel.ArrayKernel.IE_MIN;
@@ -55,12 +57,27 @@ import static org.shared.array.kernel.ArrayKernel.IU_ADD;
 import static org.shared.array.kernel.ArrayKernel.IU_FILL;
 import static org.shared.array.kernel.ArrayKernel.IU_MUL;
 import static org.shared.array.kernel.ArrayKernel.IU_SHUFFLE;
+import static org.shared.array.kernel.ArrayKernel.ML_AND;
+import static org.shared.array.kernel.ArrayKernel.ML_ANDNOT;
+import static org.shared.array.kernel.ArrayKernel.ML_NOT;
+import static org.shared.array.kernel.ArrayKernel.ML_OR;
+import static org.shared.array.kernel.ArrayKernel.ML_XOR;
 import static org.shared.array.kernel.ArrayKernel.RA_ENT;
 import static org.shared.array.kernel.ArrayKernel.RA_MAX;
 import static org.shared.array.kernel.ArrayKernel.RA_MIN;
+import static org.shared.array.kernel.ArrayKernel.RA_NORM1;
+import static org.shared.array.kernel.ArrayKernel.RA_NORM2;
+import static org.shared.array.kernel.ArrayKernel.RA_NORMINF;
 import static org.shared.array.kernel.ArrayKernel.RA_PROD;
 import static org.shared.array.kernel.ArrayKernel.RA_SUM;
 import static org.shared.array.kernel.ArrayKernel.RA_VAR;
+import static org.shared.array.kernel.ArrayKernel.RC_EQ;
+import static org.shared.array.kernel.ArrayKernel.RC_GE;
+import static org.shared.array.kernel.ArrayKernel.RC_GT;
+import static org.shared.array.kernel.ArrayKernel.RC_LE;
+import static org.shared.array.kernel.ArrayKernel.RC_LT;
+import static org.shared.array.kernel.ArrayKernel.RC_NAN;
+import static org.shared.array.kernel.ArrayKernel.RC_NE;
 import static org.shared.array.kernel.ArrayKernel.RE_ADD;
 import static org.shared.array.kernel.ArrayKernel.RE_DIV;
 import static org.shared.array.kernel.ArrayKernel.RE_MAX;
@@ -576,6 +593,30 @@ public class ElementOps {
         }
     };
 
+    final static RealAccumulatorOperation raNorm1Op = new RealAccumulatorOperation() {
+
+        @Override
+        public double op(double[] srcV) {
+            return Arithmetic.norm1(srcV);
+        }
+    };
+
+    final static RealAccumulatorOperation raNorm2Op = new RealAccumulatorOperation() {
+
+        @Override
+        public double op(double[] srcV) {
+            return Arithmetic.norm2(srcV);
+        }
+    };
+
+    final static RealAccumulatorOperation raNormInfOp = new RealAccumulatorOperation() {
+
+        @Override
+        public double op(double[] srcV) {
+            return Arithmetic.normInf(srcV);
+        }
+    };
+
     /**
      * Defines complex accumulator operations.
      */
@@ -650,6 +691,18 @@ public class ElementOps {
             op = raMinOp;
             break;
 
+        case RA_NORM1:
+            op = raNorm1Op;
+            break;
+
+        case RA_NORM2:
+            op = raNorm2Op;
+            break;
+
+        case RA_NORMINF:
+            op = raNormInfOp;
+            break;
+
         default:
             throw new IllegalArgumentException();
         }
@@ -687,6 +740,17 @@ public class ElementOps {
      * A real unary elementwise operation in support of {@link JavaArrayKernel#ruOp(int, double, double[])}.
      */
     final public static void ruOp(int type, double a, double[] srcV) {
+        ruOpTo(type, a, srcV, srcV);
+    }
+
+    /**
+     * A real unary elementwise operation in support of
+     * {@link JavaArrayKernel#ruOpTo(int, double, double[], double[])}.
+     */
+    final public static void ruOpTo(int type, double a, double[] srcV, double[] dstV) {
+
+        Control.checkTrue(srcV.length == dstV.length, //
+                "Invalid array lengths");
 
         final RealBinaryOperation op;
 
@@ -749,7 +813,13 @@ public class ElementOps {
             break;
 
         case RU_SHUFFLE:
-            Arithmetic.shuffle(srcV);
+
+            if (srcV != dstV) {
+                System.arraycopy(srcV, 0, dstV, 0, srcV.length);
+            }
+
+            Arithmetic.shuffle(dstV);
+
             return;
 
         default:
@@ -757,7 +827,7 @@ public class ElementOps {
         }
 
         for (int i = 0, n = srcV.length; i < n; i++) {
-            srcV[i] = op.op(a, srcV[i]);
+            dstV[i] = op.op(a, srcV[i]);
         }
     }
 
@@ -765,10 +835,19 @@ public class ElementOps {
      * A complex unary elementwise operation in support of {@link JavaArrayKernel#cuOp(int, double, double, double[])}.
      */
     final public static void cuOp(int type, double aRe, double aIm, double[] srcV) {
+        cuOpTo(type, aRe, aIm, srcV, srcV);
+    }
+
+    /**
+     * A complex unary elementwise operation in support of
+     * {@link JavaArrayKernel#cuOpTo(int, double, double, double[], double[])}.
+     */
+    final public static void cuOpTo(int type, double aRe, double aIm, double[] srcV, double[] dstV) {
 
         double[] tmp = new double[2];
 
-        int n = srcV.length;
+        int n = Control.checkEquals(srcV.length, dstV.length, //
+                "Invalid array lengths");
 
         final ComplexBinaryOperation op;
 
@@ -808,18 +887,22 @@ public class ElementOps {
 
         case CU_SHUFFLE:
 
+            if (srcV != dstV) {
+                System.arraycopy(srcV, 0, dstV, 0, n);
+            }
+
             for (int i = n / 2; i > 1; i--) {
 
                 int index = Arithmetic.nextInt(i);
 
-                double tmpRe = srcV[2 * (i - 1)];
-                double tmpIm = srcV[2 * (i - 1) + 1];
+                double tmpRe = dstV[2 * (i - 1)];
+                double tmpIm = dstV[2 * (i - 1) + 1];
 
-                srcV[2 * (i - 1)] = srcV[2 * index];
-                srcV[2 * (i - 1) + 1] = srcV[2 * index + 1];
+                dstV[2 * (i - 1)] = dstV[2 * index];
+                dstV[2 * (i - 1) + 1] = dstV[2 * index + 1];
 
-                srcV[2 * index] = tmpRe;
-                srcV[2 * index + 1] = tmpIm;
+                dstV[2 * index] = tmpRe;
+                dstV[2 * index + 1] = tmpIm;
             }
 
             return;
@@ -834,8 +917,8 @@ public class ElementOps {
 
             op.op(tmp, aRe, aIm, srcV[i], srcV[i + 1]);
 
-            srcV[i] = tmp[0];
-            srcV[i + 1] = tmp[1];
+            dstV[i] = tmp[0];
+            dstV[i + 1] = tmp[1];
         }
     }
 
@@ -843,6 +926,16 @@ public class ElementOps {
      * An integer unary elementwise operation in support of {@link JavaArrayKernel#iuOp(int, int, int[])}.
      */
     final public static void iuOp(int type, int a, int[] srcV) {
+        iuOpTo(type, a, srcV, srcV);
+    }
+
+    /**
+     * An integer unary elementwise operation in support of {@link JavaArrayKernel#iuOpTo(int, int, int[], int[])}.
+     */
+    final public static void iuOpTo(int type, int a, int[] srcV, int[] dstV) {
+
+        Control.checkTrue(srcV.length == dstV.length, //
+                "Invalid array lengths");
 
         final IntegerBinaryOperation op;
 
@@ -861,7 +954,13 @@ public class ElementOps {
             break;
 
         case IU_SHUFFLE:
-            Arithmetic.shuffle(srcV);
+
+            if (srcV != dstV) {
+                System.arraycopy(srcV, 0, dstV, 0, srcV.length);
+            }
+
+            Arithmetic.shuffle(dstV);
+
             return;
 
         default:
@@ -869,7 +968,7 @@ public class ElementOps {
         }
 
         for (int i = 0, n = srcV.length; i < n; i++) {
-            srcV[i] = op.op(a, srcV[i]);
+            dstV[i] = op.op(a, srcV[i]);
         }
     }
 
@@ -1095,6 +1194,402 @@ public class ElementOps {
         }
     }
 
+    /**
+     * A real comparison operation in support of {@link JavaArrayKernel#rcOp(int, double[], double[], double, long[])}.
+     */
+    final public static void rcOp(int type, double[] lhsV, double[] rhsV, double a, long[] dstV) {
+
+        int len = lhsV.length;
+
+        Control.checkTrue(rhsV == null || rhsV.length == len, //
+                "Invalid array lengths");
+        Control.checkTrue(dstV.length == maskWords(len), //
+                "Invalid array lengths");
+
+        boolean scalar = (rhsV == null);
+
+        for (int w = 0, offset = 0; offset < len; w++, offset += 64) {
+
+            long bits = 0;
+
+            for (int k = 0, size = Math.min(len - offset, 64); k < size; k++) {
+
+                double x = lhsV[offset + k];
+                double y = scalar ? a : rhsV[offset + k];
+
+                final boolean outcome;
+
+                switch (type) {
+
+                case RC_LT:
+                    outcome = x < y;
+                    break;
+
+                case RC_LE:
+                    outcome = x <= y;
+                    break;
+
+                case RC_EQ:
+                    outcome = x == y;
+                    break;
+
+                case RC_NE:
+                    outcome = x != y;
+                    break;
+
+                case RC_GT:
+                    outcome = x > y;
+                    break;
+
+                case RC_GE:
+                    outcome = x >= y;
+                    break;
+
+                case RC_NAN:
+                    outcome = Double.isNaN(x);
+                    break;
+
+                default:
+                    throw new IllegalArgumentException("Operation type not recognized");
+                }
+
+                bits |= (outcome ? 1L : 0L) << k;
+            }
+
+            dstV[w] = bits;
+        }
+    }
+
+    /**
+     * A mask logical operation in support of {@link JavaArrayKernel#mlOp(int, long[], long[], long[], int)}.
+     */
+    final public static void mlOp(int type, long[] lhsV, long[] rhsV, long[] dstV, int len) {
+
+        boolean unary = (type == ML_NOT);
+
+        Control.checkTrue(len >= 0, //
+                "Invalid arguments");
+
+        int nWords = maskWords(len);
+
+        Control.checkTrue(lhsV.length == nWords && (unary || rhsV.length == nWords) && dstV.length == nWords, //
+                "Invalid array lengths");
+
+        for (int i = 0; i < nWords; i++) {
+
+            switch (type) {
+
+            case ML_AND:
+                dstV[i] = lhsV[i] & rhsV[i];
+                break;
+
+            case ML_OR:
+                dstV[i] = lhsV[i] | rhsV[i];
+                break;
+
+            case ML_XOR:
+                dstV[i] = lhsV[i] ^ rhsV[i];
+                break;
+
+            case ML_ANDNOT:
+                dstV[i] = lhsV[i] & ~rhsV[i];
+                break;
+
+            case ML_NOT:
+                dstV[i] = ~lhsV[i];
+                break;
+
+            default:
+                throw new IllegalArgumentException("Operation type not recognized");
+            }
+        }
+
+        // Keep the bits past the end cleared.
+        if ((len & 63) != 0) {
+            dstV[nWords - 1] &= (1L << (len & 63)) - 1;
+        }
+    }
+
+    /**
+     * A masked selection operation in support of {@link JavaArrayKernel#select(long[], Object, Object, Object)}.
+     */
+    final public static void select(long[] maskV, Object lhsV, Object rhsV, Object dstV) {
+
+        if (lhsV instanceof double[] && rhsV instanceof double[] && dstV instanceof double[]) {
+
+            double[] lhsV_d = (double[]) lhsV;
+            double[] rhsV_d = (double[]) rhsV;
+            double[] dstV_d = (double[]) dstV;
+
+            int len = dstV_d.length;
+
+            Control.checkTrue(lhsV_d.length == len && rhsV_d.length == len && maskV.length == maskWords(len), //
+                    "Invalid array lengths");
+
+            for (int i = 0; i < len; i++) {
+                dstV_d[i] = ((maskV[i >>> 6] >>> (i & 63)) & 1L) != 0 ? lhsV_d[i] : rhsV_d[i];
+            }
+
+        } else if (lhsV instanceof int[] && rhsV instanceof int[] && dstV instanceof int[]) {
+
+            int[] lhsV_i = (int[]) lhsV;
+            int[] rhsV_i = (int[]) rhsV;
+            int[] dstV_i = (int[]) dstV;
+
+            int len = dstV_i.length;
+
+            Control.checkTrue(lhsV_i.length == len && rhsV_i.length == len && maskV.length == maskWords(len), //
+                    "Invalid array lengths");
+
+            for (int i = 0; i < len; i++) {
+                dstV_i[i] = ((maskV[i >>> 6] >>> (i & 63)) & 1L) != 0 ? lhsV_i[i] : rhsV_i[i];
+            }
+
+        } else {
+
+            throw new IllegalArgumentException("Invalid array types");
+        }
+    }
+
+    /**
+     * A masked fill operation in support of {@link JavaArrayKernel#maskedFill(long[], double, double[])}.
+     */
+    final public static void maskedFill(long[] maskV, double a, double[] dstV) {
+
+        int len = dstV.length;
+
+        Control.checkTrue(maskV.length == maskWords(len), //
+                "Invalid array lengths");
+
+        for (int w = 0, offset = 0; offset < len; w++, offset += 64) {
+
+            // Visit only the set bits.
+            for (long bits = maskV[w]; bits != 0; bits &= bits - 1) {
+                dstV[offset + Long.numberOfTrailingZeros(bits)] = a;
+            }
+        }
+    }
+
+    /**
+     * A half-precision conversion operation in support of {@link JavaArrayKernel#halfConvert(int, double[], short[])}.
+     */
+    final public static void halfConvert(int format, double[] srcV, short[] dstV) {
+
+        int len = Control.checkEquals(srcV.length, dstV.length, //
+                "Invalid array lengths");
+
+        int nMantissaBits = halfMantissaBits(format);
+        int bias = halfBias(format);
+
+        for (int i = 0; i < len; i++) {
+            dstV[i] = toHalf(srcV[i], nMantissaBits, bias);
+        }
+    }
+
+    /**
+     * A half-precision expansion operation in support of {@link JavaArrayKernel#halfExpand(int, short[], double[])}.
+     */
+    final public static void halfExpand(int format, short[] srcV, double[] dstV) {
+
+        int len = Control.checkEquals(srcV.length, dstV.length, //
+                "Invalid array lengths");
+
+        int nMantissaBits = halfMantissaBits(format);
+        int bias = halfBias(format);
+
+        for (int i = 0; i < len; i++) {
+            dstV[i] = fromHalf(srcV[i], nMantissaBits, bias);
+        }
+    }
+
+    /**
+     * A half-precision binary operation in support of
+     * {@link JavaArrayKernel#heOp(int, int, short[], short[], short[])}.
+     */
+    final public static void heOp(int type, int format, short[] lhsV, short[] rhsV, short[] dstV) {
+
+        int len = dstV.length;
+
+        Control.checkTrue(lhsV.length == len && rhsV.length == len, //
+                "Invalid array lengths");
+
+        int nMantissaBits = halfMantissaBits(format);
+        int bias = halfBias(format);
+
+        for (int i = 0; i < len; i++) {
+
+            float a = fromHalf(lhsV[i], nMantissaBits, bias);
+            float b = fromHalf(rhsV[i], nMantissaBits, bias);
+
+            final float r;
+
+            switch (type) {
+
+            case RE_ADD:
+                r = a + b;
+                break;
+
+            case RE_SUB:
+                r = a - b;
+                break;
+
+            case RE_MUL:
+                r = a * b;
+                break;
+
+            case RE_DIV:
+                r = a / b;
+                break;
+
+            case RE_MAX:
+                r = Math.max(a, b);
+                break;
+
+            case RE_MIN:
+                r = Math.min(a, b);
+                break;
+
+            default:
+                throw new IllegalArgumentException("Operation type not recognized");
+            }
+
+            dstV[i] = toHalf(r, nMantissaBits, bias);
+        }
+    }
+
+    /**
+     * A half-precision accumulator operation in support of {@link JavaArrayKernel#haOp(int, int, short[])}.
+     */
+    final public static double haOp(int type, int format, short[] srcV) {
+
+        switch (type) {
+
+        case RA_SUM:
+        case RA_MAX:
+        case RA_MIN:
+        case RA_NORM1:
+        case RA_NORM2:
+        case RA_NORMINF:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Operation type not recognized");
+        }
+
+        double[] values = new double[srcV.length];
+
+        halfExpand(format, srcV, values);
+
+        return raOp(type, values);
+    }
+
+    /**
+     * Rounds a value to the nearest half-precision bit pattern, with ties going to even. Overflows become infinities,
+     * and NaNs become quiet NaNs.
+     */
+    final protected static short toHalf(double value, int nMantissaBits, int bias) {
+
+        long bits = Double.doubleToRawLongBits(value);
+
+        int sign = (bits < 0) ? 0x8000 : 0;
+
+        bits &= Long.MAX_VALUE;
+
+        int exp = (int) (bits >>> 52) - 1023;
+        int inf = (2 * bias + 1) << nMantissaBits;
+
+        if (exp == 1024) {
+            return (short) (((bits & ((1L << 52) - 1)) != 0) ? (inf | (1 << (nMantissaBits - 1))) : (sign | inf));
+        }
+
+        if (exp > bias) {
+            return (short) (sign | inf);
+        }
+
+        // Anything below half of the smallest subnormal rounds to zero.
+        if (exp < -bias - nMantissaBits) {
+            return (short) sign;
+        }
+
+        long m = (bits & ((1L << 52) - 1)) | (1L << 52);
+        int shift = 52 - nMantissaBits + Math.max(1 - bias - exp, 0);
+
+        long q = m >>> shift;
+        long rem = m & ((1L << shift) - 1);
+        long half = 1L << (shift - 1);
+
+        if (rem > half || (rem == half && (q & 1) != 0)) {
+            q++;
+        }
+
+        // Adding the rounded significand lets carries propagate into the exponent, and from there into infinity.
+        return (short) (sign | (((exp >= 1 - bias) ? (exp + bias - 1) << nMantissaBits : 0) + (int) q));
+    }
+
+    /**
+     * Expands a half-precision bit pattern into a single precision value, which is exact.
+     */
+    final protected static float fromHalf(short value, int nMantissaBits, int bias) {
+
+        int bits = value & 0xFFFF;
+        int sign = (bits & 0x8000) << 16;
+        int exp = (bits >>> nMantissaBits) & (2 * bias + 1);
+        int mant = bits & ((1 << nMantissaBits) - 1);
+
+        if (exp == 0) {
+
+            float res = (float) Math.scalb((double) mant, 1 - bias - nMantissaBits);
+
+            return (sign != 0) ? -res : res;
+        }
+
+        return Float.intBitsToFloat(sign | (mant << (23 - nMantissaBits)) //
+                | ((exp == 2 * bias + 1) ? 0x7F800000 : ((exp - bias + 127) << 23)));
+    }
+
+    /**
+     * Gets the number of mantissa bits of the given half-precision format.
+     */
+    final protected static int halfMantissaBits(int format) {
+
+        switch (format) {
+
+        case HF_FP16:
+            return 10;
+
+        case HF_BF16:
+            return 7;
+
+        default:
+            throw new IllegalArgumentException("Format not recognized");
+        }
+    }
+
+    /**
+     * Gets the exponent bias of the given half-precision format.
+     */
+    final protected static int halfBias(int format) {
+
+        switch (format) {
+
+        case HF_FP16:
+            return 15;
+
+        case HF_BF16:
+            return 127;
+
+        default:
+            throw new IllegalArgumentException("Format not recognized");
+        }
+    }
+
+    /**
+     * Computes the number of words needed to pack the given number of mask bits.
+     */
+    final protected static int maskWords(int len) {
+        return (len >>> 6) + ((len & 63) != 0 ? 1 : 0);
+    }
+
     // Dummy constructor.
     ElementOps() {
     }
@@ -28,6 +28,19 @@
 
 package org.shared.array.kernel;
 
+import static org.shared.array.kernel.ArrayKernel.EC_PR;
+import static org.shared.array.kernel.ArrayKernel.EC_ROC;
+import static org.shared.array.kernel.ArrayKernel.HI_FIXED;
+import static org.shared.array.kernel.ArrayKernel.HI_LINEAR;
+import static org.shared.array.kernel.ArrayKernel.HI_QUANTILE;
+import static org.shared.array.kernel.ArrayKernel.IN_LINEAR;
+import static org.shared.array.kernel.ArrayKernel.IN_MONOTONE_CUBIC;
+import static org.shared.array.kernel.ArrayKernel.SS_LEFT;
+import static org.shared.array.kernel.ArrayKernel.SS_RIGHT;
+
+import java.util.Arrays;
+import java.util.Comparator;
+
 import org.shared.util.Arithmetic;
 import org.shared.util.Control;
 
@@ -90,6 +103,797 @@ public class IndexOps {
         return res;
     }
 
+    /**
+     * An operation in support of {@link JavaArrayKernel#sortRows(Object, int[], int[])}.
+     */
+    final public static int[] sortRows(Object srcV, int[] srcD, int[] srcS) {
+
+        Integer[] perm = sortRowsProxy(createRowComparator(srcV, srcD, srcS), srcD[0]);
+
+        int nRows = perm.length;
+        int[] res = new int[nRows];
+
+        for (int i = 0; i < nRows; i++) {
+            res[i] = perm[i];
+        }
+
+        return res;
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#unique(Object, int[], int[], int[], int[])}.
+     */
+    final public static int[] unique(Object srcV, int[] srcD, int[] srcS, int[] inverse, int[] counts) {
+
+        Comparator<Integer> c = createRowComparator(srcV, srcD, srcS);
+
+        int nRows = srcD[0];
+
+        Control.checkTrue(inverse.length == nRows && counts.length == nRows, //
+                "Invalid arguments");
+
+        Integer[] perm = sortRowsProxy(c, nRows);
+
+        int[] firsts = new int[nRows];
+        int nUnique = 0;
+
+        // Equal rows are now adjacent, and the stable sort puts every run's first occurrence up front.
+        for (int i = 0; i < nRows; i++) {
+
+            if (i == 0 || c.compare(perm[i - 1], perm[i]) != 0) {
+
+                firsts[nUnique] = perm[i];
+                counts[nUnique] = 0;
+                nUnique++;
+            }
+
+            inverse[perm[i]] = nUnique - 1;
+            counts[nUnique - 1]++;
+        }
+
+        int[] res = new int[nUnique];
+        System.arraycopy(firsts, 0, res, 0, nUnique);
+
+        return res;
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#searchSorted(int, double[], double[], int[])}.
+     */
+    final public static void searchSorted(int type, double[] edges, double[] srcV, int[] dstV) {
+
+        Control.checkTrue(srcV.length == dstV.length, //
+                "Invalid arguments");
+
+        final boolean right;
+
+        switch (type) {
+
+        case SS_LEFT:
+            right = false;
+            break;
+
+        case SS_RIGHT:
+            right = true;
+            break;
+
+        default:
+            throw new IllegalArgumentException("Operation type not recognized");
+        }
+
+        for (int i = 0, n = srcV.length; i < n; i++) {
+            dstV[i] = searchSortedProxy(edges, srcV[i], right);
+        }
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#interpolate(int, double[], double[], double[], double[])}.
+     */
+    final public static void interpolate(int type, double[] xV, double[] yV, double[] srcV, double[] dstV) {
+
+        int n = xV.length;
+
+        Control.checkTrue(n == yV.length && srcV.length == dstV.length, //
+                "Invalid arguments");
+
+        Control.checkTrue(n >= 1, //
+                "There must be at least one breakpoint");
+
+        final boolean cubic;
+
+        switch (type) {
+
+        case IN_LINEAR:
+            cubic = false;
+            break;
+
+        case IN_MONOTONE_CUBIC:
+            cubic = true;
+            break;
+
+        default:
+            throw new IllegalArgumentException("Interpolation type not recognized");
+        }
+
+        for (int i = 0; i < n - 1; i++) {
+            Control.checkTrue(xV[i] < xV[i + 1], //
+                    "Breakpoint abscissas must be strictly increasing");
+        }
+
+        double[] slopes = cubic ? monotoneSlopes(xV, yV) : null;
+
+        double lower = xV[0];
+        double upper = xV[n - 1];
+
+        for (int i = 0, len = srcV.length; i < len; i++) {
+
+            double query = srcV[i];
+
+            // Queries outside of the breakpoints take on the nearest endpoint value.
+            if (Double.isNaN(query)) {
+
+                dstV[i] = query;
+
+                continue;
+
+            } else if (query <= lower) {
+
+                dstV[i] = yV[0];
+
+                continue;
+
+            } else if (query >= upper) {
+
+                dstV[i] = yV[n - 1];
+
+                continue;
+            }
+
+            int j = searchSortedProxy(xV, query, true) - 1;
+
+            double h = xV[j + 1] - xV[j];
+            double t = (query - xV[j]) / h;
+
+            double y0 = yV[j];
+            double y1 = yV[j + 1];
+
+            if (!cubic) {
+
+                dstV[i] = y0 + t * (y1 - y0);
+
+            } else {
+
+                // Evaluate the cubic Hermite basis.
+                double t2 = t * t;
+                double t3 = t2 * t;
+
+                dstV[i] = (2.0 * t3 - 3.0 * t2 + 1.0) * y0 //
+                        + (t3 - 2.0 * t2 + t) * h * slopes[j] //
+                        + (3.0 * t2 - 2.0 * t3) * y1 //
+                        + (t3 - t2) * h * slopes[j + 1];
+            }
+        }
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#errorCurve(int, double[], boolean[], int, double[])}.
+     */
+    final public static double[] errorCurve(int type, double[] scoresV, boolean[] outcomesV, int nPoints,
+            double[] statsV) {
+
+        int n = scoresV.length;
+
+        Control.checkTrue(n == outcomesV.length && statsV.length == 2, //
+                "Invalid array lengths");
+
+        Control.checkTrue(nPoints == 0 || nPoints >= 2, //
+                "Invalid arguments");
+
+        switch (type) {
+
+        case EC_ROC:
+        case EC_PR:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Operation type not recognized");
+        }
+
+        int nPos = 0;
+
+        for (boolean outcome : outcomesV) {
+
+            if (outcome) {
+                nPos++;
+            }
+        }
+
+        int nNeg = n - nPos;
+
+        double[] posScores = new double[nPos];
+        double[] negScores = new double[nNeg];
+
+        for (int i = 0, iPos = 0, iNeg = 0; i < n; i++) {
+
+            // Negative zero ties with positive zero.
+            double score = (scoresV[i] == 0.0) ? 0.0 : scoresV[i];
+
+            if (outcomesV[i]) {
+                posScores[iPos++] = score;
+            } else {
+                negScores[iNeg++] = score;
+            }
+        }
+
+        Arrays.sort(posScores);
+        Arrays.sort(negScores);
+
+        // NaNs sort to the ends, and they rank below all other scores.
+        int posEnd = nPos;
+        int negEnd = nNeg;
+
+        while (posEnd > 0 && Double.isNaN(posScores[posEnd - 1])) {
+            posEnd--;
+        }
+
+        while (negEnd > 0 && Double.isNaN(negScores[negEnd - 1])) {
+            negEnd--;
+        }
+
+        // The curve starts at the point where no example is predicted positive.
+        int[] tps = new int[n + 1];
+        int[] fps = new int[n + 1];
+        int nGroups = 1;
+
+        // Merge the scores in descending order, where tied scores enter together.
+        for (int i = posEnd - 1, j = negEnd - 1; i >= 0 || j >= 0; nGroups++) {
+
+            double score = (i < 0) ? negScores[j] //
+                    : (j < 0) ? posScores[i] //
+                            : Math.max(posScores[i], negScores[j]);
+
+            int tp = tps[nGroups - 1];
+            int fp = fps[nGroups - 1];
+
+            for (; i >= 0 && posScores[i] == score; i--) {
+                tp++;
+            }
+
+            for (; j >= 0 && negScores[j] == score; j--) {
+                fp++;
+            }
+
+            tps[nGroups] = tp;
+            fps[nGroups] = fp;
+        }
+
+        if (posEnd < nPos || negEnd < nNeg) {
+
+            tps[nGroups] = nPos;
+            fps[nGroups] = nNeg;
+            nGroups++;
+        }
+
+        double auc = 0.0;
+        double ap = 0.0;
+
+        for (int g = 1; g < nGroups; g++) {
+
+            int tp = tps[g];
+            int fp = fps[g];
+
+            auc += (double) (fp - fps[g - 1]) * ((double) tp + tps[g - 1]);
+            ap += (double) (tp - tps[g - 1]) * tp / (tp + fp);
+        }
+
+        statsV[0] = (nPos > 0 && nNeg > 0) ? auc / (2.0 * nPos * nNeg) : Double.NaN;
+        statsV[1] = (nPos > 0) ? ap / nPos : Double.NaN;
+
+        int nOut = (nPoints != 0 && nPoints < nGroups) ? nPoints : nGroups;
+
+        double[] res = new double[2 * nOut];
+
+        for (int k = 0; k < nOut; k++) {
+
+            int g = (nOut > 1) ? (int) (((long) k * (nGroups - 1)) / (nOut - 1)) : 0;
+
+            int tp = tps[g];
+            int fp = fps[g];
+
+            double tpr = (nPos > 0) ? (double) tp / nPos : 1.0;
+
+            if (type == EC_ROC) {
+
+                res[2 * k] = (nNeg > 0) ? (double) fp / nNeg : 0.0;
+                res[2 * k + 1] = tpr;
+
+            } else {
+
+                res[2 * k] = tpr;
+                res[2 * k + 1] = (tp + fp > 0) ? (double) tp / (tp + fp) : 1.0;
+            }
+        }
+
+        return res;
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#histogram(int, double[], double, double, double[], double[])}.
+     */
+    final public static void histogram(int type, double[] srcV, double min, double max, double[] edgesV,
+            double[] dstV) {
+
+        int nBins = dstV.length;
+
+        switch (type) {
+
+        case HI_FIXED:
+        case HI_LINEAR:
+
+            // The range must be nonempty and finite.
+            Control.checkTrue(min < max && max - min <= Double.MAX_VALUE, //
+                    "Invalid arguments");
+
+            break;
+
+        case HI_QUANTILE:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Operation type not recognized");
+        }
+
+        boolean linear = (type == HI_LINEAR);
+
+        Control.checkTrue(nBins >= (linear ? 2 : 1) && edgesV.length == (linear ? nBins : nBins + 1), //
+                "Invalid array lengths");
+
+        Arrays.fill(dstV, 0.0);
+
+        switch (type) {
+
+        case HI_FIXED:
+
+        {
+            double scale = nBins / (max - min);
+
+            for (double value : srcV) {
+
+                double t = (value - min) * scale;
+
+                // Skip NaNs, and send values outside of the range to the nearest bin.
+                if (Double.isNaN(t)) {
+                    continue;
+                }
+
+                dstV[(t < 0.0) ? 0 : (t >= nBins) ? nBins - 1 : (int) t]++;
+            }
+
+            for (int bin = 0; bin < nBins; bin++) {
+                edgesV[bin] = min + (max - min) * ((double) bin / nBins);
+            }
+
+            edgesV[nBins] = max;
+        }
+
+            break;
+
+        case HI_QUANTILE:
+
+        {
+            double[] values = new double[srcV.length];
+            int nValues = 0;
+
+            for (double value : srcV) {
+
+                // Skip NaNs.
+                if (!Double.isNaN(value)) {
+                    values[nValues++] = value;
+                }
+            }
+
+            if (nValues == 0) {
+
+                Arrays.fill(edgesV, Double.NaN);
+
+                break;
+            }
+
+            Arrays.sort(values, 0, nValues);
+
+            // The edges are the order statistics at evenly spaced ranks.
+            for (int k = 0; k <= nBins; k++) {
+                edgesV[k] = values[(int) (((long) k * (nValues - 1)) / nBins)];
+            }
+
+            for (int i = 0; i < nValues; i++) {
+
+                // Find the last edge at or below the value.
+                int bin = searchSortedProxy(edgesV, values[i], true) - 1;
+
+                dstV[Math.min(bin, nBins - 1)]++;
+            }
+        }
+
+            break;
+
+        case HI_LINEAR:
+
+        {
+            int last = nBins - 1;
+            double scale = last / (max - min);
+
+            for (double value : srcV) {
+
+                double t = (value - min) * scale;
+
+                // Skip NaNs, and send values outside of the grid to the nearest end.
+                if (Double.isNaN(t)) {
+
+                    continue;
+
+                } else if (t <= 0.0) {
+
+                    dstV[0]++;
+
+                } else if (t >= last) {
+
+                    dstV[last]++;
+
+                } else {
+
+                    // Split the unit weight between the two nearest grid points.
+                    int j = (int) t;
+                    double frac = t - j;
+
+                    dstV[j] += 1.0 - frac;
+                    dstV[j + 1] += frac;
+                }
+            }
+
+            for (int j = 0; j < last; j++) {
+                edgesV[j] = min + (max - min) * ((double) j / last);
+            }
+
+            edgesV[last] = max;
+        }
+
+            break;
+
+        default:
+            throw new IllegalArgumentException("Operation type not recognized");
+        }
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#lttb(double[], double[], int)}.
+     */
+    final public static int[] lttb(double[] xV, double[] yV, int nPoints) {
+
+        Control.checkTrue(nPoints >= 3, //
+                "Invalid arguments");
+
+        int n = xV.length;
+
+        Control.checkTrue(n == yV.length, //
+                "Invalid array lengths");
+
+        int nOut = Math.min(n, nPoints);
+
+        int[] indices = new int[nOut];
+
+        if (nOut == n) {
+
+            for (int i = 0; i < n; i++) {
+                indices[i] = i;
+            }
+
+            return indices;
+        }
+
+        int nBuckets = nOut - 2;
+        int a = 0;
+
+        for (int bucket = 0; bucket < nBuckets; bucket++) {
+
+            // The buckets evenly divide the points strictly between the first and the last.
+            int start = 1 + (int) (((long) bucket * (n - 2)) / nBuckets);
+            int end = 1 + (int) (((long) (bucket + 1) * (n - 2)) / nBuckets);
+            int nextEnd = Math.min(1 + (int) (((long) (bucket + 2) * (n - 2)) / nBuckets), n);
+
+            // Average the next bucket, which for the last bucket is just the last point.
+            double xAvg = 0.0;
+            double yAvg = 0.0;
+            int count = 0;
+
+            for (int i = end; i < nextEnd; i++) {
+
+                // Skip NaN coordinates, which would otherwise poison the average.
+                if (!Double.isNaN(xV[i]) && !Double.isNaN(yV[i])) {
+
+                    xAvg += xV[i];
+                    yAvg += yV[i];
+                    count++;
+                }
+            }
+
+            xAvg /= count;
+            yAvg /= count;
+
+            double xA = xV[a];
+            double yA = yV[a];
+
+            double maxArea = -1.0;
+            int best = start;
+
+            for (int i = start; i < end; i++) {
+
+                // Twice the triangle area; NaNs never compare greater, so that they're kept only as a last resort.
+                double area = Math.abs((xA - xAvg) * (yV[i] - yA) - (xA - xV[i]) * (yAvg - yA));
+
+                if (area > maxArea) {
+
+                    maxArea = area;
+                    best = i;
+                }
+            }
+
+            indices[bucket + 1] = best;
+            a = best;
+        }
+
+        indices[nOut - 1] = n - 1;
+
+        return indices;
+    }
+
+    /**
+     * An operation in support of {@link JavaArrayKernel#thin(double[], double[], double[], int, int)}.
+     */
+    final public static int[] thin(double[] xV, double[] yV, double[] boundsV, int nX, int nY) {
+
+        Control.checkTrue(nX >= 1 && nY >= 1 && (long) nX * nY <= Integer.MAX_VALUE, //
+                "Invalid arguments");
+
+        int n = xV.length;
+
+        Control.checkTrue(n == yV.length && boundsV.length == 4, //
+                "Invalid array lengths");
+
+        double xMin = boundsV[0];
+        double xMax = boundsV[1];
+        double yMin = boundsV[2];
+        double yMax = boundsV[3];
+
+        // The ranges must be nonempty and finite.
+        Control.checkTrue(xMin < xMax && xMax - xMin <= Double.MAX_VALUE //
+                && yMin < yMax && yMax - yMin <= Double.MAX_VALUE, //
+                "Invalid arguments");
+
+        int nCells = nX * nY;
+
+        int[] occupied = new int[(int) (((long) nCells + 31) / 32)];
+        int[] kept = new int[Math.min(n, nCells)];
+
+        double xScale = nX / (xMax - xMin);
+        double yScale = nY / (yMax - yMin);
+
+        int nKept = 0;
+
+        for (int i = 0; i < n && nKept < nCells; i++) {
+
+            double tx = (xV[i] - xMin) * xScale;
+            double ty = (yV[i] - yMin) * yScale;
+
+            // Drop NaNs and points outside of the bounds.
+            if (!(tx >= 0.0 && tx <= nX && ty >= 0.0 && ty <= nY)) {
+                continue;
+            }
+
+            int cell = Math.min((int) ty, nY - 1) * nX + Math.min((int) tx, nX - 1);
+            int mask = 1 << (cell & 31);
+
+            if ((occupied[cell >>> 5] & mask) == 0) {
+
+                occupied[cell >>> 5] |= mask;
+                kept[nKept++] = i;
+            }
+        }
+
+        return Arrays.copyOf(kept, nKept);
+    }
+
+    /**
+     * Finds the insertion index of a query into sorted edges.
+     */
+    final protected static int searchSortedProxy(double[] edges, double query, boolean right) {
+
+        int nEdges = edges.length;
+
+        // NaN queries go after all edges.
+        if (Double.isNaN(query)) {
+            return nEdges;
+        }
+
+        int lower = 0;
+        int upper = nEdges;
+
+        while (lower < upper) {
+
+            int mid = (lower + upper) >>> 1;
+
+            if (right ? (edges[mid] <= query) : (edges[mid] < query)) {
+                lower = mid + 1;
+            } else {
+                upper = mid;
+            }
+        }
+
+        return lower;
+    }
+
+    /**
+     * Computes the slopes of a piecewise monotone cubic interpolant at its breakpoints.
+     */
+    final protected static double[] monotoneSlopes(double[] xV, double[] yV) {
+
+        int n = xV.length;
+
+        double[] slopes = new double[n];
+
+        if (n == 1) {
+            return slopes;
+        }
+
+        if (n == 2) {
+
+            slopes[0] = slopes[1] = (yV[1] - yV[0]) / (xV[1] - xV[0]);
+
+            return slopes;
+        }
+
+        // Interior slopes are weighted harmonic means of the secants, and vanish at local extrema (Fritsch-Carlson).
+        for (int i = 1; i < n - 1; i++) {
+
+            double hPrev = xV[i] - xV[i - 1];
+            double hNext = xV[i + 1] - xV[i];
+
+            double mPrev = (yV[i] - yV[i - 1]) / hPrev;
+            double mNext = (yV[i + 1] - yV[i]) / hNext;
+
+            if (Math.signum(mPrev) != Math.signum(mNext) || mPrev == 0.0) {
+
+                slopes[i] = 0.0;
+
+            } else {
+
+                double w1 = 2.0 * hNext + hPrev;
+                double w2 = hNext + 2.0 * hPrev;
+
+                slopes[i] = (w1 + w2) / (w1 / mPrev + w2 / mNext);
+            }
+        }
+
+        // End slopes come from one-sided three-point estimates, limited to preserve monotonicity.
+        for (int end = 0; end < 2; end++) {
+
+            int i = (end == 0) ? 0 : n - 1;
+            int di = (end == 0) ? 1 : -1;
+
+            double h0 = Math.abs(xV[i + di] - xV[i]);
+            double h1 = Math.abs(xV[i + 2 * di] - xV[i + di]);
+
+            double m0 = (yV[i + di] - yV[i]) / (xV[i + di] - xV[i]);
+            double m1 = (yV[i + 2 * di] - yV[i + di]) / (xV[i + 2 * di] - xV[i + di]);
+
+            double slope = ((2.0 * h0 + h1) * m0 - h0 * m1) / (h0 + h1);
+
+            if (Math.signum(slope) != Math.signum(m0)) {
+
+                slope = 0.0;
+
+            } else if (Math.signum(m0) != Math.signum(m1) && Math.abs(slope) > Math.abs(3.0 * m0)) {
+
+                slope = 3.0 * m0;
+            }
+
+            slopes[i] = slope;
+        }
+
+        return slopes;
+    }
+
+    /**
+     * Stably sorts row indices with the given {@link Comparator}.
+     */
+    final protected static Integer[] sortRowsProxy(Comparator<Integer> c, int nRows) {
+
+        Integer[] perm = new Integer[nRows];
+
+        for (int i = 0; i < nRows; i++) {
+            perm[i] = i;
+        }
+
+        Arrays.sort(perm, c);
+
+        return perm;
+    }
+
+    /**
+     * Creates a {@link Comparator} that orders the rows of a one- or two-dimensional array lexicographically.
+     */
+    final protected static Comparator<Integer> createRowComparator(Object srcV, int[] srcD, int[] srcS) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims == srcS.length, //
+                "Invalid arguments");
+
+        Control.checkTrue(nDims == 1 || nDims == 2, //
+                "Array must be one- or two-dimensional");
+
+        // The elements of one-dimensional arrays are rows of their own.
+        final int nCols = (nDims == 2) ? srcD[1] : 1;
+        final int rowStride = srcS[0];
+        final int colStride = (nDims == 2) ? srcS[1] : 0;
+
+        if (srcV instanceof double[]) {
+
+            final double[] srcVArr = (double[]) srcV;
+
+            MappingOps.checkDimensions(srcVArr.length, srcD, srcS);
+
+            return new Comparator<Integer>() {
+
+                @Override
+                public int compare(Integer lhs, Integer rhs) {
+
+                    for (int j = 0, lhsOffset = lhs * rowStride, rhsOffset = rhs * rowStride; j < nCols; //
+                    j++, lhsOffset += colStride, rhsOffset += colStride) {
+
+                        int cmp = Double.compare(srcVArr[lhsOffset], srcVArr[rhsOffset]);
+
+                        if (cmp != 0) {
+                            return cmp;
+                        }
+                    }
+
+                    return 0;
+                }
+            };
+
+        } else if (srcV instanceof int[]) {
+
+            final int[] srcVArr = (int[]) srcV;
+
+            MappingOps.checkDimensions(srcVArr.length, srcD, srcS);
+
+            return new Comparator<Integer>() {
+
+                @Override
+                public int compare(Integer lhs, Integer rhs) {
+
+                    for (int j = 0, lhsOffset = lhs * rowStride, rhsOffset = rhs * rowStride; j < nCols; //
+                    j++, lhsOffset += colStride, rhsOffset += colStride) {
+
+                        int lhsValue = srcVArr[lhsOffset];
+                        int rhsValue = srcVArr[rhsOffset];
+
+                        if (lhsValue != rhsValue) {
+                            return (lhsValue < rhsValue) ? -1 : 1;
+                        }
+                    }
+
+                    return 0;
+                }
+            };
+
+        } else {
+
+            throw new IllegalArgumentException("Only integer and real arrays can be sorted");
+        }
+    }
+
     // Dummy constructor.
     IndexOps() {
     }
@@ -80,6 +80,34 @@ public class JavaArrayKernel implements ArrayKernel {
         MappingOps.slice(slices, srcV, srcD, srcS, dstV, dstD, dstS);
     }
 
+    @Override
+    public void concat(int opDim, //
+            Object[] srcVs, int[][] srcDs, int[][] srcSs, //
+            Object dstV, int[] dstD, int[] dstS) {
+        MappingOps.concat(opDim, srcVs, srcDs, srcSs, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void pad(int mode, int[] offsets, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        MappingOps.pad(mode, offsets, srcV, srcD, srcS, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void gather(int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        MappingOps.gather(opDim, indices, srcV, srcD, srcS, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void scatter(int type, int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        MappingOps.scatter(type, opDim, indices, srcV, srcD, srcS, dstV, dstD, dstS);
+    }
+
     //
 
     @Override
@@ -104,6 +132,21 @@ public class JavaArrayKernel implements ArrayKernel {
         DimensionOps.rdOp(type, srcV, srcD, srcS, dstV, opDims);
     }
 
+    @Override
+    public void rwOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
+            int dim, int size) {
+        DimensionOps.rwOp(type, srcV, srcD, srcS, dstV, dim, size);
+    }
+
+    @Override
+    public void rgOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, int[] labels, //
+            double[] dstV, int[] dstD, int[] dstS, //
+            int dim) {
+        DimensionOps.rgOp(type, srcV, srcD, srcS, labels, dstV, dstD, dstS, dim);
+    }
+
     //
 
     @Override
@@ -131,6 +174,21 @@ public class JavaArrayKernel implements ArrayKernel {
         ElementOps.iuOp(type, a, srcV);
     }
 
+    @Override
+    public void ruOpTo(int type, double a, double[] srcV, double[] dstV) {
+        ElementOps.ruOpTo(type, a, srcV, dstV);
+    }
+
+    @Override
+    public void cuOpTo(int type, double aRe, double aIm, double[] srcV, double[] dstV) {
+        ElementOps.cuOpTo(type, aRe, aIm, srcV, dstV);
+    }
+
+    @Override
+    public void iuOpTo(int type, int a, int[] srcV, int[] dstV) {
+        ElementOps.iuOpTo(type, a, srcV, dstV);
+    }
+
     @Override
     public void eOp(int type, Object lhsV, Object rhsV, Object dstV, boolean complex) {
         ElementOps.eOp(type, lhsV, rhsV, dstV, complex);
@@ -141,6 +199,53 @@ public class JavaArrayKernel implements ArrayKernel {
         ElementOps.convert(type, srcV, isSrcComplex, dstV, isDstComplex);
     }
 
+    @Override
+    public void rcOp(int type, double[] lhsV, double[] rhsV, double a, long[] dstV) {
+        ElementOps.rcOp(type, lhsV, rhsV, a, dstV);
+    }
+
+    @Override
+    public void mlOp(int type, long[] lhsV, long[] rhsV, long[] dstV, int len) {
+        ElementOps.mlOp(type, lhsV, rhsV, dstV, len);
+    }
+
+    @Override
+    public void select(long[] maskV, Object lhsV, Object rhsV, Object dstV) {
+        ElementOps.select(maskV, lhsV, rhsV, dstV);
+    }
+
+    @Override
+    public void maskedFill(long[] maskV, double a, double[] dstV) {
+        ElementOps.maskedFill(maskV, a, dstV);
+    }
+
+    //
+
+    @Override
+    public void halfConvert(int format, double[] srcV, short[] dstV) {
+        ElementOps.halfConvert(format, srcV, dstV);
+    }
+
+    @Override
+    public void halfExpand(int format, short[] srcV, double[] dstV) {
+        ElementOps.halfExpand(format, srcV, dstV);
+    }
+
+    @Override
+    public void heOp(int type, int format, short[] lhsV, short[] rhsV, short[] dstV) {
+        ElementOps.heOp(type, format, lhsV, rhsV, dstV);
+    }
+
+    @Override
+    public double haOp(int type, int format, short[] srcV) {
+        return ElementOps.haOp(type, format, srcV);
+    }
+
+    @Override
+    public void hMul(int format, short[] lhsV, short[] rhsV, int lr, int rc, double[] dstV) {
+        MatrixOps.hMul(format, lhsV, rhsV, lr, rc, dstV);
+    }
+
     //
 
     @Override
@@ -179,6 +284,46 @@ public class JavaArrayKernel implements ArrayKernel {
         return IndexOps.find(srcV, srcD, srcS, logical);
     }
 
+    @Override
+    public int[] sortRows(Object srcV, int[] srcD, int[] srcS) {
+        return IndexOps.sortRows(srcV, srcD, srcS);
+    }
+
+    @Override
+    public int[] unique(Object srcV, int[] srcD, int[] srcS, int[] inverse, int[] counts) {
+        return IndexOps.unique(srcV, srcD, srcS, inverse, counts);
+    }
+
+    @Override
+    public void searchSorted(int type, double[] edges, double[] srcV, int[] dstV) {
+        IndexOps.searchSorted(type, edges, srcV, dstV);
+    }
+
+    @Override
+    public void interpolate(int type, double[] xV, double[] yV, double[] srcV, double[] dstV) {
+        IndexOps.interpolate(type, xV, yV, srcV, dstV);
+    }
+
+    @Override
+    public double[] errorCurve(int type, double[] scoresV, boolean[] outcomesV, int nPoints, double[] statsV) {
+        return IndexOps.errorCurve(type, scoresV, outcomesV, nPoints, statsV);
+    }
+
+    @Override
+    public void histogram(int type, double[] srcV, double min, double max, double[] edgesV, double[] dstV) {
+        IndexOps.histogram(type, srcV, min, max, edgesV, dstV);
+    }
+
+    @Override
+    public int[] lttb(double[] xV, double[] yV, int nPoints) {
+        return IndexOps.lttb(xV, yV, nPoints);
+    }
+
+    @Override
+    public int[] thin(double[] xV, double[] yV, double[] boundsV, int nX, int nY) {
+        return IndexOps.thin(xV, yV, boundsV, nX, nY);
+    }
+
     //
 
     @Override
@@ -28,9 +28,20 @@
 
 package org.shared.array.kernel;
 
+import static org.shared.array.kernel.ArrayKernel.PM_CIRCULAR;
+import static org.shared.array.kernel.ArrayKernel.PM_CONSTANT;
+import static org.shared.array.kernel.ArrayKernel.PM_REFLECT;
+import static org.shared.array.kernel.ArrayKernel.PM_REPLICATE;
+import static org.shared.array.kernel.ArrayKernel.PM_SYMMETRIC;
+import static org.shared.array.kernel.ArrayKernel.SC_ADD;
+import static org.shared.array.kernel.ArrayKernel.SC_ASSIGN;
+import static org.shared.array.kernel.ArrayKernel.SC_MAX;
+import static org.shared.array.kernel.ArrayKernel.SC_MIN;
+
 import java.lang.reflect.Array;
 import java.util.Arrays;
 
+import org.shared.util.Arithmetic;
 import org.shared.util.Control;
 
 /**
@@ -137,6 +148,88 @@ public class MappingOps {
         return len;
     }
 
+    /**
+     * Plans a traversal that visits every element once by dropping singleton dimensions, ordering the rest by
+     * decreasing source stride, and coalescing neighbors whose strides nest in both the source and the destination.
+     * 
+     * @param dims
+     *            the dimensions.
+     * @param srcStrides
+     *            the source strides.
+     * @param dstStrides
+     *            the destination strides.
+     * @param planD
+     *            the planned dimensions.
+     * @param planSrcS
+     *            the planned source strides.
+     * @param planDstS
+     *            the planned destination strides.
+     * @return the number of planned dimensions, which is at least one.
+     */
+    final public static int planTraversal(int[] dims, int[] srcStrides, int[] dstStrides, //
+            int[] planD, int[] planSrcS, int[] planDstS) {
+
+        int nPlanDims = 0;
+
+        // Insert nonsingleton dimensions in order of decreasing source stride.
+        for (int dim = 0, nDims = dims.length; dim < nDims; dim++) {
+
+            if (dims[dim] == 1) {
+                continue;
+            }
+
+            int srcStride = srcStrides[dim];
+            int i = nPlanDims++;
+
+            for (; i > 0 && planSrcS[i - 1] < srcStride; i--) {
+
+                planD[i] = planD[i - 1];
+                planSrcS[i] = planSrcS[i - 1];
+                planDstS[i] = planDstS[i - 1];
+            }
+
+            planD[i] = dims[dim];
+            planSrcS[i] = srcStride;
+            planDstS[i] = dstStrides[dim];
+        }
+
+        // Coalesce neighbors whose strides nest exactly.
+
+        int nCoalesced = 0;
+
+        for (int i = 0; i < nPlanDims; i++) {
+
+            if (nCoalesced > 0 //
+                    && planSrcS[nCoalesced - 1] == planSrcS[i] * planD[i] //
+                    && planDstS[nCoalesced - 1] == planDstS[i] * planD[i]) {
+
+                planD[nCoalesced - 1] *= planD[i];
+                planSrcS[nCoalesced - 1] = planSrcS[i];
+                planDstS[nCoalesced - 1] = planDstS[i];
+
+            } else {
+
+                planD[nCoalesced] = planD[i];
+                planSrcS[nCoalesced] = planSrcS[i];
+                planDstS[nCoalesced] = planDstS[i];
+
+                nCoalesced++;
+            }
+        }
+
+        // A single element still needs one dimension to traverse.
+        if (nCoalesced == 0) {
+
+            planD[0] = 1;
+            planSrcS[0] = 0;
+            planDstS[0] = 0;
+
+            nCoalesced = 1;
+        }
+
+        return nCoalesced;
+    }
+
     /**
      * Assigns source values to destination values based on arrays of physical indices.
      * 
@@ -259,6 +352,419 @@ public class MappingOps {
         assign(srcV, srcIndices, dstV, dstIndices);
     }
 
+    /**
+     * A concatenation operation in support of
+     * {@link JavaArrayKernel#concat(int, Object[], int[][], int[][], Object, int[], int[])}.
+     */
+    final public static void concat(int opDim, //
+            Object[] srcVs, int[][] srcDs, int[][] srcSs, //
+            Object dstV, int[] dstD, int[] dstS) {
+
+        int nSrcs = srcVs.length;
+        int nDims = dstD.length;
+
+        Control.checkTrue(nSrcs == srcDs.length //
+                && nSrcs == srcSs.length //
+                && nDims == dstS.length, //
+                "Invalid arguments");
+
+        Control.checkTrue(opDim >= 0 && opDim < nDims, //
+                "Invalid dimension");
+
+        checkDimensions(Array.getLength(dstV), dstD, dstS);
+
+        int total = 0;
+
+        for (int i = 0; i < nSrcs; i++) {
+
+            Object srcV = srcVs[i];
+            int[] srcD = srcDs[i];
+            int[] srcS = srcSs[i];
+
+            Control.checkTrue(nDims == srcD.length && nDims == srcS.length, //
+                    "Dimensionality mismatch");
+
+            Control.checkTrue((srcV instanceof double[] && dstV instanceof double[]) //
+                    || (srcV instanceof int[] && dstV instanceof int[]) //
+                    || (srcV instanceof Object[] && dstV instanceof Object[] //
+                    && dstV.getClass().isAssignableFrom(srcV.getClass())), //
+                    "Invalid array types");
+
+            checkDimensions(Array.getLength(srcV), srcD, srcS);
+
+            for (int dim = 0; dim < nDims; dim++) {
+                Control.checkTrue(dim == opDim || srcD[dim] == dstD[dim], //
+                        "Dimension mismatch");
+            }
+
+            total += srcD[opDim];
+        }
+
+        Control.checkTrue(total == dstD[opDim], //
+                "Dimension mismatch");
+
+        int[] planD = new int[nDims];
+        int[] planSrcS = new int[nDims];
+        int[] planDstS = new int[nDims];
+
+        // Copy every source into its slab of the destination.
+        for (int i = 0, offset = 0; i < nSrcs; offset += srcDs[i][opDim], i++) {
+
+            Object srcV = srcVs[i];
+            int[] srcD = srcDs[i];
+            int[] srcS = srcSs[i];
+
+            int srcLen = Array.getLength(srcV);
+
+            if (srcLen == 0) {
+                continue;
+            }
+
+            int dstBase = offset * dstS[opDim];
+
+            int nPlanDims = planTraversal(srcD, srcS, dstS, planD, planSrcS, planDstS);
+
+            int nOuterDims = nPlanDims - 1;
+            int innerSize = planD[nOuterDims];
+
+            if (planSrcS[nOuterDims] != 1 || planDstS[nOuterDims] != 1) {
+
+                int[] dstIndices = assignMappingIndices(srcLen, srcD, dstS);
+
+                for (int j = 0; j < srcLen; j++) {
+                    dstIndices[j] += dstBase;
+                }
+
+                assign(srcV, assignMappingIndices(srcLen, srcD, srcS), dstV, dstIndices);
+
+                continue;
+            }
+
+            int[] counters = new int[nOuterDims];
+
+            // Copy contiguous runs in bulk, and walk the outer dimensions as an odometer.
+            for (int n = srcLen / innerSize, srcOffset = 0, dstOffset = dstBase; n > 0; n--) {
+
+                System.arraycopy(srcV, srcOffset, dstV, dstOffset, innerSize);
+
+                for (int dim = nOuterDims - 1; dim >= 0; dim--) {
+
+                    srcOffset += planSrcS[dim];
+                    dstOffset += planDstS[dim];
+
+                    if (++counters[dim] < planD[dim]) {
+                        break;
+                    }
+
+                    counters[dim] = 0;
+                    srcOffset -= planSrcS[dim] * planD[dim];
+                    dstOffset -= planDstS[dim] * planD[dim];
+                }
+            }
+        }
+    }
+
+    /**
+     * A padding operation in support of
+     * {@link JavaArrayKernel#pad(int, int[], Object, int[], int[], Object, int[], int[])}.
+     */
+    final public static void pad(int mode, int[] offsets, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims == srcS.length //
+                && nDims == dstD.length //
+                && nDims == dstS.length //
+                && nDims == offsets.length, //
+                "Invalid arguments");
+
+        Control.checkTrue((srcV instanceof double[] && dstV instanceof double[]) //
+                || (srcV instanceof int[] && dstV instanceof int[]) //
+                || (srcV instanceof Object[] && dstV instanceof Object[] //
+                && dstV.getClass().isAssignableFrom(srcV.getClass())), //
+                "Invalid array types");
+
+        checkDimensions(Array.getLength(srcV), srcD, srcS);
+        int dstLen = checkDimensions(Array.getLength(dstV), dstD, dstS);
+
+        for (int dim = 0; dim < nDims; dim++) {
+            Control.checkTrue(offsets[dim] >= 0 && offsets[dim] + srcD[dim] <= dstD[dim], //
+                    "Invalid padding offsets");
+        }
+
+        if (dstLen == 0) {
+            return;
+        }
+
+        int nIndices = 1;
+
+        int[][] ssi = new int[nDims][];
+        int[][] dsi = new int[nDims][];
+
+        // Only keep destination indices that take their values from the source.
+        for (int dim = 0; dim < nDims; dim++) {
+
+            int[] lookup = assignPaddingLookup(mode, offsets[dim], srcD[dim], dstD[dim]);
+
+            int count = 0;
+
+            for (int i = 0, n = lookup.length; i < n; i++) {
+                count += (lookup[i] >= 0) ? 1 : 0;
+            }
+
+            ssi[dim] = new int[count];
+            dsi[dim] = new int[count];
+
+            for (int i = 0, n = lookup.length, j = 0; i < n; i++) {
+
+                if (lookup[i] >= 0) {
+
+                    ssi[dim][j] = lookup[i];
+                    dsi[dim][j] = i;
+                    j++;
+                }
+            }
+
+            nIndices *= count;
+        }
+
+        if (nIndices == 0) {
+            return;
+        }
+
+        int[] srcIndices = assignSlicingIndices(nIndices, srcS, ssi);
+        int[] dstIndices = assignSlicingIndices(nIndices, dstS, dsi);
+
+        assign(srcV, srcIndices, dstV, dstIndices);
+    }
+
+    /**
+     * Creates a table that maps every destination index along a dimension to the source index that it takes its value
+     * from, or to {@code -1} if it keeps its constant value.
+     * 
+     * @param mode
+     *            the padding mode.
+     * @param offset
+     *            the offset of the source in the destination.
+     * @param srcSize
+     *            the source size.
+     * @param dstSize
+     *            the destination size.
+     * @return the lookup table.
+     */
+    final public static int[] assignPaddingLookup(int mode, int offset, int srcSize, int dstSize) {
+
+        switch (mode) {
+
+        case PM_CONSTANT:
+        case PM_REPLICATE:
+        case PM_REFLECT:
+        case PM_SYMMETRIC:
+        case PM_CIRCULAR:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Padding mode not recognized");
+        }
+
+        int[] lookup = new int[dstSize];
+
+        if (srcSize == 0) {
+
+            Control.checkTrue(mode == PM_CONSTANT || dstSize == 0, //
+                    "Only constant padding applies to empty dimensions");
+
+            Arrays.fill(lookup, -1);
+
+            return lookup;
+        }
+
+        // Periods of the reflective modes.
+        int reflectPeriod = Math.max(2 * srcSize - 2, 1);
+        int symmetricPeriod = 2 * srcSize;
+
+        for (int i = 0; i < dstSize; i++) {
+
+            int index = i - offset;
+
+            if (index >= 0 && index < srcSize) {
+
+                lookup[i] = index;
+
+                continue;
+            }
+
+            switch (mode) {
+
+            case PM_CONSTANT:
+                index = -1;
+                break;
+
+            case PM_REPLICATE:
+                index = Math.min(Math.max(index, 0), srcSize - 1);
+                break;
+
+            case PM_REFLECT:
+                index = ((index % reflectPeriod) + reflectPeriod) % reflectPeriod;
+                index = (index < srcSize) ? index : reflectPeriod - index;
+                break;
+
+            case PM_SYMMETRIC:
+                index = ((index % symmetricPeriod) + symmetricPeriod) % symmetricPeriod;
+                index = (index < srcSize) ? index : symmetricPeriod - 1 - index;
+                break;
+
+            case PM_CIRCULAR:
+                index = ((index % srcSize) + srcSize) % srcSize;
+                break;
+            }
+
+            lookup[i] = index;
+        }
+
+        return lookup;
+    }
+
+    /**
+     * A gather operation in support of
+     * {@link JavaArrayKernel#gather(int, int[], Object, int[], int[], Object, int[], int[])}.
+     */
+    final public static void gather(int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        gatherScatter(SC_ASSIGN, opDim, indices, srcV, srcD, srcS, dstV, dstD, dstS, false);
+    }
+
+    /**
+     * A scatter operation in support of
+     * {@link JavaArrayKernel#scatter(int, int, int[], Object, int[], int[], Object, int[], int[])}.
+     */
+    final public static void scatter(int type, int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        gatherScatter(type, opDim, indices, srcV, srcD, srcS, dstV, dstD, dstS, true);
+    }
+
+    /**
+     * Transfers slabs along the dimension of interest, where the indices name source slabs for gathers and destination
+     * slabs for scatters.
+     */
+    final static void gatherScatter(int type, int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS, //
+            boolean scatter) {
+
+        switch (type) {
+
+        case SC_ASSIGN:
+        case SC_ADD:
+        case SC_MAX:
+        case SC_MIN:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Operation type not recognized");
+        }
+
+        int nDims = srcD.length;
+        int nIndices = indices.length;
+
+        Control.checkTrue(nDims == srcS.length //
+                && nDims == dstD.length //
+                && nDims == dstS.length, //
+                "Invalid arguments");
+
+        Control.checkTrue((srcV instanceof double[] && dstV instanceof double[]) //
+                || (srcV instanceof int[] && dstV instanceof int[]) //
+                || (srcV instanceof Object[] && dstV instanceof Object[] //
+                && dstV.getClass().isAssignableFrom(srcV.getClass())), //
+                "Invalid array types");
+
+        Control.checkTrue(!(srcV instanceof Object[]) || type == SC_ASSIGN, //
+                "Only assignment applies to object arrays");
+
+        Control.checkTrue(opDim >= 0 && opDim < nDims, //
+                "Invalid dimension");
+
+        checkDimensions(Array.getLength(srcV), srcD, srcS);
+        checkDimensions(Array.getLength(dstV), dstD, dstS);
+
+        int[] indexedD = scatter ? dstD : srcD;
+        int[] listedD = scatter ? srcD : dstD;
+
+        for (int dim = 0; dim < nDims; dim++) {
+            Control.checkTrue((dim == opDim) ? (listedD[dim] == nIndices) : (srcD[dim] == dstD[dim]), //
+                    "Dimension mismatch");
+        }
+
+        for (int i = 0, size = indexedD[opDim]; i < nIndices; i++) {
+            Control.checkTrue(indices[i] >= 0 && indices[i] < size, //
+                    "Invalid index");
+        }
+
+        int[] slabD = srcD.clone();
+        slabD[opDim] = 1;
+
+        int slabLen = Arithmetic.product(slabD);
+        int mapLen = nIndices * slabLen;
+
+        if (mapLen == 0) {
+            return;
+        }
+
+        int[] srcIndices = assignMappingIndices(mapLen, slabD, srcS);
+        int[] dstIndices = assignMappingIndices(mapLen, slabD, dstS);
+
+        // Replicate the first slab's indices for every index, offset along the dimension of interest.
+        for (int i = nIndices - 1; i >= 0; i--) {
+
+            int srcOffset = (scatter ? i : indices[i]) * srcS[opDim];
+            int dstOffset = (scatter ? indices[i] : i) * dstS[opDim];
+
+            for (int j = 0, k = i * slabLen; j < slabLen; j++, k++) {
+
+                srcIndices[k] = srcIndices[j] + srcOffset;
+                dstIndices[k] = dstIndices[j] + dstOffset;
+            }
+        }
+
+        if (type == SC_ASSIGN) {
+
+            assign(srcV, srcIndices, dstV, dstIndices);
+
+            return;
+        }
+
+        if (srcV instanceof double[]) {
+
+            double[] srcVArr = (double[]) srcV;
+            double[] dstVArr = (double[]) dstV;
+
+            for (int i = 0; i < mapLen; i++) {
+
+                double a = dstVArr[dstIndices[i]];
+                double b = srcVArr[srcIndices[i]];
+
+                dstVArr[dstIndices[i]] = (type == SC_ADD) ? a + b : (type == SC_MAX) ? Math.max(a, b) : Math.min(a, b);
+            }
+
+        } else {
+
+            int[] srcVArr = (int[]) srcV;
+            int[] dstVArr = (int[]) dstV;
+
+            for (int i = 0; i < mapLen; i++) {
+
+                int a = dstVArr[dstIndices[i]];
+                int b = srcVArr[srcIndices[i]];
+
+                dstVArr[dstIndices[i]] = (type == SC_ADD) ? a + b : (type == SC_MAX) ? Math.max(a, b) : Math.min(a, b);
+            }
+        }
+    }
+
     /**
      * A slicing operation in support of
      * {@link JavaArrayKernel#slice(int[], Object, int[], int[], Object, int[], int[])}.
@@ -28,6 +28,8 @@
 
 package org.shared.array.kernel;
 
+import java.util.Arrays;
+
 import org.shared.util.Control;
 
 /**
@@ -99,6 +101,52 @@ public class MatrixOps {
         }
     }
 
+    /**
+     * A half-precision matrix multiply operation in support of
+     * {@link JavaArrayKernel#hMul(int, short[], short[], int, int, double[])}.
+     */
+    final public static void hMul(int format, short[] lhsV, short[] rhsV, int lr, int rc, double[] dstV) {
+
+        int lc = (lr != 0) ? lhsV.length / lr : 0;
+        int rr = (rc != 0) ? rhsV.length / rc : 0;
+        int inner = Control.checkEquals(lc, rr);
+
+        Control.checkTrue(lr >= 0 && rc >= 0 //
+                && (lhsV.length == lr * lc) //
+                && (rhsV.length == rr * rc) //
+                && (dstV.length == lr * rc), //
+                "Invalid array lengths");
+
+        int nMantissaBits = ElementOps.halfMantissaBits(format);
+        int bias = ElementOps.halfBias(format);
+
+        // Expand the right hand side once.
+        float[] rArr = new float[rhsV.length];
+        float[] accArr = new float[rc];
+
+        for (int i = 0, n = rhsV.length; i < n; i++) {
+            rArr[i] = ElementOps.fromHalf(rhsV[i], nMantissaBits, bias);
+        }
+
+        for (int i = 0; i < lr; i++) {
+
+            Arrays.fill(accArr, 0.0f);
+
+            for (int k = 0; k < inner; k++) {
+
+                float a = ElementOps.fromHalf(lhsV[i * lc + k], nMantissaBits, bias);
+
+                for (int j = 0, offset = k * rc; j < rc; j++) {
+                    accArr[j] += a * rArr[offset + j];
+                }
+            }
+
+            for (int j = 0; j < rc; j++) {
+                dstV[i * rc + j] = accArr[j];
+            }
+        }
+    }
+
     /**
      * A matrix diagonal operation in support of {@link JavaArrayKernel#diag(double[], double[], int, boolean)}.
      */
@@ -112,6 +112,34 @@ public class ModalArrayKernel implements ArrayKernel {
         this.opKernel.slice(slices, srcV, srcD, srcS, dstV, dstD, dstS);
     }
 
+    @Override
+    public void concat(int opDim, //
+            Object[] srcVs, int[][] srcDs, int[][] srcSs, //
+            Object dstV, int[] dstD, int[] dstS) {
+        this.opKernel.concat(opDim, srcVs, srcDs, srcSs, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void pad(int mode, int[] offsets, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        this.opKernel.pad(mode, offsets, srcV, srcD, srcS, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void gather(int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        this.opKernel.gather(opDim, indices, srcV, srcD, srcS, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void scatter(int type, int opDim, int[] indices, //
+            Object srcV, int[] srcD, int[] srcS, //
+            Object dstV, int[] dstD, int[] dstS) {
+        this.opKernel.scatter(type, opDim, indices, srcV, srcD, srcS, dstV, dstD, dstS);
+    }
+
     //
 
     @Override
@@ -136,6 +164,21 @@ public class ModalArrayKernel implements ArrayKernel {
         this.opKernel.rdOp(type, srcV, srcD, srcS, dstV, opDims);
     }
 
+    @Override
+    public void rwOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, double[] dstV, //
+            int dim, int size) {
+        this.opKernel.rwOp(type, srcV, srcD, srcS, dstV, dim, size);
+    }
+
+    @Override
+    public void rgOp(int type, //
+            double[] srcV, int[] srcD, int[] srcS, int[] labels, //
+            double[] dstV, int[] dstD, int[] dstS, //
+            int dim) {
+        this.opKernel.rgOp(type, srcV, srcD, srcS, labels, dstV, dstD, dstS, dim);
+    }
+
     @Override
     public double raOp(int type, double[] srcV) {
         return this.opKernel.raOp(type, srcV);
@@ -161,6 +204,21 @@ public class ModalArrayKernel implements ArrayKernel {
         this.opKernel.iuOp(type, a, srcV);
     }
 
+    @Override
+    public void ruOpTo(int type, double a, double[] srcV, double[] dstV) {
+        this.opKernel.ruOpTo(type, a, srcV, dstV);
+    }
+
+    @Override
+    public void cuOpTo(int type, double aRe, double aIm, double[] srcV, double[] dstV) {
+        this.opKernel.cuOpTo(type, aRe, aIm, srcV, dstV);
+    }
+
+    @Override
+    public void iuOpTo(int type, int a, int[] srcV, int[] dstV) {
+        this.opKernel.iuOpTo(type, a, srcV, dstV);
+    }
+
     @Override
     public void eOp(int type, Object lhsV, Object rhsV, Object dstV, boolean complex) {
         this.opKernel.eOp(type, lhsV, rhsV, dstV, complex);
@@ -173,6 +231,53 @@ public class ModalArrayKernel implements ArrayKernel {
         this.opKernel.convert(type, srcV, isSrcComplex, dstV, isDstComplex);
     }
 
+    @Override
+    public void rcOp(int type, double[] lhsV, double[] rhsV, double a, long[] dstV) {
+        this.opKernel.rcOp(type, lhsV, rhsV, a, dstV);
+    }
+
+    @Override
+    public void mlOp(int type, long[] lhsV, long[] rhsV, long[] dstV, int len) {
+        this.opKernel.mlOp(type, lhsV, rhsV, dstV, len);
+    }
+
+    @Override
+    public void select(long[] maskV, Object lhsV, Object rhsV, Object dstV) {
+        this.opKernel.select(maskV, lhsV, rhsV, dstV);
+    }
+
+    @Override
+    public void maskedFill(long[] maskV, double a, double[] dstV) {
+        this.opKernel.maskedFill(maskV, a, dstV);
+    }
+
+    //
+
+    @Override
+    public void halfConvert(int format, double[] srcV, short[] dstV) {
+        this.opKernel.halfConvert(format, srcV, dstV);
+    }
+
+    @Override
+    public void halfExpand(int format, short[] srcV, double[] dstV) {
+        this.opKernel.halfExpand(format, srcV, dstV);
+    }
+
+    @Override
+    public void heOp(int type, int format, short[] lhsV, short[] rhsV, short[] dstV) {
+        this.opKernel.heOp(type, format, lhsV, rhsV, dstV);
+    }
+
+    @Override
+    public double haOp(int type, int format, short[] srcV) {
+        return this.opKernel.haOp(type, format, srcV);
+    }
+
+    @Override
+    public void hMul(int format, short[] lhsV, short[] rhsV, int lr, int rc, double[] dstV) {
+        this.opKernel.hMul(format, lhsV, rhsV, lr, rc, dstV);
+    }
+
     //
 
     @Override
@@ -211,6 +316,46 @@ public class ModalArrayKernel implements ArrayKernel {
         return this.opKernel.find(srcV, srcD, srcS, logical);
     }
 
+    @Override
+    public int[] sortRows(Object srcV, int[] srcD, int[] srcS) {
+        return this.opKernel.sortRows(srcV, srcD, srcS);
+    }
+
+    @Override
+    public int[] unique(Object srcV, int[] srcD, int[] srcS, int[] inverse, int[] counts) {
+        return this.opKernel.unique(srcV, srcD, srcS, inverse, counts);
+    }
+
+    @Override
+    public void searchSorted(int type, double[] edges, double[] srcV, int[] dstV) {
+        this.opKernel.searchSorted(type, edges, srcV, dstV);
+    }
+
+    @Override
+    public void interpolate(int type, double[] xV, double[] yV, double[] srcV, double[] dstV) {
+        this.opKernel.interpolate(type, xV, yV, srcV, dstV);
+    }
+
+    @Override
+    public double[] errorCurve(int type, double[] scoresV, boolean[] outcomesV, int nPoints, double[] statsV) {
+        return this.opKernel.errorCurve(type, scoresV, outcomesV, nPoints, statsV);
+    }
+
+    @Override
+    public void histogram(int type, double[] srcV, double min, double max, double[] edgesV, double[] dstV) {
+        this.opKernel.histogram(type, srcV, min, max, edgesV, dstV);
+    }
+
+    @Override
+    public int[] lttb(double[] xV, double[] yV, int nPoints) {
+        return this.opKernel.lttb(xV, yV, nPoints);
+    }
+
+    @Override
+    public int[] thin(double[] xV, double[] yV, double[] boundsV, int nX, int nY) {
+        return this.opKernel.thin(xV, yV, boundsV, nX, nY);
+    }
+
     //
 
     @Override
@@ -595,6 +595,32 @@ abstract public class ProtoSparseArray<T extends ProtoSparseArray<T, V, E, D>, V
         return dst;
     }
 
+    @SuppressWarnings("unchecked")
+    @Override
+    public T stack(int opDim, T... srcs) {
+
+        ProtoSparseArray<T, V, E, D> src = this;
+
+        int nDims = src.dims.length;
+
+        Control.checkTrue(opDim >= 0 && opDim <= nDims, //
+                "Invalid dimension");
+
+        int[] newDims = ArrayBase.insertDimension(src.dims, opDim, 1);
+
+        T[] reshaped = srcs.clone();
+
+        for (int i = 0, n = srcs.length; i < n; i++) {
+
+            Control.checkTrue(Arrays.equals(src.dims, srcs[i].dims), //
+                    "Dimension mismatch");
+
+            reshaped[i] = srcs[i].reshape(newDims);
+        }
+
+        return reshape(newDims).concat(opDim, reshaped);
+    }
+
     @SuppressWarnings("unchecked")
     @Override
     public T clone() {
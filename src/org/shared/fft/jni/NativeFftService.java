@@ -0,0 +1,73 @@
+/**
+ * <p>
+ * Copyright (c) 2008 The Regents of the University of California<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.fft.jni;
+
+import org.shared.fft.FftService;
+import org.shared.metaclass.Library;
+import org.shared.util.Control;
+
+/**
+ * A portable native implementation of {@link FftService} for when FFTW3 is unavailable. One-dimensional transforms use
+ * mixed-radix Stockham passes and fall back to Bluestein's algorithm for lengths with large prime factors.
+ * 
+ * @author Roy Liu
+ */
+public class NativeFftService implements FftService {
+
+    /**
+     * Default constructor.
+     */
+    public NativeFftService() {
+
+        Control.checkTrue(Library.isInitialized(), //
+                "Could not instantiate native bindings -- Linking failed");
+    }
+
+    @Override
+    final public native void rfft(int[] dims, double[] in, double[] out);
+
+    @Override
+    final public native void rifft(int[] dims, double[] in, double[] out);
+
+    @Override
+    final public native void fft(int[] dims, double[] in, double[] out);
+
+    @Override
+    final public native void ifft(int[] dims, double[] in, double[] out);
+
+    @Override
+    public void setHint(String name, String value) {
+        throw new IllegalArgumentException("Unknown hint");
+    }
+
+    @Override
+    public String getHint(String name) {
+        throw new IllegalArgumentException("Unknown hint");
+    }
+}
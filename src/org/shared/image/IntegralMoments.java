@@ -0,0 +1,127 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.image;
+
+import java.util.Arrays;
+
+import org.shared.array.RealArray;
+import org.shared.image.kernel.ImageOps;
+import org.shared.util.Control;
+
+/**
+ * A data structure for computing sums of multiple moments, like those of values, squared values, and cross products,
+ * over any rectangular region quickly. All requested moment tables are built in a single pass over the source.
+ * 
+ * @author Roy Liu
+ */
+public class IntegralMoments extends RealArray {
+
+    final int[] ilut;
+    final int[] types;
+
+    /**
+     * Default constructor.
+     * 
+     * @param x
+     *            the primary {@link RealArray} to integrate over.
+     * @param y
+     *            the secondary {@link RealArray} to integrate over, or {@code null} if no moment requires it.
+     * @param types
+     *            the moment types, as given by {@link org.shared.image.kernel.ImageKernel#IM_X} and friends.
+     */
+    public IntegralMoments(RealArray x, RealArray y, int... types) {
+        super(IntegralHistogram.getDimensionsPlusOne(x, types.length));
+
+        RealArray dst = this;
+
+        int[] srcDims = x.dims();
+        int[] dstDims = dst.dims();
+
+        if (y != null) {
+
+            Control.checkTrue(x.order() == y.order(), //
+                    "Indexing order mismatch");
+
+            Control.checkTrue(Arrays.equals(srcDims, y.dims()), //
+                    "Dimension mismatch");
+        }
+
+        ImageOps.imKernel.createIntegralMoments( //
+                types, x.values(), (y != null) ? y.values() : null, srcDims, x.order().strides(srcDims), //
+                dst.values(), dstDims, dst.order().strides(dstDims));
+
+        this.ilut = ImageOps.createIlut(nDims() - 1);
+        this.types = types.clone();
+    }
+
+    /**
+     * Queries for the moment sums within a rectangular region, whose bounds are expressed in the same way as
+     * {@link RealArray#subarray(int...)}. Sums are stored in the order in which their types were given.
+     * 
+     * @see RealArray#subarray(int...)
+     */
+    public double[] query(double[] res, int... bounds) {
+
+        double[] values = values();
+
+        int nDims = nDims() - 1;
+        int stride = nDims + 1;
+        int[] ilut = this.ilut;
+
+        int nTypes = size(nDims);
+        int typeStride = stride(nDims);
+
+        for (int typeIndex = 0, typeOffset = 0; typeIndex < nTypes; typeIndex++, typeOffset += typeStride) {
+
+            double sum = 0.0;
+
+            for (int i = 0, n = (1 << nDims), offset = 0; i < n; i++, offset += stride) {
+
+                int index = typeOffset;
+
+                for (int dim = 0; dim < nDims; dim++) {
+                    index += bounds[ilut[offset + dim]] * stride(dim);
+                }
+
+                sum += values[index] * ilut[offset + nDims];
+            }
+
+            res[typeIndex] = sum;
+        }
+
+        return res;
+    }
+
+    /**
+     * Gets the moment types.
+     */
+    public int[] types() {
+        return this.types.clone();
+    }
+}
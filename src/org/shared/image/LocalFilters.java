@@ -0,0 +1,132 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.image;
+
+import java.util.Arrays;
+
+import org.shared.array.RealArray;
+import org.shared.image.kernel.ImageOps;
+import org.shared.util.Control;
+
+/**
+ * A static utility class for filters over local neighborhoods of multidimensional images.
+ * 
+ * @author Roy Liu
+ */
+public class LocalFilters {
+
+    /**
+     * Computes local means and variances over box windows with the given radii. Windows are clipped at the borders.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param radii
+     *            the window radii.
+     * @return the local means and variances, in that order.
+     */
+    final public static RealArray[] meanVariance(RealArray src, int... radii) {
+
+        int[] dims = src.dims();
+
+        RealArray mean = new RealArray(src.order(), dims);
+        RealArray var = new RealArray(src.order(), dims);
+
+        ImageOps.imKernel.localMeanVariance( //
+                src.values(), dims, src.order().strides(dims), radii, //
+                mean.values(), var.values());
+
+        return new RealArray[] { mean, var };
+    }
+
+    /**
+     * Applies the guided filter of He, Sun, and Tang, which smooths the source while preserving the edges of the guide.
+     * 
+     * @param guide
+     *            the guide {@link RealArray}.
+     * @param src
+     *            the source {@link RealArray}.
+     * @param epsilon
+     *            the regularization parameter.
+     * @param radii
+     *            the window radii.
+     * @return the filtered result.
+     */
+    final public static RealArray guided(RealArray guide, RealArray src, double epsilon, int... radii) {
+
+        int[] dims = src.dims();
+
+        Control.checkTrue(guide.order() == src.order(), //
+                "Indexing order mismatch");
+
+        Control.checkTrue(Arrays.equals(guide.dims(), dims), //
+                "Dimension mismatch");
+
+        RealArray dst = new RealArray(src.order(), dims);
+
+        ImageOps.imKernel.guidedFilter( //
+                guide.values(), src.values(), dims, src.order().strides(dims), radii, epsilon, //
+                dst.values());
+
+        return dst;
+    }
+
+    /**
+     * Applies an approximate bilateral filter, which smooths the source while preserving its edges. Grayscale sources
+     * go through a bilateral grid, and multi-channel sources go through a permutohedral lattice; either way, the cost
+     * is linear in the number of pixels regardless of the spatial standard deviations.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param rangeSigma
+     *            the range standard deviation.
+     * @param spatialSigmas
+     *            the spatial standard deviations. If there is one fewer than the number of dimensions, the last
+     *            dimension holds channels.
+     * @return the filtered result.
+     */
+    final public static RealArray bilateral(RealArray src, double rangeSigma, double... spatialSigmas) {
+
+        int[] dims = src.dims();
+
+        double[] sigmas = Arrays.copyOf(spatialSigmas, spatialSigmas.length + 1);
+        sigmas[spatialSigmas.length] = rangeSigma;
+
+        RealArray dst = new RealArray(src.order(), dims);
+
+        ImageOps.imKernel.bilateralFilter( //
+                src.values(), dims, src.order().strides(dims), sigmas, //
+                dst.values());
+
+        return dst;
+    }
+
+    // Dummy constructor.
+    LocalFilters() {
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.image;
+
+import org.shared.array.IntegerArray;
+import org.shared.array.RealArray;
+import org.shared.image.kernel.ImageOps;
+import org.shared.util.Control;
+
+/**
+ * A static utility class for finding local peaks with non-maximum suppression.
+ * 
+ * @author Roy Liu
+ */
+public class PeakFinder {
+
+    /**
+     * Finds local peaks, which are values at least the threshold and no less than every other value in their box
+     * windows. Windows are separable, so the cost per value doesn't depend on their sizes. Peaks are then visited in
+     * order of decreasing value, and any peak closer than the minimum distance, in the maximum norm, to an earlier
+     * accepted peak is suppressed. NaNs are never peaks.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param threshold
+     *            the threshold.
+     * @param minDistance
+     *            the minimum distance between peaks, where values of {@code 0} and {@code 1} suppress nothing.
+     * @param radii
+     *            the window radii.
+     * @return the logical indices of the peaks, one per row, in order of decreasing value.
+     */
+    final public static IntegerArray find(RealArray src, double threshold, int minDistance, int... radii) {
+
+        int[] dims = src.dims();
+        int nDims = dims.length;
+
+        Control.checkTrue(nDims == radii.length, //
+                "Dimensionality mismatch");
+
+        int[] peaks = ImageOps.imKernel.findPeaks(src.values(), dims, src.strides(), radii, threshold, minDistance);
+
+        int nPeaks = peaks.length;
+        int[] res = new int[nPeaks * nDims];
+
+        for (int i = 0; i < nPeaks; i++) {
+
+            for (int dim = nDims - 1, rem = peaks[i]; dim >= 0; rem /= dims[dim--]) {
+                res[i * nDims + dim] = rem % dims[dim];
+            }
+        }
+
+        return new IntegerArray(res, nPeaks, nDims);
+    }
+
+    /**
+     * Looks up the values at the given peaks.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param peaks
+     *            the logical indices of the peaks, one per row.
+     * @return the values.
+     */
+    final public static RealArray values(RealArray src, IntegerArray peaks) {
+
+        int nDims = src.nDims();
+
+        Control.checkTrue(peaks.nDims() == 2 && peaks.size(1) == nDims, //
+                "Invalid peaks");
+
+        int nPeaks = peaks.size(0);
+        int[] peaksV = peaks.values();
+        int[] peaksS = peaks.strides();
+        int[] srcS = src.strides();
+        int[] srcD = src.dims();
+        double[] srcV = src.values();
+        double[] res = new double[nPeaks];
+
+        for (int i = 0; i < nPeaks; i++) {
+
+            int index = 0;
+
+            for (int dim = 0; dim < nDims; dim++) {
+
+                int coord = peaksV[i * peaksS[0] + dim * peaksS[1]];
+
+                Control.checkTrue(coord >= 0 && coord < srcD[dim], //
+                        "Invalid index");
+
+                index += coord * srcS[dim];
+            }
+
+            res[i] = srcV[index];
+        }
+
+        return new RealArray(res, nPeaks);
+    }
+
+    // Dummy constructor.
+    PeakFinder() {
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.image;
+
+import java.util.Arrays;
+
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.ComplexArray;
+import org.shared.array.RealArray;
+import org.shared.image.kernel.ImageKernel;
+import org.shared.image.kernel.ImageOps;
+import org.shared.util.Control;
+
+/**
+ * A static utility class for resampling arrays at arbitrary coordinates, as in geometric warps. Interpolation types
+ * and boundary modes are those of {@link ImageKernel}.
+ * 
+ * @author Roy Liu
+ */
+public class Resampler {
+
+    /**
+     * Interpolates values at arbitrary coordinates. The source is treated as extended indefinitely by the boundary
+     * mode, except for {@link ImageKernel#BM_NEAREST}, where coordinates are clamped into the source extent instead.
+     * With {@link ImageKernel#IP_CUBIC}, cubic B-spline coefficients are computed on every call; to reuse them across
+     * calls, compute them once with {@link #splineCoefficients(RealArray, int, double)} and interpolate with
+     * {@link ImageKernel#IP_SPLINE}.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param coords
+     *            the coordinates, whose last dimension indexes into the source dimensions.
+     * @param interpolation
+     *            the interpolation type.
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the constant for {@link ImageKernel#BM_CONSTANT}.
+     * @return the interpolated values, whose dimensions are those of the coordinates less the last.
+     */
+    final public static RealArray map(RealArray src, RealArray coords, int interpolation, int boundary, double cval) {
+
+        checkCoordinates(coords, src.nDims());
+
+        RealArray dst = new RealArray(IndexingOrder.FAR, Arrays.copyOf(coords.dims(), coords.nDims() - 1));
+
+        ImageOps.imKernel.mapCoordinates(interpolation, boundary, cval, //
+                src.values(), src.dims(), src.strides(), //
+                contiguous(coords).values(), dst.values(), false);
+
+        return dst;
+    }
+
+    /**
+     * Interpolates complex values at arbitrary coordinates.
+     * 
+     * @param src
+     *            the source {@link ComplexArray}.
+     * @param coords
+     *            the coordinates, whose last dimension indexes into the source dimensions.
+     * @param interpolation
+     *            the interpolation type.
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the real constant for {@link ImageKernel#BM_CONSTANT}.
+     * @return the interpolated values, whose dimensions are those of the coordinates less the last.
+     * @see #map(RealArray, RealArray, int, int, double)
+     */
+    final public static ComplexArray map(ComplexArray src, RealArray coords, int interpolation, int boundary,
+            double cval) {
+
+        checkCoordinates(coords, src.nDims() - 1);
+
+        int[] dstDims = coords.dims();
+
+        dstDims[dstDims.length - 1] = 2;
+
+        ComplexArray dst = new ComplexArray(dstDims);
+
+        ImageOps.imKernel.mapCoordinates(interpolation, boundary, cval, //
+                src.values(), src.dims(), src.strides(), //
+                contiguous(coords).values(), dst.values(), true);
+
+        return dst;
+    }
+
+    /**
+     * Computes cubic B-spline coefficients for interpolation with {@link ImageKernel#IP_SPLINE}. The boundary mode
+     * and constant must match those given at interpolation time.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the constant for {@link ImageKernel#BM_CONSTANT}.
+     * @return the coefficients.
+     */
+    final public static RealArray splineCoefficients(RealArray src, int boundary, double cval) {
+
+        RealArray dst = new RealArray(src.order(), src.dims());
+
+        ImageOps.imKernel.splineCoefficients(boundary, cval, //
+                src.values(), src.dims(), src.strides(), //
+                dst.values(), false);
+
+        return dst;
+    }
+
+    /**
+     * Creates the coordinates of an affine warp.
+     * 
+     * @param matrix
+     *            the {@code n}-by-{@code (n + 1)} matrix that maps homogeneous destination positions to source
+     *            coordinates.
+     * @param dims
+     *            the destination dimensions.
+     * @return the coordinates, whose last dimension indexes into the source dimensions.
+     */
+    final public static RealArray affineCoordinates(RealArray matrix, int... dims) {
+
+        int nDims = dims.length;
+
+        Control.checkTrue(nDims > 0 && matrix.nDims() == 2 //
+                && matrix.size(0) == nDims && matrix.size(1) == nDims + 1, //
+                "Invalid affine matrix");
+
+        int[] coordsDims = Arrays.copyOf(dims, nDims + 1);
+
+        coordsDims[nDims] = nDims;
+
+        RealArray coords = new RealArray(IndexingOrder.FAR, coordsDims);
+
+        double[] coordsV = coords.values();
+        int[] s = new int[nDims];
+
+        for (int i = 0, n = coordsV.length / nDims; i < n; i++) {
+
+            for (int row = 0; row < nDims; row++) {
+
+                double acc = matrix.get(row, nDims);
+
+                for (int col = 0; col < nDims; col++) {
+                    acc += matrix.get(row, col) * s[col];
+                }
+
+                coordsV[i * nDims + row] = acc;
+            }
+
+            for (int dim = nDims - 1; dim >= 0 && ++s[dim] == dims[dim]; dim--) {
+                s[dim] = 0;
+            }
+        }
+
+        return coords;
+    }
+
+    /**
+     * Creates the identity coordinates, to which dense displacement fields may be added.
+     * 
+     * @param dims
+     *            the destination dimensions.
+     * @return the coordinates, whose last dimension indexes into the source dimensions.
+     */
+    final public static RealArray gridCoordinates(int... dims) {
+
+        int nDims = dims.length;
+
+        RealArray matrix = new RealArray(nDims, nDims + 1);
+
+        for (int dim = 0; dim < nDims; dim++) {
+            matrix.set(1.0, dim, dim);
+        }
+
+        return affineCoordinates(matrix, dims);
+    }
+
+    /**
+     * Checks the coordinates against the source dimensionality.
+     */
+    final protected static void checkCoordinates(RealArray coords, int nDims) {
+
+        int nCoordsDims = coords.nDims();
+
+        Control.checkTrue(nCoordsDims >= 2 && coords.size(nCoordsDims - 1) == nDims, //
+                "Invalid coordinates");
+    }
+
+    /**
+     * Gets coordinates stored contiguously one point at a time.
+     */
+    final protected static RealArray contiguous(RealArray coords) {
+        return (coords.order() == IndexingOrder.FAR) ? coords : coords.reverseOrder();
+    }
+
+    // Dummy constructor.
+    Resampler() {
+    }
+}
@@ -0,0 +1,237 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.image;
+
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.PriorityQueue;
+
+import org.shared.array.IntegerArray;
+import org.shared.array.RealArray;
+import org.shared.array.kernel.MappingOps;
+import org.shared.image.kernel.ImageOps;
+import org.shared.util.Control;
+
+/**
+ * A static utility class for template matching by normalized cross-correlation.
+ * 
+ * @author Roy Liu
+ */
+public class TemplateMatcher {
+
+    /**
+     * Computes the normalized cross-correlation scores of a template against every position where it fits entirely
+     * inside the source. Window statistics come from integral images, and correlation is done directly for small
+     * templates and in the frequency domain otherwise.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param template
+     *            the template {@link RealArray}.
+     * @return the scores, in {@code [-1, 1]}, whose dimensions are those of the source minus those of the template
+     *         plus one.
+     */
+    final public static RealArray match(RealArray src, RealArray template) {
+
+        int nDims = src.nDims();
+
+        Control.checkTrue(nDims == template.nDims(), //
+                "Dimensionality mismatch");
+
+        int[] srcDims = src.dims();
+        int[] tplDims = template.dims();
+        int[] dstDims = new int[nDims];
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            Control.checkTrue(tplDims[dim] <= srcDims[dim], //
+                    "Template must fit inside the source");
+
+            dstDims[dim] = srcDims[dim] - tplDims[dim] + 1;
+        }
+
+        RealArray dst = new RealArray(src.order(), dstDims);
+
+        ImageOps.imKernel.normalizedCrossCorrelation( //
+                src.values(), srcDims, src.order().strides(srcDims), //
+                template.values(), tplDims, template.order().strides(tplDims), //
+                dst.values(), dstDims, dst.order().strides(dstDims));
+
+        return dst;
+    }
+
+    /**
+     * Finds the positions of the highest scores, suppressing any position that overlaps an accepted match of the
+     * given template. This is {@link #top(RealArray, int, int...)} with the template dimensions as the radii.
+     * 
+     * @param scores
+     *            the scores.
+     * @param template
+     *            the template whose scores were computed.
+     * @param k
+     *            the maximum number of positions.
+     * @return the logical indices of the positions, one per row, in order of decreasing score.
+     */
+    final public static IntegerArray top(RealArray scores, RealArray template, int k) {
+        return top(scores, k, template.dims());
+    }
+
+    /**
+     * Finds the positions of the highest scores. Positions are visited in order of decreasing score, and any
+     * position lying inside the suppression box of an earlier accepted one is skipped, so that the smooth
+     * neighborhood of a single match doesn't crowd out other matches.
+     * 
+     * @param scores
+     *            the scores.
+     * @param k
+     *            the maximum number of positions.
+     * @param radii
+     *            the suppression radii, where a position is suppressed if it differs from an accepted one by less
+     *            than the radius along every dimension. Values of {@code 0} and {@code 1} suppress nothing, as does
+     *            leaving them out altogether.
+     * @return the logical indices of the positions, one per row, in order of decreasing score.
+     */
+    final public static IntegerArray top(RealArray scores, int k, int... radii) {
+
+        Control.checkTrue(k >= 0, //
+                "Invalid number of positions");
+
+        int[] dims = scores.dims();
+        int nDims = dims.length;
+        int len = scores.values().length;
+
+        Control.checkTrue(radii.length == 0 || radii.length == nDims, //
+                "Dimensionality mismatch");
+
+        boolean suppress = false;
+
+        for (int radius : radii) {
+            suppress |= (radius > 1);
+        }
+
+        final double[] values = scores.values();
+        final int[] indices = MappingOps.assignMappingIndices(len, dims, scores.strides());
+
+        // Order by score, breaking ties in favor of earlier positions.
+        Comparator<Integer> comparator = new Comparator<Integer>() {
+
+            @Override
+            public int compare(Integer a, Integer b) {
+
+                int cmp = Double.compare(values[indices[a]], values[indices[b]]);
+
+                return (cmp != 0) ? cmp : b.compareTo(a);
+            }
+        };
+
+        final int[] positions;
+        int nPositions = 0;
+
+        if (!suppress) {
+
+            // Keep a min-heap of the best positions seen so far.
+            PriorityQueue<Integer> heap = new PriorityQueue<Integer>(Math.max(k, 1), comparator);
+
+            for (int i = 0; i < len && k > 0; i++) {
+
+                if (heap.size() < k) {
+
+                    heap.add(i);
+
+                } else if (comparator.compare(i, heap.peek()) > 0) {
+
+                    heap.poll();
+                    heap.add(i);
+                }
+            }
+
+            nPositions = heap.size();
+            positions = new int[nPositions];
+
+            for (int i = nPositions - 1; i >= 0; i--) {
+                positions[i] = heap.poll();
+            }
+
+        } else {
+
+            Integer[] order = new Integer[len];
+
+            for (int i = 0; i < len; i++) {
+                order[i] = i;
+            }
+
+            Arrays.sort(order, Collections.reverseOrder(comparator));
+
+            positions = new int[Math.min(k, len)];
+
+            int[] logical = new int[nDims];
+            int[] accepted = new int[positions.length * nDims];
+
+            for (int i = 0; i < len && nPositions < positions.length; i++) {
+
+                for (int dim = nDims - 1, rem = order[i]; dim >= 0; rem /= dims[dim--]) {
+                    logical[dim] = rem % dims[dim];
+                }
+
+                boolean suppressed = false;
+
+                for (int j = 0; j < nPositions && !suppressed; j++) {
+
+                    suppressed = true;
+
+                    for (int dim = 0; dim < nDims && suppressed; dim++) {
+                        suppressed = Math.abs(logical[dim] - accepted[j * nDims + dim]) < radii[dim];
+                    }
+                }
+
+                if (!suppressed) {
+
+                    System.arraycopy(logical, 0, accepted, nPositions * nDims, nDims);
+                    positions[nPositions++] = order[i];
+                }
+            }
+        }
+
+        int[] res = new int[nPositions * nDims];
+
+        for (int i = 0; i < nPositions; i++) {
+
+            for (int dim = nDims - 1, rem = positions[i]; dim >= 0; rem /= dims[dim--]) {
+                res[i * nDims + dim] = rem % dims[dim];
+            }
+        }
+
+        return new IntegerArray(res, nPositions, nDims);
+    }
+
+    // Dummy constructor.
+    TemplateMatcher() {
+    }
+}
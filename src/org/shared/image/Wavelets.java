@@ -0,0 +1,114 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.image;
+
+import org.shared.array.RealArray;
+import org.shared.image.kernel.ImageKernel;
+import org.shared.image.kernel.ImageOps;
+
+/**
+ * A static utility class for multilevel, separable discrete wavelet transforms computed by lifting.
+ * 
+ * @author Roy Liu
+ */
+public class Wavelets {
+
+    /**
+     * Applies a discrete wavelet transform in place. At each level, every dimension of the current approximation region
+     * is split into approximation coefficients followed by detail coefficients, and the next level recurses into the
+     * leading corner.
+     * 
+     * @param src
+     *            the source {@link RealArray}.
+     * @param wavelet
+     *            the wavelet, such as {@link ImageKernel#WT_DB4}.
+     * @param nLevels
+     *            the number of levels.
+     * @return the source, which now holds the coefficients.
+     */
+    final public static RealArray transform(RealArray src, int wavelet, int nLevels) {
+
+        int[] dims = src.dims();
+
+        ImageOps.imKernel.waveletTransform(wavelet, nLevels, //
+                src.values(), dims, src.order().strides(dims), //
+                false);
+
+        return src;
+    }
+
+    /**
+     * Applies an inverse discrete wavelet transform in place.
+     * 
+     * @param src
+     *            the source {@link RealArray} of coefficients.
+     * @param wavelet
+     *            the wavelet.
+     * @param nLevels
+     *            the number of levels.
+     * @return the source, which now holds the reconstruction.
+     */
+    final public static RealArray inverse(RealArray src, int wavelet, int nLevels) {
+
+        int[] dims = src.dims();
+
+        ImageOps.imKernel.waveletTransform(wavelet, nLevels, //
+                src.values(), dims, src.order().strides(dims), //
+                true);
+
+        return src;
+    }
+
+    /**
+     * Gets the dimensions of the approximation region after the given number of levels.
+     * 
+     * @param nLevels
+     *            the number of levels.
+     * @param dims
+     *            the dimensions.
+     * @return the approximation region dimensions.
+     */
+    final public static int[] approximationDims(int nLevels, int... dims) {
+
+        int[] res = dims.clone();
+
+        for (int level = 0; level < nLevels; level++) {
+
+            for (int dim = 0; dim < res.length; dim++) {
+                res[dim] = (res[dim] + 1) >> 1;
+            }
+        }
+
+        return res;
+    }
+
+    // Dummy constructor.
+    Wavelets() {
+    }
+}
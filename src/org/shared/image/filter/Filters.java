@@ -50,7 +50,7 @@ public class Filters {
             RealArray m = (RealArray) array;
 
             m = m.uAdd(-m.aMean());
-            m.uMul(1.0 / m.clone().uAbs().aSum());
+            m.uMul(1.0 / m.eAbs().aSum());
 
         } else if (array instanceof ComplexArray) {
 
@@ -118,8 +118,8 @@ public class Gabor extends ComplexArray implements Cacheable {
 
         final double a = -4.0d / (k * k);
 
-        RealArray ptsRe = ((ptsX.clone().uPow(2.0).uMul(1.0 / (elongation * elongation))) //
-                .eAdd(ptsY.clone().uPow(2.0))) //
+        RealArray ptsRe = ((ptsX.ePow(2.0).uMul(1.0 / (elongation * elongation))) //
+                .eAdd(ptsY.ePow(2.0))) //
                 .uMul(a);
 
         final double b = 2.0d * Math.PI * frequency / k;
@@ -104,11 +104,11 @@ public class GaborCircular extends ComplexArray implements Cacheable {
 
         final double a = -4.0d / (k * k);
 
-        RealArray ptsRe = ((ptsX.clone().uPow(2.0)).eAdd(ptsY.clone().uPow(2.0))).uMul(a);
+        RealArray ptsRe = ptsX.ePow(2.0).eAdd(ptsY.ePow(2.0)).uMul(a);
 
         final double b = 2.0d * Math.PI * frequency / k;
 
-        RealArray ptsIm = ((ptsX.clone().uPow(2.0)).eAdd(ptsY.clone().uPow(2.0))).uPow(0.5).uMul(b);
+        RealArray ptsIm = ptsX.ePow(2.0).eAdd(ptsY.ePow(2.0)).uPow(0.5).uMul(b);
 
         (ptsRe.tocRe()).eAdd(ptsIm.tocIm()).uExp().map(this, 0, 0, size(0), 0, 0, size(1), 0, 0, 2);
     }
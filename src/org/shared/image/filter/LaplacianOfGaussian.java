@@ -95,7 +95,7 @@ public class LaplacianOfGaussian extends RealArray implements Cacheable {
         RealArray ptsX = ptsMatrix.subarray(1, 2, 0, ptsMatrix.size(1)) //
                 .reshape(2 * supportRadius + 1, 2 * supportRadius + 1);
 
-        ptsX.clone().uSqr().eAdd(ptsY.clone().uSqr()) //
+        ptsX.eSqr().eAdd(ptsY.eSqr()) //
                 .uAdd(-2.0 * sigma * sigma) //
                 .uMul(1.0 / (sigma * sigma * sigma * sigma)) //
                 .eMul(new DerivativeOfGaussian(supportRadius, 0.0, 1.0, 0)) //
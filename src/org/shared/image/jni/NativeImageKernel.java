@@ -57,4 +57,47 @@ public class NativeImageKernel implements ImageKernel {
     final public native void createIntegralHistogram( //
             double[] srcV, int[] srcD, int[] srcS, int[] memV, //
             double[] dstV, int[] dstD, int[] dstS);
+
+    @Override
+    final public native void createIntegralMoments( //
+            int[] types, double[] xV, double[] yV, int[] srcD, int[] srcS, //
+            double[] dstV, int[] dstD, int[] dstS);
+
+    @Override
+    final public native void localMeanVariance( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, //
+            double[] meanV, double[] varV);
+
+    @Override
+    final public native void guidedFilter( //
+            double[] guideV, double[] srcV, int[] srcD, int[] srcS, int[] radii, double epsilon, //
+            double[] dstV);
+
+    @Override
+    final public native void normalizedCrossCorrelation( //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] tplV, int[] tplD, int[] tplS, //
+            double[] dstV, int[] dstD, int[] dstS);
+
+    @Override
+    final public native int[] findPeaks( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, double threshold, int minDistance);
+
+    @Override
+    final public native void mapCoordinates(int interpolation, int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] coordsV, double[] dstV, boolean complex);
+
+    @Override
+    final public native void splineCoefficients(int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] dstV, boolean complex);
+
+    @Override
+    final public native void bilateralFilter(double[] srcV, int[] srcD, int[] srcS, double[] sigmas, double[] dstV);
+
+    @Override
+    final public native void waveletTransform(int wavelet, int nLevels, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            boolean inverse);
 }
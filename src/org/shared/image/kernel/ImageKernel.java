@@ -37,6 +37,74 @@ import org.shared.util.Service;
  */
 public interface ImageKernel extends Service {
 
+    /** Integral moment of the primary values. */
+    final public static int IM_X = 0;
+
+    /** Integral moment of the squared primary values. */
+    final public static int IM_XX = 1;
+
+    /** Integral moment of the secondary values. */
+    final public static int IM_Y = 2;
+
+    /** Integral moment of the squared secondary values. */
+    final public static int IM_YY = 3;
+
+    /** Integral moment of the products of primary and secondary values. */
+    final public static int IM_XY = 4;
+
+    /** Interpolation by nearest neighbor. */
+    final public static int IP_NEAREST = 0;
+
+    /** Interpolation by multilinear weighting. */
+    final public static int IP_LINEAR = 1;
+
+    /** Interpolation by cubic B-spline, with coefficients computed from the source. */
+    final public static int IP_CUBIC = 2;
+
+    /** Interpolation by cubic B-spline, with the source already holding coefficients. */
+    final public static int IP_SPLINE = 3;
+
+    /** Boundary mode extending with a constant. */
+    final public static int BM_CONSTANT = 0;
+
+    /** Boundary mode extending with the nearest edge value. */
+    final public static int BM_NEAREST = 1;
+
+    /** Boundary mode extending by half-sample symmetric reflection. */
+    final public static int BM_REFLECT = 2;
+
+    /** Boundary mode extending periodically. */
+    final public static int BM_WRAP = 3;
+
+    /** The Haar wavelet. */
+    final public static int WT_HAAR = 0;
+
+    /** The Daubechies wavelet with 2 vanishing moments. */
+    final public static int WT_DB2 = 1;
+
+    /** The Daubechies wavelet with 3 vanishing moments. */
+    final public static int WT_DB3 = 2;
+
+    /** The Daubechies wavelet with 4 vanishing moments. */
+    final public static int WT_DB4 = 3;
+
+    /** The Daubechies wavelet with 5 vanishing moments. */
+    final public static int WT_DB5 = 4;
+
+    /** The Daubechies wavelet with 6 vanishing moments. */
+    final public static int WT_DB6 = 5;
+
+    /** The Daubechies wavelet with 7 vanishing moments. */
+    final public static int WT_DB7 = 6;
+
+    /** The Daubechies wavelet with 8 vanishing moments. */
+    final public static int WT_DB8 = 7;
+
+    /** The Cohen-Daubechies-Feauveau 9/7 biorthogonal wavelet. */
+    final public static int WT_CDF97 = 8;
+
+    //
+
     /**
      * Creates an integral image.
      * 
@@ -78,4 +146,219 @@ public interface ImageKernel extends Service {
     public void createIntegralHistogram( //
             double[] srcV, int[] srcD, int[] srcS, int[] memV, //
             double[] dstV, int[] dstD, int[] dstS);
+
+    /**
+     * Creates integral images of multiple moments in a single pass.
+     * 
+     * @param types
+     *            the moment types.
+     * @param xV
+     *            the primary values.
+     * @param yV
+     *            the secondary values, or {@code null} if no moment requires them.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     */
+    public void createIntegralMoments( //
+            int[] types, double[] xV, double[] yV, int[] srcD, int[] srcS, //
+            double[] dstV, int[] dstD, int[] dstS);
+
+    /**
+     * Computes local means and variances over box windows clipped at the borders.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param radii
+     *            the window radii.
+     * @param meanV
+     *            the local means.
+     * @param varV
+     *            the local variances.
+     */
+    public void localMeanVariance( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, //
+            double[] meanV, double[] varV);
+
+    /**
+     * Applies the guided filter.
+     * 
+     * @param guideV
+     *            the guide values.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param radii
+     *            the window radii.
+     * @param epsilon
+     *            the regularization parameter.
+     * @param dstV
+     *            the destination values.
+     */
+    public void guidedFilter( //
+            double[] guideV, double[] srcV, int[] srcD, int[] srcS, int[] radii, double epsilon, //
+            double[] dstV);
+
+    /**
+     * Computes the normalized cross-correlation of a template against every position where it fits entirely inside the
+     * source. Small templates are correlated directly, at a cost proportional to the product of the template and
+     * output sizes. Once that exceeds the cost of transforms over the source, correlation moves to the frequency
+     * domain, by way of FFTW when it is available and a portable FFT otherwise.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param tplV
+     *            the template values.
+     * @param tplD
+     *            the template dimensions.
+     * @param tplS
+     *            the template strides.
+     * @param dstV
+     *            the destination values.
+     * @param dstD
+     *            the destination dimensions.
+     * @param dstS
+     *            the destination strides.
+     */
+    public void normalizedCrossCorrelation( //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] tplV, int[] tplD, int[] tplS, //
+            double[] dstV, int[] dstD, int[] dstS);
+
+    /**
+     * Finds local peaks, which are values at least the threshold and no less than every other value in their box
+     * windows. Peaks are then visited in order of decreasing value, and any peak closer than the minimum distance, in
+     * the maximum norm, to an earlier accepted peak is suppressed.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param radii
+     *            the window radii.
+     * @param threshold
+     *            the threshold.
+     * @param minDistance
+     *            the minimum distance between peaks.
+     * @return the row-major logical indices of the peaks, in order of decreasing value.
+     */
+    public int[] findPeaks( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, double threshold, int minDistance);
+
+    /**
+     * Interpolates values at arbitrary coordinates. The source is treated as extended indefinitely by the boundary
+     * mode.
+     * 
+     * @param interpolation
+     *            the interpolation type.
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the constant for {@link #BM_CONSTANT}, which applies only to real parts of complex values.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param coordsV
+     *            the coordinates, stored contiguously one point at a time.
+     * @param dstV
+     *            the destination values, stored contiguously one point at a time.
+     * @param complex
+     *            whether the values are complex, in which case the last source dimension holds real and imaginary
+     *            parts and isn't interpolated over.
+     */
+    public void mapCoordinates(int interpolation, int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] coordsV, double[] dstV, boolean complex);
+
+    /**
+     * Computes cubic B-spline coefficients for later use with {@link #IP_SPLINE}.
+     * 
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the constant for {@link #BM_CONSTANT}, which applies only to real parts of complex values.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param dstV
+     *            the destination values, which share the source dimensions and strides.
+     * @param complex
+     *            whether the values are complex.
+     */
+    public void splineCoefficients(int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] dstV, boolean complex);
+
+    /**
+     * Applies an approximate bilateral filter whose cost is linear in the number of pixels, regardless of the spatial
+     * standard deviations. Single-channel values are splatted onto a bilateral grid sampled at the standard deviations,
+     * which takes {@code 2} doubles for each of the {@code prod_k (floor((n_k - 1) / s_k) + 4)} cells, where the range
+     * dimension spans the finite values. Multi-channel values are splatted onto a permutohedral lattice over the
+     * {@code d} spatial and channel features, which takes at most {@code (d + 1)} lattice points per pixel, each holding
+     * {@code d} integers and {@code 2 (c + 1)} doubles for {@code c} channels. Non-finite values pass through and don't
+     * contribute.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param sigmas
+     *            the spatial standard deviations followed by the range standard deviation. If there is one fewer
+     *            spatial standard deviation than dimensions, the last dimension holds channels.
+     * @param dstV
+     *            the destination values, which share the source dimensions and strides.
+     */
+    public void bilateralFilter(double[] srcV, int[] srcD, int[] srcS, double[] sigmas, double[] dstV);
+
+    /**
+     * Applies a multilevel, separable discrete wavelet transform or its inverse in place by way of lifting. At each
+     * level, every dimension of the current approximation region, of size {@code n}, is split into {@code ceil(n / 2)}
+     * approximation coefficients followed by {@code floor(n / 2)} detail coefficients, and the next level recurses into
+     * the leading corner. Lifting steps extend each channel symmetrically past its ends, so that the transform is
+     * perfectly invertible for all sizes.
+     * 
+     * @param wavelet
+     *            the wavelet.
+     * @param nLevels
+     *            the number of levels.
+     * @param srcV
+     *            the source values.
+     * @param srcD
+     *            the source dimensions.
+     * @param srcS
+     *            the source strides.
+     * @param inverse
+     *            whether to apply the inverse transform.
+     */
+    public void waveletTransform(int wavelet, int nLevels, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            boolean inverse);
 }
@@ -29,8 +29,11 @@
 package org.shared.image.kernel;
 
 import java.util.Arrays;
+import java.util.Comparator;
 
+import org.shared.array.ArrayBase;
 import org.shared.array.kernel.MappingOps;
+import org.shared.util.Arithmetic;
 import org.shared.util.Control;
 
 /**
@@ -45,6 +48,115 @@ public class ImageOps {
      */
     public static ModalImageKernel imKernel = new ModalImageKernel();
 
+    /**
+     * The pole of the cubic B-spline prefilter.
+     */
+    final protected static double SPLINE_POLE = Math.sqrt(3.0) - 2.0;
+
+    /**
+     * The number of samples past which the influence of the prefilter's initial conditions drops below machine
+     * precision.
+     */
+    final protected static int SPLINE_HORIZON = 28;
+
+    /**
+     * The coordinate magnitude past which coordinates are clamped to avoid integer overflow.
+     */
+    final protected static double COORDINATE_LIMIT = 1 << 30;
+
+    /**
+     * The number of padding cells on either side of each bilateral grid dimension.
+     */
+    final protected static int GRID_PADDING = 1;
+
+    /**
+     * Lifting schemes, one per wavelet. Each begins with the scale factors of the even and odd channels and the number
+     * of steps, which follow as (channel, first offset, number of taps, taps). Channel 0 means that the even channel is
+     * updated from the odd channel, and channel 1 means the reverse. The Daubechies schemes come from Euclidean
+     * factorizations of the polyphase matrices of the minimum phase filters.
+     */
+    final protected static double[][] LIFTING_SCHEMES = new double[][] {
+            //
+            // Haar
+            new double[] {
+                1.4142135623730951, 0.7071067811865475, 2, //
+                1, 0, 1, -1.0, //
+                0, 0, 1, 0.5 },
+            // Daubechies 2
+            new double[] {
+                1.9318516525781366, 0.5176380902050415, 3, //
+                1, 0, 1, -1.7320508075688772, //
+                0, 0, 2, 0.4330127018922193, -0.06698729810778067, //
+                1, -1, 1, 1.0 },
+            // Daubechies 3
+            new double[] {
+                1.0475237291258894, 0.9546323125629376, 5, //
+                1, 0, 1, 0.41228659505180554, //
+                0, -1, 2, -0.46675694679423824, -0.35238765767485547, //
+                1, 0, 3, -1.0, 0.492151844887739, -0.09542943900975187, //
+                0, 0, 1, 1.0, //
+                1, -2, 3, -0.11619309193636232, 0.0, -1.0 },
+            // Daubechies 4
+            new double[] {
+                0.6829218120354147, 1.4642964719775893, 5, //
+                1, 0, 1, 0.3222758880002811, //
+                0, -1, 2, 1.1171236051162172, -0.29195312600347534, //
+                1, 0, 2, -0.11355149660809287, -0.5400282834197139, //
+                0, 0, 2, 0.5547946968043383, -0.09842349449508443, //
+                1, -1, 1, 0.02145362655440929 },
+            // Daubechies 5
+            new double[] {
+                1.3101844390190502, 0.7632513180729816, 7, //
+                1, 0, 1, 0.26514514281158824, //
+                0, -1, 2, -0.9940591343240417, -0.24772929136032967, //
+                1, 1, 2, 0.5341246460373478, -0.21327429818773413, //
+                0, -3, 2, -0.22473522485729788, 0.7168557193161884, //
+                1, 0, 5, -1.0, 0.0, 0.0, 0.07755333443426865, -0.012132186617261762, //
+                0, 0, 1, 1.0, //
+                1, -4, 5, -0.03576492464588209, 0.0, 0.0, 0.0, -1.0 },
+            // Daubechies 6
+            new double[] {
+                0.9209502755579572, 1.0858349538949328, 7, //
+                1, 0, 1, 0.2255061785637888, //
+                0, -1, 2, 0.7273420740972343, -0.2145934500030082, //
+                1, 0, 2, -0.391113547975628, -0.507005568565545, //
+                0, 0, 2, 0.6595714136346803, -0.2718462593445387, //
+                1, -2, 2, -0.05908637151044026, 0.20512679659260868, //
+                0, 2, 2, 0.08252478647755451, -0.011386511463891974, //
+                1, -3, 1, 0.008191735616131821 },
+            // Daubechies 7
+            new double[] {
+                0.7387553345534635, 1.3536281272397772, 9, //
+                1, 0, 1, 0.19632871258951998, //
+                0, -1, 2, 0.6226081148006308, -0.18904209207199213, //
+                1, 0, 2, 0.9762494930979289, -0.473542027592843, //
+                0, -1, 2, -0.17784841690967768, -0.6554653836458486, //
+                1, 1, 2, 0.6504897597802894, -0.2556344430137497, //
+                0, -3, 2, -0.020183939381539093, 0.07747053174898423, //
+                1, 0, 5, -1.0, 0.0, 0.0, 0.06785481821590963, -0.008324759649383943, //
+                0, 0, 1, 1.0, //
+                1, -4, 5, -0.0024796089094268705, 0.0, 0.0, 0.0, -1.0 },
+            // Daubechies 8
+            new double[] {
+                1.0998205796126963, 0.9092392145927581, 9, //
+                1, 0, 1, 0.17392388386585503, //
+                0, -1, 2, 0.545240042147073, -0.16881724371813134, //
+                1, 0, 2, -0.709599782718359, -0.4399133163852162, //
+                0, 0, 2, 0.6353677588938296, -0.337998430891021, //
+                1, -2, 2, -0.26417387650139024, 0.5578087497857382, //
+                0, 2, 2, 0.18749477001593542, -0.06841128991724878, //
+                1, -4, 2, -0.02370601458932583, 0.10071357518206554, //
+                0, 4, 2, 0.016208171869188496, -0.0017847647755538983, //
+                1, -5, 1, 0.0026113818275875092 },
+            // CDF 9/7
+            new double[] {
+                1.1496043988602445, 0.8698644516247788, 4, //
+                1, 0, 2, -1.586134342059924, -1.586134342059924, //
+                0, -1, 2, -0.052980118572961, -0.052980118572961, //
+                1, 0, 2, 0.882911075530934, 0.882911075530934, //
+                0, -1, 2, 0.443506852043971, 0.443506852043971 }
+    };
+
     /**
      * Creates an index lookup table for speedy index calculations.
      */
@@ -215,6 +327,2286 @@ public class ImageOps {
         }
     }
 
+    /**
+     * Supports {@link JavaImageKernel#createIntegralMoments(int[], double[], double[], int[], int[], double[], int[], int[])}
+     * .
+     */
+    final public static void createIntegralMoments( //
+            int[] types, double[] xV, double[] yV, int[] srcD, int[] srcS, //
+            double[] dstV, int[] dstD, int[] dstS) {
+
+        int nTypes = types.length;
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims == srcS.length //
+                && nDims + 1 == dstD.length //
+                && nDims + 1 == dstS.length //
+                && (yV == null || yV.length == xV.length));
+
+        int[] dstDModified = Arrays.copyOf(dstD, nDims);
+        int[] dstSModified = Arrays.copyOf(dstS, nDims);
+
+        int srcLen = MappingOps.checkDimensions(xV.length, srcD, srcS);
+        int dstLen = MappingOps.checkDimensions(dstV.length, dstD, dstS);
+
+        Control.checkTrue(dstD[nDims] == nTypes, //
+                "Dimension mismatch");
+
+        for (int type : types) {
+
+            switch (type) {
+
+            case ImageKernel.IM_X:
+            case ImageKernel.IM_XX:
+                break;
+
+            case ImageKernel.IM_Y:
+            case ImageKernel.IM_YY:
+            case ImageKernel.IM_XY:
+                Control.checkTrue(yV != null, //
+                        "Secondary values required");
+                break;
+
+            default:
+                throw new IllegalArgumentException();
+            }
+        }
+
+        int dstOffset = 0;
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            Control.checkTrue(srcD[dim] + 1 == dstD[dim], //
+                    "Dimension mismatch");
+
+            dstOffset += dstS[dim];
+        }
+
+        if (srcLen == 0 || nTypes == 0) {
+            return;
+        }
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        int[] dstIndices = MappingOps.assignMappingIndices(srcLen, srcD, dstSModified);
+
+        int typeStride = dstS[nDims];
+        int dstLenModified = dstLen / nTypes;
+
+        // Scatter every requested moment while each source value is at hand.
+        for (int i = 0; i < srcLen; i++) {
+
+            double x = xV[srcIndices[i]];
+            double y = (yV != null) ? yV[srcIndices[i]] : 0.0;
+
+            for (int typeIndex = 0, physical = dstIndices[i] + dstOffset; //
+            typeIndex < nTypes; //
+            typeIndex++, physical += typeStride) {
+
+                switch (types[typeIndex]) {
+
+                case ImageKernel.IM_X:
+                    dstV[physical] = x;
+                    break;
+
+                case ImageKernel.IM_XX:
+                    dstV[physical] = x * x;
+                    break;
+
+                case ImageKernel.IM_Y:
+                    dstV[physical] = y;
+                    break;
+
+                case ImageKernel.IM_YY:
+                    dstV[physical] = y * y;
+                    break;
+
+                case ImageKernel.IM_XY:
+                    dstV[physical] = x * y;
+                    break;
+                }
+            }
+        }
+
+        //
+
+        dstIndices = MappingOps.assignMappingIndices(dstLenModified, dstDModified, dstSModified);
+
+        for (int dim = 0, indexBlockIncrement = dstLenModified; //
+        dim < nDims; //
+        indexBlockIncrement /= dstDModified[dim++]) {
+
+            int size = dstDModified[dim];
+            int stride = dstSModified[dim];
+
+            for (int lower = 0, upper = indexBlockIncrement / size; //
+            lower < dstLenModified; //
+            lower += indexBlockIncrement, upper += indexBlockIncrement) {
+
+                for (int indexIndex = lower; indexIndex < upper; indexIndex++) {
+
+                    for (int typeIndex = 0, typeOffset = 0; typeIndex < nTypes; typeIndex++, typeOffset += typeStride) {
+
+                        double acc = 0.0;
+
+                        for (int k = 0, physical = dstIndices[indexIndex] + typeOffset; //
+                        k < size; //
+                        k++, physical += stride) {
+
+                            acc += dstV[physical];
+                            dstV[physical] = acc;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Supports {@link JavaImageKernel#localMeanVariance(double[], int[], int[], int[], double[], double[])}.
+     */
+    final public static void localMeanVariance( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, //
+            double[] meanV, double[] varV) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims > 0 //
+                && nDims == srcS.length //
+                && nDims == radii.length //
+                && srcV.length == meanV.length //
+                && srcV.length == varV.length);
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        for (int radius : radii) {
+            Control.checkTrue(radius >= 0, //
+                    "Invalid radius");
+        }
+
+        if (srcLen == 0) {
+            return;
+        }
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        double[] moments = new double[2 * srcLen];
+
+        // Center the values first so that the sum of squares doesn't swamp the squared sum.
+        double shift = 0.0;
+
+        for (int i = 0; i < srcLen; i++) {
+            shift += srcV[i];
+        }
+
+        shift /= srcLen;
+
+        for (int i = 0; i < srcLen; i++) {
+
+            double x = srcV[srcIndices[i]] - shift;
+
+            moments[2 * i] = x;
+            moments[2 * i + 1] = x * x;
+        }
+
+        boxMeans(moments, moments, srcD, radii, 2);
+
+        for (int i = 0; i < srcLen; i++) {
+
+            double mean = moments[2 * i];
+            double var = moments[2 * i + 1] - mean * mean;
+
+            meanV[srcIndices[i]] = mean + shift;
+            varV[srcIndices[i]] = Math.max(var, 0.0);
+        }
+    }
+
+    /**
+     * Supports {@link JavaImageKernel#guidedFilter(double[], double[], int[], int[], int[], double, double[])}.
+     */
+    final public static void guidedFilter( //
+            double[] guideV, double[] srcV, int[] srcD, int[] srcS, int[] radii, double epsilon, //
+            double[] dstV) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims > 0 //
+                && nDims == srcS.length //
+                && nDims == radii.length //
+                && srcV.length == guideV.length //
+                && srcV.length == dstV.length //
+                && epsilon > 0.0);
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        for (int radius : radii) {
+            Control.checkTrue(radius >= 0, //
+                    "Invalid radius");
+        }
+
+        if (srcLen == 0) {
+            return;
+        }
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        double[] tables = new double[4 * srcLen];
+
+        // The coefficients are invariant to shifts of the guide, and the output shifts with the source.
+        double guideShift = 0.0;
+        double srcShift = 0.0;
+
+        for (int i = 0; i < srcLen; i++) {
+
+            guideShift += guideV[i];
+            srcShift += srcV[i];
+        }
+
+        guideShift /= srcLen;
+        srcShift /= srcLen;
+
+        for (int i = 0; i < srcLen; i++) {
+
+            double g = guideV[srcIndices[i]] - guideShift;
+            double p = srcV[srcIndices[i]] - srcShift;
+
+            tables[4 * i] = g;
+            tables[4 * i + 1] = p;
+            tables[4 * i + 2] = g * g;
+            tables[4 * i + 3] = g * p;
+        }
+
+        boxMeans(tables, tables, srcD, radii, 4);
+
+        // Compact the linear coefficients into the front of the buffer; reads stay ahead of writes.
+        for (int i = 0; i < srcLen; i++) {
+
+            double meanG = tables[4 * i];
+            double meanP = tables[4 * i + 1];
+            double varG = Math.max(tables[4 * i + 2] - meanG * meanG, 0.0);
+            double covGp = tables[4 * i + 3] - meanG * meanP;
+
+            double a = covGp / (varG + epsilon);
+
+            tables[2 * i] = a;
+            tables[2 * i + 1] = meanP - a * meanG;
+        }
+
+        boxMeans(tables, tables, srcD, radii, 2);
+
+        for (int i = 0; i < srcLen; i++) {
+
+            double g = guideV[srcIndices[i]] - guideShift;
+
+            dstV[srcIndices[i]] = tables[2 * i] * g + tables[2 * i + 1] + srcShift;
+        }
+    }
+
+    /**
+     * Supports
+     * {@link JavaImageKernel#normalizedCrossCorrelation(double[], int[], int[], double[], int[], int[], double[], int[], int[])}
+     * .
+     */
+    final public static void normalizedCrossCorrelation( //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] tplV, int[] tplD, int[] tplS, //
+            double[] dstV, int[] dstD, int[] dstS) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims > 0 //
+                && nDims == srcS.length //
+                && nDims == tplD.length //
+                && nDims == tplS.length //
+                && nDims == dstD.length //
+                && nDims == dstS.length);
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            Control.checkTrue(tplD[dim] > 0 && tplD[dim] <= srcD[dim], //
+                    "Invalid template dimensions");
+
+            Control.checkTrue(srcD[dim] - tplD[dim] + 1 == dstD[dim], //
+                    "Dimension mismatch");
+        }
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+        int tplLen = MappingOps.checkDimensions(tplV.length, tplD, tplS);
+        int dstLen = MappingOps.checkDimensions(dstV.length, dstD, dstS);
+
+        int srcLast = srcD[nDims - 1];
+        int tplLast = tplD[nDims - 1];
+        int dstLast = dstD[nDims - 1];
+        int nTplRows = tplLen / tplLast;
+        int nDstRows = dstLen / dstLast;
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        int[] tplIndices = MappingOps.assignMappingIndices(tplLen, tplD, tplS);
+        int[] dstIndices = MappingOps.assignMappingIndices(dstLen, dstD, dstS);
+
+        int[] rowStrides = new int[nDims];
+        int[] tablesD = new int[nDims];
+        int[] lower = new int[nDims];
+        int[] upper = tplD.clone();
+
+        for (int dim = nDims - 1, stride = 1; dim >= 0; stride *= srcD[dim--]) {
+
+            rowStrides[dim] = stride;
+            tablesD[dim] = srcD[dim] + 1;
+        }
+
+        // Offsets of template rows, as they would lie in the source.
+        int[] tplRowOffsets = new int[nTplRows];
+
+        for (int row = 0; row < nTplRows; row++) {
+
+            int offset = 0;
+
+            for (int dim = nDims - 2, rem = row; dim >= 0; rem /= tplD[dim--]) {
+                offset += (rem % tplD[dim]) * rowStrides[dim];
+            }
+
+            tplRowOffsets[row] = offset;
+        }
+
+        // Center the source and template. The former doesn't change the numerators, since the template sums to zero.
+        double srcShift = 0.0;
+        double tplShift = 0.0;
+
+        for (int i = 0; i < srcLen; i++) {
+            srcShift += srcV[i];
+        }
+
+        for (int i = 0; i < tplLen; i++) {
+            tplShift += tplV[i];
+        }
+
+        srcShift /= srcLen;
+        tplShift /= tplLen;
+
+        double[] srcBuf = new double[srcLen];
+        double[] moments = new double[2 * srcLen];
+        double[] tplBuf = new double[tplLen];
+
+        double srcNorm = 0.0;
+        double tplNorm = 0.0;
+
+        for (int i = 0; i < srcLen; i++) {
+
+            double x = srcV[srcIndices[i]] - srcShift;
+
+            srcBuf[i] = x;
+            moments[2 * i] = x;
+            moments[2 * i + 1] = x * x;
+            srcNorm += x * x;
+        }
+
+        for (int i = 0; i < tplLen; i++) {
+
+            double t = tplV[tplIndices[i]] - tplShift;
+
+            tplBuf[i] = t;
+            tplNorm += t * t;
+        }
+
+        double[] tables = new double[Arithmetic.product(tablesD) * 2];
+        double[] stats = new double[2 * dstLen];
+
+        createIntegralTables(moments, tables, srcD, 2);
+        windowSums(tables, tablesD, stats, dstD, lower, upper, 2, false);
+
+        //
+
+        double[] numerators = new double[dstLen];
+
+        // Correlate in the frequency domain once the direct approach would be substantially more expensive.
+        if ((double) dstLen * tplLen <= 8.0 * srcLen * (Math.log(srcLen) / Math.log(2.0) + 1.0)) {
+
+            // Accumulate along contiguous output rows, one template element at a time.
+            for (int row = 0; row < nDstRows; row++) {
+
+                int base = 0;
+
+                for (int dim = nDims - 2, rem = row; dim >= 0; rem /= dstD[dim--]) {
+                    base += (rem % dstD[dim]) * rowStrides[dim];
+                }
+
+                int accOffset = row * dstLast;
+
+                for (int tplRow = 0; tplRow < nTplRows; tplRow++) {
+
+                    int srcRowOffset = base + tplRowOffsets[tplRow];
+                    int tplRowOffset = tplRow * tplLast;
+
+                    for (int j = 0; j < tplLast; j++) {
+
+                        double t = tplBuf[tplRowOffset + j];
+
+                        for (int k = 0, srcOffset = srcRowOffset + j; k < dstLast; k++) {
+                            numerators[accOffset + k] += t * srcBuf[srcOffset + k];
+                        }
+                    }
+                }
+            }
+
+        } else {
+
+            int spectrumLen = 2 * (srcLen / srcLast) * ((srcLast >>> 1) + 1);
+
+            double[] padded = new double[srcLen];
+            double[] srcSpectrum = new double[spectrumLen];
+            double[] tplSpectrum = new double[spectrumLen];
+
+            for (int tplRow = 0; tplRow < nTplRows; tplRow++) {
+                System.arraycopy(tplBuf, tplRow * tplLast, padded, tplRowOffsets[tplRow], tplLast);
+            }
+
+            ArrayBase.fftService.rfft(srcD, srcBuf, srcSpectrum);
+            ArrayBase.fftService.rfft(srcD, padded, tplSpectrum);
+
+            for (int i = 0; i < spectrumLen; i += 2) {
+
+                double re1 = srcSpectrum[i];
+                double im1 = srcSpectrum[i + 1];
+                double re2 = tplSpectrum[i];
+                double im2 = tplSpectrum[i + 1];
+
+                srcSpectrum[i] = re1 * re2 + im1 * im2;
+                srcSpectrum[i + 1] = im1 * re2 - re1 * im2;
+            }
+
+            ArrayBase.fftService.rifft(srcD, srcSpectrum, padded);
+
+            // Only positions where the template doesn't wrap around are kept.
+            for (int row = 0; row < nDstRows; row++) {
+
+                int base = 0;
+
+                for (int dim = nDims - 2, rem = row; dim >= 0; rem /= dstD[dim--]) {
+                    base += (rem % dstD[dim]) * rowStrides[dim];
+                }
+
+                System.arraycopy(padded, base, numerators, row * dstLast, dstLast);
+            }
+        }
+
+        //
+
+        // Treat windows with negligible variance relative to the whole source as flat.
+        double varianceFloor = 1e-12 * tplLen * (srcNorm / srcLen);
+
+        for (int i = 0; i < dstLen; i++) {
+
+            double sum = stats[2 * i];
+            double variance = stats[2 * i + 1] - sum * sum / tplLen;
+
+            double score = (variance > varianceFloor && tplNorm > 0.0) //
+            ? numerators[i] / Math.sqrt(variance * tplNorm) : 0.0;
+
+            dstV[dstIndices[i]] = Math.max(Math.min(score, 1.0), -1.0);
+        }
+    }
+
+    /**
+     * Supports {@link JavaImageKernel#findPeaks(double[], int[], int[], int[], double, int)}.
+     */
+    final public static int[] findPeaks( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, double threshold, int minDistance) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims > 0 //
+                && nDims == srcS.length //
+                && nDims == radii.length);
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        for (int radius : radii) {
+            Control.checkTrue(radius >= 0, //
+                    "Invalid radius");
+        }
+
+        Control.checkTrue(minDistance >= 0, //
+                "Invalid minimum distance");
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        final double[] values = new double[srcLen];
+        double[] maxima = new double[srcLen];
+
+        // NaNs can neither be peaks nor mask their neighbors.
+        for (int i = 0; i < srcLen; i++) {
+
+            double value = srcV[srcIndices[i]];
+
+            values[i] = maxima[i] = !Double.isNaN(value) ? value : Double.NEGATIVE_INFINITY;
+        }
+
+        boxMaxima(maxima, srcD, radii);
+
+        // Flag the candidates, and then compact them by way of an exclusive prefix sum.
+        int[] offsets = new int[srcLen + 1];
+
+        for (int i = 0; i < srcLen; i++) {
+
+            double value = values[i];
+
+            offsets[i + 1] = offsets[i] //
+                    + ((value >= threshold && value >= maxima[i] && value > Double.NEGATIVE_INFINITY) ? 1 : 0);
+        }
+
+        int nCandidates = offsets[srcLen];
+        Integer[] candidates = new Integer[nCandidates];
+
+        for (int i = 0; i < srcLen; i++) {
+
+            if (offsets[i + 1] != offsets[i]) {
+                candidates[offsets[i]] = i;
+            }
+        }
+
+        // A stable sort keeps ties in row-major order.
+        Arrays.sort(candidates, new Comparator<Integer>() {
+
+            @Override
+            public int compare(Integer a, Integer b) {
+                return Double.compare(values[b], values[a]);
+            }
+        });
+
+        int[] res = new int[nCandidates];
+        int nPeaks = 0;
+
+        if (minDistance > 1) {
+
+            boolean[] suppressed = new boolean[srcLen];
+            int[] strides = new int[nDims];
+            int[] coords = new int[nDims];
+            int[] lower = new int[nDims];
+            int[] upper = new int[nDims];
+
+            strides[nDims - 1] = 1;
+
+            for (int dim = nDims - 1; dim > 0; dim--) {
+                strides[dim - 1] = strides[dim] * srcD[dim];
+            }
+
+            for (int index : candidates) {
+
+                if (suppressed[index]) {
+                    continue;
+                }
+
+                res[nPeaks++] = index;
+
+                // Suppress everything strictly within the minimum distance.
+                for (int dim = 0, rem = index; dim < nDims; dim++) {
+
+                    int coord = rem / strides[dim];
+
+                    rem %= strides[dim];
+
+                    lower[dim] = Math.max(coord - minDistance + 1, 0);
+                    upper[dim] = Math.min(coord + minDistance, srcD[dim]);
+                    coords[dim] = lower[dim];
+                }
+
+                for (boolean done = false; !done;) {
+
+                    int offset = 0;
+
+                    for (int dim = 0; dim < nDims; dim++) {
+                        offset += coords[dim] * strides[dim];
+                    }
+
+                    for (int j = 0, size = upper[nDims - 1] - lower[nDims - 1]; j < size; j++) {
+                        suppressed[offset + j] = true;
+                    }
+
+                    int dim = nDims - 2;
+
+                    for (; dim >= 0 && ++coords[dim] == upper[dim]; dim--) {
+                        coords[dim] = lower[dim];
+                    }
+
+                    done = (dim < 0);
+                }
+            }
+
+        } else {
+
+            for (int index : candidates) {
+                res[nPeaks++] = index;
+            }
+        }
+
+        return Arrays.copyOf(res, nPeaks);
+    }
+
+    /**
+     * Supports
+     * {@link JavaImageKernel#mapCoordinates(int, int, double, double[], int[], int[], double[], double[], boolean)}.
+     */
+    final public static void mapCoordinates(int interpolation, int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] coordsV, double[] dstV, boolean complex) {
+
+        int nDims = srcD.length;
+        int nChannels = complex ? 2 : 1;
+        int nCoordDims = complex ? nDims - 1 : nDims;
+
+        Control.checkTrue(nCoordDims > 0 //
+                && nDims == srcS.length //
+                && coordsV.length % nCoordDims == 0 //
+                && coordsV.length / nCoordDims * nChannels == dstV.length);
+
+        checkInterpolation(interpolation, boundary);
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        Control.checkTrue(!complex || srcD[nDims - 1] == 2, //
+                "Invalid dimensions");
+
+        int nPoints = coordsV.length / nCoordDims;
+
+        if (nPoints == 0) {
+            return;
+        }
+
+        Control.checkTrue(srcLen > 0, //
+                "Invalid dimensions");
+
+        if (interpolation == ImageKernel.IP_CUBIC) {
+
+            // Compute spline coefficients over a row-major copy of the source.
+            int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+            double[] coefficients = new double[srcLen];
+            int[] strides = new int[nCoordDims];
+
+            for (int i = 0; i < srcLen; i++) {
+                coefficients[i] = srcV[srcIndices[i]];
+            }
+
+            strides[nCoordDims - 1] = nChannels;
+
+            for (int dim = nCoordDims - 1; dim > 0; dim--) {
+                strides[dim - 1] = strides[dim] * srcD[dim];
+            }
+
+            prefilter(coefficients, Arrays.copyOf(srcD, nCoordDims), nChannels, boundary, cval);
+            interpolate(coefficients, srcD, strides, nCoordDims, nChannels, 1, //
+                    coordsV, dstV, nPoints, //
+                    ImageKernel.IP_SPLINE, boundary, cval);
+
+        } else {
+
+            interpolate(srcV, srcD, srcS, nCoordDims, nChannels, complex ? srcS[nDims - 1] : 0, //
+                    coordsV, dstV, nPoints, //
+                    interpolation, boundary, cval);
+        }
+    }
+
+    /**
+     * Supports {@link JavaImageKernel#splineCoefficients(int, double, double[], int[], int[], double[], boolean)}.
+     */
+    final public static void splineCoefficients(int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] dstV, boolean complex) {
+
+        int nDims = srcD.length;
+        int nChannels = complex ? 2 : 1;
+        int nCoordDims = complex ? nDims - 1 : nDims;
+
+        Control.checkTrue(nCoordDims > 0 //
+                && nDims == srcS.length //
+                && srcV.length == dstV.length);
+
+        checkInterpolation(ImageKernel.IP_SPLINE, boundary);
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        Control.checkTrue(!complex || srcD[nDims - 1] == 2, //
+                "Invalid dimensions");
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        double[] coefficients = new double[srcLen];
+
+        for (int i = 0; i < srcLen; i++) {
+            coefficients[i] = srcV[srcIndices[i]];
+        }
+
+        prefilter(coefficients, Arrays.copyOf(srcD, nCoordDims), nChannels, boundary, cval);
+
+        for (int i = 0; i < srcLen; i++) {
+            dstV[srcIndices[i]] = coefficients[i];
+        }
+    }
+
+    /**
+     * Supports {@link JavaImageKernel#bilateralFilter(double[], int[], int[], double[], double[])}.
+     */
+    final public static void bilateralFilter(double[] srcV, int[] srcD, int[] srcS, double[] sigmas, double[] dstV) {
+
+        int nDims = srcD.length;
+        int nSpatialDims = sigmas.length - 1;
+
+        Control.checkTrue(nDims > 0 //
+                && nDims == srcS.length //
+                && (nSpatialDims == nDims || nSpatialDims == nDims - 1) //
+                && srcV.length == dstV.length);
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        for (int dim = 0; dim <= nSpatialDims; dim++) {
+            Control.checkTrue(sigmas[dim] > 0.0 && sigmas[dim] < Double.POSITIVE_INFINITY, //
+                    "Invalid standard deviation");
+        }
+
+        if (srcLen == 0) {
+            return;
+        }
+
+        int[] spatialD = Arrays.copyOf(srcD, nSpatialDims);
+        int nChannels = srcLen / Arithmetic.product(spatialD);
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        double[] values = new double[srcLen];
+        double[] filtered = new double[srcLen];
+
+        for (int i = 0; i < srcLen; i++) {
+            values[i] = srcV[srcIndices[i]];
+        }
+
+        if (nChannels == 1) {
+
+            bilateralGrid(values, filtered, spatialD, sigmas, sigmas[nSpatialDims]);
+
+        } else {
+
+            bilateralLattice(values, filtered, spatialD, nChannels, sigmas, sigmas[nSpatialDims]);
+        }
+
+        for (int i = 0; i < srcLen; i++) {
+            dstV[srcIndices[i]] = filtered[i];
+        }
+    }
+
+    /**
+     * Supports {@link JavaImageKernel#waveletTransform(int, int, double[], int[], int[], boolean)}.
+     */
+    final public static void waveletTransform(int wavelet, int nLevels, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            boolean inverse) {
+
+        int nDims = srcD.length;
+
+        Control.checkTrue(nDims > 0 //
+                && nDims == srcS.length);
+
+        Control.checkTrue(wavelet >= ImageKernel.WT_HAAR && wavelet <= ImageKernel.WT_CDF97, //
+                "Wavelet not recognized");
+
+        Control.checkTrue(nLevels >= 0, //
+                "Invalid number of levels");
+
+        int srcLen = MappingOps.checkDimensions(srcV.length, srcD, srcS);
+
+        if (srcLen == 0) {
+            return;
+        }
+
+        // Levels past the point where every dimension has collapsed to one leave the values unchanged.
+        int maxSize = 1;
+
+        for (int dim = 0; dim < nDims; dim++) {
+            maxSize = Math.max(maxSize, srcD[dim]);
+        }
+
+        int nEffectiveLevels = 0;
+
+        for (; nEffectiveLevels < nLevels && maxSize > 1; nEffectiveLevels++) {
+            maxSize = (maxSize + 1) >> 1;
+        }
+
+        int[] srcIndices = MappingOps.assignMappingIndices(srcLen, srcD, srcS);
+        double[] values = new double[srcLen];
+        double[] region = new double[srcLen];
+        double[] work = new double[srcLen];
+        int[][] levelDims = new int[nEffectiveLevels + 1][];
+
+        for (int i = 0; i < srcLen; i++) {
+            values[i] = srcV[srcIndices[i]];
+        }
+
+        levelDims[0] = srcD.clone();
+
+        for (int level = 1; level <= nEffectiveLevels; level++) {
+
+            levelDims[level] = new int[nDims];
+
+            for (int dim = 0; dim < nDims; dim++) {
+                levelDims[level][dim] = (levelDims[level - 1][dim] + 1) >> 1;
+            }
+        }
+
+        double[] scheme = LIFTING_SCHEMES[wavelet];
+
+        for (int i = 0; i < nEffectiveLevels; i++) {
+
+            int[] dims = levelDims[!inverse ? i : nEffectiveLevels - 1 - i];
+            int regionLen = Arithmetic.product(dims);
+
+            copyRegion(values, region, srcD, dims, true);
+
+            for (int j = 0; j < nDims; j++) {
+
+                int dim = !inverse ? j : nDims - 1 - j;
+                int size = dims[dim];
+                int blockSize = Arithmetic.product(Arrays.copyOfRange(dims, dim, nDims));
+
+                if (size < 2) {
+                    continue;
+                }
+
+                for (int offset = 0; offset < regionLen; offset += blockSize) {
+                    liftLines(region, offset, work, size, blockSize / size, scheme, inverse);
+                }
+            }
+
+            copyRegion(values, region, srcD, dims, false);
+        }
+
+        for (int i = 0; i < srcLen; i++) {
+            srcV[srcIndices[i]] = values[i];
+        }
+    }
+
+    /**
+     * Integrates interleaved tables stored in row-major order in place.
+     * 
+     * @param values
+     *            the values.
+     * @param dims
+     *            the dimensions.
+     * @param nTables
+     *            the number of interleaved tables.
+     */
+    final public static void integrate(double[] values, int[] dims, int nTables) {
+
+        int nDims = dims.length;
+        int len = Arithmetic.product(dims) * nTables;
+
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+            int size = dims[dim];
+            int rowSize = blockSize / size;
+
+            for (int offset = 0; offset < len; offset += blockSize) {
+
+                for (int k = 1, row = offset + rowSize; k < size; k++, row += rowSize) {
+
+                    for (int i = 0; i < rowSize; i++) {
+                        values[row + i] += values[row - rowSize + i];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Derives window sums from interleaved integral tables stored in row-major order. The window for output position
+     * {@code j} along dimension {@code k} is {@code [j + lower[k], j + upper[k])}, clipped to the source extent.
+     * 
+     * @param srcV
+     *            the integral tables, each of whose dimensions is one more than the extent it covers.
+     * @param srcD
+     *            the integral table dimensions.
+     * @param dstV
+     *            the window sums.
+     * @param dstD
+     *            the window sum dimensions.
+     * @param lower
+     *            the window lower offsets.
+     * @param upper
+     *            the window upper offsets.
+     * @param nTables
+     *            the number of interleaved tables.
+     * @param normalize
+     *            whether to divide sums by window sizes.
+     */
+    final public static void windowSums(double[] srcV, int[] srcD, //
+            double[] dstV, int[] dstD, //
+            int[] lower, int[] upper, int nTables, boolean normalize) {
+
+        int nDims = srcD.length;
+        int[] currentD = srcD.clone();
+
+        double[] in = srcV;
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            int nBlocks = Arithmetic.product(Arrays.copyOf(currentD, dim));
+            int inSize = currentD[dim];
+            int outSize = dstD[dim];
+            int rowSize = Arithmetic.product(Arrays.copyOfRange(currentD, dim + 1, nDims)) * nTables;
+            int extent = inSize - 1;
+
+            double[] out = (dim == nDims - 1) ? dstV : new double[nBlocks * outSize * rowSize];
+
+            for (int block = 0; block < nBlocks; block++) {
+
+                int inBlock = block * inSize * rowSize;
+                int outBlock = block * outSize * rowSize;
+
+                for (int k = 0; k < outSize; k++) {
+
+                    int lo = Math.min(Math.max(k + lower[dim], 0), extent);
+                    int hi = Math.min(Math.max(k + upper[dim], 0), extent);
+
+                    double factor = !normalize ? 1.0 : (hi > lo) ? 1.0 / (hi - lo) : 0.0;
+
+                    for (int i = 0, rowLo = inBlock + lo * rowSize, rowHi = inBlock + hi * rowSize, //
+                    row = outBlock + k * rowSize; i < rowSize; i++) {
+                        out[row + i] = (in[rowHi + i] - in[rowLo + i]) * factor;
+                    }
+                }
+            }
+
+            currentD[dim] = outSize;
+            in = out;
+        }
+    }
+
+    /**
+     * Creates integral tables from interleaved tables stored in row-major order. Each destination dimension is one
+     * more than its source counterpart, with a leading hyperplane of zeros.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param dstV
+     *            the integral tables.
+     * @param dims
+     *            the source dimensions.
+     * @param nTables
+     *            the number of interleaved tables.
+     */
+    final public static void createIntegralTables(double[] srcV, double[] dstV, int[] dims, int nTables) {
+
+        int nDims = dims.length;
+
+        int[] dstD = new int[nDims];
+        int[] dstS = new int[nDims];
+
+        int dstLen = nTables;
+
+        for (int dim = nDims - 1; dim >= 0; dstLen *= dstD[dim--]) {
+
+            dstD[dim] = dims[dim] + 1;
+            dstS[dim] = dstLen;
+        }
+
+        Arrays.fill(dstV, 0, dstLen, 0.0);
+
+        // Copy rows into the interior, leaving a leading hyperplane of zeros along every dimension.
+        int rowSize = dims[nDims - 1] * nTables;
+        int nRows = Arithmetic.product(Arrays.copyOf(dims, nDims - 1));
+
+        for (int row = 0; row < nRows; row++) {
+
+            int offset = dstS[nDims - 1];
+
+            for (int dim = nDims - 2, rem = row; dim >= 0; rem /= dims[dim--]) {
+                offset += (rem % dims[dim] + 1) * dstS[dim];
+            }
+
+            System.arraycopy(srcV, row * rowSize, dstV, offset, rowSize);
+        }
+
+        integrate(dstV, dstD, nTables);
+    }
+
+    /**
+     * Computes box means of interleaved tables stored in row-major order. Windows are clipped at the borders.
+     * 
+     * @param srcV
+     *            the source values.
+     * @param dstV
+     *            the destination values.
+     * @param dims
+     *            the dimensions.
+     * @param radii
+     *            the window radii.
+     * @param nTables
+     *            the number of interleaved tables.
+     */
+    final public static void boxMeans(double[] srcV, double[] dstV, int[] dims, int[] radii, int nTables) {
+
+        int nDims = dims.length;
+
+        int[] tablesD = new int[nDims];
+        int[] lower = new int[nDims];
+        int[] upper = new int[nDims];
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            tablesD[dim] = dims[dim] + 1;
+            lower[dim] = -radii[dim];
+            upper[dim] = radii[dim] + 1;
+        }
+
+        double[] tables = new double[Arithmetic.product(tablesD) * nTables];
+
+        createIntegralTables(srcV, tables, dims, nTables);
+        windowSums(tables, tablesD, dstV, dims, lower, upper, nTables, true);
+    }
+
+    /**
+     * Computes box maxima of values stored in row-major order in place. Windows are clipped at the borders.
+     * 
+     * @param values
+     *            the values.
+     * @param dims
+     *            the dimensions.
+     * @param radii
+     *            the window radii.
+     */
+    final public static void boxMaxima(double[] values, int[] dims, int[] radii) {
+
+        int nDims = dims.length;
+        int len = Arithmetic.product(dims);
+
+        if (len == 0) {
+            return;
+        }
+
+        int bufferLen = 0;
+
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+            bufferLen = Math.max(bufferLen, (blockSize / dims[dim]) * (dims[dim] + 2 * radii[dim]));
+        }
+
+        double[] prefixes = new double[bufferLen];
+        double[] suffixes = new double[bufferLen];
+
+        // The van Herk-Gil-Werman algorithm takes running maxima within blocks of the window width, so that any window
+        // is the union of a suffix of one block and a prefix of the next. Lines are padded with negative infinities and
+        // processed a whole row at a time.
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+            int size = dims[dim];
+            int radius = radii[dim];
+            int rowSize = blockSize / size;
+            int width = 2 * radius + 1;
+            int padded = size + 2 * radius;
+
+            if (radius == 0) {
+                continue;
+            }
+
+            for (int offset = 0; offset < len; offset += blockSize) {
+
+                for (int j = 0, k = -radius; j < padded; j++, k++) {
+
+                    int row = j * rowSize;
+
+                    if (k >= 0 && k < size) {
+
+                        System.arraycopy(values, offset + k * rowSize, suffixes, row, rowSize);
+
+                    } else {
+
+                        Arrays.fill(suffixes, row, row + rowSize, Double.NEGATIVE_INFINITY);
+                    }
+
+                    if (j % width != 0) {
+
+                        for (int i = 0; i < rowSize; i++) {
+                            prefixes[row + i] = Math.max(prefixes[row - rowSize + i], suffixes[row + i]);
+                        }
+
+                    } else {
+
+                        System.arraycopy(suffixes, row, prefixes, row, rowSize);
+                    }
+                }
+
+                for (int j = padded - 2; j >= 0; j--) {
+
+                    if ((j + 1) % width != 0) {
+
+                        for (int i = 0, row = j * rowSize; i < rowSize; i++) {
+                            suffixes[row + i] = Math.max(suffixes[row + i], suffixes[row + rowSize + i]);
+                        }
+                    }
+                }
+
+                for (int k = 0; k < size; k++) {
+
+                    int row = offset + k * rowSize;
+                    int suffix = k * rowSize;
+                    int prefix = (k + 2 * radius) * rowSize;
+
+                    for (int i = 0; i < rowSize; i++) {
+                        values[row + i] = Math.max(suffixes[suffix + i], prefixes[prefix + i]);
+                    }
+                }
+            }
+        }
+    }
+
+
+    /**
+     * Checks that the interpolation type and boundary mode are recognized.
+     * 
+     * @param interpolation
+     *            the interpolation type.
+     * @param boundary
+     *            the boundary mode.
+     */
+    final public static void checkInterpolation(int interpolation, int boundary) {
+
+        switch (interpolation) {
+
+        case ImageKernel.IP_NEAREST:
+        case ImageKernel.IP_LINEAR:
+        case ImageKernel.IP_CUBIC:
+        case ImageKernel.IP_SPLINE:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Interpolation type not recognized");
+        }
+
+        switch (boundary) {
+
+        case ImageKernel.BM_CONSTANT:
+        case ImageKernel.BM_NEAREST:
+        case ImageKernel.BM_REFLECT:
+        case ImageKernel.BM_WRAP:
+            break;
+
+        default:
+            throw new IllegalArgumentException("Boundary mode not recognized");
+        }
+    }
+
+    /**
+     * Maps an index into the extent of a dimension according to a boundary mode.
+     * 
+     * @param index
+     *            the index.
+     * @param size
+     *            the dimension size, which must be positive.
+     * @param boundary
+     *            the boundary mode.
+     * @return the mapped index, or {@code -1} if the index falls on the constant extension.
+     */
+    final public static int boundaryIndex(int index, int size, int boundary) {
+
+        if (index >= 0 && index < size) {
+            return index;
+        }
+
+        switch (boundary) {
+
+        case ImageKernel.BM_CONSTANT:
+            return -1;
+
+        case ImageKernel.BM_NEAREST:
+            return (index < 0) ? 0 : size - 1;
+
+        case ImageKernel.BM_REFLECT:
+
+            index %= 2 * size;
+            index += (index < 0) ? 2 * size : 0;
+
+            return (index < size) ? index : 2 * size - 1 - index;
+
+        case ImageKernel.BM_WRAP:
+
+            index %= size;
+
+            return index + ((index < 0) ? size : 0);
+
+        default:
+            throw new IllegalArgumentException("Boundary mode not recognized");
+        }
+    }
+
+    /**
+     * Converts interleaved channels stored in row-major order into cubic B-spline coefficients in place.
+     * 
+     * @param values
+     *            the values.
+     * @param dims
+     *            the dimensions, not counting the channels.
+     * @param nChannels
+     *            the number of interleaved channels.
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the constant for {@link ImageKernel#BM_CONSTANT}, which applies only to the first channel.
+     */
+    final public static void prefilter(double[] values, int[] dims, int nChannels, int boundary, double cval) {
+
+        int nDims = dims.length;
+        int len = Arithmetic.product(dims) * nChannels;
+
+        if (len == 0) {
+            return;
+        }
+
+        int bufferLen = 0;
+
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+            bufferLen = Math.max(bufferLen, (blockSize / dims[dim]) * (dims[dim] + 2 * SPLINE_HORIZON));
+        }
+
+        double[] buffer = new double[bufferLen];
+
+        double z = SPLINE_POLE;
+        double gain = (1.0 - z) * (1.0 - 1.0 / z);
+
+        // Clamped coordinates never leave the source extent, and so reflection serves just as well.
+        if (boundary == ImageKernel.BM_NEAREST) {
+            boundary = ImageKernel.BM_REFLECT;
+        }
+
+        // Lines are padded with enough of the boundary extension that truncating the recursive filters' initial
+        // conditions is harmless. This way, the coefficients interpolate the source as extended by the boundary mode.
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+            int size = dims[dim];
+            int rowSize = blockSize / size;
+            int padded = size + 2 * SPLINE_HORIZON;
+
+            if (size == 1 && boundary != ImageKernel.BM_CONSTANT) {
+                continue;
+            }
+
+            for (int offset = 0; offset < len; offset += blockSize) {
+
+                for (int j = 0; j < padded; j++) {
+
+                    int k = boundaryIndex(j - SPLINE_HORIZON, size, boundary);
+
+                    if (k >= 0) {
+
+                        System.arraycopy(values, offset + k * rowSize, buffer, j * rowSize, rowSize);
+
+                    } else {
+
+                        for (int i = 0, row = j * rowSize; i < rowSize; i++) {
+                            buffer[row + i] = (i % nChannels != 0) ? 0.0 : cval;
+                        }
+                    }
+                }
+
+                for (int i = rowSize, n = padded * rowSize; i < n; i++) {
+                    buffer[i] += z * buffer[i - rowSize];
+                }
+
+                for (int i = (padded - 1) * rowSize, n = padded * rowSize; i < n; i++) {
+                    buffer[i] = (z / (z * z - 1.0)) * (buffer[i] + z * buffer[i - rowSize]);
+                }
+
+                for (int i = (padded - 1) * rowSize - 1; i >= 0; i--) {
+                    buffer[i] = z * (buffer[i + rowSize] - buffer[i]);
+                }
+
+                for (int k = 0; k < size; k++) {
+
+                    int row = offset + k * rowSize;
+                    int bufferRow = (k + SPLINE_HORIZON) * rowSize;
+
+                    for (int i = 0; i < rowSize; i++) {
+                        values[row + i] = gain * buffer[bufferRow + i];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Interpolates channels at coordinates by nearest neighbor, multilinear weighting, or cubic B-spline coefficients.
+     * 
+     * @param values
+     *            the values.
+     * @param dims
+     *            the dimensions, of which only the leading ones are interpolated over.
+     * @param strides
+     *            the strides.
+     * @param nDims
+     *            the number of dimensions to interpolate over.
+     * @param nChannels
+     *            the number of channels.
+     * @param channelStride
+     *            the channel stride.
+     * @param coords
+     *            the coordinates.
+     * @param dst
+     *            the destination values.
+     * @param nPoints
+     *            the number of points.
+     * @param interpolation
+     *            the interpolation type, which can't require coefficients to be computed.
+     * @param boundary
+     *            the boundary mode.
+     * @param cval
+     *            the constant for {@link ImageKernel#BM_CONSTANT}, which applies only to the first channel.
+     */
+    final public static void interpolate(double[] values, int[] dims, int[] strides, //
+            int nDims, int nChannels, int channelStride, //
+            double[] coords, double[] dst, int nPoints, //
+            int interpolation, int boundary, double cval) {
+
+        final int nTaps;
+
+        switch (interpolation) {
+
+        case ImageKernel.IP_NEAREST:
+            nTaps = 1;
+            break;
+
+        case ImageKernel.IP_LINEAR:
+            nTaps = 2;
+            break;
+
+        case ImageKernel.IP_SPLINE:
+            nTaps = 4;
+            break;
+
+        default:
+            throw new IllegalArgumentException("Interpolation type not recognized");
+        }
+
+        boolean clamp = (boundary == ImageKernel.BM_NEAREST);
+        boolean spline = (interpolation == ImageKernel.IP_SPLINE);
+
+        // Clamped coordinates sample the source as reflected, since that's how coefficients are computed.
+        int tapBoundary = clamp ? ImageKernel.BM_REFLECT : boundary;
+
+        double[] weights = new double[nTaps * nDims];
+        double[] factors = new double[nTaps * nDims];
+        int[] offsets = new int[nTaps * nDims];
+        int[] taps = new int[nDims];
+
+        int nCombinations = 1;
+
+        for (int dim = 0; dim < nDims; dim++) {
+            nCombinations *= nTaps;
+        }
+
+        for (int p = 0; p < nPoints; p++) {
+
+            int coordOffset = p * nDims;
+            int dstOffset = p * nChannels;
+            int nanDim = 0;
+
+            for (; nanDim < nDims && !Double.isNaN(coords[coordOffset + nanDim]); nanDim++) {
+            }
+
+            // NaN coordinates propagate.
+            if (nanDim < nDims) {
+
+                Arrays.fill(dst, dstOffset, dstOffset + nChannels, Double.NaN);
+
+                continue;
+            }
+
+            // Precompute the physical offsets and weights of taps along each dimension.
+            for (int dim = 0; dim < nDims; dim++) {
+
+                int size = dims[dim];
+                double x = Math.max(Math.min(coords[coordOffset + dim], COORDINATE_LIMIT), -COORDINATE_LIMIT);
+
+                if (clamp) {
+                    x = Math.max(Math.min(x, size - 1), 0.0);
+                }
+
+                int tapOffset = dim * nTaps;
+                int base;
+
+                switch (interpolation) {
+
+                case ImageKernel.IP_NEAREST:
+
+                    base = (int) Math.floor(x + 0.5);
+                    weights[tapOffset] = 1.0;
+
+                    break;
+
+                case ImageKernel.IP_LINEAR:
+                {
+                    base = (int) Math.floor(x);
+
+                    double t = x - base;
+
+                    weights[tapOffset] = 1.0 - t;
+                    weights[tapOffset + 1] = t;
+                }
+
+                    break;
+
+                default:
+                {
+                    base = (int) Math.floor(x) - 1;
+
+                    double t = x - (base + 1);
+                    double s = 1.0 - t;
+
+                    weights[tapOffset] = s * s * s / 6.0;
+                    weights[tapOffset + 1] = (4.0 - 6.0 * t * t + 3.0 * t * t * t) / 6.0;
+                    weights[tapOffset + 2] = (4.0 - 6.0 * s * s + 3.0 * s * s * s) / 6.0;
+                    weights[tapOffset + 3] = t * t * t / 6.0;
+                }
+
+                    break;
+                }
+
+                for (int tap = 0; tap < nTaps; tap++) {
+
+                    int index = boundaryIndex(base + tap, size, tapBoundary);
+
+                    if (index >= 0) {
+
+                        offsets[tapOffset + tap] = index * strides[dim];
+                        factors[tapOffset + tap] = 1.0;
+
+                    } else {
+
+                        // Past the edges of a constant extension, spline coefficients relax toward the constant
+                        // geometrically.
+                        index = Math.max(Math.min(base + tap, size - 1), 0);
+
+                        offsets[tapOffset + tap] = index * strides[dim];
+                        factors[tapOffset + tap] = spline ? Math.pow(SPLINE_POLE, Math.abs(base + tap - index)) : 0.0;
+                    }
+                }
+            }
+
+            Arrays.fill(dst, dstOffset, dstOffset + nChannels, 0.0);
+            Arrays.fill(taps, 0);
+
+            // Accumulate the tensor product of taps.
+            for (int combination = 0; combination < nCombinations; combination++) {
+
+                double weight = 1.0;
+                double factor = 1.0;
+                int offset = 0;
+
+                for (int dim = 0; dim < nDims; dim++) {
+
+                    int k = dim * nTaps + taps[dim];
+
+                    weight *= weights[k];
+                    factor *= factors[k];
+                    offset += offsets[k];
+                }
+
+                for (int c = 0; c < nChannels; c++) {
+
+                    double constant = (c != 0) ? 0.0 : cval;
+                    double value = values[offset + c * channelStride];
+
+                    dst[dstOffset + c] += weight * ((factor == 1.0) ? value : constant + factor * (value - constant));
+                }
+
+                for (int dim = nDims - 1; dim >= 0 && ++taps[dim] == nTaps; dim--) {
+                    taps[dim] = 0;
+                }
+            }
+        }
+    }
+
+    /**
+     * Filters values stored in row-major order with a bilateral grid. Non-finite values pass through and don't
+     * contribute.
+     * 
+     * @param values
+     *            the values.
+     * @param dst
+     *            the destination values.
+     * @param dims
+     *            the dimensions.
+     * @param spatialSigmas
+     *            the spatial standard deviations.
+     * @param rangeSigma
+     *            the range standard deviation.
+     */
+    final public static void bilateralGrid(double[] values, double[] dst, //
+            int[] dims, double[] spatialSigmas, double rangeSigma) {
+
+        int nDims = dims.length;
+        int len = Arithmetic.product(dims);
+
+        double lower = Double.POSITIVE_INFINITY;
+        double upper = Double.NEGATIVE_INFINITY;
+
+        for (int i = 0; i < len; i++) {
+
+            double value = values[i];
+
+            if (value > Double.NEGATIVE_INFINITY && value < Double.POSITIVE_INFINITY) {
+
+                lower = Math.min(lower, value);
+                upper = Math.max(upper, value);
+            }
+        }
+
+        if (lower > upper) {
+
+            System.arraycopy(values, 0, dst, 0, len);
+
+            return;
+        }
+
+        int nGridDims = nDims + 1;
+        int nCorners = 1 << nGridDims;
+
+        double[] scales = new double[nGridDims];
+        double[] lowers = new double[nGridDims];
+        double[] fractions = new double[nGridDims];
+        double[] positions = new double[nGridDims];
+        int[] gridD = new int[nGridDims];
+        int[] gridS = new int[nGridDims];
+
+        // The grid samples each dimension at its standard deviation, and an extra cell absorbs round-off at the upper
+        // end.
+        double gridLen = 2.0;
+
+        for (int dim = 0; dim < nGridDims; dim++) {
+
+            scales[dim] = 1.0 / ((dim < nDims) ? spatialSigmas[dim] : rangeSigma);
+            lowers[dim] = (dim < nDims) ? 0.0 : lower;
+
+            double size = Math.floor(((dim < nDims) ? dims[dim] - 1 : upper - lower) * scales[dim]) //
+                    + 2 + 2 * GRID_PADDING;
+
+            gridLen *= size;
+
+            Control.checkTrue(gridLen < (1 << 27), //
+                    "Grid too large");
+
+            gridD[dim] = (int) size;
+        }
+
+        gridS[nGridDims - 1] = 2;
+
+        for (int dim = nGridDims - 1; dim > 0; dim--) {
+            gridS[dim - 1] = gridS[dim] * gridD[dim];
+        }
+
+        double[] grid = new double[(int) gridLen];
+
+        // Splat homogeneous values into the grid with multilinear weights, blur, and then slice.
+        for (int pass = 0; pass < 2; pass++) {
+
+            Arrays.fill(positions, 0.0);
+
+            for (int i = 0; i < len; i++) {
+
+                double value = values[i];
+
+                if (value > Double.NEGATIVE_INFINITY && value < Double.POSITIVE_INFINITY) {
+
+                    positions[nDims] = value;
+
+                    int base = 0;
+
+                    for (int dim = 0; dim < nGridDims; dim++) {
+
+                        double position = (positions[dim] - lowers[dim]) * scales[dim] + GRID_PADDING;
+                        int index = (int) position;
+
+                        fractions[dim] = position - index;
+                        base += index * gridS[dim];
+                    }
+
+                    double acc = 0.0;
+                    double weightAcc = 0.0;
+
+                    for (int corner = 0; corner < nCorners; corner++) {
+
+                        double weight = 1.0;
+                        int offset = base;
+
+                        for (int dim = 0; dim < nGridDims; dim++) {
+
+                            if ((corner & (1 << dim)) != 0) {
+
+                                weight *= fractions[dim];
+                                offset += gridS[dim];
+
+                            } else {
+
+                                weight *= 1.0 - fractions[dim];
+                            }
+                        }
+
+                        if (pass == 0) {
+
+                            grid[offset] += weight * value;
+                            grid[offset + 1] += weight;
+
+                        } else {
+
+                            acc += weight * grid[offset];
+                            weightAcc += weight * grid[offset + 1];
+                        }
+                    }
+
+                    if (pass == 1) {
+                        dst[i] = acc / weightAcc;
+                    }
+
+                } else if (pass == 1) {
+
+                    dst[i] = value;
+                }
+
+                for (int dim = nDims - 1; dim >= 0 && ++positions[dim] == dims[dim]; dim--) {
+                    positions[dim] = 0.0;
+                }
+            }
+
+            if (pass == 0) {
+                blurGrid(grid, gridD, 2);
+            }
+        }
+    }
+
+    /**
+     * Blurs interleaved grids stored in row-major order in place with the kernel [1 2 1] / 4 along each dimension.
+     * 
+     * @param values
+     *            the values.
+     * @param dims
+     *            the dimensions.
+     * @param nValues
+     *            the number of interleaved grids.
+     */
+    final public static void blurGrid(double[] values, int[] dims, int nValues) {
+
+        int nDims = dims.length;
+        int len = Arithmetic.product(dims) * nValues;
+        int bufferLen = 0;
+
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+            bufferLen = Math.max(bufferLen, blockSize / dims[dim]);
+        }
+
+        double[] prev = new double[bufferLen];
+        double[] curr = new double[bufferLen];
+
+        // Convolve with the kernel [1 2 1] / 4 along each dimension, treating the outside as zero.
+        for (int dim = 0, blockSize = len; dim < nDims; blockSize /= dims[dim++]) {
+
+            int size = dims[dim];
+            int rowSize = blockSize / size;
+
+            for (int offset = 0; offset < len; offset += blockSize) {
+
+                Arrays.fill(prev, 0, rowSize, 0.0);
+
+                for (int k = 0, row = offset; k < size; k++, row += rowSize) {
+
+                    System.arraycopy(values, row, curr, 0, rowSize);
+
+                    if (k + 1 < size) {
+
+                        for (int i = 0; i < rowSize; i++) {
+                            values[row + i] = 0.5 * values[row + i] + 0.25 * (prev[i] + values[row + rowSize + i]);
+                        }
+
+                    } else {
+
+                        for (int i = 0; i < rowSize; i++) {
+                            values[row + i] = 0.5 * values[row + i] + 0.25 * prev[i];
+                        }
+                    }
+
+                    double[] tmp = prev;
+                    prev = curr;
+                    curr = tmp;
+                }
+            }
+        }
+    }
+
+    /**
+     * Filters interleaved channels stored in row-major order with a permutohedral lattice. Pixels with non-finite
+     * channels pass through and don't contribute.
+     * 
+     * @param values
+     *            the values.
+     * @param dst
+     *            the destination values.
+     * @param dims
+     *            the dimensions, not counting the channels.
+     * @param nChannels
+     *            the number of interleaved channels.
+     * @param spatialSigmas
+     *            the spatial standard deviations.
+     * @param rangeSigma
+     *            the range standard deviation.
+     */
+    final public static void bilateralLattice(double[] values, double[] dst, //
+            int[] dims, int nChannels, double[] spatialSigmas, double rangeSigma) {
+
+        int nDims = dims.length;
+        int len = Arithmetic.product(dims);
+        int d = nDims + nChannels;
+        int nValues = nChannels + 1;
+
+        double[] scales = new double[d];
+        double[] elevated = new double[d + 1];
+        double[] barycentric = new double[d + 2];
+        double[] acc = new double[nValues];
+        int[] positions = new int[nDims];
+        int[] greedy = new int[d + 1];
+        int[] rank = new int[d + 1];
+        int[] key = new int[d];
+        int[] canonical = new int[(d + 1) * (d + 1)];
+
+        // Features are scaled so that the lattice blur approximates a Gaussian of unit variance.
+        for (int i = 0; i < d; i++) {
+
+            double sigma = (i < nDims) ? spatialSigmas[i] : rangeSigma;
+
+            scales[i] = (d + 1) * Math.sqrt(2.0 / 3.0) / Math.sqrt((i + 1.0) * (i + 2.0)) / sigma;
+        }
+
+        for (int i = 0; i <= d; i++) {
+
+            for (int j = 0; j <= d; j++) {
+                canonical[i * (d + 1) + j] = (j <= d - i) ? i : i - (d + 1);
+            }
+        }
+
+        Control.checkTrue((double) (d + 1) * len < (1 << 27), //
+                "Lattice too large");
+
+        double[] weights = new double[(d + 1) * len];
+        int[] indices = new int[(d + 1) * len];
+
+        PermutohedralLattice lattice = new PermutohedralLattice(d, nValues, len);
+
+        // Splat homogeneous values onto the vertices of enclosing simplices.
+        for (int i = 0; i < len; i++) {
+
+            int pixel = i * nChannels;
+            int pixelOffset = i * (d + 1);
+
+            boolean finite = true;
+
+            for (int c = 0; c < nChannels; c++) {
+                finite &= (values[pixel + c] > Double.NEGATIVE_INFINITY //
+                        && values[pixel + c] < Double.POSITIVE_INFINITY);
+            }
+
+            if (finite) {
+
+                // Project onto the hyperplane of coordinates summing to zero.
+                double sum = 0.0;
+
+                for (int j = d; j > 0; j--) {
+
+                    double feature = ((j - 1 < nDims) ? positions[j - 1] : values[pixel + j - 1 - nDims]) //
+                            * scales[j - 1];
+
+                    elevated[j] = sum - j * feature;
+                    sum += feature;
+                }
+
+                elevated[0] = sum;
+
+                // Find the nearest remainder-zero lattice point.
+                int remainder = 0;
+
+                for (int j = 0; j <= d; j++) {
+
+                    double v = elevated[j] / (d + 1);
+                    double up = Math.ceil(v) * (d + 1);
+                    double down = Math.floor(v) * (d + 1);
+
+                    greedy[j] = (int) ((up - elevated[j] < elevated[j] - down) ? up : down);
+                    remainder += greedy[j];
+                    rank[j] = 0;
+                }
+
+                remainder /= d + 1;
+
+                // Rank differentials to find the enclosing simplex.
+                for (int j = 0; j < d; j++) {
+
+                    for (int k = j + 1; k <= d; k++) {
+
+                        if (elevated[j] - greedy[j] < elevated[k] - greedy[k]) {
+
+                            rank[j]++;
+
+                        } else {
+
+                            rank[k]++;
+                        }
+                    }
+                }
+
+                if (remainder > 0) {
+
+                    for (int j = 0; j <= d; j++) {
+
+                        if (rank[j] >= d + 1 - remainder) {
+
+                            greedy[j] -= d + 1;
+                            rank[j] += remainder - (d + 1);
+
+                        } else {
+
+                            rank[j] += remainder;
+                        }
+                    }
+
+                } else if (remainder < 0) {
+
+                    for (int j = 0; j <= d; j++) {
+
+                        if (rank[j] < -remainder) {
+
+                            greedy[j] += d + 1;
+                            rank[j] += (d + 1) + remainder;
+
+                        } else {
+
+                            rank[j] += remainder;
+                        }
+                    }
+                }
+
+                Arrays.fill(barycentric, 0.0);
+
+                for (int j = 0; j <= d; j++) {
+
+                    double delta = (elevated[j] - greedy[j]) / (d + 1);
+
+                    barycentric[d - rank[j]] += delta;
+                    barycentric[d + 1 - rank[j]] -= delta;
+                }
+
+                barycentric[0] += 1.0 + barycentric[d + 1];
+
+                for (int r = 0; r <= d; r++) {
+
+                    for (int j = 0; j < d; j++) {
+                        key[j] = greedy[j] + canonical[r * (d + 1) + rank[j]];
+                    }
+
+                    int index = lattice.insert(key);
+                    int vertex = index * nValues;
+
+                    for (int c = 0; c < nChannels; c++) {
+                        lattice.values[vertex + c] += barycentric[r] * values[pixel + c];
+                    }
+
+                    lattice.values[vertex + nChannels] += barycentric[r];
+
+                    indices[pixelOffset + r] = index;
+                    weights[pixelOffset + r] = barycentric[r];
+                }
+
+            } else {
+
+                indices[pixelOffset] = -1;
+            }
+
+            for (int dim = nDims - 1; dim >= 0 && ++positions[dim] == dims[dim]; dim--) {
+                positions[dim] = 0;
+            }
+        }
+
+        // Blur along each lattice direction with the kernel [1 2 1] / 4.
+        int nPoints = lattice.size;
+
+        double[] blurred = new double[nPoints * nValues];
+        int[] prevKey = new int[d];
+        int[] nextKey = new int[d];
+
+        for (int j = 0; j <= d; j++) {
+
+            for (int i = 0; i < nPoints; i++) {
+
+                int pointKey = i * d;
+
+                for (int k = 0; k < d; k++) {
+
+                    prevKey[k] = lattice.keys[pointKey + k] + 1;
+                    nextKey[k] = lattice.keys[pointKey + k] - 1;
+                }
+
+                if (j < d) {
+
+                    prevKey[j] = lattice.keys[pointKey + j] - d;
+                    nextKey[j] = lattice.keys[pointKey + j] + d;
+                }
+
+                int prev = lattice.find(prevKey);
+                int next = lattice.find(nextKey);
+
+                for (int c = 0; c < nValues; c++) {
+                    blurred[i * nValues + c] = 0.5 * lattice.values[i * nValues + c] //
+                            + ((prev >= 0) ? 0.25 * lattice.values[prev * nValues + c] : 0.0) //
+                            + ((next >= 0) ? 0.25 * lattice.values[next * nValues + c] : 0.0);
+                }
+            }
+
+            System.arraycopy(blurred, 0, lattice.values, 0, nPoints * nValues);
+        }
+
+        // Slice by barycentric interpolation, and then divide out the homogeneous coordinate.
+        for (int i = 0; i < len; i++) {
+
+            int pixel = i * nChannels;
+            int pixelOffset = i * (d + 1);
+
+            if (indices[pixelOffset] < 0) {
+
+                System.arraycopy(values, pixel, dst, pixel, nChannels);
+
+                continue;
+            }
+
+            Arrays.fill(acc, 0.0);
+
+            for (int r = 0; r <= d; r++) {
+
+                int vertex = indices[pixelOffset + r] * nValues;
+
+                for (int c = 0; c < nValues; c++) {
+                    acc[c] += weights[pixelOffset + r] * lattice.values[vertex + c];
+                }
+            }
+
+            for (int c = 0; c < nChannels; c++) {
+                dst[pixel + c] = acc[c] / acc[nChannels];
+            }
+        }
+    }
+
+    /**
+     * Applies one level of a lifting scheme, or its inverse, along the rows of a block stored in row-major order in
+     * place. The forward transform leaves the approximation rows ahead of the detail rows.
+     * 
+     * @param values
+     *            the values.
+     * @param valuesOffset
+     *            the offset of the block.
+     * @param work
+     *            the working storage, which must be as large as the block.
+     * @param size
+     *            the number of rows.
+     * @param rowSize
+     *            the row size.
+     * @param scheme
+     *            the lifting scheme.
+     * @param inverse
+     *            whether to apply the inverse transform.
+     */
+    final public static void liftLines(double[] values, int valuesOffset, double[] work, int size, int rowSize, //
+            double[] scheme, boolean inverse) {
+
+        int nSteps = (int) scheme[2];
+        int[] sizes = new int[] { (size + 1) >> 1, size >> 1 };
+        int[] channels = new int[] { 0, sizes[0] * rowSize };
+        int[] steps = new int[nSteps];
+
+        for (int i = 0, offset = 3; i < nSteps; offset += 3 + (int) scheme[offset + 2], i++) {
+            steps[i] = offset;
+        }
+
+        if (!inverse) {
+
+            // Split the rows into even and odd channels.
+            for (int k = 0; k < size; k++) {
+                System.arraycopy(values, valuesOffset + k * rowSize, //
+                        work, channels[k & 1] + (k >> 1) * rowSize, rowSize);
+            }
+
+        } else {
+
+            // Undo the scaling.
+            System.arraycopy(values, valuesOffset, work, 0, size * rowSize);
+
+            for (int c = 0; c < 2; c++) {
+
+                double factor = 1.0 / scheme[c];
+
+                for (int i = channels[c], n = channels[c] + sizes[c] * rowSize; i < n; i++) {
+                    work[i] *= factor;
+                }
+            }
+        }
+
+        // Lift whole rows at a time, extending the source channel symmetrically past its ends.
+        for (int i = 0; i < nSteps; i++) {
+
+            int step = steps[!inverse ? i : nSteps - 1 - i];
+
+            int channel = (int) scheme[step];
+            int first = (int) scheme[step + 1];
+            int nTaps = (int) scheme[step + 2];
+            double sign = !inverse ? 1.0 : -1.0;
+
+            int dst = channels[channel];
+            int src = channels[1 - channel];
+            int dstSize = sizes[channel];
+            int srcSize = sizes[1 - channel];
+
+            for (int k = 0; k < dstSize; k++) {
+
+                int dstRow = dst + k * rowSize;
+
+                for (int tap = 0; tap < nTaps; tap++) {
+
+                    double coefficient = sign * scheme[step + 3 + tap];
+
+                    if (coefficient == 0.0) {
+                        continue;
+                    }
+
+                    int index = k + first + tap;
+
+                    while (index < 0 || index >= srcSize) {
+                        index = (index < 0) ? -1 - index : 2 * srcSize - 1 - index;
+                    }
+
+                    int srcRow = src + index * rowSize;
+
+                    for (int r = 0; r < rowSize; r++) {
+                        work[dstRow + r] += coefficient * work[srcRow + r];
+                    }
+                }
+            }
+        }
+
+        if (!inverse) {
+
+            for (int c = 0; c < 2; c++) {
+
+                double factor = scheme[c];
+
+                for (int i = channels[c], n = channels[c] + sizes[c] * rowSize; i < n; i++) {
+                    work[i] *= factor;
+                }
+            }
+
+            System.arraycopy(work, 0, values, valuesOffset, size * rowSize);
+
+        } else {
+
+            // Merge the even and odd channels back into rows.
+            for (int k = 0; k < size; k++) {
+                System.arraycopy(work, channels[k & 1] + (k >> 1) * rowSize, //
+                        values, valuesOffset + k * rowSize, rowSize);
+            }
+        }
+    }
+
+    /**
+     * Copies between values stored in row-major order and the leading corner region of them.
+     * 
+     * @param values
+     *            the values.
+     * @param region
+     *            the region values.
+     * @param dims
+     *            the dimensions.
+     * @param regionDims
+     *            the region dimensions.
+     * @param extract
+     *            whether to copy from the values to the region, as opposed to the reverse.
+     */
+    final public static void copyRegion(double[] values, double[] region, //
+            int[] dims, int[] regionDims, boolean extract) {
+
+        int nDims = dims.length;
+        int rowSize = regionDims[nDims - 1];
+        int nRows = Arithmetic.product(regionDims) / rowSize;
+
+        for (int row = 0; row < nRows; row++) {
+
+            // Find the offset of the row's leading corner in the full array.
+            int offset = 0;
+
+            for (int dim = nDims - 2, rem = row, stride = dims[nDims - 1]; dim >= 0; stride *= dims[dim--]) {
+
+                offset += (rem % regionDims[dim]) * stride;
+                rem /= regionDims[dim];
+            }
+
+            if (extract) {
+
+                System.arraycopy(values, offset, region, row * rowSize, rowSize);
+
+            } else {
+
+                System.arraycopy(region, row * rowSize, values, offset, rowSize);
+            }
+        }
+    }
+
+    /**
+     * A hash table of permutohedral lattice points, each with a vector of values. Storage grows geometrically as points
+     * are inserted.
+     */
+    final protected static class PermutohedralLattice {
+
+        /**
+         * The keys of lattice points.
+         */
+        int[] keys;
+
+        /**
+         * The values of lattice points.
+         */
+        double[] values;
+
+        /**
+         * The number of lattice points.
+         */
+        int size;
+
+        final int nKeys;
+        final int nValues;
+
+        int[] slots;
+
+        /**
+         * Default constructor.
+         * 
+         * @param nKeys
+         *            the number of key components.
+         * @param nValues
+         *            the number of value components.
+         * @param capacity
+         *            the initial capacity.
+         */
+        protected PermutohedralLattice(int nKeys, int nValues, int capacity) {
+
+            this.nKeys = nKeys;
+            this.nValues = nValues;
+            this.size = 0;
+
+            int nSlots = 1;
+
+            while (nSlots < 2 * capacity) {
+                nSlots <<= 1;
+            }
+
+            this.slots = new int[nSlots];
+            this.keys = new int[nKeys * (nSlots >> 1)];
+            this.values = new double[nValues * (nSlots >> 1)];
+
+            Arrays.fill(this.slots, -1);
+        }
+
+        /**
+         * Looks up a lattice point, and inserts it if it isn't present.
+         * 
+         * @param key
+         *            the key.
+         * @return the index of the lattice point.
+         */
+        protected int insert(int[] key) {
+
+            int slot = slotOf(key, 0);
+            int index = this.slots[slot];
+
+            if (index >= 0) {
+                return index;
+            }
+
+            index = this.size++;
+
+            this.slots[slot] = index;
+
+            System.arraycopy(key, 0, this.keys, index * this.nKeys, this.nKeys);
+
+            // Keep the load factor at most one half.
+            if (2 * this.size >= this.slots.length) {
+                grow();
+            }
+
+            return index;
+        }
+
+        /**
+         * Looks up a lattice point.
+         * 
+         * @param key
+         *            the key.
+         * @return the index of the lattice point, or {@code -1} if it isn't present.
+         */
+        protected int find(int[] key) {
+            return this.slots[slotOf(key, 0)];
+        }
+
+        /**
+         * Finds the slot of a key.
+         */
+        protected int slotOf(int[] key, int keyOffset) {
+
+            int nKeys = this.nKeys;
+            int mask = this.slots.length - 1;
+            int hash = 0;
+
+            for (int i = 0; i < nKeys; i++) {
+                hash = (hash + key[keyOffset + i]) * 2531011;
+            }
+
+            // Lattice keys share residues, so fold the high bits into the low bits used for indexing.
+            hash ^= hash >>> 16;
+            hash *= 0x85ebca6b;
+            hash ^= hash >>> 13;
+
+            for (int slot = hash & mask;; slot = (slot + 1) & mask) {
+
+                int index = this.slots[slot];
+
+                if (index < 0) {
+                    return slot;
+                }
+
+                boolean match = true;
+
+                for (int i = 0, offset = index * nKeys; i < nKeys && match; i++) {
+                    match = (this.keys[offset + i] == key[keyOffset + i]);
+                }
+
+                if (match) {
+                    return slot;
+                }
+            }
+        }
+
+        /**
+         * Doubles the capacity.
+         */
+        protected void grow() {
+
+            Control.checkTrue(this.slots.length <= (1 << 29), //
+                    "Lattice too large");
+
+            int nSlots = this.slots.length << 1;
+
+            this.slots = new int[nSlots];
+            this.keys = Arrays.copyOf(this.keys, this.nKeys * (nSlots >> 1));
+            this.values = Arrays.copyOf(this.values, this.nValues * (nSlots >> 1));
+
+            Arrays.fill(this.slots, -1);
+
+            for (int index = 0; index < this.size; index++) {
+                this.slots[slotOf(this.keys, index * this.nKeys)] = index;
+            }
+        }
+    }
+
     // Dummy constructor.
     ImageOps() {
     }
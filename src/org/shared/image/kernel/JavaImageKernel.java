@@ -55,4 +55,65 @@ public class JavaImageKernel implements ImageKernel {
             double[] dstV, int[] dstD, int[] dstS) {
         ImageOps.createIntegralHistogram(srcV, srcD, srcS, memV, dstV, dstD, dstS);
     }
+
+    @Override
+    public void createIntegralMoments( //
+            int[] types, double[] xV, double[] yV, int[] srcD, int[] srcS, //
+            double[] dstV, int[] dstD, int[] dstS) {
+        ImageOps.createIntegralMoments(types, xV, yV, srcD, srcS, dstV, dstD, dstS);
+    }
+
+    @Override
+    public void localMeanVariance( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, //
+            double[] meanV, double[] varV) {
+        ImageOps.localMeanVariance(srcV, srcD, srcS, radii, meanV, varV);
+    }
+
+    @Override
+    public void guidedFilter( //
+            double[] guideV, double[] srcV, int[] srcD, int[] srcS, int[] radii, double epsilon, //
+            double[] dstV) {
+        ImageOps.guidedFilter(guideV, srcV, srcD, srcS, radii, epsilon, dstV);
+    }
+
+    @Override
+    public void normalizedCrossCorrelation( //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] tplV, int[] tplD, int[] tplS, //
+            double[] dstV, int[] dstD, int[] dstS) {
+        ImageOps.normalizedCrossCorrelation(srcV, srcD, srcS, tplV, tplD, tplS, dstV, dstD, dstS);
+    }
+
+    @Override
+    public int[] findPeaks( //
+            double[] srcV, int[] srcD, int[] srcS, int[] radii, double threshold, int minDistance) {
+        return ImageOps.findPeaks(srcV, srcD, srcS, radii, threshold, minDistance);
+    }
+
+    @Override
+    public void mapCoordinates(int interpolation, int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] coordsV, double[] dstV, boolean complex) {
+        ImageOps.mapCoordinates(interpolation, boundary, cval, srcV, srcD, srcS, coordsV, dstV, complex);
+    }
+
+    @Override
+    public void splineCoefficients(int boundary, double cval, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            double[] dstV, boolean complex) {
+        ImageOps.splineCoefficients(boundary, cval, srcV, srcD, srcS, dstV, complex);
+    }
+
+    @Override
+    public void bilateralFilter(double[] srcV, int[] srcD, int[] srcS, double[] sigmas, double[] dstV) {
+        ImageOps.bilateralFilter(srcV, srcD, srcS, sigmas, dstV);
+    }
+
+    @Override
+    public void waveletTransform(int wavelet, int nLevels, //
+            double[] srcV, int[] srcD, int[] srcS, //
+            boolean inverse) {
+        ImageOps.waveletTransform(wavelet, nLevels, srcV, srcD, srcS, inverse);
+    }
 }
@@ -110,6 +110,6 @@ public class GmComponents {
                 + "%s%n" //
                 + "likelihood = %4.4e%n%n" //
                 + "n_rounds = %d%n", //
-                this.centers, this.covariances.clone().uSqrt(), this.weights, this.likelihood, this.nRounds);
+                this.centers, this.covariances.eSqrt(), this.weights, this.likelihood, this.nRounds);
     }
 }
@@ -61,7 +61,7 @@ public class GmModel extends AbstractGmModel {
         RealArray globalSum = input.rSum(0);
         RealArray globalMean = input.rMean(0);
 
-        (globalSum.clone().uSqr().uMul(1.0 / input.size(0))) //
+        (globalSum.eSqr().uMul(1.0 / input.size(0))) //
                 .lSub(globalMean.eMul(globalMean)).uAdd(regularization) //
                 .tile(nComps, 1) //
                 .map(gmc.covariances, 0, 0, nComps, 0, 0, nDims);
@@ -96,8 +96,8 @@ public class GmModel extends AbstractGmModel {
 
         // Update the covariances.
 
-        posterior.mMul(points.clone().uSqr()).lDiv(nrmp) //
-                .lSub(gmc.centers.clone().uSqr()) //
+        posterior.mMul(points.eSqr()).lDiv(nrmp) //
+                .lSub(gmc.centers.eSqr()) //
                 .map(gmc.covariances, 0, 0, nComps, 0, 0, nDims);
 
         gmc.regularize(regularization);
@@ -112,17 +112,17 @@ public class GmModel extends AbstractGmModel {
 
         int nPoints = points.size(0);
 
-        RealArray iCov = gmc.covariances.clone().uInv(1.0);
+        RealArray iCov = gmc.covariances.eInv(1.0);
 
-        RealArray nrmTiled = (gmc.centers.clone().uSqr().lMul(iCov)) //
-                .lAdd(gmc.covariances.clone().uLog()) //
+        RealArray nrmTiled = (gmc.centers.eSqr().lMul(iCov)) //
+                .lAdd(gmc.covariances.eLog()) //
                 .rSum(1).tile(1, nPoints);
 
         RealArray pointsT = points.transpose(1, 0);
 
         RealArray logWeightsTiled = gmc.weights.tile(1, nPoints).uAdd(1e-64).uLog();
 
-        RealArray exponent = (iCov.mMul(pointsT.clone().uSqr())) //
+        RealArray exponent = (iCov.mMul(pointsT.eSqr())) //
                 .lAdd(gmc.centers.eMul(iCov).mMul(pointsT).uMul(-2.0)) //
                 .lAdd(nrmTiled).uMul(-0.5);
 
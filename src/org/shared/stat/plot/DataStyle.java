@@ -107,6 +107,8 @@ public class DataStyle implements EnumType<DataStyle.DataStyleType> {
 
     Double pointSize;
 
+    double[] boxWidths;
+
     /**
      * Default constructor.
      */
@@ -224,4 +226,21 @@ public class DataStyle implements EnumType<DataStyle.DataStyleType> {
 
         return this;
     }
+
+    /**
+     * Gets the per-row box widths for {@link DataStyleType#BARS}, or {@code null} if they are left to the renderer.
+     */
+    public double[] getBoxWidths() {
+        return this.boxWidths;
+    }
+
+    /**
+     * Sets the per-row box widths for {@link DataStyleType#BARS}.
+     */
+    public DataStyle setBoxWidths(double[] boxWidths) {
+
+        this.boxWidths = boxWidths;
+
+        return this;
+    }
 }
@@ -28,7 +28,10 @@
 
 package org.shared.stat.plot;
 
+import static org.shared.array.ArrayBase.opKernel;
+
 import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
 import org.shared.stat.plot.Plot.AxisType;
 import org.shared.util.Arrays;
 import org.shared.util.Control;
@@ -45,6 +48,11 @@ abstract public class ErrorDistribution implements Plottable {
      */
     final protected RealArray[] datasets;
 
+    /**
+     * The average precisions.
+     */
+    final protected double[] averagePrecisions;
+
     /**
      * The data titles.
      */
@@ -68,27 +76,19 @@ abstract public class ErrorDistribution implements Plottable {
         int nClasses = Control.checkEquals(confidencesArray.length, outcomesArray.length);
 
         this.datasets = new RealArray[nClasses];
+        this.averagePrecisions = new double[nClasses];
 
-        for (int i = 0; i < nClasses; i++) {
-
-            int nExamples = Control.checkEquals(confidencesArray[i].length, outcomesArray[i].length);
-
-            double[] confidences = new double[nExamples];
-            boolean[] outcomes = new boolean[nExamples];
-
-            RealArray dataset = new RealArray(nExamples, 2);
+        double[] stats = new double[2];
 
-            int[] perm = new RealArray(confidencesArray[i]).clone().iSort(0).reverse(0).values();
-
-            for (int j = 0; j < nExamples; j++) {
+        for (int i = 0; i < nClasses; i++) {
 
-                confidences[j] = confidencesArray[i][perm[j]];
-                outcomes[j] = outcomesArray[i][perm[j]];
-            }
+            Control.checkEquals(confidencesArray[i].length, outcomesArray[i].length);
 
-            initDataset(dataset, outcomes);
+            double[] points = opKernel.errorCurve(getCurveType(), //
+                    confidencesArray[i], outcomesArray[i], 0, stats);
 
-            this.datasets[i] = dataset;
+            this.datasets[i] = new RealArray(points, points.length / 2, 2);
+            this.averagePrecisions[i] = stats[1];
         }
 
         this.dataTitles = PlotBase.createDefaultTitles(nClasses);
@@ -116,6 +116,13 @@ abstract public class ErrorDistribution implements Plottable {
         return aucs;
     }
 
+    /**
+     * Gets the average precisions, which summarize the precision-recall curves.
+     */
+    public double[] getAveragePrecisions() {
+        return this.averagePrecisions.clone();
+    }
+
     @Override
     public RealArray[] getDatasets() {
         return this.datasets;
@@ -169,14 +176,9 @@ abstract public class ErrorDistribution implements Plottable {
     }
 
     /**
-     * Initializes the given dataset.
-     * 
-     * @param dataset
-     *            the dataset.
-     * @param outcomes
-     *            the prediction outcomes.
+     * Gets the curve type, one of {@link ArrayKernel#EC_ROC} and {@link ArrayKernel#EC_PR}.
      */
-    abstract protected void initDataset(RealArray dataset, boolean[] outcomes);
+    abstract protected int getCurveType();
 
     /**
      * Gets the <code>x</code>-axis title.
@@ -28,6 +28,8 @@
 
 package org.shared.stat.plot;
 
+import static org.shared.array.ArrayBase.opKernel;
+
 import java.io.ByteArrayInputStream;
 import java.io.File;
 import java.io.FileOutputStream;
@@ -40,6 +42,7 @@ import java.util.Formatter;
 import java.util.List;
 
 import org.shared.array.RealArray;
+import org.shared.stat.plot.DataStyle.DataStyleType;
 import org.shared.stat.plot.Plot.AxisScaleType;
 import org.shared.stat.plot.Plot.AxisType;
 import org.shared.util.Control;
@@ -79,6 +82,11 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
      */
     final public static String PROPERTY_COLORMAP = "colormap";
 
+    /**
+     * The property that toggles downsampling of datasets with more points than the panel has pixels across.
+     */
+    final public static String PROPERTY_DOWNSAMPLE = "downsample";
+
     static {
         gnuplotExecArgs = new String[] { "gnuplot" };
     }
@@ -324,21 +332,38 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
                     throw new IllegalStateException("Invalid plotting style");
                 }
 
-                f.format("\"-\" title \"%s\" with %s ls %d", plot.dataTitles[i], styleStr, i + 1);
+                // Take box widths from the style instead of letting Gnuplot autoscale them.
+                String usingStr = (getBoxWidths(plot, i) != null) ? " using 1:2:3" : "";
+
+                f.format("\"-\"%s title \"%s\" with %s ls %d", usingStr, plot.dataTitles[i], styleStr, i + 1);
                 f.format((i < nClasses - 1) ? ", " : "%n");
             }
 
+            int pixelWidth = Math.max(1, (this.outputWidth * plot.panelWidth) / maxWidth);
+            int pixelHeight = Math.max(1, (this.outputHeight * plot.panelHeight) / maxHeight);
+
             for (int i = 0; i < nClasses; i++) {
 
                 RealArray data = plot.datasets[i];
+                double[] boxWidths = getBoxWidths(plot, i);
+
+                int[] rows = plot.isDownsampleEnabled ? downsample(plot, i, pixelWidth, pixelHeight) : null;
 
-                for (int j = 0, m = data.size(0); j < m; j++) {
+                for (int j = 0, m = (rows != null) ? rows.length : data.size(0); j < m; j++) {
+
+                    int row = (rows != null) ? rows[j] : j;
 
                     for (int dim = 0; dim < nDims; dim++) {
 
-                        f.format("%.4e", data.get(j, dim));
-                        f.format((dim < nDims - 1) ? " " : "%n");
+                        f.format("%.4e", data.get(row, dim));
+                        f.format((dim < nDims - 1) ? " " : "");
+                    }
+
+                    if (boxWidths != null) {
+                        f.format(" %.4e", boxWidths[row]);
                     }
+
+                    f.format("%n");
                 }
 
                 f.format("e%n");
@@ -378,6 +403,24 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
         return this;
     }
 
+    /**
+     * Gets the box widths of the given dataset, or {@code null} if it isn't drawn as bars with explicit widths.
+     */
+    final protected static double[] getBoxWidths(Gnuplot plot, int i) {
+
+        DataStyle style = plot.dataStyles[i];
+        double[] boxWidths = style.getBoxWidths();
+
+        if (plot.nDims != 2 || style.getType() != DataStyleType.BARS || boxWidths == null) {
+            return null;
+        }
+
+        Control.checkTrue(boxWidths.length == plot.datasets[i].size(0), //
+                "Box widths must match the dataset rows");
+
+        return boxWidths;
+    }
+
     /**
      * Creates a Gnuplot line style definition from the given {@link DataStyle}.
      */
@@ -415,6 +458,44 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
         return !res.equals("") ? f.toString() : " default";
     }
 
+    /**
+     * Selects the rows of a dataset that survive downsampling to the given panel size in pixels. Series drawn with
+     * lines are downsampled with Largest-Triangle-Three-Buckets to two points per pixel column, and point clouds are
+     * thinned to one point per pixel.
+     * 
+     * @return the rows to keep, or {@code null} to keep all of them.
+     */
+    final protected static int[] downsample(Gnuplot plot, int index, int pixelWidth, int pixelHeight) {
+
+        RealArray data = plot.datasets[index];
+
+        int nRows = data.size(0);
+
+        // Only two-dimensional, linearly scaled plots with more points than pixels across are candidates.
+        if (plot.nDims != 2 || nRows <= pixelWidth //
+                || plot.axisScaleTypes[0] != AxisScaleType.NORMAL //
+                || plot.axisScaleTypes[1] != AxisScaleType.NORMAL) {
+            return null;
+        }
+
+        double[] xV = data.subarray(0, nRows, 0, 1).values();
+        double[] yV = data.subarray(0, nRows, 1, 2).values();
+
+        switch (plot.dataStyles[index].getType()) {
+
+        case LINES:
+        case LINESPOINTS:
+            return (nRows > 2 * pixelWidth) ? opKernel.lttb(xV, yV, Math.max(3, 2 * pixelWidth)) : null;
+
+        case POINTS:
+            return (plot.axisRanges[0] < plot.axisRanges[1] && plot.axisRanges[2] < plot.axisRanges[3]) //
+                    ? opKernel.thin(xV, yV, plot.axisRanges, pixelWidth, pixelHeight) : null;
+
+        default:
+            return null;
+        }
+    }
+
     /**
      * An internal implementation of {@link Plot}.
      */
@@ -437,6 +518,7 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
         boolean isGridEnabled;
         boolean isMeshEnabled;
         boolean isColormapEnabled;
+        boolean isDownsampleEnabled;
 
         int panelX;
         int panelY;
@@ -476,6 +558,7 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
             this.isGridEnabled = false;
             this.isMeshEnabled = false;
             this.isColormapEnabled = false;
+            this.isDownsampleEnabled = true;
             this.panelX = 0;
             this.panelY = 0;
             this.panelWidth = 1;
@@ -598,6 +681,10 @@ public class GnuplotContext implements PlotContext<GnuplotContext, GnuplotContex
 
                 this.isColormapEnabled = isPropertyEnabled;
 
+            } else if (property.equals(PROPERTY_DOWNSAMPLE)) {
+
+                this.isDownsampleEnabled = isPropertyEnabled;
+
             } else {
 
                 throw new IllegalArgumentException("Invalid Gnuplot property");
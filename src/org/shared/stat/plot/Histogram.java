@@ -28,8 +28,13 @@
 
 package org.shared.stat.plot;
 
+import static org.shared.array.ArrayBase.opKernel;
+
 import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
+import org.shared.stat.plot.DataStyle.DataStyleType;
 import org.shared.stat.plot.Plot.AxisType;
+import org.shared.util.Control;
 
 /**
  * A representation of histograms.
@@ -63,9 +68,17 @@ public class Histogram implements Plottable {
      */
     final protected double[] yrange;
 
+    /**
+     * The binning type.
+     */
+    final protected int type;
+
     /**
      * Default constructor.
      * 
+     * @param type
+     *            the binning type, one of {@link ArrayKernel#HI_FIXED} and {@link ArrayKernel#HI_QUANTILE}. Quantile
+     *            bins are plotted as densities.
      * @param min
      *            the range minimum.
      * @param max
@@ -75,39 +88,81 @@ public class Histogram implements Plottable {
      * @param valuesArray
      *            the array of values.
      */
-    public Histogram(double min, double max, int nBins, double[]... valuesArray) {
+    public Histogram(int type, double min, double max, int nBins, double[]... valuesArray) {
+
+        Control.checkTrue(type == ArrayKernel.HI_FIXED || type == ArrayKernel.HI_QUANTILE, //
+                "Invalid binning type");
 
         int nClasses = valuesArray.length;
 
         this.datasets = new RealArray[nClasses];
+        this.dataStyles = new DataStyle[nClasses];
 
-        double increment = (max - min) / nBins;
+        double xMin = min;
+        double xMax = max;
         double maxCount = 0.0;
 
-        for (int i = 0, n = valuesArray.length; i < n; i++) {
+        double[] edges = new double[nBins + 1];
+        double[] counts = new double[nBins];
+
+        for (int i = 0; i < nClasses; i++) {
+
+            opKernel.histogram(type, valuesArray[i], min, max, edges, counts);
 
             RealArray dataset = new RealArray(nBins, 2);
+            double[] widths = new double[nBins];
 
             for (int bin = 0; bin < nBins; bin++) {
-                dataset.set(increment * (bin + 0.5) + min, bin, 0);
+
+                double width = edges[bin + 1] - edges[bin];
+
+                // Degenerate bins from tied or missing values have no extent to draw.
+                widths[bin] = (width > 0.0) ? width : 0.0;
+
+                dataset.set(0.5 * (edges[bin] + edges[bin + 1]), bin, 0);
+
+                // Quantile bins hold roughly equal counts, so only their densities tell them apart.
+                if (type == ArrayKernel.HI_QUANTILE) {
+                    dataset.set((width > 0.0) ? counts[bin] / width : 0.0, bin, 1);
+                } else {
+                    dataset.set(counts[bin], bin, 1);
+                }
             }
 
-            for (double value : valuesArray[i]) {
+            // Quantile bins span the values themselves.
+            if (type == ArrayKernel.HI_QUANTILE && !Double.isNaN(edges[0])) {
 
-                int bin = Math.max(0, Math.min(nBins - 1, (int) ((value - min) / increment)));
-                dataset.set(dataset.get(bin, 1) + 1.0d, bin, 1);
+                xMin = (i == 0) ? edges[0] : Math.min(xMin, edges[0]);
+                xMax = (i == 0) ? edges[nBins] : Math.max(xMax, edges[nBins]);
             }
 
             maxCount = Math.max(maxCount, dataset.subarray(0, nBins, 1, 2).aMax());
 
             this.datasets[i] = dataset;
+            this.dataStyles[i] = new DataStyle(DataStyleType.BARS).setBoxWidths(widths);
         }
 
-        this.xrange = new double[] { min, max };
+        this.xrange = new double[] { xMin, xMax };
         this.yrange = new double[] { 0, maxCount };
 
         this.dataTitles = PlotBase.createDefaultTitles(nClasses);
-        this.dataStyles = org.shared.util.Arrays.newArray(DataStyle.class, nClasses, DataStyle.bars);
+        this.type = type;
+    }
+
+    /**
+     * Alternate constructor for fixed bins.
+     * 
+     * @param min
+     *            the range minimum.
+     * @param max
+     *            the range maximum.
+     * @param nBins
+     *            the number of bins.
+     * @param valuesArray
+     *            the array of values.
+     */
+    public Histogram(double min, double max, int nBins, double[]... valuesArray) {
+        this(ArrayKernel.HI_FIXED, min, max, nBins, valuesArray);
     }
 
     @Override
@@ -160,7 +215,7 @@ public class Histogram implements Plottable {
             return "bins";
 
         case Y:
-            return "counts";
+            return (this.type == ArrayKernel.HI_QUANTILE) ? "density" : "counts";
 
         default:
             throw new IllegalArgumentException("Invalid axis type");
@@ -0,0 +1,352 @@
+/**
+ * <p>
+ * Copyright (c) 2007 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.stat.plot;
+
+import static org.shared.array.ArrayBase.opKernel;
+
+import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
+import org.shared.stat.plot.Plot.AxisType;
+import org.shared.util.Arrays;
+import org.shared.util.Control;
+
+/**
+ * A representation of Gaussian kernel density estimates. Values are linearly binned onto an evenly spaced grid, and
+ * the binned counts are convolved with the kernel by way of the FFT.
+ * 
+ * @author Roy Liu
+ */
+public class KernelDensity implements Plottable {
+
+    /**
+     * The number of bandwidths beyond which the kernel is truncated.
+     */
+    final protected static double KERNEL_RADIUS = 4.0;
+
+    /**
+     * The maximum kernel radius, in binning grid points, as a multiple of the number of plotted points.
+     */
+    final protected static int MAX_RADIUS_FACTOR = 4;
+
+    /**
+     * The datasets.
+     */
+    final protected RealArray[] datasets;
+
+    /**
+     * The data titles.
+     */
+    final protected String[] dataTitles;
+
+    /**
+     * The {@link DataStyle}s.
+     */
+    final protected DataStyle[] dataStyles;
+
+    /**
+     * The bandwidths.
+     */
+    final protected double[] bandwidths;
+
+    /**
+     * The <code>x</code> range.
+     */
+    final protected double[] xrange;
+
+    /**
+     * The <code>y</code> range.
+     */
+    final protected double[] yrange;
+
+    /**
+     * Default constructor.
+     * 
+     * @param min
+     *            the range minimum.
+     * @param max
+     *            the range maximum.
+     * @param nPoints
+     *            the number of grid points.
+     * @param bandwidth
+     *            the kernel bandwidth, or a nonpositive value to select one with Silverman's rule of thumb.
+     * @param valuesArray
+     *            the array of values.
+     */
+    public KernelDensity(double min, double max, int nPoints, double bandwidth, double[]... valuesArray) {
+
+        Control.checkTrue(nPoints >= 2, //
+                "Invalid number of grid points");
+
+        Control.checkTrue(min < max, //
+                "Invalid range");
+
+        int nClasses = valuesArray.length;
+
+        this.datasets = new RealArray[nClasses];
+        this.bandwidths = new double[nClasses];
+
+        double spacing = (max - min) / (nPoints - 1);
+        double maxDensity = 0.0;
+
+        for (int i = 0; i < nClasses; i++) {
+
+            double[] values = valuesArray[i];
+
+            int n = 0;
+
+            for (double value : values) {
+
+                if (value == value) {
+                    n++;
+                }
+            }
+
+            double h = (bandwidth > 0.0) ? bandwidth : selectBandwidth(values, n);
+
+            // Fall back to the grid spacing for degenerate samples.
+            h = (h > 0.0 && h < Double.POSITIVE_INFINITY) ? h : spacing;
+
+            // Bin onto the plotted grid, unless the kernel would span more than a bounded number of its points. In that
+            // case, coarsen the binning grid by an integral stride so that the kernel is never truncated, and
+            // interpolate the plotted points.
+            int maxRadius = MAX_RADIUS_FACTOR * nPoints;
+            int stride = (int) Math.max(1.0, Math.ceil(KERNEL_RADIUS * h / (spacing * maxRadius)));
+            double binSpacing = stride * spacing;
+
+            // Widen the grid by the kernel radius on each side, so that values just outside of the range contribute
+            // their tails instead of piling up on the end grid points.
+            int radius = (int) Math.ceil(KERNEL_RADIUS * h / binSpacing);
+            int nInnerPoints = (nPoints + stride - 2) / stride + 1;
+            int nWidePoints = nInnerPoints + 2 * radius;
+
+            double wideMin = min - radius * binSpacing;
+            double wideMax = min + (nInnerPoints - 1 + radius) * binSpacing;
+
+            // Values beyond the wide grid lie farther than the kernel radius from every plotted point, and so only
+            // count toward the normalization.
+            int nWideValues = 0;
+
+            for (double value : values) {
+
+                if (value >= wideMin && value <= wideMax) {
+                    nWideValues++;
+                }
+            }
+
+            double[] wideValues = new double[nWideValues];
+
+            for (int j = 0, k = 0, m = values.length; j < m; j++) {
+
+                if (values[j] >= wideMin && values[j] <= wideMax) {
+                    wideValues[k++] = values[j];
+                }
+            }
+
+            double[] grid = new double[nWidePoints];
+            double[] counts = new double[nWidePoints];
+
+            opKernel.histogram(ArrayKernel.HI_LINEAR, wideValues, wideMin, wideMax, grid, counts);
+
+            RealArray dataset = new RealArray(nPoints, 2);
+
+            if (nWideValues > 0) {
+
+                // Only the cropped outputs are read, and the widening keeps them from wrapping around.
+                int len = Integer.highestOneBit(nWidePoints - 1) << 1;
+
+                RealArray binned = new RealArray(len);
+                RealArray kernel = new RealArray(len);
+
+                for (int j = 0; j < nWidePoints; j++) {
+                    binned.set(counts[j], j);
+                }
+
+                for (int j = 0; j <= radius; j++) {
+
+                    double t = j * binSpacing / h;
+                    double weight = Math.exp(-0.5 * t * t) / (h * Math.sqrt(2.0 * Math.PI) * n);
+
+                    kernel.set(weight, j);
+                    kernel.set(weight, (len - j) % len);
+                }
+
+                RealArray density = binned.rfft().eMul(kernel.rfft()).rifft();
+
+                for (int j = 0; j < nPoints; j++) {
+
+                    int k = j / stride + radius;
+                    double frac = (double) (j % stride) / stride;
+
+                    double value = (frac > 0.0) //
+                            ? (1.0 - frac) * density.get(k) + frac * density.get(k + 1) //
+                            : density.get(k);
+
+                    dataset.set(Math.max(value, 0.0), j, 1);
+                }
+            }
+
+            for (int j = 0; j < nPoints - 1; j++) {
+                dataset.set(min + j * spacing, j, 0);
+            }
+
+            dataset.set(max, nPoints - 1, 0);
+
+            maxDensity = Math.max(maxDensity, dataset.subarray(0, nPoints, 1, 2).aMax());
+
+            this.datasets[i] = dataset;
+            this.bandwidths[i] = h;
+        }
+
+        this.xrange = new double[] { min, max };
+        this.yrange = new double[] { 0, maxDensity };
+
+        this.dataTitles = PlotBase.createDefaultTitles(nClasses);
+        this.dataStyles = Arrays.newArray(DataStyle.class, nClasses, DataStyle.lines);
+    }
+
+    /**
+     * Alternate constructor that selects bandwidths automatically.
+     * 
+     * @param min
+     *            the range minimum.
+     * @param max
+     *            the range maximum.
+     * @param nPoints
+     *            the number of grid points.
+     * @param valuesArray
+     *            the array of values.
+     */
+    public KernelDensity(double min, double max, int nPoints, double[]... valuesArray) {
+        this(min, max, nPoints, 0.0, valuesArray);
+    }
+
+    /**
+     * Selects a bandwidth with Silverman's rule of thumb, which takes the smaller of the standard deviation and the
+     * normalized interquartile range as the spread.
+     * 
+     * @param values
+     *            the values.
+     * @param n
+     *            the number of non-NaN values.
+     * @return the bandwidth.
+     */
+    protected static double selectBandwidth(double[] values, int n) {
+
+        if (n < 2) {
+            return 0.0;
+        }
+
+        double[] edges = new double[5];
+        opKernel.histogram(ArrayKernel.HI_QUANTILE, values, 0.0, 0.0, edges, new double[4]);
+
+        double[] finiteValues = values;
+
+        if (n < values.length) {
+
+            finiteValues = new double[n];
+
+            for (int i = 0, j = 0, m = values.length; i < m; i++) {
+
+                if (values[i] == values[i]) {
+                    finiteValues[j++] = values[i];
+                }
+            }
+        }
+
+        double sigma = Math.sqrt(opKernel.raOp(ArrayKernel.RA_VAR, finiteValues));
+        double iqr = edges[3] - edges[1];
+        double spread = (iqr > 0.0) ? Math.min(sigma, iqr / 1.34) : sigma;
+
+        return 0.9 * spread * Math.pow(n, -0.2);
+    }
+
+    /**
+     * Gets the bandwidths.
+     */
+    public double[] getBandwidths() {
+        return this.bandwidths.clone();
+    }
+
+    @Override
+    public String getTitle() {
+        return "Kernel Density Estimate";
+    }
+
+    @Override
+    public RealArray[] getDatasets() {
+        return this.datasets;
+    }
+
+    @Override
+    public String[] getDataTitles() {
+        return this.dataTitles;
+    }
+
+    @Override
+    public DataStyle[] getDataStyles() {
+        return this.dataStyles;
+    }
+
+    @Override
+    public boolean isPropertyEnabled(String property) {
+        return false;
+    }
+
+    @Override
+    public double[] getAxisRange(AxisType axisType) {
+
+        switch (axisType) {
+
+        case X:
+            return this.xrange;
+
+        case Y:
+            return this.yrange;
+
+        default:
+            throw new IllegalArgumentException("Invalid axis type");
+        }
+    }
+
+    @Override
+    public String getAxisTitle(AxisType axisType) {
+
+        switch (axisType) {
+
+        case X:
+            return axisType.toString();
+
+        case Y:
+            return "density";
+
+        default:
+            throw new IllegalArgumentException("Invalid axis type");
+        }
+    }
+}
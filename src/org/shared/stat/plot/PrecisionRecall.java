@@ -29,6 +29,7 @@
 package org.shared.stat.plot;
 
 import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
 
 /**
  * A representation of precision-recall plots.
@@ -74,19 +75,8 @@ public class PrecisionRecall extends ErrorDistribution {
     }
 
     @Override
-    protected void initDataset(RealArray dataset, boolean[] outcomes) {
-
-        int nExamples = dataset.size(0);
-
-        for (int i = 0, nCorrect = 0; i < nExamples; i++) {
-
-            if (outcomes[i]) {
-                nCorrect++;
-            }
-
-            dataset.set(i / (double) nExamples, i, 0);
-            dataset.set((i > 0) ? nCorrect / (double) i : 1.0, i, 1);
-        }
+    protected int getCurveType() {
+        return ArrayKernel.EC_PR;
     }
 
     @Override
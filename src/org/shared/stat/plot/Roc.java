@@ -28,7 +28,7 @@
 
 package org.shared.stat.plot;
 
-import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
 
 /**
  * A representation of ROC (receiver operating characteristic) plots.
@@ -69,53 +69,8 @@ public class Roc extends ErrorDistribution {
     }
 
     @Override
-    protected void initDataset(RealArray dataset, boolean[] outcomes) {
-
-        int nExamples = dataset.size(0);
-
-        int nTrue = 0;
-        int nFalse = 0;
-
-        for (int i = 0; i < nExamples; i++) {
-
-            if (outcomes[i]) {
-
-                nTrue++;
-
-            } else {
-
-                nFalse++;
-            }
-
-            dataset.set(nFalse, i, 0);
-            dataset.set(nTrue, i, 1);
-        }
-
-        if (nFalse > 0) {
-
-            for (int i = 0; i < nExamples; i++) {
-                dataset.set(dataset.get(i, 0) / nFalse, i, 0);
-            }
-
-        } else {
-
-            for (int i = 0; i < nExamples; i++) {
-                dataset.set(0.0, i, 0);
-            }
-        }
-
-        if (nTrue > 0) {
-
-            for (int i = 0; i < nExamples; i++) {
-                dataset.set(dataset.get(i, 1) / nTrue, i, 1);
-            }
-
-        } else {
-
-            for (int i = 0; i < nExamples; i++) {
-                dataset.set(1.0, i, 1);
-            }
-        }
+    protected int getCurveType() {
+        return ArrayKernel.EC_ROC;
     }
 
     @Override
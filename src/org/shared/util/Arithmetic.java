@@ -42,6 +42,26 @@ public class Arithmetic {
      */
     final protected static Random randomKernel = new Random(0xdeadbeefcacabeadL);
 
+    /**
+     * The magnitude below which squares would underflow, as in Blue's algorithm.
+     */
+    final protected static double NORM2_SMALL_THRESHOLD = 0x1p-511;
+
+    /**
+     * The magnitude above which sums of squares could overflow, as in Blue's algorithm.
+     */
+    final protected static double NORM2_BIG_THRESHOLD = 0x1p486;
+
+    /**
+     * The scaling for small magnitudes.
+     */
+    final protected static double NORM2_SMALL_SCALE = 0x1p537;
+
+    /**
+     * The scaling for big magnitudes.
+     */
+    final protected static double NORM2_BIG_SCALE = 0x1p-538;
+
     /**
      * Computes the maximum.
      * 
@@ -155,6 +175,135 @@ public class Arithmetic {
         return -en;
     }
 
+    /**
+     * Computes the L1 norm.
+     * 
+     * @param values
+     *            the array.
+     * @return the L1 norm.
+     */
+    final public static double norm1(double... values) {
+
+        double acc = 0.0;
+
+        for (double v : values) {
+            acc += Math.abs(v);
+        }
+
+        return acc;
+    }
+
+    /**
+     * Computes the Euclidean norm without overflow or underflow.
+     * 
+     * @param values
+     *            the array.
+     * @return the Euclidean norm.
+     */
+    final public static double norm2(double... values) {
+
+        double[] sums = new double[3];
+
+        for (double v : values) {
+            norm2Accumulate(v, sums, 0);
+        }
+
+        return norm2Combine(sums, 0);
+    }
+
+    /**
+     * Computes the L-infinity norm. NaNs propagate.
+     * 
+     * @param values
+     *            the array.
+     * @return the L-infinity norm.
+     */
+    final public static double normInf(double... values) {
+
+        double acc = 0.0;
+
+        for (double v : values) {
+
+            double a = Math.abs(v);
+            acc = (a > acc || Double.isNaN(a)) ? a : acc;
+        }
+
+        return acc;
+    }
+
+    /**
+     * Accumulates the square of a value into one of three sums by magnitude, as in Blue's algorithm, so that the
+     * Euclidean norm comes out of {@link #norm2Combine(double[], int)} without overflow or underflow. NaNs land in
+     * the medium sum.
+     * 
+     * @param value
+     *            the value.
+     * @param sums
+     *            the scaled big, medium and scaled small sums of squares.
+     * @param offset
+     *            the offset into the sums.
+     */
+    final public static void norm2Accumulate(double value, double[] sums, int offset) {
+
+        double a = Math.abs(value);
+
+        boolean isBig = (a > NORM2_BIG_THRESHOLD);
+        boolean isSmall = (a < NORM2_SMALL_THRESHOLD);
+
+        double big = isBig ? a * NORM2_BIG_SCALE : 0.0;
+        double medium = (isBig || isSmall) ? 0.0 : a;
+        double small = isSmall ? a * NORM2_SMALL_SCALE : 0.0;
+
+        sums[offset] += big * big;
+        sums[offset + 1] += medium * medium;
+        sums[offset + 2] += small * small;
+    }
+
+    /**
+     * Combines sums of squares from {@link #norm2Accumulate(double, double[], int)} into a Euclidean norm.
+     * 
+     * @param sums
+     *            the scaled big, medium and scaled small sums of squares.
+     * @param offset
+     *            the offset into the sums.
+     * @return the Euclidean norm.
+     */
+    final public static double norm2Combine(double[] sums, int offset) {
+
+        double big = sums[offset];
+        double medium = sums[offset + 1];
+        double small = sums[offset + 2];
+
+        if (big > 0.0) {
+
+            // The medium sum only matters if it's NaN or could register against the big one.
+            if (medium > 0.0 || Double.isNaN(medium)) {
+                big += (medium * NORM2_BIG_SCALE) * NORM2_BIG_SCALE;
+            }
+
+            return Math.sqrt(big) / NORM2_BIG_SCALE;
+
+        } else if (small > 0.0) {
+
+            if (medium > 0.0 || Double.isNaN(medium)) {
+
+                double m = Math.sqrt(medium);
+                double sm = Math.sqrt(small) / NORM2_SMALL_SCALE;
+
+                double yMin = Math.min(m, sm);
+                double yMax = Math.max(m, sm);
+
+                return yMax * Math.sqrt(1.0 + (yMin / yMax) * (yMin / yMax));
+            }
+
+            return Math.sqrt(small) / NORM2_SMALL_SCALE;
+
+        } else {
+
+            return Math.sqrt(medium);
+        }
+    }
+
     /**
      * Shuffles the given array.
      * 
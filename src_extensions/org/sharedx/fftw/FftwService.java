@@ -36,18 +36,23 @@ import static org.sharedx.fftw.Plan.FFTW_MEASURE;
 import static org.sharedx.fftw.Plan.FFTW_PATIENT;
 import static org.sharedx.fftw.Plan.FORWARD;
 import static org.sharedx.fftw.Plan.R_TO_C;
+import static org.sharedx.fftw.Plan.STFT_COMPLEX;
 
 import java.lang.ref.Reference;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
 
+import org.shared.array.Array.IndexingOrder;
 import org.shared.fft.FftService;
+import org.shared.util.Arithmetic;
+import org.shared.util.Control;
 import org.shared.util.ReferenceReaper;
 import org.shared.util.ReferenceReaper.ReferenceType;
 
 /**
  * An <a href="http://www.fftw.org/">FFTW3</a>-backed service provider ascribing to {@link FftService}.
  * 
+ * @apiviz.owns org.sharedx.fftw.GuruPlan
  * @apiviz.owns org.sharedx.fftw.Plan
  * @author Roy Liu
  */
@@ -57,6 +62,8 @@ public class FftwService implements FftService {
 
     final ConcurrentMap<PlanKey, Reference<Plan>> planMap;
     final ReferenceReaper<Plan> rr;
+    final ConcurrentMap<GuruPlanKey, Reference<GuruPlan>> guruPlanMap;
+    final ReferenceReaper<GuruPlan> guruRr;
 
     /**
      * Default constructor.
@@ -65,6 +72,8 @@ public class FftwService implements FftService {
 
         this.planMap = new ConcurrentHashMap<PlanKey, Reference<Plan>>();
         this.rr = new ReferenceReaper<Plan>();
+        this.guruPlanMap = new ConcurrentHashMap<GuruPlanKey, Reference<GuruPlan>>();
+        this.guruRr = new ReferenceReaper<GuruPlan>();
 
         this.mode = FFTW_MEASURE;
     }
@@ -198,6 +207,393 @@ public class FftwService implements FftService {
         }
     }
 
+    /**
+     * Performs a transform of the given type along the given axes of an arbitrarily strided array, looping over the
+     * remaining axes. For real-to-complex and complex-to-real transforms, the last of the given axes is the one whose
+     * complex side has length {@code n / 2 + 1}. Strides are in units of real numbers for real arrays and complex
+     * numbers for interleaved complex arrays. If a cached plan for the layout doesn't exist, a new one is created and
+     * cached.
+     * 
+     * @param type
+     *            the kind of transform.
+     * @param dims
+     *            the logical dimensions of the array.
+     * @param axes
+     *            the axes to transform along.
+     * @param inStrides
+     *            the input strides.
+     * @param in
+     *            the input array.
+     * @param inOffset
+     *            the offset of the first input element.
+     * @param outStrides
+     *            the output strides.
+     * @param out
+     *            the output array.
+     * @param outOffset
+     *            the offset of the first output element.
+     */
+    public void transform(int type, int[] dims, int[] axes, //
+            int[] inStrides, double[] in, int inOffset, //
+            int[] outStrides, double[] out, int outOffset) {
+
+        int nDims = dims.length;
+        int rank = axes.length;
+
+        Control.checkTrue(nDims == inStrides.length && nDims == outStrides.length, //
+                "Invalid arguments");
+
+        boolean[] selected = new boolean[nDims];
+
+        int[] transformDims = new int[rank];
+        int[] transformInStrides = new int[rank];
+        int[] transformOutStrides = new int[rank];
+
+        for (int i = 0; i < rank; i++) {
+
+            int axis = axes[i];
+
+            Control.checkTrue(axis >= 0 && axis < nDims && !selected[axis], //
+                    "Invalid axis");
+
+            selected[axis] = true;
+
+            transformDims[i] = dims[axis];
+            transformInStrides[i] = inStrides[axis];
+            transformOutStrides[i] = outStrides[axis];
+        }
+
+        int howmanyRank = nDims - rank;
+
+        int[] loopDims = new int[howmanyRank];
+        int[] loopInStrides = new int[howmanyRank];
+        int[] loopOutStrides = new int[howmanyRank];
+
+        for (int dim = 0, i = 0; dim < nDims; dim++) {
+
+            if (!selected[dim]) {
+
+                loopDims[i] = dims[dim];
+                loopInStrides[i] = inStrides[dim];
+                loopOutStrides[i] = outStrides[dim];
+                i++;
+            }
+        }
+
+        final GuruPlanKey key = new GuruPlanKey(type, //
+                transformDims, transformInStrides, transformOutStrides, //
+                loopDims, loopInStrides, loopOutStrides, //
+                this.mode);
+
+        Reference<GuruPlan> ref = this.guruPlanMap.get(key);
+
+        GuruPlan plan = (ref != null) ? ref.get() : null;
+
+        if (plan == null) {
+
+            plan = new GuruPlan(type, //
+                    transformDims, transformInStrides, transformOutStrides, //
+                    loopDims, loopInStrides, loopOutStrides, //
+                    this.mode);
+
+            this.guruPlanMap.put(key, this.guruRr.wrap(ReferenceType.SOFT, plan, new Runnable() {
+
+                @Override
+                public void run() {
+                    FftwService.this.guruPlanMap.remove(key);
+                }
+            }));
+        }
+
+        plan.transform(in, inOffset, out, outOffset);
+    }
+
+    /**
+     * Computes the full linear convolution of a real array with a real kernel. Transforms are carried out over the
+     * smallest {@link #smoothSize(int)} padded dimensions that prevent wraparound, and the first passes of
+     * multidimensional transforms skip rows known to consist entirely of padding.
+     * 
+     * @param imDims
+     *            the array dimensions.
+     * @param im
+     *            the array.
+     * @param kerDims
+     *            the kernel dimensions.
+     * @param ker
+     *            the kernel.
+     * @return the convolution, whose dimensions are {@code imDims[i] + kerDims[i] - 1}.
+     */
+    public double[] convolve(int[] imDims, double[] im, int[] kerDims, double[] ker) {
+
+        int nDims = imDims.length;
+
+        Control.checkTrue(nDims > 0 && nDims == kerDims.length //
+                && im.length == Arithmetic.product(imDims) && ker.length == Arithmetic.product(kerDims), //
+                "Invalid arguments");
+
+        int[] dims = new int[nDims];
+        int[] outDims = new int[nDims];
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            Control.checkTrue(imDims[dim] > 0 && kerDims[dim] > 0, //
+                    "Invalid dimensions");
+
+            outDims[dim] = imDims[dim] + kerDims[dim] - 1;
+            dims[dim] = smoothSize(outDims[dim]);
+        }
+
+        double[] imSpectrum = prunedRfft(dims, imDims, im);
+        double[] kerSpectrum = prunedRfft(dims, kerDims, ker);
+
+        for (int i = 0, n = imSpectrum.length; i < n; i += 2) {
+
+            double re1 = imSpectrum[i];
+            double im1 = imSpectrum[i + 1];
+            double re2 = kerSpectrum[i];
+            double im2 = kerSpectrum[i + 1];
+
+            imSpectrum[i] = re1 * re2 - im1 * im2;
+            imSpectrum[i + 1] = re1 * im2 + im1 * re2;
+        }
+
+        return prunedRifft(dims, outDims, imSpectrum, kerSpectrum);
+    }
+
+    /**
+     * Gets the smallest size no less than the given one whose prime factors are among 2, 3, 5, and 7. FFTW transforms
+     * such sizes efficiently.
+     * 
+     * @param n
+     *            the lower bound.
+     * @return the smooth size.
+     */
+    final public static int smoothSize(int n) {
+
+        Control.checkTrue(n > 0, //
+                "Invalid size");
+
+        for (int m = n;; m++) {
+
+            int r = m;
+
+            for (int p : SMOOTH_PRIMES) {
+
+                for (; r % p == 0;) {
+                    r /= p;
+                }
+            }
+
+            if (r == 1) {
+                return m;
+            }
+        }
+    }
+
+    /**
+     * The prime factors of smooth sizes.
+     */
+    final protected static int[] SMOOTH_PRIMES = new int[] { 2, 3, 5, 7 };
+
+    /**
+     * Computes the reduced FFT of an array zero padded to the given dimensions. Only the rows holding data are
+     * transformed along the last dimension, and each subsequent pass along a dimension skips rows that are zero
+     * because of padding in the dimensions not yet transformed.
+     * 
+     * @param dims
+     *            the padded dimensions.
+     * @param srcDims
+     *            the array dimensions.
+     * @param src
+     *            the array.
+     * @return the half-complex spectrum, laid out in row-major order.
+     */
+    protected double[] prunedRfft(int[] dims, int[] srcDims, double[] src) {
+
+        int nDims = dims.length;
+        int last = nDims - 1;
+
+        int[] cDims = dims.clone();
+        cDims[last] = dims[last] / 2 + 1;
+
+        int[] cStrides = IndexingOrder.FAR.strides(cDims);
+
+        // Pad along the last dimension only.
+
+        int[] rowDims = srcDims.clone();
+        rowDims[last] = dims[last];
+
+        double[] rows = new double[Arithmetic.product(rowDims)];
+
+        for (int i = 0, n = src.length / srcDims[last]; i < n; i++) {
+            System.arraycopy(src, i * srcDims[last], rows, i * dims[last], srcDims[last]);
+        }
+
+        int cLen = 2 * Arithmetic.product(cDims);
+
+        double[] in = new double[cLen];
+        double[] out = new double[cLen];
+
+        int[] passDims = srcDims.clone();
+        passDims[last] = dims[last];
+
+        transform(R_TO_C, passDims, new int[] { last }, //
+                IndexingOrder.FAR.strides(rowDims), rows, 0, cStrides, out, 0);
+
+        passDims[last] = cDims[last];
+
+        for (int dim = last - 1; dim >= 0; dim--) {
+
+            double[] tmp = in;
+            in = out;
+            out = tmp;
+
+            passDims[dim] = dims[dim];
+
+            transform(FORWARD, passDims, new int[] { dim }, cStrides, in, 0, cStrides, out, 0);
+        }
+
+        return out;
+    }
+
+    /**
+     * Computes the reduced IFFT of a half-complex spectrum and crops the result to the given dimensions. Each pass
+     * along a dimension skips rows that get cropped away in the dimensions already transformed. Both of the given
+     * arrays are overwritten.
+     * 
+     * @param dims
+     *            the padded dimensions.
+     * @param dstDims
+     *            the cropped dimensions.
+     * @param spectrum
+     *            the half-complex spectrum, laid out in row-major order.
+     * @param scratch
+     *            a scratch array of the same size.
+     * @return the cropped result.
+     */
+    protected double[] prunedRifft(int[] dims, int[] dstDims, double[] spectrum, double[] scratch) {
+
+        int nDims = dims.length;
+        int last = nDims - 1;
+
+        int[] cDims = dims.clone();
+        cDims[last] = dims[last] / 2 + 1;
+
+        int[] cStrides = IndexingOrder.FAR.strides(cDims);
+
+        double[] in = scratch;
+        double[] out = spectrum;
+
+        int[] passDims = cDims.clone();
+
+        for (int dim = 0; dim < last; dim++) {
+
+            double[] tmp = in;
+            in = out;
+            out = tmp;
+
+            transform(BACKWARD, passDims, new int[] { dim }, cStrides, in, 0, cStrides, out, 0);
+
+            passDims[dim] = dstDims[dim];
+        }
+
+        int[] rowDims = dstDims.clone();
+        rowDims[last] = dims[last];
+
+        double[] rows = new double[Arithmetic.product(rowDims)];
+
+        passDims[last] = dims[last];
+
+        transform(C_TO_R, passDims, new int[] { last }, //
+                cStrides, out, 0, IndexingOrder.FAR.strides(rowDims), rows, 0);
+
+        // Crop along the last dimension.
+
+        double[] dst = new double[Arithmetic.product(dstDims)];
+
+        for (int i = 0, n = dst.length / dstDims[last]; i < n; i++) {
+            System.arraycopy(rows, i * dims[last], dst, i * dstDims[last], dstDims[last]);
+        }
+
+        return dst;
+    }
+
+    /**
+     * Computes a short-time Fourier transform with a cached real-to-complex plan whose length is that of the window.
+     * Frames start every {@code hop} samples and lie entirely inside the signal.
+     * 
+     * @param signal
+     *            the signal.
+     * @param window
+     *            the analysis window.
+     * @param hop
+     *            the hop size.
+     * @param outputType
+     *            the output type, one of {@link Plan#STFT_COMPLEX}, {@link Plan#STFT_MAGNITUDE},
+     *            {@link Plan#STFT_POWER}, and {@link Plan#STFT_LOG_MAGNITUDE}.
+     * @return the spectra of consecutive frames, each consisting of interleaved complex values if the output type is
+     *         {@link Plan#STFT_COMPLEX} and of {@code window.length / 2 + 1} real values otherwise.
+     */
+    public double[] stft(double[] signal, double[] window, int hop, int outputType) {
+
+        int frameLen = window.length;
+        int nBins = frameLen / 2 + 1;
+
+        double[] out = new double[frameCount(signal.length, frameLen, hop) //
+                * ((outputType == STFT_COMPLEX) ? 2 * nBins : nBins)];
+
+        getPlan(R_TO_C, new int[] { frameLen }, this.mode).stft(signal, window, hop, outputType, out);
+
+        return out;
+    }
+
+    /**
+     * Computes an inverse short-time Fourier transform with a cached complex-to-real plan by weighted overlap-add.
+     * 
+     * @param in
+     *            the complex spectra of consecutive frames.
+     * @param window
+     *            the synthesis window.
+     * @param hop
+     *            the hop size.
+     * @return the reconstructed signal.
+     */
+    public double[] istft(double[] in, double[] window, int hop) {
+
+        int frameLen = window.length;
+        int spectrumLen = 2 * (frameLen / 2 + 1);
+
+        Control.checkTrue(hop > 0 && in.length % spectrumLen == 0, //
+                "Invalid arguments");
+
+        int nFrames = in.length / spectrumLen;
+
+        double[] out = new double[(nFrames > 0) ? (nFrames - 1) * hop + frameLen : 0];
+
+        getPlan(C_TO_R, new int[] { frameLen }, this.mode).istft(in, window, hop, out);
+
+        return out;
+    }
+
+    /**
+     * Gets the number of frames of a short-time Fourier transform.
+     * 
+     * @param signalLen
+     *            the signal length.
+     * @param frameLen
+     *            the frame length.
+     * @param hop
+     *            the hop size.
+     * @return the number of frames.
+     */
+    final public static int frameCount(int signalLen, int frameLen, int hop) {
+
+        Control.checkTrue(frameLen > 0 && hop > 0, //
+                "Invalid arguments");
+
+        return (signalLen >= frameLen) ? (signalLen - frameLen) / hop + 1 : 0;
+    }
+
     /**
      * Performs a transform of the given type and dimensions on the given input/output arrays. If a cached transform
      * doesn't exist, a new one is created and cached. Computation time initially depends on the amount of
@@ -215,6 +611,21 @@ public class FftwService implements FftService {
      *            the output array.
      */
     protected void transform(int type, int[] dims, int mode, double[] in, double[] out) {
+        getPlan(type, dims, mode).transform(in, out);
+    }
+
+    /**
+     * Gets a cached plan of the given type and dimensions, creating and caching a new one if it doesn't exist.
+     * 
+     * @param type
+     *            the kind of transform.
+     * @param dims
+     *            the dimensions of the transform.
+     * @param mode
+     *            the transform mode.
+     * @return the plan.
+     */
+    protected Plan getPlan(int type, int[] dims, int mode) {
 
         final PlanKey key = new PlanKey(type, dims, mode);
 
@@ -235,6 +646,6 @@ public class FftwService implements FftService {
             }));
         }
 
-        plan.transform(in, out);
+        return plan;
     }
 }
@@ -0,0 +1,144 @@
+/**
+ * <p>
+ * Copyright (c) 2006 The Regents of the University of California<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+package org.sharedx.fftw;
+
+import java.util.Arrays;
+
+/**
+ * The Java peer to <a href="http://www.fftw.org/">FFTW3</a> {@code plan} structures created through the guru
+ * interface. Such plans transform along arbitrarily strided dimensions and loop over the remaining ones, and so they
+ * operate directly on array layouts without permuting or copying. Strides are in units of real numbers for real arrays
+ * and complex numbers for interleaved complex arrays.
+ * 
+ * @author Roy Liu
+ */
+public class GuruPlan extends GuruPlanKey {
+
+    // The pointer to the native peer.
+    final byte[] memory;
+
+    /**
+     * Default constructor.
+     * 
+     * @param type
+     *            the transform type, one of {@link Plan#R_TO_C}, {@link Plan#C_TO_R}, {@link Plan#FORWARD}, and
+     *            {@link Plan#BACKWARD}.
+     * @param dims
+     *            the logical transform dimensions.
+     * @param inStrides
+     *            the input strides of the transform dimensions.
+     * @param outStrides
+     *            the output strides of the transform dimensions.
+     * @param loopDims
+     *            the loop dimensions.
+     * @param loopInStrides
+     *            the input strides of the loop dimensions.
+     * @param loopOutStrides
+     *            the output strides of the loop dimensions.
+     * @param mode
+     *            the mode of the transform.
+     */
+    public GuruPlan(int type, //
+            int[] dims, int[] inStrides, int[] outStrides, //
+            int[] loopDims, int[] loopInStrides, int[] loopOutStrides, //
+            int mode) {
+        super(type, dims.clone(), inStrides.clone(), outStrides.clone(), //
+                loopDims.clone(), loopInStrides.clone(), loopOutStrides.clone(), mode);
+
+        this.memory = create(this.type, this.dims, this.inStrides, this.outStrides, //
+                this.loopDims, this.loopInStrides, this.loopOutStrides, this.mode);
+    }
+
+    /**
+     * Creates a human-readable representation of this plan.
+     */
+    @Override
+    public String toString() {
+        return String.format("%s[%s, %s, %s, %s, %s, %s, %s, %s]", //
+                GuruPlan.class.getSimpleName(), //
+                FftwService.typeToString(this.type), //
+                Arrays.toString(this.dims), Arrays.toString(this.inStrides), Arrays.toString(this.outStrides), //
+                Arrays.toString(this.loopDims), Arrays.toString(this.loopInStrides), //
+                Arrays.toString(this.loopOutStrides), //
+                FftwService.modeToString(this.mode));
+    }
+
+    /**
+     * Performs an out-of-place transform.
+     * 
+     * @param in
+     *            the input array.
+     * @param inOffset
+     *            the offset of the first input element.
+     * @param out
+     *            the output array.
+     * @param outOffset
+     *            the offset of the first output element.
+     */
+    final public native void transform(double[] in, int inOffset, double[] out, int outOffset);
+
+    /**
+     * Creates a pointer to the native peer.
+     * 
+     * @param type
+     *            the transform type.
+     * @param dims
+     *            the logical transform dimensions.
+     * @param inStrides
+     *            the input strides of the transform dimensions.
+     * @param outStrides
+     *            the output strides of the transform dimensions.
+     * @param loopDims
+     *            the loop dimensions.
+     * @param loopInStrides
+     *            the input strides of the loop dimensions.
+     * @param loopOutStrides
+     *            the output strides of the loop dimensions.
+     * @param mode
+     *            the transform mode.
+     * @return a pointer to the native peer.
+     */
+    final protected native byte[] create(int type, //
+            int[] dims, int[] inStrides, int[] outStrides, //
+            int[] loopDims, int[] loopInStrides, int[] loopOutStrides, //
+            int mode);
+
+    /**
+     * Destroys the native peer.
+     */
+    final protected native void destroy();
+
+    // The finalizer guardian for the native peer.
+    final Object reaper = new Object() {
+
+        @Override
+        protected void finalize() {
+            GuruPlan.this.destroy();
+        }
+    };
+}
@@ -0,0 +1,109 @@
+/**
+ * <p>
+ * Copyright (c) 2006 The Regents of the University of California<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+package org.sharedx.fftw;
+
+import java.util.Arrays;
+
+/**
+ * A base class for {@link GuruPlan} suitable for hashing.
+ * 
+ * @author Roy Liu
+ */
+public class GuruPlanKey {
+
+    final int type, mode;
+    final int[] dims, inStrides, outStrides;
+    final int[] loopDims, loopInStrides, loopOutStrides;
+
+    /**
+     * Default constructor.
+     * 
+     * @param type
+     *            the transform type.
+     * @param dims
+     *            the logical transform dimensions.
+     * @param inStrides
+     *            the input strides of the transform dimensions.
+     * @param outStrides
+     *            the output strides of the transform dimensions.
+     * @param loopDims
+     *            the loop dimensions.
+     * @param loopInStrides
+     *            the input strides of the loop dimensions.
+     * @param loopOutStrides
+     *            the output strides of the loop dimensions.
+     * @param mode
+     *            the mode of the transform.
+     */
+    public GuruPlanKey(int type, //
+            int[] dims, int[] inStrides, int[] outStrides, //
+            int[] loopDims, int[] loopInStrides, int[] loopOutStrides, //
+            int mode) {
+
+        this.type = type;
+        this.mode = mode;
+        this.dims = dims;
+        this.inStrides = inStrides;
+        this.outStrides = outStrides;
+        this.loopDims = loopDims;
+        this.loopInStrides = loopInStrides;
+        this.loopOutStrides = loopOutStrides;
+    }
+
+    /**
+     * Fulfills the {@link #equals(Object)} contract.
+     */
+    @Override
+    public boolean equals(Object o) {
+
+        if (!(o instanceof GuruPlanKey)) {
+            return false;
+        }
+
+        GuruPlanKey p = (GuruPlanKey) o;
+
+        return this.type == p.type //
+                && this.mode == p.mode //
+                && Arrays.equals(this.dims, p.dims) //
+                && Arrays.equals(this.inStrides, p.inStrides) //
+                && Arrays.equals(this.outStrides, p.outStrides) //
+                && Arrays.equals(this.loopDims, p.loopDims) //
+                && Arrays.equals(this.loopInStrides, p.loopInStrides) //
+                && Arrays.equals(this.loopOutStrides, p.loopOutStrides);
+    }
+
+    /**
+     * Fulfills the {@link #hashCode()} contract.
+     */
+    @Override
+    public int hashCode() {
+        return this.type ^ this.mode ^ Arrays.hashCode(this.dims) //
+                ^ Arrays.hashCode(this.inStrides) ^ Arrays.hashCode(this.outStrides) //
+                ^ Arrays.hashCode(this.loopDims);
+    }
+}
@@ -107,6 +107,26 @@ public class Plan extends PlanKey {
      */
     final public static int FFTW_EXHAUSTIVE = 3;
 
+    /**
+     * Short-time Fourier transform output. Interleaved half-complex spectra.
+     */
+    final public static int STFT_COMPLEX = 0;
+
+    /**
+     * Short-time Fourier transform output. Magnitude spectra.
+     */
+    final public static int STFT_MAGNITUDE = 1;
+
+    /**
+     * Short-time Fourier transform output. Power spectra.
+     */
+    final public static int STFT_POWER = 2;
+
+    /**
+     * Short-time Fourier transform output. Natural logarithms of magnitude spectra.
+     */
+    final public static int STFT_LOG_MAGNITUDE = 3;
+
     /**
      * Exports learned wisdom to a string.
      * 
@@ -132,6 +152,39 @@ public class Plan extends PlanKey {
      */
     final public native void transform(double[] in, double[] out);
 
+    /**
+     * Performs a short-time Fourier transform with this one-dimensional, real-to-complex plan, whose length is the
+     * frame length. Frames start every {@code hop} samples and lie entirely inside the signal; their spectra are
+     * written out consecutively.
+     * 
+     * @param signal
+     *            the signal.
+     * @param window
+     *            the analysis window.
+     * @param hop
+     *            the hop size.
+     * @param outputType
+     *            the output type.
+     * @param out
+     *            the output array.
+     */
+    final public native void stft(double[] signal, double[] window, int hop, int outputType, double[] out);
+
+    /**
+     * Performs an inverse short-time Fourier transform with this one-dimensional, complex-to-real plan by weighted
+     * overlap-add. Samples not covered by the window are set to zero.
+     * 
+     * @param in
+     *            the consecutive half-complex spectra.
+     * @param window
+     *            the synthesis window.
+     * @param hop
+     *            the hop size.
+     * @param out
+     *            the output signal.
+     */
+    final public native void istft(double[] in, double[] window, int hop, double[] out);
+
     /**
      * Creates a pointer to the native peer.
      * 
@@ -36,6 +36,7 @@ import org.shared.metaclass.Loader.EntryPoint;
 import org.shared.metaclass.Loader.LoadableResources;
 import org.shared.metaclass.RegistryClassLoader;
 import org.shared.test.array.AllArrayOperationTests;
+import org.shared.test.fft.AllFftTests;
 import org.shared.test.image.AllImageTests;
 import org.shared.test.stat.AllMlTests;
 import org.shared.util.Control;
@@ -58,6 +59,7 @@ packages = {
 //
         "org.shared.test", //
         "org.shared.array.jni", //
+        "org.shared.fft.jni", //
         "org.shared.image.jni" //
 })
 public class AllNative {
@@ -92,14 +94,15 @@ public class AllNative {
             return;
         }
 
-        Control.checkTrue(ArrayBase.opKernel.useRegisteredKernel() && ImageOps.imKernel.useRegisteredKernel(), //
+        Control.checkTrue(ArrayBase.opKernel.useRegisteredKernel() && ImageOps.imKernel.useRegisteredKernel() //
+                && ArrayBase.fftService.useRegisteredService(), //
                 "Could not link native library");
 
         ArrayBase.ioKernel.useMatlabIo();
-        ArrayBase.fftService.useJava();
 
         Tests.runTests("Native Tests", //
                 AllArrayOperationTests.class, //
+                AllFftTests.class, //
                 AllMlTests.class, //
                 AllImageTests.class);
     }
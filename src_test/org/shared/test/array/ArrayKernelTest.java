@@ -270,6 +270,25 @@ public class ArrayKernelTest {
 
         //
 
+        double[] src;
+
+        kernel.ruOpTo(ArrayKernel.RU_EXP, Double.NaN, src = new double[] { 0, -1, 1 }, v = new double[3]);
+        Assert.assertTrue(Tests.equals(v, new double[] { 1, Math.exp(-1), Math.exp(1) }));
+        Assert.assertTrue(Tests.equals(src, new double[] { 0, -1, 1 }));
+
+        kernel.cuOpTo(ArrayKernel.CU_CONJ, Double.NaN, Double.NaN, //
+                src = new double[] { 1, 2, 3, -4 }, v = new double[4]);
+        Assert.assertTrue(Tests.equals(v, new double[] { 1, -2, 3, 4 }));
+        Assert.assertTrue(Tests.equals(src, new double[] { 1, 2, 3, -4 }));
+
+        int[] isrc;
+
+        kernel.iuOpTo(ArrayKernel.IU_MUL, 3, isrc = new int[] { 1, 2, 3 }, iv = new int[3]);
+        Assert.assertTrue(Arrays.equals(iv, new int[] { 3, 6, 9 }));
+        Assert.assertTrue(Arrays.equals(isrc, new int[] { 1, 2, 3 }));
+
+        //
+
         kernel.eOp(ArrayKernel.RE_ADD, //
                 new double[] { 1, -1, -1 }, //
                 new double[] { -2, 1, 2 }, v = new double[3], false);
@@ -376,4 +395,76 @@ public class ArrayKernelTest {
         kernel.convert(ArrayKernel.I_TO_R, new int[] { 1, 2, 3, 4, 5, 6 }, false, v = new double[6], false);
         Assert.assertTrue(Tests.equals(v, new double[] { 1, 2, 3, 4, 5, 6 }));
     }
+
+    /**
+     * Tests {@link ArrayKernel#errorCurve(int, double[], boolean[], int, double[])}.
+     */
+    @Test
+    public void testErrorCurve() {
+
+        ArrayKernel kernel = opKernel;
+
+        double[] scores = new double[] { 0.9, 0.8, 0.8, 0.3, Double.NaN };
+        boolean[] outcomes = new boolean[] { true, true, false, false, true };
+        double[] stats = new double[2];
+
+        // Tied scores contribute one point, and NaN scores rank last.
+        Assert.assertTrue(Tests.equals(kernel.errorCurve(ArrayKernel.EC_ROC, scores, outcomes, 0, stats), //
+                new double[] { 0, 0, 0, 1.0 / 3.0, 0.5, 2.0 / 3.0, 1, 2.0 / 3.0, 1, 1 }));
+        Assert.assertTrue(Tests.equals(stats, new double[] { 7.0 / 12.0, 34.0 / 45.0 }));
+
+        Assert.assertTrue(Tests.equals(kernel.errorCurve(ArrayKernel.EC_PR, scores, outcomes, 0, stats), //
+                new double[] { 0, 1, 1.0 / 3.0, 1, 2.0 / 3.0, 2.0 / 3.0, 2.0 / 3.0, 0.5, 1, 0.6 }));
+
+        Assert.assertTrue(Tests.equals(kernel.errorCurve(ArrayKernel.EC_ROC, scores, outcomes, 3, stats), //
+                new double[] { 0, 0, 0.5, 2.0 / 3.0, 1, 1 }));
+    }
+
+    /**
+     * Tests {@link ArrayKernel#histogram(int, double[], double, double, double[], double[])}.
+     */
+    @Test
+    public void testHistogram() {
+
+        ArrayKernel kernel = opKernel;
+
+        double[] values = new double[] { 0.5, 1.5, 1.5, 3.9, -2, Double.NaN, 10 };
+        double[] edges, counts;
+
+        // NaNs are skipped, and values outside of the range go to the nearest bin.
+        kernel.histogram(ArrayKernel.HI_FIXED, values, 0, 4, edges = new double[5], counts = new double[4]);
+        Assert.assertTrue(Tests.equals(edges, new double[] { 0, 1, 2, 3, 4 }));
+        Assert.assertTrue(Tests.equals(counts, new double[] { 2, 2, 0, 2 }));
+
+        kernel.histogram(ArrayKernel.HI_QUANTILE, values, 0, 0, edges = new double[3], counts = new double[2]);
+        Assert.assertTrue(Tests.equals(edges, new double[] { -2, 1.5, 10 }));
+        Assert.assertTrue(Tests.equals(counts, new double[] { 2, 4 }));
+
+        kernel.histogram(ArrayKernel.HI_LINEAR, values, 0, 4, edges = new double[5], counts = new double[5]);
+        Assert.assertTrue(Tests.equals(edges, new double[] { 0, 1, 2, 3, 4 }));
+        Assert.assertTrue(Tests.equals(counts, new double[] { 1.5, 1.5, 1, 0.1, 1.9 }));
+    }
+
+    /**
+     * Tests {@link ArrayKernel#lttb(double[], double[], int)} and
+     * {@link ArrayKernel#thin(double[], double[], double[], int, int)}.
+     */
+    @Test
+    public void testDownsample() {
+
+        ArrayKernel kernel = opKernel;
+
+        double[] x = new double[] { 0, 1, 2, 3, 4, 5, 6 };
+        double[] y = new double[] { 0, 5, 0, 0, -5, 0, 0 };
+
+        // The extremes survive, along with the endpoints.
+        Assert.assertTrue(Arrays.equals(kernel.lttb(x, y, 4), new int[] { 0, 1, 4, 6 }));
+        Assert.assertTrue(Arrays.equals(kernel.lttb(x, y, 8), new int[] { 0, 1, 2, 3, 4, 5, 6 }));
+
+        x = new double[] { 0.1, 0.2, 0.9, 0.6, Double.NaN, 2, 1 };
+        y = new double[] { 0.1, 0.3, 0.9, 0.1, 0.5, 0.5, 1 };
+
+        // Points outside of the bounds are dropped, and points on the upper bounds go to the last cells.
+        Assert.assertTrue(Arrays.equals(kernel.thin(x, y, new double[] { 0, 1, 0, 1 }, 2, 2), new int[] { 0, 2, 3 }));
+    }
 }
@@ -32,13 +32,19 @@ import java.util.Arrays;
 
 import org.junit.Assert;
 import org.junit.Test;
+import org.shared.array.AbstractComplexArray;
 import org.shared.array.AbstractRealArray;
 import org.shared.array.AbstractRealArray.RealMap;
 import org.shared.array.AbstractRealArray.RealReduce;
 import org.shared.array.Array;
 import org.shared.array.Array.IndexingOrder;
+import org.shared.array.ComplexArray;
+import org.shared.array.HalfArray;
 import org.shared.array.IntegerArray;
+import org.shared.array.Mask;
+import org.shared.array.ProtoArray;
 import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
 import org.shared.test.Tests;
 import org.shared.util.Arithmetic;
 
@@ -686,6 +692,208 @@ public class RealArrayTest {
         Assert.assertTrue(Arrays.equals(a.concat(1, b, a).values(), expected.values()));
     }
 
+    /**
+     * Tests {@link Array#stack(int, Array...)}.
+     */
+    @Test
+    public void testStack() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                0, 1, 2, //
+                3, 4, 5 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3 //
+        );
+
+        RealArray b = new RealArray(new double[] {
+                //
+                6, 9, //
+                7, 10, //
+                8, 11 //
+                }, //
+                IndexingOrder.FAR, //
+                3, 2 //
+        ).transpose(1, 0).reverseOrder();
+
+        RealArray expected = new RealArray(new double[] {
+                //
+                0, 6, //
+                1, 7, //
+                2, 8, //
+                //
+                3, 9, //
+                4, 10, //
+                5, 11 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3, 2 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.stack(2, b).values(), expected.values()));
+
+        expected = new RealArray(new double[] {
+                //
+                0, 1, 2, //
+                3, 4, 5, //
+                //
+                6, 7, 8, //
+                9, 10, 11 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 2, 3 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.stack(0, b).values(), expected.values()));
+
+        // Sources in a different storage order still land in place.
+        Assert.assertTrue(Arrays.equals(a.concat(0, b).values(), expected.reshape(4, 3).values()));
+    }
+
+    /**
+     * Tests {@link RealArray#pad(int, int...)} and {@link RealArray#padConstant(Double, int...)}.
+     */
+    @Test
+    public void testPad() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                1, 2, 3, //
+                4, 5, 6 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3 //
+        );
+
+        RealArray expected = new RealArray(new double[] {
+                //
+                5, 4, 5, 6, 5, 4, //
+                2, 1, 2, 3, 2, 1, //
+                5, 4, 5, 6, 5, 4, //
+                2, 1, 2, 3, 2, 1 //
+                }, //
+                IndexingOrder.FAR, //
+                4, 6 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.pad(ArrayKernel.PM_REFLECT, 1, 1, 1, 2).values(), expected.values()));
+
+        expected = new RealArray(new double[] {
+                //
+                1, 1, 2, 3, 3, 2, //
+                1, 1, 2, 3, 3, 2, //
+                4, 4, 5, 6, 6, 5, //
+                4, 4, 5, 6, 6, 5 //
+                }, //
+                IndexingOrder.FAR, //
+                4, 6 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.pad(ArrayKernel.PM_SYMMETRIC, 1, 1, 1, 2).values(), expected.values()));
+
+        expected = new RealArray(new double[] {
+                //
+                1, 1, 2, 3, 3, 3, //
+                1, 1, 2, 3, 3, 3, //
+                4, 4, 5, 6, 6, 6, //
+                4, 4, 5, 6, 6, 6 //
+                }, //
+                IndexingOrder.FAR, //
+                4, 6 //
+        );
+
+        // The source storage order does not matter.
+        Assert.assertTrue(Arrays.equals(a.reverseOrder().pad(ArrayKernel.PM_REPLICATE, 1, 1, 1, 2).values(), //
+                expected.reverseOrder().values()));
+
+        expected = new RealArray(new double[] {
+                //
+                6, 4, 5, 6, 4, 5, //
+                3, 1, 2, 3, 1, 2, //
+                6, 4, 5, 6, 4, 5, //
+                3, 1, 2, 3, 1, 2 //
+                }, //
+                IndexingOrder.FAR, //
+                4, 6 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.pad(ArrayKernel.PM_CIRCULAR, 1, 1, 1, 2).values(), expected.values()));
+
+        expected = new RealArray(new double[] {
+                //
+                -1, -1, -1, -1, -1, -1, //
+                -1, 1, 2, 3, -1, -1, //
+                -1, 4, 5, 6, -1, -1, //
+                -1, -1, -1, -1, -1, -1 //
+                }, //
+                IndexingOrder.FAR, //
+                4, 6 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.padConstant(-1.0, 1, 1, 1, 2).values(), expected.values()));
+    }
+
+    /**
+     * Tests {@link RealArray#gather(int, int...)}, {@link RealArray#scatter(int, RealArray, int, int...)}, and their
+     * linear counterparts.
+     */
+    @Test
+    public void testGatherScatter() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                1, 2, 3, //
+                4, 5, 6 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3 //
+        );
+
+        RealArray expected = new RealArray(new double[] {
+                //
+                3, 1, 3, 2, //
+                6, 4, 6, 5 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 4 //
+        );
+
+        RealArray gathered = a.reverseOrder().gather(1, 2, 0, 2, 1);
+
+        Assert.assertTrue(Arrays.equals(gathered.reverseOrder().values(), expected.values()));
+
+        expected = new RealArray(new double[] {
+                //
+                2, 4, 9, //
+                8, 10, 18 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3 //
+        );
+
+        Assert.assertTrue(Arrays.equals(gathered.reverseOrder() //
+                .scatter(ArrayKernel.SC_ADD, a.clone(), 1, 2, 0, 2, 1).values(), expected.values()));
+
+        expected = new RealArray(new double[] {
+                //
+                1, 2, 3, //
+                4, 5, 6 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3 //
+        );
+
+        Assert.assertTrue(Arrays.equals(gathered.reverseOrder() //
+                .scatter(ArrayKernel.SC_MAX, a.clone(), 1, 2, 0, 2, 1).values(), expected.values()));
+
+        Assert.assertTrue(Arrays.equals(a.gatherLinear(5, 0, 0).values(), new double[] { 6, 1, 1 }));
+
+        Assert.assertTrue(Arrays.equals(new RealArray(new double[] { 1, 2, 3 }, 3) //
+                .scatterLinear(ArrayKernel.SC_ADD, new RealArray(2, 3), 5, 0, 0).values(), //
+                new double[] { 5, 0, 0, 0, 0, 1 }));
+    }
+
     /**
      * Tests {@link RealArray#reverseOrder()}.
      */
@@ -937,6 +1145,73 @@ public class RealArrayTest {
         Assert.assertTrue(Arrays.equals(a.rVar(0).values(), expected.values()));
     }
 
+    /**
+     * Tests that reducing several dimensions at once agrees with reducing them one at a time.
+     */
+    @Test
+    public void testRrOpsMultiple() {
+
+        for (IndexingOrder order : new IndexingOrder[] { IndexingOrder.FAR, IndexingOrder.NEAR }) {
+
+            RealArray a = new RealArray(order, 3, 4, 1, 5, 2).uRnd(1.0);
+
+            Assert.assertTrue(Tests.equals(a.rSum(1, 3, 4).values(), //
+                    a.rSum(1).rSum(3).rSum(4).values()));
+
+            Assert.assertTrue(Tests.equals(a.rSum(0, 2).values(), //
+                    a.rSum(0).values()));
+
+            Assert.assertTrue(Arrays.equals(a.rMax(0, 1, 2, 3, 4).values(), //
+                    a.rMax(0).rMax(1).rMax(3).rMax(4).values()));
+
+            Assert.assertTrue(Arrays.equals(a.rMin(0, 3).values(), //
+                    a.rMin(3).rMin(0).values()));
+
+            Assert.assertTrue(Tests.equals(a.rProd(1, 4).values(), //
+                    a.rProd(4).rProd(1).values()));
+        }
+    }
+
+    /**
+     * Tests norms over elements and along dimensions, including magnitudes whose squares overflow or underflow.
+     */
+    @Test
+    public void testNorms() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                3, -4, 0, //
+                -1, 2, -2 //
+                }, //
+                2, 3);
+
+        Assert.assertTrue(Tests.equals(a.rNorm1(1).values(), new double[] { 7, 5 }));
+        Assert.assertTrue(Tests.equals(a.rNorm2(1).values(), new double[] { 5, 3 }));
+        Assert.assertTrue(Tests.equals(a.rNormInf(0).values(), new double[] { 3, 4, 2 }));
+        Assert.assertTrue(Tests.equals(a.rNorm2(0, 1).values(), new double[] { Math.sqrt(34) }));
+
+        Assert.assertEquals(12.0, a.aNorm1(), 1e-10);
+        Assert.assertEquals(Math.sqrt(34), a.aNorm2(), 1e-10);
+        Assert.assertEquals(4.0, a.aNormInf(), 1e-10);
+
+        RealArray b = new RealArray(new double[] { 3e300, -4e300, 3e-310, -4e-310 }, 2, 2);
+
+        Assert.assertEquals(1.0, b.rNorm2(1).get(0, 0) / 5e300, 1e-14);
+        Assert.assertEquals(1.0, b.rNorm2(1).get(1, 0) / 5e-310, 1e-10);
+        Assert.assertEquals(1.0, b.aNorm2() / 5e300, 1e-14);
+
+        // The spectral norm of a diagonal matrix is its largest magnitude.
+        RealArray c = new RealArray(new double[] {
+                //
+                2, 0, 0, //
+                0, -5, 0, //
+                0, 0, 1 //
+                }, //
+                3, 3);
+
+        Assert.assertEquals(5.0, c.mNormEstimate(50), 1e-8);
+    }
+
     /**
      * Tests dimension index functions.
      */
@@ -1360,6 +1635,477 @@ public class RealArrayTest {
         Assert.assertTrue(Arrays.equals(a.dProd(1).values(), expected.values()));
     }
 
+    /**
+     * Tests window functions.
+     */
+    @Test
+    public void testRwOps() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                1, 3, 2, 5, 4, //
+                4, 0, -1, 2, 8 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 5 //
+        );
+
+        Assert.assertTrue(Arrays.equals(a.wSum(1, 3).values(), new double[] {
+                //
+                1, 4, 6, 10, 11, //
+                4, 4, 3, 1, 9 //
+                }));
+
+        Assert.assertTrue(Arrays.equals(a.wMax(1, 3).values(), new double[] {
+                //
+                1, 3, 3, 5, 5, //
+                4, 4, 4, 2, 8 //
+                }));
+
+        Assert.assertTrue(Arrays.equals(a.wMin(1, 2).values(), new double[] {
+                //
+                1, 1, 2, 2, 4, //
+                4, 0, -1, -1, 2 //
+                }));
+
+        Assert.assertTrue(Tests.equals(a.wMean(0, 2).values(), new double[] {
+                //
+                1, 3, 2, 5, 4, //
+                2.5, 1.5, 0.5, 3.5, 6 //
+                }));
+
+        Assert.assertTrue(Tests.equals(a.wVar(1, 2).values(), new double[] {
+                //
+                0, 1, 0.25, 2.25, 0.25, //
+                0, 4, 0.25, 2.25, 9 //
+                }));
+
+        // Windows covering whole lines degenerate into cumulative operations.
+        Assert.assertTrue(Arrays.equals(a.wSum(1, 5).values(), a.dSum(1).values()));
+
+        // Moving sums shouldn't drift away from exact values under large offsets.
+
+        int size = 1 << 16;
+
+        RealArray b = new RealArray(size);
+
+        for (int i = 0; i < size; i++) {
+            b.set(1e8 + (i % 3), i);
+        }
+
+        Assert.assertTrue(b.wSum(0, 3).get(size - 1) == 3e8 + 3);
+        Assert.assertTrue(Math.abs(b.wVar(0, 3).get(size - 1) - 2.0 / 3.0) < 1e-6);
+
+        // Non-finite values only affect the windows holding them.
+
+        double inf = Double.POSITIVE_INFINITY;
+        double nan = Double.NaN;
+
+        RealArray c = new RealArray(new double[] { 1, 2, nan, 3, inf, 4, 5, 6 });
+
+        Assert.assertTrue(Arrays.equals(c.wSum(0, 2).values(), new double[] {
+                //
+                1, 3, nan, nan, inf, inf, 9, 11 //
+                }));
+
+        Assert.assertTrue(Arrays.equals(c.wMean(0, 2).values(), new double[] {
+                //
+                1, 1.5, nan, nan, inf, inf, 4.5, 5.5 //
+                }));
+
+        Assert.assertTrue(Arrays.equals(c.clone().uMul(-1.0).wSum(0, 3).values(), new double[] {
+                //
+                -1, -3, nan, nan, nan, -inf, -inf, -15 //
+                }));
+
+        double[] expected = new double[] { 0, 0.25, nan, nan, nan, nan, 0.25, 0.25 };
+        double[] actual = c.wVar(0, 2).values();
+
+        for (int i = 0; i < expected.length; i++) {
+            Assert.assertTrue(Double.isNaN(expected[i]) ? Double.isNaN(actual[i]) //
+                    : Math.abs(actual[i] - expected[i]) < 1e-8);
+        }
+    }
+
+    /**
+     * Tests group functions.
+     */
+    @Test
+    public void testRgOps() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                1, 3, 2, 5, 4, //
+                4, 0, -1, 2, 8 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 5 //
+        );
+
+        IntegerArray labels = new IntegerArray(new int[] { 0, 1, 0, -1, 1 }, 5);
+
+        Assert.assertTrue(Arrays.equals(a.gSum(1, labels, 3).values(), new double[] {
+                //
+                3, 7, 0, //
+                3, 8, 0 //
+                }));
+
+        Assert.assertTrue(Arrays.equals(a.gMax(1, labels, 3).values(), new double[] {
+                //
+                2, 4, Double.NaN, //
+                4, 8, Double.NaN //
+                }));
+
+        Assert.assertTrue(Arrays.equals(a.gCount(1, labels, 3).values(), new double[] {
+                //
+                2, 2, 0, //
+                2, 2, 0 //
+                }));
+
+        Assert.assertTrue(Tests.equals(a.gMean(1, labels, 2).values(), new double[] {
+                //
+                1.5, 3.5, //
+                1.5, 4 //
+                }));
+
+        Assert.assertTrue(Tests.equals(a.gVar(1, labels, 2).values(), new double[] {
+                //
+                0.25, 0.25, //
+                6.25, 16 //
+                }));
+
+        // Empty groups have no mean, variance or extrema.
+        Assert.assertTrue(Double.isNaN(a.gMean(1, labels, 3).get(0, 2)));
+        Assert.assertTrue(Double.isNaN(a.gVar(1, labels, 3).get(1, 2)));
+        Assert.assertTrue(Arrays.equals(a.gMin(1, labels, 3).values(), new double[] {
+                //
+                1, 3, Double.NaN, //
+                -1, 0, Double.NaN //
+                }));
+
+        labels = new IntegerArray(new int[] {
+                //
+                0, 0, 1, 1, 2, //
+                2, 1, 1, 0, 0 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 5 //
+        );
+
+        // Labels in a different storage order still line up.
+        Assert.assertTrue(Arrays.equals(a.gSum(labels.reverseOrder(), 3).values(), new double[] { 14, 6, 8 }));
+        Assert.assertTrue(Arrays.equals(a.gMin(labels, 3).values(), new double[] { 1, -1, 4 }));
+    }
+
+    /**
+     * Tests {@link ProtoArray#sortOrder()} and {@link ProtoArray#uniqueIndices()}.
+     */
+    @Test
+    public void testUnique() {
+
+        RealArray a = new RealArray(new double[] {
+                //
+                3, 1, //
+                2, 5, //
+                3, 1, //
+                1, 7, //
+                2, 5 //
+                }, //
+                IndexingOrder.FAR, //
+                5, 2 //
+        ).reverseOrder();
+
+        Assert.assertTrue(Arrays.equals(a.sortOrder(), new int[] { 3, 1, 4, 0, 2 }));
+
+        IntegerArray[] indices = a.uniqueIndices();
+
+        Assert.assertTrue(Arrays.equals(indices[0].values(), new int[] { 3, 1, 0 }));
+        Assert.assertTrue(Arrays.equals(indices[1].values(), new int[] { 2, 1, 2, 0, 1 }));
+        Assert.assertTrue(Arrays.equals(indices[2].values(), new int[] { 1, 2, 2 }));
+
+        Assert.assertTrue(Arrays.equals(a.unique().reverseOrder().values(), new double[] {
+                //
+                1, 7, //
+                2, 5, //
+                3, 1 //
+                }));
+
+        // Negative zero comes before positive zero, and NaN comes last.
+        RealArray b = new RealArray(new double[] { 2, -0.0, Double.NaN, 0.0, 2 }, 5);
+
+        Assert.assertTrue(Arrays.equals(b.sortOrder(), new int[] { 1, 3, 0, 4, 2 }));
+        Assert.assertTrue(Arrays.equals(b.uniqueIndices()[2].values(), new int[] { 1, 1, 2, 1 }));
+    }
+
+    /**
+     * Tests {@link AbstractRealArray#searchSorted(int, AbstractRealArray)} and
+     * {@link AbstractRealArray#interpolate(int, AbstractRealArray, AbstractRealArray)}.
+     */
+    @Test
+    public void testSearchSorted() {
+
+        RealArray edges = new RealArray(new double[] { 0, 1, 1, 3 }, 4);
+        RealArray queries = new RealArray(new double[] { -1, 0, 1, 2, 3, 4, Double.NaN }, 7);
+
+        Assert.assertTrue(Arrays.equals(queries.searchSorted(ArrayKernel.SS_LEFT, edges).values(), //
+                new int[] { 0, 0, 1, 3, 3, 4, 4 }));
+        Assert.assertTrue(Arrays.equals(queries.searchSorted(ArrayKernel.SS_RIGHT, edges).values(), //
+                new int[] { 0, 1, 3, 3, 4, 4, 4 }));
+
+        RealArray x = new RealArray(new double[] { 0, 1, 2, 3 }, 4);
+        RealArray y = new RealArray(new double[] { 0, 1, 4, 9 }, 4);
+        RealArray a = new RealArray(new double[] { -1, 0.5, 1.5, 2.5, 4 }, 5);
+
+        Assert.assertTrue(Tests.equals(a.interpolate(ArrayKernel.IN_LINEAR, x, y).values(), //
+                new double[] { 0, 0.5, 2.5, 6.5, 9 }));
+
+        // Values agree with the PCHIP scheme of Fritsch and Carlson.
+        Assert.assertTrue(Tests.equals(a.interpolate(ArrayKernel.IN_MONOTONE_CUBIC, x, y).values(), //
+                new double[] { 0, 0.3125, 2.21875, 6.21875, 9 }));
+    }
+
+    /**
+     * Tests {@link AbstractRealArray#cLt(double)}, {@link AbstractRealArray#select(Mask, AbstractRealArray)},
+     * {@link AbstractRealArray#uFill(double, Mask)} and the logical operations of {@link Mask}.
+     */
+    @Test
+    public void testMask() {
+
+        int size = 70;
+
+        RealArray a = new RealArray(Arithmetic.doubleRange(size), size);
+
+        Mask lt = a.cLt(35.0);
+        Mask ge = a.cGe(35.0);
+
+        Assert.assertEquals(35, lt.count());
+        Assert.assertTrue(lt.get(34) && !lt.get(35) && ge.get(69));
+        Assert.assertEquals(0, lt.and(ge).count());
+        Assert.assertEquals(size, lt.or(ge).count());
+        Assert.assertEquals(size, lt.xor(ge).count());
+        Assert.assertTrue(Arrays.equals(lt.not().words(), ge.words()));
+        Assert.assertTrue(Arrays.equals(ge.andNot(a.cGe(64.0)).words(), a.cLt(64.0).andNot(lt).words()));
+
+        RealArray b = a.clone().uMul(-1.0);
+
+        Assert.assertEquals(size - 1, a.cGt(b).count());
+        Assert.assertEquals(1, a.cEq(b).count());
+
+        double[] expected = new double[size];
+
+        for (int i = 0; i < size; i++) {
+            expected[i] = (i < 35) ? i : -i;
+        }
+
+        Assert.assertTrue(Tests.equals(a.select(lt, b).values(), expected));
+
+        for (int i = 35; i < size; i++) {
+            expected[i] = Double.NaN;
+        }
+
+        RealArray c = a.clone().uFill(Double.NaN, ge);
+
+        Assert.assertTrue(Arrays.equals(c.values(), expected));
+        Assert.assertTrue(Arrays.equals(c.cNaN().words(), ge.words()));
+        Assert.assertEquals(35, c.cEq(c).count());
+
+        int[] expectedI = Arithmetic.range(size);
+        Arrays.fill(expectedI, 0, 35, 0);
+
+        IntegerArray d = new IntegerArray(Arithmetic.range(size), size);
+
+        Assert.assertTrue(Arrays.equals(d.select(ge, new IntegerArray(IndexingOrder.FAR, size)).values(), //
+                expectedI));
+    }
+
+    /**
+     * Tests the non-mutative unary operations, such as {@link AbstractRealArray#eSqr()} and
+     * {@link AbstractComplexArray#eConj()}, against their mutative counterparts.
+     */
+    @Test
+    public void testNonMutativeUnary() {
+
+        double[] values = new double[] { 0.5, 1.0, 2.0, 3.5, 4.0, 10.0 };
+
+        RealArray a = new RealArray(values.clone(), 2, 3);
+
+        Assert.assertTrue(Arrays.equals(a.eExp().values(), a.clone().uExp().values()));
+        Assert.assertTrue(Arrays.equals(a.eCos().values(), a.clone().uCos().values()));
+        Assert.assertTrue(Arrays.equals(a.eSin().values(), a.clone().uSin().values()));
+        Assert.assertTrue(Arrays.equals(a.eAtan().values(), a.clone().uAtan().values()));
+        Assert.assertTrue(Arrays.equals(a.eLog().values(), a.clone().uLog().values()));
+        Assert.assertTrue(Arrays.equals(a.eAbs().values(), a.clone().uAbs().values()));
+        Assert.assertTrue(Arrays.equals(a.ePow(1.5).values(), a.clone().uPow(1.5).values()));
+        Assert.assertTrue(Arrays.equals(a.eSqrt().values(), a.clone().uSqrt().values()));
+        Assert.assertTrue(Arrays.equals(a.eSqr().values(), a.clone().uSqr().values()));
+        Assert.assertTrue(Arrays.equals(a.eInv(2.0).values(), a.clone().uInv(2.0).values()));
+
+        Assert.assertTrue(Arrays.equals(a.eSqr().dims(), a.dims()));
+        Assert.assertTrue(Arrays.equals(a.values(), values));
+
+        ComplexArray c = new ComplexArray(new double[] {
+                //
+                1, 2, -0.5, 0.25, //
+                3, -1, 0, 1.5 //
+                }, //
+                2, 2, 2);
+
+        double[] cValues = c.values().clone();
+
+        Assert.assertTrue(Arrays.equals(c.eExp().values(), c.clone().uExp().values()));
+        Assert.assertTrue(Arrays.equals(c.eConj().values(), c.clone().uConj().values()));
+        Assert.assertTrue(Arrays.equals(c.eCos().values(), c.clone().uCos().values()));
+        Assert.assertTrue(Arrays.equals(c.eSin().values(), c.clone().uSin().values()));
+
+        Assert.assertTrue(Arrays.equals(c.values(), cValues));
+    }
+
+    /**
+     * Tests conversion, elementwise operations, reductions and matrix multiplication of {@link HalfArray}s.
+     */
+    @Test
+    public void testHalf() {
+
+        // Ties round to even, and overflows past the largest finite value become infinities.
+        RealArray a = new RealArray(new double[] { 1.0, -2.5, 1.0 + 0x1p-11, 1.0 + 0x3p-11, 65504.0, 65520.0, 0x1p-25,
+                0x3p-25 }, 8);
+
+        HalfArray fp16 = new HalfArray(ArrayKernel.HF_FP16, a);
+
+        Assert.assertTrue(Arrays.equals(fp16.values(), new short[] { 0x3C00, (short) 0xC100, 0x3C00, 0x3C02, 0x7BFF,
+                0x7C00, 0x0000, 0x0002 }));
+        Assert.assertTrue(Arrays.equals(fp16.toReal().values(), new double[] { 1.0, -2.5, 1.0, 1.0 + 0x1p-9,
+                65504.0, Double.POSITIVE_INFINITY, 0.0, 0x1p-23 }));
+
+        HalfArray bf16 = new HalfArray(ArrayKernel.HF_BF16, new RealArray(new double[] { 1.0 + 0x1p-8,
+                1.0 + 0x3p-8, 65520.0, 1e39 }, 4));
+
+        Assert.assertTrue(Arrays.equals(bf16.values(), new short[] { 0x3F80, 0x3F82, 0x4780, 0x7F80 }));
+
+        // Results are rounded back to half precision on store.
+        HalfArray b = new HalfArray(ArrayKernel.HF_FP16, new RealArray(new double[] { 2048.0, 3.0, -4.0 }, 3));
+        HalfArray c = new HalfArray(ArrayKernel.HF_FP16, new RealArray(new double[] { 1.0, 3.0, 0.5 }, 3));
+
+        Assert.assertTrue(Arrays.equals(b.eAdd(c).toReal().values(), new double[] { 2048.0, 6.0, -3.5 }));
+        Assert.assertTrue(Arrays.equals(b.eMul(c).toReal().values(), new double[] { 2048.0, 9.0, -2.0 }));
+        Assert.assertTrue(Arrays.equals(b.eDiv(c).toReal().values(), new double[] { 2048.0, 1.0, -8.0 }));
+        Assert.assertTrue(Arrays.equals(b.eMin(c).toReal().values(), new double[] { 1.0, 3.0, -4.0 }));
+
+        Assert.assertEquals(2047.0, b.aSum(), 0.0);
+        Assert.assertEquals(-4.0, b.aMin(), 0.0);
+        Assert.assertEquals(2055.0, b.aNorm1(), 0.0);
+        Assert.assertEquals(Math.sqrt(2048.0 * 2048.0 + 25.0), b.aNorm2(), 1e-10);
+
+        RealArray lhs = new RealArray(new double[] {
+                //
+                1, 2, 3, //
+                -1, 0, 0.5 //
+                }, //
+                2, 3);
+
+        RealArray rhs = new RealArray(new double[] {
+                //
+                2, 0, //
+                1, -1, //
+                0.25, 4 //
+                }, //
+                3, 2);
+
+        for (int format : new int[] { ArrayKernel.HF_FP16, ArrayKernel.HF_BF16 }) {
+            Assert.assertTrue(Tests.equals(new HalfArray(format, lhs).mMul(new HalfArray(format, rhs)).values(), //
+                    lhs.mMul(rhs).values()));
+        }
+
+        // BF16 products see the operands as rounded on store.
+        HalfArray bfLhs = new HalfArray(ArrayKernel.HF_BF16, lhs.clone().uMul(1.0 + 0x1p-9));
+        HalfArray bfRhs = new HalfArray(ArrayKernel.HF_BF16, rhs.clone().uAdd(0x1p-10));
+
+        Assert.assertTrue(Tests.equals(bfLhs.mMul(bfRhs).values(), //
+                bfLhs.toReal().mMul(bfRhs.toReal()).values()));
+
+        // Arrays in nondefault indexing order keep their order and logical layout.
+        RealArray near = new RealArray(new double[] { 1, 2, 3, 4, 5, 6 }, IndexingOrder.NEAR, 2, 3);
+        HalfArray nearHalf = new HalfArray(ArrayKernel.HF_FP16, near);
+
+        Assert.assertEquals(IndexingOrder.NEAR, nearHalf.order());
+        Assert.assertEquals(IndexingOrder.NEAR, nearHalf.toReal().order());
+        Assert.assertEquals(near.get(1, 2), nearHalf.toReal().get(1, 2), 0.0);
+        Assert.assertTrue(Arrays.equals(nearHalf.eAdd(nearHalf).toReal().values(), near.clone().uMul(2.0).values()));
+
+        // Empty arrays make for empty results.
+        HalfArray empty = new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.FAR, 0, 3);
+
+        Assert.assertEquals(0, empty.eMul(empty).values().length);
+        Assert.assertEquals(0.0, empty.aSum(), 0.0);
+        Assert.assertTrue(Arrays.equals(empty.mMul(new HalfArray(ArrayKernel.HF_FP16, rhs)).dims(), //
+                new int[] { 0, 2 }));
+        Assert.assertTrue(Arrays.equals(new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.FAR, 2, 0) //
+                .mMul(new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.FAR, 0, 3)).values(), new double[6]));
+    }
+
+    /**
+     * Tests that {@link HalfArray} operations reject operands whose shapes don't match.
+     */
+    @Test(expected = RuntimeException.class)
+    public void testHalfShapeMismatch() {
+
+        HalfArray a = new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.FAR, 2, 3);
+        HalfArray b = new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.FAR, 3, 2);
+
+        try {
+
+            a.eAdd(b);
+
+        } catch (RuntimeException e) {
+
+            Assert.assertTrue(e.getMessage().equals("Dimensions do not match"));
+
+            throw e;
+        }
+    }
+
+    /**
+     * Tests that {@link HalfArray#mMul(HalfArray)} rejects operands whose inner dimensions don't match.
+     */
+    @Test(expected = RuntimeException.class)
+    public void testHalfInnerMismatch() {
+
+        HalfArray a = new HalfArray(ArrayKernel.HF_BF16, IndexingOrder.FAR, 0, 3);
+        HalfArray b = new HalfArray(ArrayKernel.HF_BF16, IndexingOrder.FAR, 2, 2);
+
+        try {
+
+            a.mMul(b);
+
+        } catch (RuntimeException e) {
+
+            Assert.assertTrue(e.getMessage().equals("Dimension mismatch"));
+
+            throw e;
+        }
+    }
+
+    /**
+     * Tests that {@link HalfArray#mMul(HalfArray)} rejects operands in nondefault indexing order.
+     */
+    @Test(expected = RuntimeException.class)
+    public void testHalfOrderMismatch() {
+
+        HalfArray a = new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.NEAR, 2, 2);
+        HalfArray b = new HalfArray(ArrayKernel.HF_FP16, IndexingOrder.FAR, 2, 2);
+
+        try {
+
+            a.mMul(b);
+
+        } catch (RuntimeException e) {
+
+            Assert.assertTrue(e.getMessage().equals("Array must have row major indexing"));
+
+            throw e;
+        }
+    }
+
     /**
      * Tests {@link AbstractRealArray#map(RealMap)}.
      */
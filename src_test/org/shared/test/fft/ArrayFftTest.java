@@ -284,6 +284,53 @@ public class ArrayFftTest {
         Assert.assertTrue(Arrays.equals(a.fftShift().ifftShift().values(), a.values()));
     }
 
+    /**
+     * Tests {@link ComplexArray#fft()} and {@link RealArray#rfft()} for lengths with assorted prime factors against the
+     * direct DFT.
+     */
+    @Test
+    public void testPrimeFactors() {
+
+        for (int n : new int[] { 1, 2, 6, 8, 15, 16, 49, 77, 97, 106, 125 }) {
+
+            ComplexArray a = new ComplexArray(n, 2);
+            double[] values = a.values();
+
+            for (int i = 0, m = values.length; i < m; i++) {
+                values[i] = Arithmetic.nextInt(16) - 8;
+            }
+
+            double[] expected = new double[2 * n];
+
+            for (int k = 0; k < n; k++) {
+
+                for (int j = 0; j < n; j++) {
+
+                    double angle = (-2.0 * Math.PI * ((long) j * k % n)) / n;
+                    double c = Math.cos(angle);
+                    double s = Math.sin(angle);
+
+                    expected[2 * k] += values[2 * j] * c - values[2 * j + 1] * s;
+                    expected[2 * k + 1] += values[2 * j] * s + values[2 * j + 1] * c;
+                }
+            }
+
+            Assert.assertTrue(Tests.equals(a.fft().values(), expected));
+            Assert.assertTrue(Tests.equals(a.fft().ifft().values(), values));
+
+            RealArray b = new RealArray(3, n);
+            double[] realValues = b.values();
+
+            for (int i = 0, m = realValues.length; i < m; i++) {
+                realValues[i] = Arithmetic.nextInt(16) - 8;
+            }
+
+            Assert.assertTrue(Tests.equals(b.rfft().rifft().values(), realValues));
+            Assert.assertTrue(Tests.equals(b.rfft().values(), //
+                    b.tocRe().fft().subarray(0, 3, 0, n / 2 + 1, 0, 2).values()));
+        }
+    }
+
     /**
      * Tests {@link JavaFftService#reducedToFull(ComplexArray, int[])}.
      */
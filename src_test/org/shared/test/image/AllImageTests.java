@@ -37,13 +37,25 @@ import org.junit.runners.Suite.SuiteClasses;
  * 
  * @apiviz.owns org.shared.test.image.IntegralImageTest
  * @apiviz.owns org.shared.test.image.IntegralHistogramTest
+ * @apiviz.owns org.shared.test.image.IntegralMomentsTest
+ * @apiviz.owns org.shared.test.image.TemplateMatcherTest
+ * @apiviz.owns org.shared.test.image.PeakFinderTest
+ * @apiviz.owns org.shared.test.image.ResamplerTest
+ * @apiviz.owns org.shared.test.image.BilateralFilterTest
+ * @apiviz.owns org.shared.test.image.WaveletsTest
  * @author Roy Liu
  */
 @RunWith(Suite.class)
 @SuiteClasses(value = {
 //
         IntegralImageTest.class, //
-        IntegralHistogramTest.class //
+        IntegralHistogramTest.class, //
+        IntegralMomentsTest.class, //
+        TemplateMatcherTest.class, //
+        PeakFinderTest.class, //
+        ResamplerTest.class, //
+        BilateralFilterTest.class, //
+        WaveletsTest.class //
 })
 public class AllImageTests {
 
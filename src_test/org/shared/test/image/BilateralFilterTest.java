@@ -0,0 +1,188 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.test.image;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.RealArray;
+import org.shared.image.LocalFilters;
+import org.shared.util.Arithmetic;
+
+/**
+ * A class of unit tests for {@link LocalFilters#bilateral(RealArray, double, double...)}.
+ * 
+ * @author Roy Liu
+ */
+public class BilateralFilterTest {
+
+    /**
+     * Default constructor.
+     */
+    public BilateralFilterTest() {
+    }
+
+    /**
+     * Tests that constant images pass through unchanged, both for the bilateral grid and the permutohedral lattice.
+     */
+    @Test
+    public void testConstant() {
+
+        for (int nChannels = 1; nChannels <= 3; nChannels++) {
+
+            for (IndexingOrder order : IndexingOrder.values()) {
+
+                RealArray src = new RealArray(order, 12, 15, nChannels);
+
+                for (int i = 0, n = 12 * 15 * nChannels; i < n; i++) {
+                    src.set(1.5 + i % nChannels, i / (15 * nChannels), (i / nChannels) % 15, i % nChannels);
+                }
+
+                RealArray res = LocalFilters.bilateral(src, 0.5, 2.0, 3.0);
+
+                Assert.assertTrue(res.eSub(src).uAbs().aMax() < 1e-12);
+            }
+        }
+    }
+
+    /**
+     * Tests that step edges much taller than the range standard deviation are preserved.
+     */
+    @Test
+    public void testEdges() {
+
+        int height = 20;
+        int width = 24;
+
+        for (int nChannels = 1; nChannels <= 3; nChannels++) {
+
+            RealArray src = new RealArray(height, width, nChannels);
+
+            for (int y = 0; y < height; y++) {
+
+                for (int x = width / 2; x < width; x++) {
+
+                    for (int channel = 0; channel < nChannels; channel++) {
+                        src.set(10.0 + channel, y, x, channel);
+                    }
+                }
+            }
+
+            RealArray res = LocalFilters.bilateral(src, 1.0, 3.0, 3.0);
+
+            Assert.assertTrue(res.eSub(src).uAbs().aMax() < 1e-6);
+        }
+    }
+
+    /**
+     * Tests the approximation against a naive Gaussian bilateral filter on a noisy step edge. The filtered result
+     * should be much closer to the naive result than the source is.
+     */
+    @Test
+    public void testApproximation() {
+
+        int height = 30;
+        int width = 36;
+        double spatialSigma = 3.0;
+        double rangeSigma = 1.0;
+
+        for (int nChannels = 1; nChannels <= 3; nChannels++) {
+
+            RealArray src = new RealArray(height, width, nChannels);
+
+            for (int y = 0; y < height; y++) {
+
+                for (int x = 0; x < width; x++) {
+
+                    for (int channel = 0; channel < nChannels; channel++) {
+                        src.set(((x < width / 2) ? 0.0 : 4.0) + Math.sin(0.2 * y + channel) //
+                                + Arithmetic.nextDouble(0.3), y, x, channel);
+                    }
+                }
+            }
+
+            RealArray res = LocalFilters.bilateral(src, rangeSigma, spatialSigma, spatialSigma);
+            RealArray expected = naiveBilateral(src, spatialSigma, rangeSigma);
+
+            Assert.assertTrue(res.eSub(expected).uAbs().aMean() < 0.5 * src.eSub(expected).uAbs().aMean());
+        }
+    }
+
+    /**
+     * Applies a Gaussian bilateral filter to an image of size [height, width, nChannels] by direct summation over
+     * windows of three standard deviations.
+     */
+    final protected static RealArray naiveBilateral(RealArray src, double spatialSigma, double rangeSigma) {
+
+        int[] dims = src.dims();
+        int height = dims[0];
+        int width = dims[1];
+        int nChannels = dims[2];
+        int radius = (int) Math.ceil(3.0 * spatialSigma);
+
+        RealArray dst = new RealArray(dims);
+
+        for (int y = 0; y < height; y++) {
+
+            for (int x = 0; x < width; x++) {
+
+                double[] acc = new double[nChannels];
+                double weightAcc = 0.0;
+
+                for (int yy = Math.max(y - radius, 0); yy <= Math.min(y + radius, height - 1); yy++) {
+
+                    for (int xx = Math.max(x - radius, 0); xx <= Math.min(x + radius, width - 1); xx++) {
+
+                        double dist = ((yy - y) * (yy - y) + (xx - x) * (xx - x)) / (spatialSigma * spatialSigma);
+
+                        for (int channel = 0; channel < nChannels; channel++) {
+
+                            double diff = (src.get(yy, xx, channel) - src.get(y, x, channel)) / rangeSigma;
+                            dist += diff * diff;
+                        }
+
+                        double weight = Math.exp(-0.5 * dist);
+
+                        for (int channel = 0; channel < nChannels; channel++) {
+                            acc[channel] += weight * src.get(yy, xx, channel);
+                        }
+
+                        weightAcc += weight;
+                    }
+                }
+
+                for (int channel = 0; channel < nChannels; channel++) {
+                    dst.set(acc[channel] / weightAcc, y, x, channel);
+                }
+            }
+        }
+
+        return dst;
+    }
+}
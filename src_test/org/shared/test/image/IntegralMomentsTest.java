@@ -0,0 +1,257 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.test.image;
+
+import static org.shared.image.kernel.ImageKernel.IM_X;
+import static org.shared.image.kernel.ImageKernel.IM_XX;
+import static org.shared.image.kernel.ImageKernel.IM_XY;
+import static org.shared.image.kernel.ImageKernel.IM_Y;
+import static org.shared.image.kernel.ImageKernel.IM_YY;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.RealArray;
+import org.shared.image.IntegralMoments;
+import org.shared.image.LocalFilters;
+import org.shared.util.Arithmetic;
+
+/**
+ * A class of unit tests for {@link IntegralMoments} and {@link LocalFilters}.
+ * 
+ * @author Roy Liu
+ */
+public class IntegralMomentsTest {
+
+    /**
+     * Default constructor.
+     */
+    public IntegralMomentsTest() {
+    }
+
+    /**
+     * Tests {@link IntegralMoments}. Multiple regions are queried and compared against naive baseline summations.
+     */
+    @Test
+    public void testIntegralMoments() {
+
+        int baseSize = 16;
+        int maxDims = 3;
+
+        int nTrials = 3;
+        int nQueries = 64;
+
+        for (int trialIndex = 0; trialIndex < nTrials; trialIndex++) {
+
+            for (int nDims = 1; nDims <= maxDims; nDims++) {
+
+                int[] dims = new int[nDims];
+
+                for (int dim = 0; dim < nDims; dim++) {
+                    dims[dim] = baseSize + Arithmetic.nextInt(baseSize);
+                }
+
+                IndexingOrder order = Arithmetic.nextInt(2) == 0 ? IndexingOrder.FAR : IndexingOrder.NEAR;
+
+                RealArray x = createRandom(order, dims);
+                RealArray y = createRandom(order, dims);
+
+                IntegralMoments im = new IntegralMoments(x, y, IM_XY, IM_X, IM_XX, IM_Y, IM_YY);
+
+                double[] res = new double[5];
+
+                for (int i = 0; i < nQueries; i++) {
+
+                    int[] bounds = new int[2 * nDims];
+
+                    for (int dim = 0; dim < nDims; dim++) {
+
+                        bounds[dim << 1] = Arithmetic.nextInt(dims[dim]);
+                        bounds[(dim << 1) + 1] = //
+                        bounds[dim << 1] + Arithmetic.nextInt(dims[dim] - bounds[dim << 1]) + 1;
+                    }
+
+                    im.query(res, bounds);
+
+                    RealArray xSub = x.subarray(bounds);
+                    RealArray ySub = y.subarray(bounds);
+
+                    Assert.assertTrue(Math.abs(res[0] - xSub.eMul(ySub).aSum()) < 1e-8);
+                    Assert.assertTrue(Math.abs(res[1] - xSub.aSum()) < 1e-8);
+                    Assert.assertTrue(Math.abs(res[2] - xSub.uSqr().aSum()) < 1e-8);
+                    Assert.assertTrue(Math.abs(res[3] - ySub.aSum()) < 1e-8);
+                    Assert.assertTrue(Math.abs(res[4] - ySub.uSqr().aSum()) < 1e-8);
+                }
+            }
+        }
+    }
+
+    /**
+     * Tests {@link LocalFilters#meanVariance(RealArray, int...)}. Results are compared against naive baselines over
+     * border-clipped windows. A large offset is added to the values to exercise numerical stability.
+     */
+    @Test
+    public void testMeanVariance() {
+
+        int baseSize = 8;
+        int maxDims = 3;
+
+        int nTrials = 3;
+
+        for (int trialIndex = 0; trialIndex < nTrials; trialIndex++) {
+
+            for (int nDims = 1; nDims <= maxDims; nDims++) {
+
+                int[] dims = new int[nDims];
+                int[] radii = new int[nDims];
+
+                for (int dim = 0; dim < nDims; dim++) {
+
+                    dims[dim] = baseSize + Arithmetic.nextInt(baseSize);
+                    radii[dim] = Arithmetic.nextInt(4);
+                }
+
+                IndexingOrder order = Arithmetic.nextInt(2) == 0 ? IndexingOrder.FAR : IndexingOrder.NEAR;
+
+                RealArray src = createRandom(order, dims).uAdd(1e6);
+                RealArray[] res = LocalFilters.meanVariance(src, radii);
+
+                for (int i = 0, n = Arithmetic.product(dims); i < n; i++) {
+
+                    int[] s = unravel(i, dims);
+                    RealArray window = src.subarray(windowBounds(s, dims, radii));
+
+                    Assert.assertTrue(Math.abs(res[0].get(s) - window.aMean()) < 1e-6);
+                    Assert.assertTrue(Math.abs(res[1].get(s) - window.aVar()) < 1e-6);
+                }
+            }
+        }
+    }
+
+    /**
+     * Tests {@link LocalFilters#guided(RealArray, RealArray, double, int...)}. Results are compared against a naive
+     * implementation of the filter.
+     */
+    @Test
+    public void testGuided() {
+
+        int[] dims = new int[] { 13, 17 };
+        int[] radii = new int[] { 2, 1 };
+        double epsilon = 0.01;
+
+        int nValues = Arithmetic.product(dims);
+
+        RealArray guide = createRandom(IndexingOrder.FAR, dims);
+        RealArray src = createRandom(IndexingOrder.FAR, dims);
+
+        RealArray a = new RealArray(dims);
+        RealArray b = new RealArray(dims);
+
+        for (int i = 0; i < nValues; i++) {
+
+            int[] s = unravel(i, dims);
+            int[] bounds = windowBounds(s, dims, radii);
+
+            RealArray guideWindow = guide.subarray(bounds);
+            RealArray srcWindow = src.subarray(bounds);
+
+            double meanG = guideWindow.aMean();
+            double meanP = srcWindow.aMean();
+            double cov = guideWindow.eMul(srcWindow).aMean() - meanG * meanP;
+
+            a.set(cov / (guideWindow.aVar() + epsilon), s);
+            b.set(meanP - a.get(s) * meanG, s);
+        }
+
+        RealArray res = LocalFilters.guided(guide, src, epsilon, radii);
+
+        for (int i = 0; i < nValues; i++) {
+
+            int[] s = unravel(i, dims);
+            int[] bounds = windowBounds(s, dims, radii);
+
+            double expected = a.subarray(bounds).aMean() * guide.get(s) + b.subarray(bounds).aMean();
+
+            Assert.assertTrue(Math.abs(res.get(s) - expected) < 1e-8);
+        }
+
+        // A source that guides itself with negligible regularization passes through unchanged.
+        res = LocalFilters.guided(src, src, 1e-12, radii);
+
+        Assert.assertTrue(res.eSub(src).uAbs().aMax() < 1e-4);
+    }
+
+    /**
+     * Creates a {@link RealArray} of uniformly random values.
+     */
+    final protected static RealArray createRandom(IndexingOrder order, int... dims) {
+
+        double[] values = new double[Arithmetic.product(dims)];
+
+        for (int i = 0; i < values.length; i++) {
+            values[i] = Arithmetic.nextDouble(1.0);
+        }
+
+        return new RealArray(values, order, dims);
+    }
+
+    /**
+     * Converts a row-major linear index into a logical index.
+     */
+    final protected static int[] unravel(int index, int[] dims) {
+
+        int nDims = dims.length;
+        int[] s = new int[nDims];
+
+        for (int dim = nDims - 1; dim >= 0; dim--) {
+
+            s[dim] = index % dims[dim];
+            index /= dims[dim];
+        }
+
+        return s;
+    }
+
+    /**
+     * Creates the bounds of a window centered at the given logical index and clipped at the borders.
+     */
+    final protected static int[] windowBounds(int[] s, int[] dims, int[] radii) {
+
+        int nDims = dims.length;
+        int[] bounds = new int[2 * nDims];
+
+        for (int dim = 0; dim < nDims; dim++) {
+
+            bounds[dim << 1] = Math.max(s[dim] - radii[dim], 0);
+            bounds[(dim << 1) + 1] = Math.min(s[dim] + radii[dim] + 1, dims[dim]);
+        }
+
+        return bounds;
+    }
+}
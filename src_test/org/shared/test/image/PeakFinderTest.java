@@ -0,0 +1,216 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.test.image;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.IntegerArray;
+import org.shared.array.RealArray;
+import org.shared.image.PeakFinder;
+import org.shared.util.Arithmetic;
+
+/**
+ * A class of unit tests for {@link PeakFinder}.
+ * 
+ * @author Roy Liu
+ */
+public class PeakFinderTest {
+
+    /**
+     * Default constructor.
+     */
+    public PeakFinderTest() {
+    }
+
+    /**
+     * Tests {@link PeakFinder#find(RealArray, double, int, int...)} against a naive baseline. Values are drawn from a
+     * small set so that plateaus and ties are common.
+     */
+    @Test
+    public void testFind() {
+
+        int[][] dimsArr = new int[][] { { 37 }, { 13, 11 }, { 6, 7, 5 } };
+
+        for (int trialIndex = 0; trialIndex < 30; trialIndex++) {
+
+            int[] dims = dimsArr[trialIndex % dimsArr.length];
+            int nDims = dims.length;
+            int[] radii = new int[nDims];
+
+            for (int dim = 0; dim < nDims; dim++) {
+                radii[dim] = Arithmetic.nextInt(4);
+            }
+
+            double[] srcV = new double[Arithmetic.product(dims)];
+
+            for (int i = 0; i < srcV.length; i++) {
+                srcV[i] = Arithmetic.nextInt(6);
+            }
+
+            RealArray src = new RealArray(srcV, //
+                    Arithmetic.nextInt(2) == 0 ? IndexingOrder.FAR : IndexingOrder.NEAR, dims);
+
+            double threshold = (trialIndex % 2 == 0) ? 2.0 : Double.NEGATIVE_INFINITY;
+            int minDistance = trialIndex % 4;
+
+            IntegerArray peaks = PeakFinder.find(src, threshold, minDistance, radii);
+
+            Assert.assertArrayEquals(naiveFind(src, threshold, minDistance, radii), peaks.values());
+
+            RealArray values = PeakFinder.values(src, peaks);
+
+            for (int i = 1, n = values.size(0); i < n; i++) {
+                Assert.assertTrue(values.get(i - 1) >= values.get(i));
+            }
+        }
+    }
+
+    /**
+     * Tests {@link PeakFinder#find(RealArray, double, int, int...)} on a small example.
+     */
+    @Test
+    public void testSuppression() {
+
+        RealArray src = new RealArray(new double[] {
+                //
+                1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, //
+                0.0, 0.0, 0.0, 5.0, 0.0, 4.0, 0.0, //
+                0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, //
+                3.0, 0.0, 0.0, 0.0, 0.0, 0.0, Double.NaN //
+                }, //
+                IndexingOrder.FAR, //
+                4, 7);
+
+        Assert.assertArrayEquals(new int[] {
+                //
+                1, 3, //
+                1, 5, //
+                3, 0, //
+                0, 0 //
+                }, PeakFinder.find(src, 0.5, 0, 1, 1).values());
+
+        // The peak at (1, 5) is within distance 3 of the one at (1, 3).
+        Assert.assertArrayEquals(new int[] {
+                //
+                1, 3, //
+                3, 0, //
+                0, 0 //
+                }, PeakFinder.find(src, 0.5, 3, 1, 1).values());
+
+        Assert.assertArrayEquals(new int[] {
+                //
+                1, 3 //
+                }, PeakFinder.find(src, 4.5, 0, 1, 1).values());
+
+        Assert.assertArrayEquals(new double[] { 5.0, 3.0, 1.0 }, //
+                PeakFinder.values(src, PeakFinder.find(src, 0.5, 3, 1, 1)).values(), 0.0);
+    }
+
+    /**
+     * Finds peaks by exhaustively comparing each value against its neighborhood.
+     */
+    final protected static int[] naiveFind(RealArray src, double threshold, int minDistance, int[] radii) {
+
+        int[] dims = src.dims();
+        int nDims = dims.length;
+        int len = src.values().length;
+
+        List<int[]> candidates = new ArrayList<int[]>();
+
+        for (int i = 0; i < len; i++) {
+
+            int[] s = IntegralMomentsTest.unravel(i, dims);
+            double value = src.get(s);
+
+            if (!(value >= threshold) || Double.isInfinite(value)) {
+                continue;
+            }
+
+            boolean isPeak = true;
+
+            for (int j = 0; j < len && isPeak; j++) {
+
+                int[] t = IntegralMomentsTest.unravel(j, dims);
+                boolean inside = true;
+
+                for (int dim = 0; dim < nDims; dim++) {
+                    inside &= Math.abs(s[dim] - t[dim]) <= radii[dim];
+                }
+
+                isPeak = !(inside && src.get(t) > value);
+            }
+
+            if (isPeak) {
+
+                // Insert after all candidates with greater or equal values.
+                int k = 0;
+
+                while (k < candidates.size() && src.get(candidates.get(k)) >= value) {
+                    k++;
+                }
+
+                candidates.add(k, s);
+            }
+        }
+
+        List<int[]> peaks = new ArrayList<int[]>();
+
+        for (int[] s : candidates) {
+
+            boolean accept = true;
+
+            for (int[] t : peaks) {
+
+                int distance = 0;
+
+                for (int dim = 0; dim < nDims; dim++) {
+                    distance = Math.max(distance, Math.abs(s[dim] - t[dim]));
+                }
+
+                accept &= (minDistance <= 1 || distance >= minDistance);
+            }
+
+            if (accept) {
+                peaks.add(s);
+            }
+        }
+
+        int[] res = new int[peaks.size() * nDims];
+
+        for (int i = 0, n = peaks.size(); i < n; i++) {
+            System.arraycopy(peaks.get(i), 0, res, i * nDims, nDims);
+        }
+
+        return res;
+    }
+}
@@ -0,0 +1,225 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.test.image;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.ComplexArray;
+import org.shared.array.RealArray;
+import org.shared.image.Resampler;
+import org.shared.image.kernel.ImageKernel;
+import org.shared.util.Arithmetic;
+
+/**
+ * A class of unit tests for {@link Resampler}.
+ * 
+ * @author Roy Liu
+ */
+public class ResamplerTest {
+
+    /**
+     * The interpolation types under test.
+     */
+    final protected static int[] interpolations = new int[] {
+            //
+            ImageKernel.IP_NEAREST, ImageKernel.IP_LINEAR, ImageKernel.IP_CUBIC //
+    };
+
+    /**
+     * The boundary modes under test.
+     */
+    final protected static int[] boundaries = new int[] {
+            //
+            ImageKernel.BM_CONSTANT, ImageKernel.BM_NEAREST, ImageKernel.BM_REFLECT, ImageKernel.BM_WRAP //
+    };
+
+    /**
+     * Default constructor.
+     */
+    public ResamplerTest() {
+    }
+
+    /**
+     * Tests {@link Resampler#map(RealArray, RealArray, int, int, double)} with integer shifts, under which every
+     * interpolation type should reproduce the source as extended by the boundary mode.
+     */
+    @Test
+    public void testShift() {
+
+        int[] dims = new int[] { 7, 5, 6 };
+        int nDims = dims.length;
+
+        RealArray src = IntegralMomentsTest.createRandom(IndexingOrder.NEAR, dims);
+
+        for (int interpolation : interpolations) {
+
+            for (int boundary : boundaries) {
+
+                int[] shifts = new int[nDims];
+
+                for (int dim = 0; dim < nDims; dim++) {
+                    shifts[dim] = Arithmetic.nextInt(2 * dims[dim] + 1) - dims[dim];
+                }
+
+                RealArray coords = Resampler.gridCoordinates(dims);
+                double[] coordsV = coords.values();
+
+                for (int i = 0, n = coordsV.length; i < n; i++) {
+                    coordsV[i] += shifts[i % nDims];
+                }
+
+                RealArray dst = Resampler.map(src, coords, interpolation, boundary, -1.0);
+
+                for (int i = 0, n = dst.values().length; i < n; i++) {
+
+                    int[] s = IntegralMomentsTest.unravel(i, dims);
+                    int[] t = new int[nDims];
+                    boolean outside = false;
+
+                    for (int dim = 0; dim < nDims; dim++) {
+
+                        t[dim] = extend(s[dim] + shifts[dim], dims[dim], boundary);
+                        outside |= (t[dim] < 0);
+                    }
+
+                    Assert.assertEquals(outside ? -1.0 : src.get(t), dst.get(s), 1e-10);
+                }
+            }
+        }
+    }
+
+    /**
+     * Tests {@link Resampler#affineCoordinates(RealArray, int...)} by warping a linear ramp, which multilinear
+     * interpolation reproduces exactly.
+     */
+    @Test
+    public void testAffine() {
+
+        int[] dims = new int[] { 40, 30 };
+
+        RealArray src = new RealArray(IndexingOrder.FAR, dims);
+
+        for (int i = 0; i < dims[0]; i++) {
+
+            for (int j = 0; j < dims[1]; j++) {
+                src.set(0.5 * i - 2.0 * j + 3.0, i, j);
+            }
+        }
+
+        // A rotation by 30 degrees about the center, scaled down.
+        double c = 0.5 * Math.cos(Math.PI / 6.0);
+        double s = 0.5 * Math.sin(Math.PI / 6.0);
+
+        RealArray matrix = new RealArray(new double[] {
+                //
+                c, -s, 20.0 - 10.0 * c + 7.5 * s, //
+                s, c, 15.0 - 10.0 * s - 7.5 * c //
+                }, //
+                2, 3);
+
+        RealArray coords = Resampler.affineCoordinates(matrix, 20, 15);
+        RealArray dst = Resampler.map(src, coords, ImageKernel.IP_LINEAR, ImageKernel.BM_CONSTANT, 0.0);
+
+        Assert.assertArrayEquals(new int[] { 20, 15 }, dst.dims());
+
+        for (int i = 0; i < 20; i++) {
+
+            for (int j = 0; j < 15; j++) {
+
+                double x = coords.get(i, j, 0);
+                double y = coords.get(i, j, 1);
+
+                Assert.assertTrue(x > 0.0 && x < dims[0] - 1 && y > 0.0 && y < dims[1] - 1);
+                Assert.assertEquals(0.5 * x - 2.0 * y + 3.0, dst.get(i, j), 1e-10);
+            }
+        }
+    }
+
+    /**
+     * Tests {@link Resampler#splineCoefficients(RealArray, int, double)} and complex interpolation for consistency.
+     */
+    @Test
+    public void testConsistency() {
+
+        int[] dims = new int[] { 9, 8 };
+
+        RealArray re = IntegralMomentsTest.createRandom(IndexingOrder.FAR, dims);
+        RealArray im = IntegralMomentsTest.createRandom(IndexingOrder.FAR, dims);
+        ComplexArray src = re.tocRe().eAdd(im.tocIm());
+
+        RealArray coords = IntegralMomentsTest.createRandom(IndexingOrder.FAR, 50, 2).uMul(16.0).uAdd(-4.0);
+
+        for (int boundary : boundaries) {
+
+            RealArray expected = Resampler.map(re, coords, ImageKernel.IP_CUBIC, boundary, 0.5);
+            RealArray actual = Resampler.map(Resampler.splineCoefficients(re, boundary, 0.5), coords, //
+                    ImageKernel.IP_SPLINE, boundary, 0.5);
+
+            Assert.assertTrue(expected.eSub(actual).uAbs().aMax() < 1e-10);
+
+            for (int interpolation : interpolations) {
+
+                ComplexArray dst = Resampler.map(src, coords, interpolation, boundary, 0.5);
+
+                Assert.assertTrue(dst.torRe().eSub( //
+                        Resampler.map(re, coords, interpolation, boundary, 0.5)).uAbs().aMax() < 1e-10);
+                Assert.assertTrue(dst.torIm().eSub( //
+                        Resampler.map(im, coords, interpolation, boundary, 0.0)).uAbs().aMax() < 1e-10);
+            }
+        }
+    }
+
+    /**
+     * Extends an index according to a boundary mode.
+     */
+    final protected static int extend(int index, int size, int boundary) {
+
+        switch (boundary) {
+
+        case ImageKernel.BM_CONSTANT:
+            return (index >= 0 && index < size) ? index : -1;
+
+        case ImageKernel.BM_NEAREST:
+            return Math.max(Math.min(index, size - 1), 0);
+
+        case ImageKernel.BM_REFLECT:
+
+            index = ((index % (2 * size)) + 2 * size) % (2 * size);
+
+            return (index < size) ? index : 2 * size - 1 - index;
+
+        case ImageKernel.BM_WRAP:
+            return ((index % size) + size) % size;
+
+        default:
+            throw new IllegalArgumentException();
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.test.image;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.RealArray;
+import org.shared.image.TemplateMatcher;
+import org.shared.util.Arithmetic;
+
+/**
+ * A class of unit tests for {@link TemplateMatcher}.
+ * 
+ * @author Roy Liu
+ */
+public class TemplateMatcherTest {
+
+    /**
+     * Default constructor.
+     */
+    public TemplateMatcherTest() {
+    }
+
+    /**
+     * Tests {@link TemplateMatcher#match(RealArray, RealArray)}. Templates are affinely transformed cutouts of the
+     * source, and scores are compared against naive baselines. Both small and large templates are tried, so as to
+     * exercise direct and frequency domain correlation.
+     */
+    @Test
+    public void testMatch() {
+
+        int[][] srcDimsArr = new int[][] { { 24, 29 }, { 64, 64 }, { 9, 10, 11 } };
+        int[][] tplDimsArr = new int[][] { { 4, 3 }, { 40, 40 }, { 3, 2, 4 } };
+
+        for (int trialIndex = 0; trialIndex < srcDimsArr.length; trialIndex++) {
+
+            int[] srcDims = srcDimsArr[trialIndex];
+            int[] tplDims = tplDimsArr[trialIndex];
+            int nDims = srcDims.length;
+
+            RealArray src = IntegralMomentsTest.createRandom( //
+                    Arithmetic.nextInt(2) == 0 ? IndexingOrder.FAR : IndexingOrder.NEAR, srcDims).uAdd(100.0);
+
+            int[] bounds = new int[2 * nDims];
+            int[] expected = new int[nDims];
+
+            for (int dim = 0; dim < nDims; dim++) {
+
+                expected[dim] = Arithmetic.nextInt(srcDims[dim] - tplDims[dim] + 1);
+                bounds[dim << 1] = expected[dim];
+                bounds[(dim << 1) + 1] = expected[dim] + tplDims[dim];
+            }
+
+            RealArray template = src.subarray(bounds).uMul(2.0).uAdd(3.0);
+            RealArray scores = TemplateMatcher.match(src, template);
+
+            Assert.assertTrue(Math.abs(scores.get(expected) - 1.0) < 1e-8);
+            Assert.assertArrayEquals(expected, TemplateMatcher.top(scores, 1).values());
+
+            for (int i = 0, n = scores.values().length; i < n; i++) {
+
+                int[] s = IntegralMomentsTest.unravel(i, scores.dims());
+
+                for (int dim = 0; dim < nDims; dim++) {
+
+                    bounds[dim << 1] = s[dim];
+                    bounds[(dim << 1) + 1] = s[dim] + tplDims[dim];
+                }
+
+                Assert.assertTrue(Math.abs(scores.get(s) - naiveScore(src.subarray(bounds), template)) < 1e-8);
+            }
+        }
+    }
+
+    /**
+     * Tests {@link TemplateMatcher#top(RealArray, int, int...)} and
+     * {@link TemplateMatcher#top(RealArray, RealArray, int)}.
+     */
+    @Test
+    public void testTop() {
+
+        RealArray scores = new RealArray(new double[] {
+                //
+                0.1, 0.9, 0.3, //
+                0.7, 0.2, 0.9 //
+                }, //
+                IndexingOrder.FAR, //
+                2, 3);
+
+        // Ties go to earlier positions.
+        int[] expected = new int[] {
+                //
+                0, 1, //
+                1, 2, //
+                1, 0 //
+        };
+
+        Assert.assertArrayEquals(expected, TemplateMatcher.top(scores, 3).values());
+        Assert.assertEquals(6, TemplateMatcher.top(scores, 10).size(0));
+        Assert.assertEquals(0, TemplateMatcher.top(scores, 0).size(0));
+
+        // Plant the template at two separated positions, with slight noise on the second copy so that it scores lower.
+        RealArray src = IntegralMomentsTest.createRandom(IndexingOrder.FAR, 40, 40);
+        RealArray template = IntegralMomentsTest.createRandom(IndexingOrder.FAR, 6, 5);
+
+        int[][] planted = new int[][] { { 3, 4 }, { 25, 30 } };
+
+        for (int k = 0; k < planted.length; k++) {
+
+            for (int i = 0; i < 6; i++) {
+
+                for (int j = 0; j < 5; j++) {
+                    src.set(template.get(i, j) + k * 0.02 * Arithmetic.nextDouble(1.0), //
+                            planted[k][0] + i, planted[k][1] + j);
+                }
+            }
+        }
+
+        RealArray matchScores = TemplateMatcher.match(src, template);
+
+        Assert.assertArrayEquals(new int[] {
+                //
+                3, 4, //
+                25, 30 //
+                }, TemplateMatcher.top(matchScores, template, 2).values());
+    }
+
+    /**
+     * Computes the normalized cross-correlation of two equally sized arrays.
+     */
+    final protected static double naiveScore(RealArray window, RealArray template) {
+
+        RealArray a = window.clone().uAdd(-window.aMean());
+        RealArray b = template.clone().uAdd(-template.aMean());
+
+        double denominator = Math.sqrt(a.clone().uSqr().aSum() * b.clone().uSqr().aSum());
+
+        return (denominator > 0.0) ? a.eMul(b).aSum() / denominator : 0.0;
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * <p>
+ * Copyright (c) 2010 Roy Liu<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.shared.test.image;
+
+import static org.shared.image.kernel.ImageKernel.WT_CDF97;
+import static org.shared.image.kernel.ImageKernel.WT_DB4;
+import static org.shared.image.kernel.ImageKernel.WT_HAAR;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.array.RealArray;
+import org.shared.image.Wavelets;
+import org.shared.util.Arithmetic;
+
+/**
+ * A class of unit tests for {@link Wavelets}.
+ * 
+ * @author Roy Liu
+ */
+public class WaveletsTest {
+
+    /**
+     * Default constructor.
+     */
+    public WaveletsTest() {
+    }
+
+    /**
+     * Tests that inverse transforms reconstruct their inputs for every wavelet, including odd sizes.
+     */
+    @Test
+    public void testReconstruction() {
+
+        for (int wavelet = WT_HAAR; wavelet <= WT_CDF97; wavelet++) {
+
+            for (int nDims = 1; nDims <= 3; nDims++) {
+
+                int[] dims = new int[nDims];
+
+                for (int dim = 0; dim < nDims; dim++) {
+                    dims[dim] = 1 + Arithmetic.nextInt(nDims == 1 ? 50 : 12);
+                }
+
+                IndexingOrder order = Arithmetic.nextInt(2) == 0 ? IndexingOrder.FAR : IndexingOrder.NEAR;
+                RealArray src = IntegralMomentsTest.createRandom(order, dims);
+                RealArray res = Wavelets.inverse(Wavelets.transform(new RealArray(src), wavelet, 3), wavelet, 3);
+
+                Assert.assertTrue(res.eSub(src).uAbs().aMax() < 1e-10);
+            }
+        }
+    }
+
+    /**
+     * Tests the Haar wavelet against its definition.
+     */
+    @Test
+    public void testHaar() {
+
+        RealArray src = IntegralMomentsTest.createRandom(IndexingOrder.FAR, 16);
+        RealArray res = Wavelets.transform(new RealArray(src), WT_HAAR, 1);
+
+        for (int i = 0; i < 8; i++) {
+
+            double a = src.get(2 * i);
+            double b = src.get(2 * i + 1);
+
+            Assert.assertTrue(Math.abs(res.get(i) - (a + b) / Math.sqrt(2.0)) < 1e-12);
+            Assert.assertTrue(Math.abs(res.get(8 + i) - (b - a) / Math.sqrt(2.0)) < 1e-12);
+        }
+    }
+
+    /**
+     * Tests that detail coefficients of polynomials of degree less than the number of vanishing moments are zero away
+     * from the boundaries.
+     */
+    @Test
+    public void testVanishingMoments() {
+
+        int size = 128;
+        int margin = 12;
+
+        for (int[] waveletMoments : new int[][] { { WT_HAAR, 1 }, { WT_DB4, 4 }, { WT_CDF97, 4 } }) {
+
+            RealArray src = new RealArray(size);
+
+            for (int i = 0; i < size; i++) {
+
+                double t = (i - size / 2) / (double) size;
+                double value = 0.0;
+
+                for (int p = 0; p < waveletMoments[1]; p++) {
+                    value += (p + 1) * Math.pow(t, p);
+                }
+
+                src.set(value, i);
+            }
+
+            RealArray res = Wavelets.transform(src, waveletMoments[0], 1);
+
+            for (int i = size / 2 + margin; i < size - margin; i++) {
+                Assert.assertTrue(Math.abs(res.get(i)) < 1e-10);
+            }
+        }
+    }
+}
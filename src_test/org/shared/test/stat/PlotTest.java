@@ -39,10 +39,12 @@ import org.junit.BeforeClass;
 import org.junit.Test;
 import org.shared.array.AbstractRealArray.RealMap;
 import org.shared.array.RealArray;
+import org.shared.array.kernel.ArrayKernel;
 import org.shared.stat.plot.DataStyle;
 import org.shared.stat.plot.DataStyle.DataStyleType;
 import org.shared.stat.plot.GnuplotContext;
 import org.shared.stat.plot.Histogram;
+import org.shared.stat.plot.KernelDensity;
 import org.shared.stat.plot.Plot.AxisScaleType;
 import org.shared.stat.plot.Plot.AxisType;
 import org.shared.stat.plot.PrecisionRecall;
@@ -51,6 +53,7 @@ import org.shared.stat.plot.ProbabilityDistribution.Mode;
 import org.shared.stat.plot.Roc;
 import org.shared.stat.plot.Scatter;
 import org.shared.test.Demo;
+import org.shared.test.Tests;
 import org.shared.util.Arithmetic;
 import org.shared.util.IoBase;
 
@@ -271,4 +274,112 @@ public class PlotTest {
         Assert.assertTrue(pngFile.exists());
         Assert.assertTrue(svgFile.exists());
     }
+
+    /**
+     * Tests that quantile {@link Histogram}s plot densities and pass their bin widths on to Gnuplot.
+     */
+    @Test
+    public void testHistogram() {
+
+        double[] values = new double[100];
+
+        for (int i = 0; i < values.length; i++) {
+            values[i] = i;
+        }
+
+        Histogram histogram = new Histogram(ArrayKernel.HI_QUANTILE, 0.0, 0.0, 4, values);
+        RealArray dataset = histogram.getDatasets()[0];
+
+        Assert.assertTrue(Tests.equals(dataset.subarray(0, 4, 0, 1).values(), //
+                new double[] { 12.0, 36.5, 61.5, 86.5 }));
+        Assert.assertTrue(Tests.equals(dataset.subarray(0, 4, 1, 2).values(), //
+                new double[] { 1.0, 1.0, 1.0, 1.04 }));
+        Assert.assertTrue(Tests.equals(histogram.getDataStyles()[0].getBoxWidths(), //
+                new double[] { 24.0, 25.0, 25.0, 25.0 }));
+
+        GnuplotContext gpc = new GnuplotContext();
+        gpc.addPlot(histogram);
+
+        Assert.assertTrue(gpc.toString().contains("\"-\" using 1:2:3"));
+    }
+
+    /**
+     * Tests that {@link KernelDensity} doesn't pile up values from outside of the plotted range on the end grid points.
+     */
+    @Test
+    public void testKernelDensity() {
+
+        int nValues = 16384;
+        int nPoints = 65;
+        double h = 0.2;
+
+        double[] values = new double[nValues];
+
+        Arithmetic.derandomize();
+
+        for (int i = 0; i < nValues; i++) {
+            values[i] = Arithmetic.nextGaussian(1.0);
+        }
+
+        RealArray dataset = new KernelDensity(-1.0, 1.0, nPoints, h, values).getDatasets()[0];
+
+        // The estimate is the standard normal density smoothed by the kernel.
+        double sigma = Math.sqrt(1.0 + h * h);
+
+        for (int i = 0; i < nPoints; i++) {
+
+            double x = dataset.get(i, 0);
+            double expected = Math.exp(-0.5 * x * x / (sigma * sigma)) / (sigma * Math.sqrt(2.0 * Math.PI));
+
+            Assert.assertEquals(expected, dataset.get(i, 1), 0.03);
+        }
+
+        Assert.assertEquals(-1.0, dataset.get(0, 0), 1e-8);
+        Assert.assertEquals(1.0, dataset.get(nPoints - 1, 0), 1e-8);
+    }
+
+    /**
+     * Tests {@link KernelDensity} with bandwidths wide enough for the kernel to extend well beyond the plotted range.
+     */
+    @Test
+    public void testKernelDensityWide() {
+
+        int nValues = 16384;
+        int nPoints = 65;
+
+        double[] values = new double[nValues];
+
+        Arithmetic.derandomize();
+
+        for (int i = 0; i < nValues; i++) {
+            values[i] = Arithmetic.nextGaussian(1.0);
+        }
+
+        for (double h : new double[] { 1.0, 4.0 }) {
+
+            RealArray dataset = new KernelDensity(-1.0, 1.0, nPoints, h, values).getDatasets()[0];
+
+            double sigma = Math.sqrt(1.0 + h * h);
+
+            double mass = 0.0;
+            double expectedMass = 0.0;
+
+            for (int i = 0; i < nPoints; i++) {
+
+                double x = dataset.get(i, 0);
+                double expected = Math.exp(-0.5 * x * x / (sigma * sigma)) / (sigma * Math.sqrt(2.0 * Math.PI));
+
+                Assert.assertEquals(expected, dataset.get(i, 1), 0.005);
+
+                // Integrate with the trapezoid rule.
+                double weight = (i == 0 || i == nPoints - 1) ? 0.5 : 1.0;
+
+                mass += weight * dataset.get(i, 1);
+                expectedMass += weight * expected;
+            }
+
+            // The estimate should carry all of the smoothed density's mass over the range.
+            Assert.assertEquals(1.0, mass / expectedMass, 0.01);
+        }
+    }
 }
@@ -43,6 +43,9 @@ import org.shared.util.Control;
  * 
  * @apiviz.owns org.sharedx.test.BenchmarkJava
  * @apiviz.owns org.sharedx.test.BenchmarkNative
+ * @apiviz.owns org.sharedx.test.ConvolutionTest
+ * @apiviz.owns org.sharedx.test.GuruPlanTest
+ * @apiviz.owns org.sharedx.test.StftTest
  * @author Roy Liu
  */
 @LoadableResources(resources = {
@@ -95,7 +98,10 @@ public class AllX {
         Tests.runTests("Extension Module Tests", //
                 AllFftTests.class, //
                 BenchmarkJava.class, //
-                BenchmarkNative.class);
+                BenchmarkNative.class, //
+                ConvolutionTest.class, //
+                GuruPlanTest.class, //
+                StftTest.class);
     }
 
     // Dummy constructor.
@@ -0,0 +1,117 @@
+/**
+ * <p>
+ * Copyright (c) 2008 The Regents of the University of California<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.sharedx.test;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.array.Array.IndexingOrder;
+import org.shared.util.Arithmetic;
+import org.sharedx.fftw.FftwService;
+
+/**
+ * A class of unit tests for {@link FftwService#convolve(int[], double[], int[], double[])}.
+ * 
+ * @author Roy Liu
+ */
+public class ConvolutionTest {
+
+    /**
+     * Default constructor.
+     */
+    public ConvolutionTest() {
+    }
+
+    /**
+     * Tests {@link FftwService#smoothSize(int)}.
+     */
+    @Test
+    public void testSmoothSize() {
+
+        Assert.assertEquals(1, FftwService.smoothSize(1));
+        Assert.assertEquals(12, FftwService.smoothSize(11));
+        Assert.assertEquals(14, FftwService.smoothSize(13));
+        Assert.assertEquals(98, FftwService.smoothSize(97));
+        Assert.assertEquals(105, FftwService.smoothSize(101));
+        Assert.assertEquals(1024, FftwService.smoothSize(1024));
+    }
+
+    /**
+     * Tests convolutions of awkwardly sized arrays against direct summation.
+     */
+    @Test
+    public void testConvolve() {
+
+        FftwService service = new FftwService();
+
+        for (int nDims = 1; nDims <= 3; nDims++) {
+
+            int[] imDims = new int[nDims];
+            int[] kerDims = new int[nDims];
+            int[] outDims = new int[nDims];
+
+            for (int dim = 0; dim < nDims; dim++) {
+
+                imDims[dim] = 1 + Arithmetic.nextInt(13);
+                kerDims[dim] = 1 + Arithmetic.nextInt(5);
+                outDims[dim] = imDims[dim] + kerDims[dim] - 1;
+            }
+
+            double[] im = StftTest.createRandom(Arithmetic.product(imDims));
+            double[] ker = StftTest.createRandom(Arithmetic.product(kerDims));
+            double[] expected = new double[Arithmetic.product(outDims)];
+
+            int[] imStrides = IndexingOrder.FAR.strides(imDims);
+            int[] kerStrides = IndexingOrder.FAR.strides(kerDims);
+            int[] outStrides = IndexingOrder.FAR.strides(outDims);
+
+            for (int i = 0; i < im.length; i++) {
+
+                for (int j = 0; j < ker.length; j++) {
+
+                    int offset = 0;
+
+                    for (int dim = 0; dim < nDims; dim++) {
+                        offset += ((i / imStrides[dim]) % imDims[dim] //
+                                + (j / kerStrides[dim]) % kerDims[dim]) * outStrides[dim];
+                    }
+
+                    expected[offset] += im[i] * ker[j];
+                }
+            }
+
+            double[] res = service.convolve(imDims, im, kerDims, ker);
+
+            Assert.assertEquals(expected.length, res.length);
+
+            for (int i = 0, n = res.length; i < n; i++) {
+                Assert.assertEquals(expected[i], res[i], 1e-10);
+            }
+        }
+    }
+}
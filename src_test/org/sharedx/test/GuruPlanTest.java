@@ -0,0 +1,206 @@
+/**
+ * <p>
+ * Copyright (c) 2008 The Regents of the University of California<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.sharedx.test;
+
+import static org.sharedx.fftw.Plan.BACKWARD;
+import static org.sharedx.fftw.Plan.C_TO_R;
+import static org.sharedx.fftw.Plan.FORWARD;
+import static org.sharedx.fftw.Plan.R_TO_C;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.sharedx.fftw.FftwService;
+import org.sharedx.fftw.GuruPlan;
+
+/**
+ * A class of unit tests for {@link GuruPlan}.
+ * 
+ * @author Roy Liu
+ */
+public class GuruPlanTest {
+
+    /**
+     * Default constructor.
+     */
+    public GuruPlanTest() {
+    }
+
+    /**
+     * Tests complex transforms along a middle axis against transforms of individually extracted lines.
+     */
+    @Test
+    public void testAxis() {
+
+        FftwService service = new FftwService();
+
+        int[] dims = new int[] { 4, 5, 6 };
+        int[] strides = new int[] { 30, 6, 1 };
+
+        double[] in = StftTest.createRandom(2 * 4 * 5 * 6);
+        double[] out = new double[in.length];
+
+        service.transform(FORWARD, dims, new int[] { 1 }, strides, in, 0, strides, out, 0);
+
+        double[] line = new double[2 * 5];
+        double[] expected = new double[2 * 5];
+
+        for (int i = 0; i < 4; i++) {
+
+            for (int k = 0; k < 6; k++) {
+
+                for (int j = 0; j < 5; j++) {
+
+                    line[2 * j] = in[2 * (30 * i + 6 * j + k)];
+                    line[2 * j + 1] = in[2 * (30 * i + 6 * j + k) + 1];
+                }
+
+                service.fft(new int[] { 5 }, line, expected);
+
+                for (int j = 0; j < 5; j++) {
+
+                    Assert.assertEquals(expected[2 * j], out[2 * (30 * i + 6 * j + k)], 1e-10);
+                    Assert.assertEquals(expected[2 * j + 1], out[2 * (30 * i + 6 * j + k) + 1], 1e-10);
+                }
+            }
+        }
+    }
+
+    /**
+     * Tests real-to-complex transforms along the slower varying axis of a column-major array.
+     */
+    @Test
+    public void testRealAxis() {
+
+        FftwService service = new FftwService();
+
+        int[] dims = new int[] { 7, 10 };
+
+        double[] in = StftTest.createRandom(7 * 10);
+        double[] out = new double[2 * 7 * 6];
+
+        service.transform(R_TO_C, dims, new int[] { 1 }, new int[] { 1, 7 }, in, 0, new int[] { 1, 7 }, out, 0);
+
+        double[] line = new double[10];
+        double[] expected = new double[2 * 6];
+
+        for (int i = 0; i < 7; i++) {
+
+            for (int j = 0; j < 10; j++) {
+                line[j] = in[i + 7 * j];
+            }
+
+            service.rfft(new int[] { 10 }, line, expected);
+
+            for (int j = 0; j < 6; j++) {
+
+                Assert.assertEquals(expected[2 * j], out[2 * (i + 7 * j)], 1e-10);
+                Assert.assertEquals(expected[2 * j + 1], out[2 * (i + 7 * j) + 1], 1e-10);
+            }
+        }
+    }
+
+    /**
+     * Tests that multidimensional real transforms along permuted axes of differently laid out arrays round-trip.
+     */
+    @Test
+    public void testRealRoundTrip() {
+
+        FftwService service = new FftwService();
+
+        int[] dims = new int[] { 6, 3, 9 };
+        int[] axes = new int[] { 2, 0 };
+
+        // The complex side has dimensions {4, 3, 9}.
+        int[] realStrides = new int[] { 1, 6, 18 };
+        int[] complexStrides = new int[] { 27, 9, 1 };
+
+        double[] in = StftTest.createRandom(6 * 3 * 9);
+        double[] spectrum = new double[2 * 4 * 3 * 9];
+        double[] res = new double[in.length];
+
+        service.transform(R_TO_C, dims, axes, realStrides, in, 0, complexStrides, spectrum, 0);
+        service.transform(C_TO_R, dims, axes, complexStrides, spectrum, 0, realStrides, res, 0);
+
+        for (int i = 0, n = in.length; i < n; i++) {
+            Assert.assertEquals(in[i], res[i], 1e-10);
+        }
+    }
+
+    /**
+     * Tests that transforms of strided subviews leave elements outside of them untouched.
+     */
+    @Test
+    public void testSubview() {
+
+        FftwService service = new FftwService();
+
+        // Every other row of an 8-by-6 complex array, starting from the second.
+        int[] dims = new int[] { 4, 6 };
+        int[] strides = new int[] { 12, 1 };
+
+        double[] in = StftTest.createRandom(2 * 8 * 6);
+        double[] spectrum = new double[in.length];
+        double[] res = new double[in.length];
+
+        service.transform(FORWARD, dims, new int[] { 1, 0 }, strides, in, 12, strides, spectrum, 12);
+        service.transform(BACKWARD, dims, new int[] { 1, 0 }, strides, spectrum, 12, strides, res, 12);
+
+        for (int row = 0; row < 8; row++) {
+
+            for (int i = 12 * row, n = 12 * (row + 1); i < n; i++) {
+                Assert.assertEquals((row % 2 == 1) ? in[i] : 0.0, res[i], 1e-10);
+            }
+        }
+    }
+
+    /**
+     * Tests that passing the same array as both input and output is rejected regardless of how the JVM pins it.
+     */
+    @Test(expected = RuntimeException.class)
+    public void testAliased() {
+
+        FftwService service = new FftwService();
+
+        int[] dims = new int[] { 4, 6 };
+        int[] strides = new int[] { 6, 1 };
+
+        double[] in = StftTest.createRandom(2 * 4 * 6);
+
+        try {
+
+            service.transform(FORWARD, dims, new int[] { 1 }, strides, in, 0, strides, in, 0);
+
+        } catch (RuntimeException e) {
+
+            Assert.assertTrue(e.getMessage().equals("Input and output arrays must be distinct"));
+
+            throw e;
+        }
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * <p>
+ * Copyright (c) 2008 The Regents of the University of California<br>
+ * All rights reserved.
+ * </p>
+ * <p>
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+ * following conditions are met:
+ * </p>
+ * <ul>
+ * <li>Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+ * disclaimer.</li>
+ * <li>Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the
+ * following disclaimer in the documentation and/or other materials provided with the distribution.</li>
+ * <li>Neither the name of the author nor the names of any contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.</li>
+ * </ul>
+ * <p>
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * </p>
+ */
+
+package org.sharedx.test;
+
+import static org.sharedx.fftw.Plan.STFT_COMPLEX;
+import static org.sharedx.fftw.Plan.STFT_LOG_MAGNITUDE;
+import static org.sharedx.fftw.Plan.STFT_MAGNITUDE;
+import static org.sharedx.fftw.Plan.STFT_POWER;
+
+import org.junit.Assert;
+import org.junit.Test;
+import org.shared.util.Arithmetic;
+import org.sharedx.fftw.FftwService;
+
+/**
+ * A class of unit tests for short-time Fourier transforms in {@link FftwService}.
+ * 
+ * @author Roy Liu
+ */
+public class StftTest {
+
+    /**
+     * Default constructor.
+     */
+    public StftTest() {
+    }
+
+    /**
+     * Tests that spectra agree with transforms of individually windowed frames.
+     */
+    @Test
+    public void testFrames() {
+
+        FftwService service = new FftwService();
+
+        int frameLen = 64;
+        int hop = 24;
+        int nBins = frameLen / 2 + 1;
+
+        double[] signal = createRandom(1000);
+        double[] window = hann(frameLen);
+
+        double[] complex = service.stft(signal, window, hop, STFT_COMPLEX);
+        double[] magnitude = service.stft(signal, window, hop, STFT_MAGNITUDE);
+        double[] power = service.stft(signal, window, hop, STFT_POWER);
+        double[] logMagnitude = service.stft(signal, window, hop, STFT_LOG_MAGNITUDE);
+
+        int nFrames = FftwService.frameCount(signal.length, frameLen, hop);
+
+        Assert.assertEquals(40, nFrames);
+        Assert.assertEquals(nFrames * 2 * nBins, complex.length);
+        Assert.assertEquals(nFrames * nBins, magnitude.length);
+
+        double[] frame = new double[frameLen];
+        double[] spectrum = new double[2 * nBins];
+
+        for (int t = 0; t < nFrames; t++) {
+
+            for (int i = 0; i < frameLen; i++) {
+                frame[i] = window[i] * signal[t * hop + i];
+            }
+
+            service.rfft(new int[] { frameLen }, frame, spectrum);
+
+            for (int k = 0; k < nBins; k++) {
+
+                double re = spectrum[2 * k];
+                double im = spectrum[2 * k + 1];
+                double p = re * re + im * im;
+
+                Assert.assertEquals(re, complex[t * 2 * nBins + 2 * k], 1e-10);
+                Assert.assertEquals(im, complex[t * 2 * nBins + 2 * k + 1], 1e-10);
+                Assert.assertEquals(Math.sqrt(p), magnitude[t * nBins + k], 1e-10);
+                Assert.assertEquals(p, power[t * nBins + k], 1e-9);
+                Assert.assertEquals(Math.log(Math.sqrt(p)), logMagnitude[t * nBins + k], 1e-8);
+            }
+        }
+    }
+
+    /**
+     * Tests that inverse transforms reconstruct the covered portion of the signal.
+     */
+    @Test
+    public void testReconstruction() {
+
+        FftwService service = new FftwService();
+
+        for (int frameLen : new int[] { 32, 45 }) {
+
+            for (int hop : new int[] { frameLen / 4, frameLen / 2, frameLen }) {
+
+                double[] signal = createRandom(frameLen + 7 * hop);
+                double[] window = hann(frameLen);
+
+                double[] res = service.istft(service.stft(signal, window, hop, STFT_COMPLEX), window, hop);
+
+                Assert.assertEquals(signal.length, res.length);
+
+                for (int i = 0, n = res.length; i < n; i++) {
+
+                    if (res[i] != 0.0) {
+                        Assert.assertEquals(signal[i], res[i], 1e-10);
+                    }
+                }
+
+                // Interior samples are always covered when hops don't exceed half a frame.
+                if (2 * hop <= frameLen) {
+
+                    for (int i = frameLen, n = res.length - frameLen; i < n; i++) {
+                        Assert.assertEquals(signal[i], res[i], 1e-10);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Creates a random signal.
+     */
+    protected static double[] createRandom(int len) {
+
+        double[] res = new double[len];
+
+        for (int i = 0; i < len; i++) {
+            res[i] = Arithmetic.nextDouble() - 0.5;
+        }
+
+        return res;
+    }
+
+    /**
+     * Creates a periodic Hann window.
+     */
+    protected static double[] hann(int len) {
+
+        double[] res = new double[len];
+
+        for (int i = 0; i < len; i++) {
+            res[i] = 0.5 - 0.5 * Math.cos(2.0 * Math.PI * i / len);
+        }
+
+        return res;
+    }
+}
@@ -35,6 +35,7 @@ includes = {
 //
         "org.shared.test", //
         "org.shared.array.jni", //
+        "org.shared.fft.jni", //
         "org.shared.image.jni", //
         "org.sharedx.fftw" //
 })